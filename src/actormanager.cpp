@@ -73,6 +73,12 @@
 
 ActorManager *actorManager = nullptr;
 
+// beings outside of screen plus margin (in tiles) not animated
+static const int lodVisibleMargin = 3;
+// beings outside of this margin updated each lodFarRate ticks
+static const int lodFarMargin = 20;
+static const int lodFarRate = 5;
+
 class FindBeingFunctor final
 {
     public:
@@ -200,6 +206,7 @@ ActorManager::ActorManager() :
     mIdName(),
     mBlockedBeings(),
     mChars(),
+    mNameRequests(),
     mMap(nullptr),
 #ifdef TMWA_SUPPORT
     mSpellHeal1(serverConfig.getValue("spellHeal1", "#lum")),
@@ -213,6 +220,7 @@ ActorManager::ActorManager() :
     mCycleNPC(config.getBoolValue("cycleNPC")),
     mExtMouseTargeting(config.getBoolValue("extMouseTargeting")),
     mEnableIdCollecting(config.getBoolValue("enableIdCollecting")),
+    mEnableBeingLod(config.getBoolValue("enableBeingLod")),
     mPriorityAttackMobs(),
     mPriorityAttackMobsSet(),
     mPriorityAttackMobsMap(),
@@ -235,6 +243,7 @@ ActorManager::ActorManager() :
     config.addListener("extMouseTargeting", this);
     config.addListener("showBadges", this);
     config.addListener("enableIdCollecting", this);
+    config.addListener("enableBeingLod", this);
 
     loadAttackList();
 }
@@ -284,26 +293,23 @@ Being *ActorManager::createBeing(const BeingId id,
         case ActorType::Homunculus:
         case ActorType::Npc:
             being->updateFromCache();
-            if (beingHandler)
-                beingHandler->requestNameById(id);
+            requestName(id);
             if (localPlayer)
                 localPlayer->checkNewName(being);
             break;
         case ActorType::Monster:
             if (serverFeatures && serverFeatures->haveMonsterName())
-                beingHandler->requestNameById(id);
+                requestName(id);
             break;
         case ActorType::Portal:
-            if (beingHandler &&
-                serverFeatures &&
+            if (serverFeatures &&
                 serverFeatures->haveServerWarpNames())
             {
-                beingHandler->requestNameById(id);
+                requestName(id);
             }
             break;
         case ActorType::Elemental:
-            if (beingHandler)
-                beingHandler->requestNameById(id);
+            requestName(id);
             break;
         case ActorType::SkillUnit:
             break;
@@ -930,11 +936,54 @@ const ActorSprites &ActorManager::getAll() const
 void ActorManager::logic()
 {
     BLOCK_START("ActorManager::logic")
-    for_actors
+    sendNameRequests();
+    if (!mEnableBeingLod || !viewport)
     {
+        for_actors
+        {
 // disabled for performance
-//        if (reportFalse(*it))
-        (*it)->logic();
+//            if (reportFalse(*it))
+            (*it)->logic();
+        }
+    }
+    else
+    {
+        // visible area with margin for big sprites
+        const int margin = lodVisibleMargin * mapTileSize;
+        const int x1 = viewport->getCameraX() - margin;
+        const int y1 = viewport->getCameraY() - margin;
+        const int x2 = viewport->getCameraX() + viewport->getWidth() + margin;
+        const int y2 = viewport->getCameraY() + viewport->getHeight()
+            + margin;
+        const int farMargin = lodFarMargin * mapTileSize;
+
+        for_actors
+        {
+            ActorSprite *const actor = *it;
+            if (actor->getType() == ActorType::FloorItem ||
+                actor == localPlayer)
+            {
+                actor->logic();
+                continue;
+            }
+            const int x = actor->getPixelX();
+            const int y = actor->getPixelY();
+            if (x >= x1 && x <= x2 && y >= y1 && y <= y2)
+            {
+                actor->logic();
+            }
+            else if (x >= x1 - farMargin &&
+                     x <= x2 + farMargin &&
+                     y >= y1 - farMargin &&
+                     y <= y2 + farMargin)
+            {
+                static_cast<Being*>(actor)->lodLogic(1);
+            }
+            else
+            {
+                static_cast<Being*>(actor)->lodLogic(lodFarRate);
+            }
+        }
     }
 
     if (mDeleteActors.empty())
@@ -987,6 +1036,30 @@ void ActorManager::logic()
     BLOCK_END("ActorManager::logic")
 }
 
+void ActorManager::requestName(const BeingId id)
+{
+    mNameRequests.push_back(id);
+}
+
+void ActorManager::sendNameRequests()
+{
+    if (mNameRequests.empty())
+        return;
+
+    BLOCK_START("ActorManager::sendNameRequests")
+    if (beingHandler)
+    {
+        // send requests in one burst, for beings what still exists
+        FOR_EACH (std::vector<BeingId>::const_iterator, it, mNameRequests)
+        {
+            if (mActorsIdMap.find(*it) != mActorsIdMap.end())
+                beingHandler->requestNameById(*it);
+        }
+    }
+    mNameRequests.clear();
+    BLOCK_END("ActorManager::sendNameRequests")
+}
+
 void ActorManager::clear()
 {
     if (beingEquipmentWindow)
@@ -1012,6 +1085,7 @@ void ActorManager::clear()
     }
 
     mChars.clear();
+    mNameRequests.clear();
 }
 
 Being *ActorManager::findNearestPvpPlayer() const
@@ -1818,6 +1892,8 @@ void ActorManager::optionChanged(const std::string &name)
         updateBadges();
     else if (name == "enableIdCollecting")
         mEnableIdCollecting = config.getBoolValue("enableIdCollecting");
+    else if (name == "enableBeingLod")
+        mEnableBeingLod = config.getBoolValue("enableBeingLod");
 }
 
 void ActorManager::removeAttackMob(const std::string &name)
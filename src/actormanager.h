@@ -255,6 +255,12 @@ class ActorManager final: public ConfigListener
          */
         void logic();
 
+        /**
+         * Queues name request for being.
+         * All queued requests sent together in next logic call.
+         */
+        void requestName(const BeingId id);
+
         /**
          * Destroys all ActorSprites except the local player
          */
@@ -408,12 +414,15 @@ class ActorManager final: public ConfigListener
 
         void storeAttackList() const;
 
+        void sendNameRequests();
+
         ActorSprites mActors;
         ActorSprites mDeleteActors;
         ActorSpritesMap mActorsIdMap;
         IdNameMapping mIdName;
         std::set<BeingId> mBlockedBeings;
         std::map<int32_t, std::string> mChars;
+        std::vector<BeingId> mNameRequests;
         Map *mMap;
 #ifdef TMWA_SUPPORT
         std::string mSpellHeal1;
@@ -428,6 +437,7 @@ class ActorManager final: public ConfigListener
         bool mCycleNPC;
         bool mExtMouseTargeting;
         bool mEnableIdCollecting;
+        bool mEnableBeingLod;
 
 #define defVarsP(mob) \
         std::list<std::string> mPriority##mob;\
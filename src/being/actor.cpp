@@ -21,6 +21,8 @@
 
 #include "being/actor.h"
 
+#include "settings.h"
+
 #include "resources/map/map.h"
 
 #include "debug.h"
@@ -31,7 +33,8 @@ Actor::Actor() :
     mMap(nullptr),
     mPos(),
     mYDiff(0),
-    mMapActor()
+    mMapActor(),
+    mSortRow(-1)
 {
 }
 
@@ -76,6 +79,12 @@ int Actor::getTileY() const
 void Actor::setPixelPositionF(const Vector &restrict pos) restrict2
 {
     mPos = pos;
-    mPixelX = CAST_S32(mPos.x);
-    mPixelY = CAST_S32(mPos.y);
+    const int pixelX = CAST_S32(mPos.x);
+    const int pixelY = CAST_S32(mPos.y);
+    if (pixelX != mPixelX || pixelY != mPixelY)
+    {
+        mPixelX = pixelX;
+        mPixelY = pixelY;
+        settings.needRedraw = true;
+    }
 }
@@ -138,7 +138,10 @@ class Actor notfinal
         int mYDiff;
 
     private:
+        friend class ActorRows;
+
         Actors::iterator mMapActor;
+        int mSortRow;
 };
 
 #endif  // BEING_ACTOR_H
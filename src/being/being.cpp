@@ -33,6 +33,7 @@
 #include "soundmanager.h"
 #include "text.h"
 
+#include "being/beingcache.h"
 #include "being/beingcacheentry.h"
 #include "being/beingflag.h"
 #include "being/beingspeech.h"
@@ -114,9 +115,9 @@
 #include "utils/gettext.h"
 #include "utils/timer.h"
 
-#include "debug.h"
+#include <algorithm>
 
-const unsigned int CACHE_SIZE = 50;
+#include "debug.h"
 
 time_t Being::mUpdateConfigTime = 0;
 unsigned int Being::mConfLineLim = 0;
@@ -138,7 +139,6 @@ bool Being::mUseDiagonal = true;
 uint8_t Being::mShowBadges = 1;
 int Being::mAwayEffect = -1;
 
-std::list<BeingCacheEntry*> beingInfoCache;
 typedef std::map<int, Guild*>::const_iterator GuildsMapCIter;
 typedef std::map<int, int>::const_iterator IntMapCIter;
 
@@ -247,6 +247,7 @@ Being::Being(const BeingId id,
     mManner(0),
     mAreaSize(11),
     mCastEndTime(0),
+    mLodTicks(0),
     mCreatorId(BeingId_zero),
     mTeamId(0U),
     mLook(0U),
@@ -375,6 +376,7 @@ void Being::setSubtype(const BeingTypeId subtype,
                     0,
                     mInfo->getColor(fromInt(mLook, ItemColor)));
                 mYDiff = mInfo->getSortOffsetY();
+                soundManager.preloadSfx(mInfo->getSounds());
             }
             break;
         case ActorType::Pet:
@@ -1761,9 +1763,29 @@ void Being::nextTile() restrict2
 void Being::logic() restrict2
 {
     BLOCK_START("Being::logic")
-    if (A_UNLIKELY(mSpeechTime != 0))
+    stateLogic(mLodTicks + 1);
+    mLodTicks = 0;
+    spritesLogic();
+    BLOCK_END("Being::logic")
+}
+
+void Being::lodLogic(const int rate) restrict2
+{
+    BLOCK_START("Being::lodLogic")
+    mLodTicks ++;
+    if (mLodTicks >= rate)
     {
-        mSpeechTime--;
+        stateLogic(mLodTicks);
+        mLodTicks = 0;
+    }
+    BLOCK_END("Being::lodLogic")
+}
+
+void Being::stateLogic(const int ticks) restrict2
+{
+    if (A_UNLIKELY(mSpeechTime > 0))
+    {
+        mSpeechTime -= std::min(mSpeechTime, ticks);
         if (mSpeechTime == 0 && mText != nullptr)
             delete2(mText)
     }
@@ -1777,39 +1799,12 @@ void Being::logic() restrict2
         }
     }
 
-    const int time = tick_time * MILLISECONDS_IN_A_TICK;
-    if (mEmotionSprite)
-        mEmotionSprite->update(time);
-    for_each_horses(mDownHorseSprites)
-        (*it)->update(time);
-    for_each_horses(mUpHorseSprites)
-        (*it)->update(time);
-
     if (mCastEndTime != 0 && mCastEndTime < tick_time)
     {
         mCastEndTime = 0;
         delete2(mCastingEffect);
     }
 
-    if (mAnimationEffect)
-    {
-        mAnimationEffect->update(time);
-        if (mAnimationEffect->isTerminated())
-            delete2(mAnimationEffect)
-    }
-    if (mCastingEffect)
-    {
-        mCastingEffect->update(time);
-        if (mCastingEffect->isTerminated())
-            delete2(mCastingEffect)
-    }
-    for_each_badges()
-    {
-        AnimatedSprite *restrict const sprite = mBadges[f];
-        if (sprite)
-            sprite->update(time);
-    }
-
     int frameCount = CAST_S32(getFrameCount());
 
     switch (mAction)
@@ -1825,8 +1820,15 @@ void Being::logic() restrict2
 
         case BeingAction::MOVE:
         {
-            if (get_elapsed_time(mActionTime) >= mSpeed)
+            // delayed update can pass more than one tile
+            for (int f = 0; f < ticks; f ++)
+            {
+                if (get_elapsed_time(mActionTime) < mSpeed)
+                    break;
                 nextTile();
+                if (mAction != BeingAction::MOVE)
+                    break;
+            }
             break;
         }
 
@@ -1883,15 +1885,13 @@ void Being::logic() restrict2
             + mapTileSize / 2 + xOffset), yOffset3);
     }
 
-    if (mEmotionSprite)
+    if (mEmotionSprite && mEmotionTime > 0)
     {
-        mEmotionTime--;
+        mEmotionTime -= std::min(mEmotionTime, ticks);
         if (mEmotionTime == 0)
             delete2(mEmotionSprite)
     }
 
-    ActorSprite::logic();
-
     if (frameCount < 10)
         frameCount = 10;
 
@@ -1916,8 +1916,39 @@ void Being::logic() restrict2
             mNextSound.time = time2 + sound->delay;
         }
     }
+}
 
-    BLOCK_END("Being::logic")
+void Being::spritesLogic() restrict2
+{
+    // sprites use absolute time, so skipped updates catched up here
+    const int time = tick_time * MILLISECONDS_IN_A_TICK;
+    if (mEmotionSprite)
+        mEmotionSprite->update(time);
+    for_each_horses(mDownHorseSprites)
+        (*it)->update(time);
+    for_each_horses(mUpHorseSprites)
+        (*it)->update(time);
+
+    if (mAnimationEffect)
+    {
+        mAnimationEffect->update(time);
+        if (mAnimationEffect->isTerminated())
+            delete2(mAnimationEffect)
+    }
+    if (mCastingEffect)
+    {
+        mCastingEffect->update(time);
+        if (mCastingEffect->isTerminated())
+            delete2(mCastingEffect)
+    }
+    for_each_badges()
+    {
+        AnimatedSprite *restrict const sprite = mBadges[f];
+        if (sprite)
+            sprite->update(time);
+    }
+
+    ActorSprite::logic();
 }
 
 void Being::botLogic() restrict2
@@ -3305,7 +3336,20 @@ bool Being::updateFromCache() restrict2
     const BeingCacheEntry *restrict const entry =
         Being::getCacheEntry(getId());
 
-    if (entry && entry->getTime() + 120 >= cur_time)
+    if (entry && entry->getTime() + 120 < cur_time)
+    {
+        // old entry or entry from previous session,
+        // show name until server send actual name.
+        // ids of other actor types reused by server.
+        if (mType == ActorType::Player &&
+            mName.empty() &&
+            !entry->getName().empty())
+        {
+            setName(entry->getName());
+        }
+        return false;
+    }
+    if (entry)
     {
         if (!entry->getName().empty())
             setName(entry->getName());
@@ -3351,18 +3395,7 @@ void Being::addToCache() const restrict2
     if (localPlayer == this)
         return;
 
-    BeingCacheEntry *entry = Being::getCacheEntry(getId());
-    if (!entry)
-    {
-        entry = new BeingCacheEntry(getId());
-        beingInfoCache.push_front(entry);
-
-        if (beingInfoCache.size() >= CACHE_SIZE)
-        {
-            delete beingInfoCache.back();
-            beingInfoCache.pop_back();
-        }
-    }
+    BeingCacheEntry *const entry = BeingCache::add(getId());
     if (!mLowTraffic)
         return;
 
@@ -3394,23 +3427,7 @@ void Being::addToCache() const restrict2
 
 BeingCacheEntry* Being::getCacheEntry(const BeingId id)
 {
-    FOR_EACH (std::list<BeingCacheEntry*>::iterator, i, beingInfoCache)
-    {
-        if (!*i)
-            continue;
-
-        if (id == (*i)->getId())
-        {
-            // Raise priority: move it to front
-            if ((*i)->getTime() + 120 < cur_time)
-            {
-                beingInfoCache.splice(beingInfoCache.begin(),
-                                      beingInfoCache, i);
-            }
-            return *i;
-        }
-    }
-    return nullptr;
+    return BeingCache::get(id);
 }
 
 
@@ -4514,8 +4531,8 @@ void Being::undressItemById(const int id) restrict2
 
 void Being::clearCache()
 {
-    delete_all(beingInfoCache);
-    beingInfoCache.clear();
+    BeingCache::save();
+    BeingCache::clear();
 }
 
 void Being::updateComment() restrict2
@@ -372,6 +372,13 @@ class Being notfinal : public ActorSprite,
          */
         void logic() restrict2 override;
 
+        /**
+         * Performs being logic for beings outside of screen.
+         * Only position and timers updated, and only each rate tick.
+         * Sprites catch up on next logic() call.
+         */
+        void lodLogic(const int rate) restrict2;
+
         void botLogic() restrict2;
 
         /**
@@ -1049,6 +1056,10 @@ class Being notfinal : public ActorSprite,
                                  int &offsetY) const;
 
     protected:
+        void stateLogic(const int ticks) restrict2;
+
+        void spritesLogic() restrict2;
+
         void drawPlayerSpriteAt(Graphics *restrict const graphics,
                                 const int x,
                                 const int y) const restrict2 A_NONNULL(2);
@@ -1296,6 +1307,7 @@ class Being notfinal : public ActorSprite,
         int mManner;
         int mAreaSize;
         int mCastEndTime;
+        int mLodTicks;
         BeingId mCreatorId;
         uint16_t mTeamId;
         uint16_t mLook;
@@ -1312,6 +1324,4 @@ class Being notfinal : public ActorSprite,
         bool mBotAi;
 };
 
-extern std::list<BeingCacheEntry*> beingInfoCache;
-
 #endif  // BEING_BEING_H
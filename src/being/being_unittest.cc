@@ -0,0 +1,161 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "catch.hpp"
+#include "client.h"
+#include "graphicsmanager.h"
+
+#include "being/being.h"
+
+#include "const/resources/map/map.h"
+
+#include "enums/being/beingdirection.h"
+
+#include "gui/theme.h"
+
+#include "resources/sdlimagehelper.h"
+
+#include "resources/map/map.h"
+
+#include "resources/resourcemanager/resourcemanager.h"
+
+#include "resources/sprite/animatedsprite.h"
+
+#include "utils/delete2.h"
+#include "utils/env.h"
+#include "utils/physfstools.h"
+#include "utils/timer.h"
+
+#ifndef USE_SDL2
+#include <SDL.h>
+#endif  // USE_SDL2
+
+#include "debug.h"
+
+static Being *createWalker(const BeingId id,
+                           Map *const map,
+                           AnimatedSprite *&sprite)
+{
+    Being *const being = new Being(id,
+        ActorType::Monster,
+        BeingTypeId_zero,
+        map);
+    sprite = AnimatedSprite::load("graphics/sprites/test.xml", 0);
+    being->addSprite(sprite);
+    being->setWalkSpeed(160);
+    being->setTileCoords(10, 10);
+    being->setDirection(BeingDirection::RIGHT);
+
+    Path path;
+    for (int x = 11; x <= 30; x ++)
+        path.push_back(Position(x, 10));
+    being->setPath(path);
+    return being;
+}
+
+static void compareBeings(const Being *const being1,
+                          const AnimatedSprite *const sprite1,
+                          const Being *const being2,
+                          const AnimatedSprite *const sprite2)
+{
+    REQUIRE(being1->getCurrentAction() == being2->getCurrentAction());
+    REQUIRE(being1->getDirection() == being2->getDirection());
+    REQUIRE(being1->getTileX() == being2->getTileX());
+    REQUIRE(being1->getTileY() == being2->getTileY());
+    REQUIRE(being1->getPixelX() == being2->getPixelX());
+    REQUIRE(being1->getPixelY() == being2->getPixelY());
+    REQUIRE(sprite1->getFrameIndex() == sprite2->getFrameIndex());
+    REQUIRE(sprite1->getFrameTime() == sprite2->getFrameTime());
+}
+
+TEST_CASE("Being lod tests", "being")
+{
+    setEnv("SDL_VIDEODRIVER", "dummy");
+
+    client = new Client;
+    PHYSFS_init("manaplus");
+    dirSeparator = "/";
+    XML::initXML();
+    SDL_Init(SDL_INIT_VIDEO);
+    logger = new Logger();
+    ResourceManager::init();
+    resourceManager->addToSearchPath("data", Append_false);
+    resourceManager->addToSearchPath("../data", Append_false);
+    theme = new Theme;
+    Theme::selectSkin();
+    imageHelper = new SDLImageHelper();
+#ifdef USE_SDL2
+    SDLImageHelper::setRenderer(graphicsManager.createRenderer(
+        graphicsManager.createWindow(640, 480, 0,
+        SDL_WINDOW_SHOWN | SDL_SWSURFACE), SDL_RENDERER_SOFTWARE));
+#else  // USE_SDL2
+
+    graphicsManager.createWindow(640, 480, 0, SDL_ANYFORMAT | SDL_SWSURFACE);
+#endif  // USE_SDL2
+
+    ActorSprite::load();
+
+    SECTION("walk outside of screen")
+    {
+        // being2 updated like ActorManager::logic do for being what come
+        // from far area to screen, and must be same as updated each tick.
+        Map *map = new Map("test map", 50, 50, mapTileSize, mapTileSize);
+        tick_time = 1;
+        AnimatedSprite *sprite1 = nullptr;
+        AnimatedSprite *sprite2 = nullptr;
+        Being *being1 = createWalker(static_cast<BeingId>(2), map, sprite1);
+        Being *being2 = createWalker(static_cast<BeingId>(3), map, sprite2);
+        being1->logic();
+        being2->logic();
+        compareBeings(being1, sprite1, being2, sprite2);
+
+        bool lagged = false;
+        for (tick_time = 2; tick_time < 450; tick_time ++)
+        {
+            being1->logic();
+            if (tick_time < 120)
+            {
+                being2->lodLogic(5);
+                if (being2->getTileX() < being1->getTileX())
+                    lagged = true;
+            }
+            else if (tick_time < 200)
+            {
+                being2->lodLogic(1);
+                REQUIRE(being1->getTileX() == being2->getTileX());
+            }
+            else
+            {
+                being2->logic();
+                compareBeings(being1, sprite1, being2, sprite2);
+            }
+        }
+        REQUIRE(lagged == true);
+        REQUIRE(being2->getTileX() == 30);
+        REQUIRE(being2->getCurrentAction() == BeingAction::STAND);
+
+        delete2(being1);
+        delete2(being2);
+        delete2(map);
+    }
+
+    delete2(client);
+}
@@ -0,0 +1,196 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "being/beingcache.h"
+
+#include "configuration.h"
+#include "logger.h"
+#include "settings.h"
+
+#include "being/beingcacheentry.h"
+
+#include "utils/files.h"
+#include "utils/timer.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "debug.h"
+
+namespace
+{
+    const size_t CACHE_SIZE = 5000;
+    const char *const CACHE_FILE = "/beingcache.txt";
+}  // namespace
+
+BeingCacheMap BeingCache::mEntries;
+
+static bool isValidField(const std::string &str)
+{
+    return str.find_first_of("\t\r\n") == std::string::npos;
+}
+
+BeingCacheEntry *BeingCache::get(const BeingId id)
+{
+    const BeingCacheMapCIter it = mEntries.find(id);
+    if (it == mEntries.end())
+        return nullptr;
+    return (*it).second;
+}
+
+BeingCacheEntry *BeingCache::add(const BeingId id)
+{
+    BeingCacheEntry *&entry = mEntries[id];
+    if (!entry)
+    {
+        entry = new BeingCacheEntry(id);
+        if (mEntries.size() > CACHE_SIZE)
+            removeOld(id);
+    }
+    return entry;
+}
+
+void BeingCache::removeOld(const BeingId keepId)
+{
+    // remove oldest quarter of entries, for not do it on each add.
+    // many entries can have same time, so order by time and id.
+    typedef std::pair<time_t, BeingId> TimeId;
+    std::vector<TimeId> times;
+    times.reserve(mEntries.size());
+    FOR_EACH (BeingCacheMapCIter, it, mEntries)
+    {
+        if ((*it).first != keepId)
+        {
+            times.push_back(TimeId((*it).second->getTime(),
+                (*it).first));
+        }
+    }
+    const std::vector<TimeId>::iterator limit = times.begin() +
+        mEntries.size() / 4;
+    std::nth_element(times.begin(), limit, times.end());
+
+    for (std::vector<TimeId>::iterator it = times.begin();
+         it != limit;
+         ++ it)
+    {
+        const BeingCacheMapIter it2 = mEntries.find((*it).second);
+        delete (*it2).second;
+        mEntries.erase(it2);
+    }
+}
+
+void BeingCache::clear()
+{
+    FOR_EACH (BeingCacheMapIter, it, mEntries)
+        delete (*it).second;
+    mEntries.clear();
+}
+
+void BeingCache::load()
+{
+    clear();
+    if (settings.serverConfigDir.empty() ||
+        !config.getBoolValue("saveBeingCache"))
+    {
+        return;
+    }
+
+    std::ifstream file((settings.serverConfigDir + CACHE_FILE).c_str(),
+        std::ios::in);
+    if (!file.is_open())
+        return;
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        // id time level pvp flags team advanced name party guild
+        std::vector<std::string> tokens;
+        size_t pos = 0;
+        for (int f = 0; f < 9; f ++)
+        {
+            const size_t idx = line.find('\t', pos);
+            if (idx == std::string::npos)
+                break;
+            tokens.push_back(line.substr(pos, idx - pos));
+            pos = idx + 1;
+        }
+        if (tokens.size() != 9)
+            continue;
+        tokens.push_back(line.substr(pos));
+        const BeingId id = fromInt(atoi(tokens[0].c_str()), BeingId);
+        if (id == BeingId_zero || tokens[7].empty())
+            continue;
+
+        BeingCacheEntry *const entry = add(id);
+        entry->setTime(static_cast<time_t>(atol(tokens[1].c_str())));
+        entry->setLevel(atoi(tokens[2].c_str()));
+        entry->setPvpRank(atoi(tokens[3].c_str()));
+        entry->setFlags(atoi(tokens[4].c_str()));
+        entry->setTeamId(CAST_U16(atoi(tokens[5].c_str())));
+        entry->setAdvanced(atoi(tokens[6].c_str()) != 0);
+        entry->setName(tokens[7]);
+        entry->setPartyName(tokens[8]);
+        entry->setGuildName(tokens[9]);
+    }
+    logger->log("Loaded being cache: %u entries",
+        CAST_U32(mEntries.size()));
+}
+
+void BeingCache::save()
+{
+    if (settings.serverConfigDir.empty() ||
+        !config.getBoolValue("saveBeingCache"))
+    {
+        return;
+    }
+
+    std::ostringstream file;
+    FOR_EACH (BeingCacheMapCIter, it, mEntries)
+    {
+        const BeingCacheEntry *const entry = (*it).second;
+        // tab and new line in text fields would break columns on load
+        if (entry->getName().empty() ||
+            !isValidField(entry->getName()) ||
+            !isValidField(entry->getPartyName()) ||
+            !isValidField(entry->getGuildName()))
+        {
+            continue;
+        }
+        file << toInt(entry->getId(), int) << '\t'
+            << static_cast<long>(entry->getTime()) << '\t'
+            << entry->getLevel() << '\t'
+            << entry->getPvpRank() << '\t'
+            << entry->getFlags() << '\t'
+            << CAST_S32(entry->getTeamId()) << '\t'
+            << (entry->isAdvanced() ? 1 : 0) << '\t'
+            << entry->getName() << '\t'
+            << entry->getPartyName() << '\t'
+            << entry->getGuildName() << '\n';
+    }
+
+    const std::string data = file.str();
+    if (!Files::writeFileAtomic(settings.serverConfigDir + CACHE_FILE,
+        data.c_str(), data.size()))
+    {
+        logger->log("Error saving being cache");
+    }
+}
@@ -0,0 +1,65 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BEING_BEINGCACHE_H
+#define BEING_BEINGCACHE_H
+
+#include "enums/simpletypes/beingid.h"
+
+#include <map>
+
+#include "localconsts.h"
+
+class BeingCacheEntry;
+
+typedef std::map<BeingId, BeingCacheEntry*> BeingCacheMap;
+typedef BeingCacheMap::iterator BeingCacheMapIter;
+typedef BeingCacheMap::const_iterator BeingCacheMapCIter;
+
+/**
+ * Cache of names, party, guild and level of seen beings.
+ * Indexed by being id. Can be saved per server between sessions.
+ */
+class BeingCache final
+{
+    public:
+        static BeingCacheEntry *get(const BeingId id) A_WARN_UNUSED;
+
+        /**
+         * Returns entry for id. Creates new entry if it not exists.
+         */
+        static BeingCacheEntry *add(const BeingId id) A_WARN_UNUSED;
+
+        static void clear();
+
+        static void load();
+
+        static void save();
+
+        static size_t size() A_WARN_UNUSED
+        { return mEntries.size(); }
+
+    private:
+        static void removeOld(const BeingId keepId);
+
+        static BeingCacheMap mEntries;
+};
+
+#endif  // BEING_BEINGCACHE_H
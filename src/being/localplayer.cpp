@@ -109,7 +109,6 @@ LocalPlayer *localPlayer = nullptr;
 
 class SkillDialog;
 
-extern std::list<BeingCacheEntry*> beingInfoCache;
 extern OkDialog *weightNotice;
 extern time_t weightNoticeTime;
 extern MiniStatusWindow *miniStatusWindow;
@@ -35,50 +35,65 @@
 #include "configuration.h"
 #include "utils/mkdir.h"
 #include "utils/physfstools.h"
+#include "utils/sdlhelper.h"
 
 #include "debug.h"
 
 ChatLogger *chatLogger = nullptr;
 
+namespace
+{
+    // size of block for reading logs from end
+    const size_t readBlockSize = 4096;
+    // buffered messages written at once if buffers bigger than this
+    const size_t maxBufferSize = 65536;
+}  // namespace
+
 ChatLogger::ChatLogger() :
-    mLogFile(),
+    mBuffers(),
+    mJobs(),
+    mMutex(),
     mLogDir(),
     mBaseLogDir(),
     mServerName(),
-    mLogFileName()
+    mThread(nullptr),
+    mBufferSize(0),
+    mJobId(0),
+    mThreadRunning(false)
 {
 }
 
 ChatLogger::~ChatLogger()
 {
-    if (mLogFile.is_open())
-        mLogFile.close();
-}
-
-void ChatLogger::setLogFile(const std::string &logFilename)
-{
-    if (mLogFile.is_open())
-        mLogFile.close();
-
-    mLogFile.open(logFilename.c_str(),
-        std::ios_base::app);
-    mLogFileName = logFilename;
-
-    if (!mLogFile.is_open())
+    flush();
     {
-        std::cout << "Warning: error while opening " <<
-            logFilename <<
-            " for writing.\n";
+        MutexLocker lock(&mMutex);
+        LoadJobsIter it = mJobs.begin();
+        while (it != mJobs.end())
+        {
+            LoadJob *const job = *it;
+            if (job->started && !job->done)
+            {
+                // thread will delete it
+                job->cancelled = true;
+                ++ it;
+            }
+            else
+            {
+                delete job;
+                it = mJobs.erase(it);
+            }
+        }
     }
+    if (mThread)
+        SDL_WaitThread(mThread, nullptr);
+    mThread = nullptr;
 }
 
 void ChatLogger::setLogDir(const std::string &logDir)
 {
     mLogDir = logDir;
 
-    if (mLogFile.is_open())
-        mLogFile.close();
-
     DIR *const dir = opendir(mLogDir.c_str());
     if (!dir)
         mkdir_r(mLogDir.c_str());
@@ -89,34 +104,23 @@ void ChatLogger::setLogDir(const std::string &logDir)
 void ChatLogger::log(std::string str)
 {
     const std::string &dateStr = getDir();
-    const std::string logFileName = strprintf(
-        "%s/#General.log", dateStr.c_str());
-    if (!mLogFile.is_open() ||
-        logFileName != mLogFileName)
-    {
+    if (dateStr != mLogDir)
         setLogDir(dateStr);
-        setLogFile(logFileName);
-    }
 
     str = removeColors(str);
-    writeTo(mLogFile, str);
+    writeTo(strprintf("%s/#General.log", dateStr.c_str()), str);
 }
 
 void ChatLogger::log(std::string name,
                      std::string str)
 {
     const std::string &dateStr = getDir();
-    const std::string logFileName = strprintf("%s/%s.log",
-        dateStr.c_str(), secureName(name).c_str());
-
-    if (!mLogFile.is_open() || logFileName != mLogFileName)
-    {
+    if (dateStr != mLogDir)
         setLogDir(dateStr);
-        setLogFile(logFileName);
-    }
 
     str = removeColors(str);
-    writeTo(mLogFile, str);
+    writeTo(strprintf("%s/%s.log",
+        dateStr.c_str(), secureName(name).c_str()), str);
 }
 
 std::string ChatLogger::getDir() const
@@ -139,6 +143,13 @@ std::string ChatLogger::getDir() const
     return date;
 }
 
+std::string ChatLogger::getFileName(std::string name) const
+{
+    return strprintf("%s/%s.log",
+        getDir().c_str(),
+        secureName(name).c_str());
+}
+
 std::string ChatLogger::secureName(std::string &name)
 {
     const size_t sz = name.length();
@@ -165,21 +176,60 @@ std::string ChatLogger::secureName(std::string &name)
     return name;
 }
 
-void ChatLogger::writeTo(std::ofstream &file,
+void ChatLogger::writeTo(const std::string &fileName,
                          const std::string &str)
 {
-    file << str << std::endl;
+    mBuffers[fileName].append(str).append("\n");
+    mBufferSize += str.size() + 1;
+    if (mBufferSize > maxBufferSize)
+        flush();
+}
+
+void ChatLogger::flush()
+{
+    FOR_EACH (LogBuffersIter, it, mBuffers)
+    {
+        const std::string &data = (*it).second;
+        if (data.empty())
+            continue;
+        FILE *const file = fopen((*it).first.c_str(), "a");
+        if (!file)
+        {
+            std::cout << "Warning: error while opening " <<
+                (*it).first <<
+                " for writing.\n";
+            continue;
+        }
+        fwrite(data.c_str(), 1, data.size(), file);
+        fclose(file);
+    }
+    mBuffers.clear();
+    mBufferSize = 0;
+}
+
+void ChatLogger::flush(const std::string &fileName)
+{
+    const LogBuffersIter it = mBuffers.find(fileName);
+    if (it == mBuffers.end())
+        return;
+    const std::string &data = (*it).second;
+    FILE *const file = fopen(fileName.c_str(), "a");
+    if (file)
+    {
+        fwrite(data.c_str(), 1, data.size(), file);
+        fclose(file);
+    }
+    mBufferSize -= data.size();
+    mBuffers.erase(it);
 }
 
 void ChatLogger::setServerName(const std::string &serverName)
 {
+    flush();
     mServerName = serverName;
     if (mServerName.empty())
         mServerName = config.getStringValue("MostUsedServerName0");
 
-    if (mLogFile.is_open())
-        mLogFile.close();
-
     secureName(mServerName);
     if (!mLogDir.empty())
     {
@@ -195,38 +245,198 @@ void ChatLogger::setServerName(const std::string &serverName)
 
 void ChatLogger::loadLast(std::string name,
                           std::list<std::string> &list,
-                          const unsigned int n) const
+                          const unsigned int n)
 {
-    std::ifstream logFile;
-    std::string fileName = strprintf("%s/%s.log",
-        getDir().c_str(),
-        secureName(name).c_str());
+    const std::string fileName = getFileName(name);
+    flush(fileName);
+    readLast(fileName, list, n);
+}
 
-    logFile.open(fileName.c_str(), std::ios::in);
+int ChatLogger::loadLastAsync(std::string name,
+                              const unsigned int n)
+{
+    const std::string fileName = getFileName(name);
+    flush(fileName);
+
+    MutexLocker lock(&mMutex);
+    mJobId ++;
+    LoadJob *const job = new LoadJob(fileName, n, mJobId);
+    mJobs.push_back(job);
+    if (!mThreadRunning)
+    {
+        // previous thread already finished all jobs
+        if (mThread)
+            SDL_WaitThread(mThread, nullptr);
+        mThread = SDL::createThread(&ChatLogger::loadThread,
+            "chatlogload", this);
+        if (mThread)
+        {
+            mThreadRunning = true;
+        }
+        else
+        {
+            logger->log1("Error: chat log loading thread creation failed");
+            readLast(fileName, job->lines, n);
+            job->started = true;
+            job->done = true;
+        }
+    }
+    return job->id;
+}
 
-    if (!logFile.is_open())
+bool ChatLogger::getLoaded(const int id,
+                           std::list<std::string> &list)
+{
+    MutexLocker lock(&mMutex);
+    FOR_EACH (LoadJobsIter, it, mJobs)
+    {
+        LoadJob *const job = *it;
+        if (job->id != id)
+            continue;
+        if (!job->done)
+            return false;
+        list.splice(list.end(), job->lines);
+        delete job;
+        mJobs.erase(it);
+        return true;
+    }
+    // unknown id, nothing to wait
+    return true;
+}
+
+void ChatLogger::cancelLoad(const int id)
+{
+    MutexLocker lock(&mMutex);
+    FOR_EACH (LoadJobsIter, it, mJobs)
+    {
+        LoadJob *const job = *it;
+        if (job->id != id)
+            continue;
+        if (job->started && !job->done)
+        {
+            job->cancelled = true;
+        }
+        else
+        {
+            delete job;
+            mJobs.erase(it);
+        }
         return;
+    }
+}
 
-    char line[710];
-    unsigned sz = CAST_U32(list.size());
-    while (logFile.getline(line, 700))
+int ChatLogger::loadThread(void *ptr)
+{
+    ChatLogger *const chatLog = static_cast<ChatLogger*>(ptr);
+    if (!chatLog)
+        return 0;
+
+    for (;;)
     {
-        list.push_back(line);
-        sz ++;
-        if (sz > n)
+        LoadJob *job = nullptr;
+        {
+            MutexLocker lock(&chatLog->mMutex);
+            FOR_EACH (LoadJobsIter, it, chatLog->mJobs)
+            {
+                if (!(*it)->started)
+                {
+                    job = *it;
+                    break;
+                }
+            }
+            if (!job)
+            {
+                chatLog->mThreadRunning = false;
+                return 0;
+            }
+            job->started = true;
+        }
+
+        std::list<std::string> lines;
+        readLast(job->fileName, lines, job->n);
+
+        MutexLocker lock(&chatLog->mMutex);
+        if (job->cancelled)
         {
-            list.pop_front();
-            sz --;
+            chatLog->mJobs.remove(job);
+            delete job;
         }
+        else
+        {
+            job->lines.swap(lines);
+            job->done = true;
+        }
+    }
+}
+
+void ChatLogger::readLast(const std::string &fileName,
+                          std::list<std::string> &list,
+                          const unsigned int n)
+{
+    if (!n)
+        return;
+    FILE *const file = fopen(fileName.c_str(), "rb");
+    if (!file)
+        return;
+
+    // read blocks from end until found enough line ends.
+    // n + 1 line ends is enough for n lines after first incomplete line.
+    std::string data;
+    char buf[readBlockSize];
+    unsigned int lineEnds = 0;
+    fseek(file, 0, SEEK_END);
+    long pos = ftell(file);
+    while (pos > 0 && lineEnds <= n)
+    {
+        const size_t sz = std::min(readBlockSize, CAST_SIZE(pos));
+        pos -= static_cast<long>(sz);
+        if (fseek(file, pos, SEEK_SET) != 0 ||
+            fread(buf, 1, sz, file) != sz)
+        {
+            break;
+        }
+        for (size_t f = 0; f < sz; f ++)
+        {
+            if (buf[f] == '\n')
+                lineEnds ++;
+        }
+        data.insert(0, buf, sz);
+    }
+    fclose(file);
+
+    std::list<std::string> lines;
+    size_t start = 0;
+    // first line is not complete if file not read from start
+    if (pos > 0)
+    {
+        start = data.find('\n');
+        if (start == std::string::npos)
+            return;
+        start ++;
+    }
+    const size_t dataSize = data.size();
+    while (start < dataSize)
+    {
+        size_t end = data.find('\n', start);
+        if (end == std::string::npos)
+            end = dataSize;
+        size_t len = end - start;
+        if (len > 0 && data[start + len - 1] == '\r')
+            len --;
+        lines.push_back(data.substr(start, len));
+        start = end + 1;
     }
+    while (lines.size() > n)
+        lines.pop_front();
 
-    if (logFile.is_open())
-        logFile.close();
+    list.splice(list.end(), lines);
+    while (list.size() > n)
+        list.pop_front();
 }
 
 void ChatLogger::clear()
 {
+    flush();
     mLogDir.clear();
     mServerName.clear();
-    mLogFileName.clear();
 }
@@ -23,11 +23,20 @@
 #ifndef CHATLOGGER_H
 #define CHATLOGGER_H
 
-#include <fstream>
+#include "utils/mutex.h"
+
 #include <list>
+#include <map>
 
 #include "localconsts.h"
 
+struct SDL_Thread;
+
+/**
+ * Writes chat logs and loads history from it.
+ * Messages buffered and written to files by flush.
+ * History loaded from end of file, and can be loaded in worker thread.
+ */
 class ChatLogger final
 {
     public:
@@ -39,20 +48,48 @@ class ChatLogger final
         A_DELETE_COPY(ChatLogger)
 
         /**
-         * Destructor, closes log file.
+         * Destructor, writes buffered messages and stops loading thread.
          */
         ~ChatLogger();
 
         /**
-         * Enters a message in the log. The message will be timestamped.
+         * Enters a message in the log.
          */
         void log(std::string str);
 
         void log(std::string name, std::string str);
 
+        /**
+         * Loads last n lines of log.
+         * File read backward by blocks, so size of log not matter.
+         */
         void loadLast(std::string name,
                       std::list<std::string> &list,
-                      const unsigned int n) const;
+                      const unsigned int n);
+
+        /**
+         * Starts loading of last n lines of log in worker thread.
+         *
+         * @return id what should be passed to getLoaded or cancelLoad.
+         */
+        int loadLastAsync(std::string name,
+                          const unsigned int n);
+
+        /**
+         * Moves lines loaded by loadLastAsync to list.
+         *
+         * @return false if loading not finished yet.
+         */
+        bool getLoaded(const int id,
+                       std::list<std::string> &list);
+
+        void cancelLoad(const int id);
+
+        /**
+         * Writes buffered messages to files.
+         * Must be called from main thread.
+         */
+        void flush();
 
         std::string getDir() const A_WARN_UNUSED;
 
@@ -65,22 +102,68 @@ class ChatLogger final
 
         void clear();
 
+#ifndef UNITTESTS
     private:
+#endif  // UNITTESTS
+        struct LoadJob final
+        {
+            LoadJob(const std::string &fileName0,
+                    const unsigned int n0,
+                    const int id0) :
+                fileName(fileName0),
+                lines(),
+                n(n0),
+                id(id0),
+                started(false),
+                done(false),
+                cancelled(false)
+            {
+            }
+
+            A_DELETE_COPY(LoadJob)
+
+            std::string fileName;
+            std::list<std::string> lines;
+            unsigned int n;
+            int id;
+            bool started;
+            bool done;
+            bool cancelled;
+        };
+
+        typedef std::list<LoadJob*> LoadJobs;
+        typedef LoadJobs::iterator LoadJobsIter;
+        typedef std::map<std::string, std::string> LogBuffers;
+        typedef LogBuffers::iterator LogBuffersIter;
+
+        void setLogDir(const std::string &logDir);
+
         /**
-         * Sets the file to log to and opens it
+         * Adds line to buffer of file.
          */
-        void setLogFile(const std::string &logFilename);
+        void writeTo(const std::string &fileName,
+                     const std::string &str);
 
-        void setLogDir(const std::string &logDir);
+        void flush(const std::string &fileName);
+
+        std::string getFileName(std::string name) const A_WARN_UNUSED;
+
+        static void readLast(const std::string &fileName,
+                             std::list<std::string> &list,
+                             const unsigned int n);
 
-        static void writeTo(std::ofstream &file,
-                            const std::string &str);
+        static int loadThread(void *ptr);
 
-        std::ofstream mLogFile;
+        LogBuffers mBuffers;
+        LoadJobs mJobs;
+        Mutex mMutex;
         std::string mLogDir;
         std::string mBaseLogDir;
         std::string mServerName;
-        std::string mLogFileName;
+        SDL_Thread *mThread;
+        size_t mBufferSize;
+        int mJobId;
+        bool mThreadRunning;
 };
 
 extern ChatLogger *chatLogger;
@@ -0,0 +1,160 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "chatlogger.h"
+
+#include "catch.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+#include "debug.h"
+
+static const std::string testFile = "chatlogger_test.log";
+
+static void writeTestFile(const std::string &data)
+{
+    std::ofstream file(testFile.c_str(),
+        std::ios::out | std::ios::binary | std::ios::trunc);
+    file << data;
+}
+
+// old loadLast implementation based on getline, without line size limit
+static void readLastOld(std::list<std::string> &list,
+                        const unsigned int n)
+{
+    std::ifstream file(testFile.c_str(), std::ios::in | std::ios::binary);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (!line.empty() && line[line.size() - 1] == '\r')
+            line.erase(line.size() - 1);
+        list.push_back(line);
+        if (list.size() > n)
+            list.pop_front();
+    }
+}
+
+static void compareRead(const std::string &data,
+                        const unsigned int n)
+{
+    writeTestFile(data);
+    std::list<std::string> list1;
+    std::list<std::string> list2;
+    ChatLogger::readLast(testFile, list1, n);
+    readLastOld(list2, n);
+    REQUIRE(list1 == list2);
+}
+
+static std::string makeLines(const size_t sz,
+                             const int cnt,
+                             const std::string &lineEnd)
+{
+    std::string data;
+    for (int f = 0; f < cnt; f ++)
+    {
+        data.append(sz + f, static_cast<char>('a' + f % 26));
+        data.append(lineEnd);
+    }
+    return data;
+}
+
+TEST_CASE("ChatLogger readLast")
+{
+    SECTION("missing file")
+    {
+        ::remove(testFile.c_str());
+        std::list<std::string> list;
+        ChatLogger::readLast(testFile, list, 10);
+        REQUIRE(list.empty());
+    }
+
+    SECTION("empty file")
+    {
+        compareRead("", 10);
+    }
+
+    SECTION("smaller than block")
+    {
+        compareRead("line1\nline2\nline3\n", 1);
+        compareRead("line1\nline2\nline3\n", 2);
+        compareRead("line1\nline2\nline3\n", 3);
+        compareRead("\n\nline1\n\nline2\n\n", 3);
+        compareRead(makeLines(10, 100, "\n"), 50);
+    }
+
+    SECTION("n bigger than lines count")
+    {
+        compareRead("line1\nline2\nline3\n", 4);
+        compareRead("line1\nline2\nline3\n", 1000);
+        compareRead(makeLines(100, 200, "\n"), 1000);
+    }
+
+    SECTION("no trailing new line")
+    {
+        compareRead("line1", 1);
+        compareRead("line1\nline2\nline3", 2);
+        compareRead("line1\nline2\nline3", 10);
+        compareRead(makeLines(700, 30, "\n") + "last line", 5);
+    }
+
+    SECTION("crlf")
+    {
+        compareRead("line1\r\nline2\r\nline3\r\n", 2);
+        compareRead("line1\r\nline2\r\nline3", 10);
+        compareRead(makeLines(1000, 30, "\r\n"), 7);
+    }
+
+    SECTION("lines over block boundary")
+    {
+        for (size_t sz = 4090; sz < 4100; sz ++)
+        {
+            compareRead(makeLines(sz, 5, "\n"), 1);
+            compareRead(makeLines(sz, 5, "\n"), 3);
+            compareRead(makeLines(sz, 5, "\r\n"), 2);
+            compareRead(makeLines(sz, 5, "\n"), 10);
+        }
+        for (unsigned int n = 1; n < 20; n ++)
+        {
+            compareRead(makeLines(1000, 40, "\n"), n);
+            compareRead(makeLines(1000, 40, "\r\n"), n);
+            compareRead(makeLines(5000, 4, "\n"), n);
+            compareRead(makeLines(2047, 10, "\n"), n);
+        }
+        // line end right at block boundary
+        compareRead(makeLines(4095, 3, "\n"), 1);
+        compareRead(makeLines(4094, 3, "\r\n"), 1);
+    }
+
+    SECTION("append to list")
+    {
+        writeTestFile("line1\nline2\nline3\n");
+        std::list<std::string> list;
+        list.push_back("old1");
+        list.push_back("old2");
+        ChatLogger::readLast(testFile, list, 4);
+        REQUIRE(list.size() == 4);
+        REQUIRE(list.front() == "old2");
+        REQUIRE(list.back() == "line3");
+    }
+
+    ::remove(testFile.c_str());
+}
@@ -145,6 +145,7 @@
 #include "utils/physfstools.h"
 #include "utils/sdlcheckutils.h"
 #include "utils/timer.h"
+#include "utils/vfsindex.h"
 
 #include "utils/translation/translationmanager.h"
 
@@ -318,6 +319,7 @@ void Client::gameInit()
         logger->error(strprintf("%s couldn't be set as home directory! "
             "Exiting.", settings.localDataDir.c_str()));
     }
+    VfsIndex::setCacheDir(settings.localDataDir + "/cache");
 
     GettextHelper::initLang();
 
@@ -496,6 +498,7 @@ void Client::gameInit()
 
     settings.guiAlpha = config.getFloatValue("guialpha");
     optionChanged("fpslimit");
+    optionChanged("idleSleep");
 
     start_time = time(nullptr);
 
@@ -532,6 +535,7 @@ Client::~Client()
 void Client::initConfigListeners()
 {
     config.addListener("fpslimit", this);
+    config.addListener("idleSleep", this);
     config.addListener("guialpha", this);
     config.addListener("gamma", this);
     config.addListener("enableGamma", this);
@@ -918,10 +922,13 @@ void Client::stateSwitchLogin1()
 int Client::gameExec()
 {
     int lastTickTime = tick_time;
+    time_t lastDrawTime = 0;
 
     while (mState != State::EXIT)
     {
         PROFILER_START();
+        if (EventsManager::hasEvents())
+            settings.needRedraw = true;
         if (eventsManager.handleEvents())
             continue;
 
@@ -960,12 +967,30 @@ int Client::gameExec()
         lastTickTime = tick_time;
 
         // Update the screen when application is visible, delay otherwise.
+        bool waited(false);
         if (!WindowManager::getIsMinimized())
         {
-            frame_count++;
-            if (gui)
-                gui->draw();
-            mainGraphics->updateScreen();
+            // Screen is redrawn only if input, network, gui or animations
+            // changed something, and once per second for gui timers.
+            // Otherwise sleep until next logic tick or new event.
+            if (settings.needRedraw ||
+                !settings.idleSleep ||
+                mState != mOldState ||
+                lastDrawTime != cur_time)
+            {
+                frame_count++;
+                if (gui)
+                    gui->draw();
+                mainGraphics->updateScreen();
+                // changes made while drawing already on screen
+                settings.needRedraw = false;
+                lastDrawTime = cur_time;
+            }
+            else
+            {
+                EventsManager::waitEvents(get_next_tick_delay());
+                waited = true;
+            }
         }
         else
         {
@@ -973,7 +998,8 @@ int Client::gameExec()
         }
 
         BLOCK_START("~Client::SDL_framerateDelay")
-        if (settings.limitFps)
+        // frame without drawing already slept in waitEvents
+        if (settings.limitFps && !waited)
             SDL_framerateDelay(&fpsManager);
         BLOCK_END("~Client::SDL_framerateDelay")
 
@@ -1004,6 +1030,7 @@ int Client::gameExec()
         if (mState != mOldState)
         {
             BLOCK_START("Client::gameExec 7")
+            settings.needRedraw = true;
             PlayerInfo::stateChange(mState);
 
             if (mOldState == State::GAME)
@@ -1309,6 +1336,9 @@ int Client::gameExec()
                             Append_false);
                     }
 
+                    // index all mounted archives before data loading
+                    VfsIndex::update();
+
                     logger->log("Init paths");
                     paths.init("paths.xml", UseResman_true);
                     paths.setDefaultValues(getPathsDefaults());
@@ -1754,6 +1784,10 @@ void Client::optionChanged(const std::string &name)
         settings.limitFps = fpsLimit > 0;
         WindowManager::setFramerate(fpsLimit);
     }
+    else if (name == "idleSleep")
+    {
+        settings.idleSleep = config.getBoolValue("idleSleep");
+    }
     else if (name == "guialpha" ||
              name == "enableGuiOpacity")
     {
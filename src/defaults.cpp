@@ -160,6 +160,7 @@ DefaultsData* getConfigDefaults()
     AddDEF("username", "");
     AddDEF("lastCharacter", "");
     AddDEF("altfpslimit", 5);
+    AddDEF("idleSleep", true);
     AddDEF("updatehost", "");
     AddDEF("screenshotDirectory3", "");
     AddDEF("useScreenshotDirectorySuffix", true);
@@ -189,6 +190,7 @@ DefaultsData* getConfigDefaults()
     AddDEF("playGuiSound", true);
     AddDEF("playMusic", true);
     AddDEF("packetcounters", true);
+    AddDEF("packetHandlersBudget", 10);
     AddDEF("safemode", false);
     AddDEF("font", "fonts/dejavusans.ttf");
     AddDEF("boldFont", "fonts/dejavusans-bold.ttf");
@@ -223,7 +225,6 @@ DefaultsData* getConfigDefaults()
     AddDEF("drawHotKeys", true);
     AddDEF("serverAttack", true);
     AddDEF("autofixPos", false);
-    AddDEF("alphaCache", true);
     AddDEF("attackMoving", true);
     AddDEF("attackNext", false);
     AddDEF("quickStats", true);
@@ -284,6 +285,7 @@ DefaultsData* getConfigDefaults()
     AddDEF("autohideChat", false);
     AddDEF("downloadProxy", "");
     AddDEF("downloadProxyType", 0);
+    AddDEF("updateDownloads", 3);
     AddDEF("blur", false);
 #if defined(WIN32) || defined(__APPLE__)
     AddDEF("centerwindow", true);
@@ -308,11 +310,19 @@ DefaultsData* getConfigDefaults()
     AddDEF("compresstextures", 0);
     AddDEF("rectangulartextures", false);
     AddDEF("networksleep", 0);
+    AddDEF("networkFlushSize", 1400);
+    AddDEF("networkFlushDelay", 10);
+    AddDEF("saveBeingCache", true);
     AddDEF("newtextures", true);
     AddDEF("videodetected", false);
     AddDEF("hideErased", false);
     AddDEF("enableDelayedAnimations", true);
     AddDEF("enableCompoundSpriteDelay", true);
+    AddDEF("enableBeingLod", true);
+    AddDEF("enableMapPrefetch", true);
+    AddDEF("mapPrefetchMemory", 64);
+    AddDEF("mapPrefetchDistance", 8);
+    AddDEF("mapLoadThreads", 3);
 #ifdef ANDROID
     AddDEF("useAtlases", false);
 #else  // ANDROID
@@ -359,6 +369,7 @@ DefaultsData* getConfigDefaults()
     AddDEF("screenActionButton11", CAST_S32(InputAction::DIRECT_DOWN));
     AddDEF("screenButtonsFormat", 0);
     AddDEF("autoresizeminimaps", false);
+    AddDEF("minimapDotsDelay", 200);
     AddDEF("showGuildOnline", false);
     AddDEF("showPartyOnline", false);
     AddDEF("enableGmTab", true);
@@ -370,6 +381,7 @@ DefaultsData* getConfigDefaults()
     AddDEF("moveNames", false);
     AddDEF("uselonglivesprites", false);
     AddDEF("uselonglivesounds", true);
+    AddDEF("sfxCacheSize", 16384);
     AddDEF("screenDensity", 0);
     AddDEF("cfgver", 14);
     AddDEF("enableDebugLog", false);
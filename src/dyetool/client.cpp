@@ -66,6 +66,7 @@
 #include "utils/physfstools.h"
 #include "utils/sdlcheckutils.h"
 #include "utils/timer.h"
+#include "utils/vfsindex.h"
 
 #include "utils/translation/translationmanager.h"
 
@@ -645,6 +646,9 @@ int Client::gameExec()
                             Append_false);
                     }
 
+                    // index all mounted archives before data loading
+                    VfsIndex::update();
+
                     logger->log("Init paths");
                     paths.init("paths.xml", UseResman_true);
                     paths.setDefaultValues(getPathsDefaults());
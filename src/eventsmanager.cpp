@@ -45,10 +45,14 @@
 
 #include "utils/process.h"
 
+#include <SDL_timer.h>
+
 #include "debug.h"
 
 EventsManager eventsManager;
 
+volatile bool EventsManager::mWaiting = false;
+
 EventsManager::EventsManager() :
     mLogInput(false)
 {
@@ -200,6 +204,49 @@ void EventsManager::handleGameEvents() const
     BLOCK_END("EventsManager::handleGameEvents")
 }
 
+bool EventsManager::hasEvents()
+{
+    // check queue without removing events from it
+    return SDL_PollEvent(nullptr) != 0;
+}
+
+void EventsManager::waitEvents(const int timeout)
+{
+    if (timeout <= 0)
+        return;
+    BLOCK_START("EventsManager::waitEvents")
+    mWaiting = true;
+#ifdef USE_SDL2
+    // with null event SDL leave event in queue
+    SDL_WaitEventTimeout(nullptr, timeout);
+#else  // USE_SDL2
+
+    // SDL1 cant wait with timeout, sleep by small steps
+    int left = timeout;
+    while (left > 0 && !SDL_PollEvent(nullptr))
+    {
+        SDL_Delay(1);
+        left --;
+    }
+#endif  // USE_SDL2
+    mWaiting = false;
+    BLOCK_END("EventsManager::waitEvents")
+}
+
+void EventsManager::wakeUp()
+{
+    // push event only if main thread sleeping, for not flood queue
+    if (!mWaiting)
+        return;
+    mWaiting = false;
+    SDL_Event event;
+    event.type = SDL_USEREVENT;
+    event.user.code = 0;
+    event.user.data1 = nullptr;
+    event.user.data2 = nullptr;
+    SDL_PushEvent(&event);
+}
+
 void EventsManager::optionChanged(const std::string &name)
 {
     if (name == "logInput")
@@ -46,6 +46,16 @@ class EventsManager final : public ConfigListener
 
         void handleGameEvents() const;
 
+        static bool hasEvents() A_WARN_UNUSED;
+
+        static void waitEvents(const int timeout);
+
+        /**
+         * Breaks waitEvents from other thread, for example if network
+         * data received.
+         */
+        static void wakeUp();
+
 #ifdef USE_SDL2
         static void handleSDL2WindowEvent(const SDL_Event &event);
 #else  // USE_SDL2
@@ -59,6 +69,8 @@ class EventsManager final : public ConfigListener
 
     protected:
         bool mLogInput;
+
+        static volatile bool mWaiting;
 };
 
 extern EventsManager eventsManager;
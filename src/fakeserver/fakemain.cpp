@@ -0,0 +1,208 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "fakeserver/fakeserver.h"
+
+#include <getopt.h>
+#include <iostream>
+#include <signal.h>
+
+#include <SDL.h>
+
+#include "debug.h"
+
+static void stopServer(int sig A_UNUSED)
+{
+    FakeServer::stop();
+}
+
+static void printHelp()
+{
+    std::cout << "fakeserver [options]" << std::endl <<
+        "  -b --beings N         : Number of beings (100)" << std::endl <<
+        "  -r --rate N           : Crowd updates per second (10, max 1000)"
+        << std::endl <<
+        "  -m --map NAME         : Map name (000-1)" << std::endl <<
+        "  -x --x N              : Crowd center x (50)" << std::endl <<
+        "  -y --y N              : Crowd center y (50)" << std::endl <<
+        "  -a --radius N         : Crowd radius in tiles (20)" << std::endl <<
+        "  -j --job N            : Monster class id (1002)" << std::endl <<
+        "  -M --move N           : Move chance in percents (50)" <<
+        std::endl <<
+        "  -A --attack N         : Attack chance in percents (10)" <<
+        std::endl <<
+        "  -D --despawn N        : Despawn chance in percents (2)" <<
+        std::endl <<
+        "  -p --port N           : Login server port (6900)" << std::endl <<
+        "  -c --char-port N      : Char server port (6121)" << std::endl <<
+        "  -g --map-port N       : Map server port (5121)" << std::endl <<
+        "  -P --packet-version N : Packet version (20150000)" << std::endl <<
+        "  -S --server-version N : Server version (8)" << std::endl <<
+        "  -s --seed N           : Random seed (1)" << std::endl <<
+        "  -h --help             : Display this help" << std::endl <<
+        std::endl <<
+        "Start client with: manaplus -y evol2 -s 127.0.0.1 -p 6900 "
+        "-U test -P test -D -u" << std::endl;
+}
+
+static bool parseOptions(const int argc,
+                         char *const argv[],
+                         FakeServerOptions &options)
+{
+    const char *const optstring = "hb:r:m:x:y:a:j:M:A:D:p:c:g:P:S:s:";
+
+    const struct option long_options[] =
+    {
+        { "beings",         required_argument, nullptr, 'b' },
+        { "rate",           required_argument, nullptr, 'r' },
+        { "map",            required_argument, nullptr, 'm' },
+        { "x",              required_argument, nullptr, 'x' },
+        { "y",              required_argument, nullptr, 'y' },
+        { "radius",         required_argument, nullptr, 'a' },
+        { "job",            required_argument, nullptr, 'j' },
+        { "move",           required_argument, nullptr, 'M' },
+        { "attack",         required_argument, nullptr, 'A' },
+        { "despawn",        required_argument, nullptr, 'D' },
+        { "port",           required_argument, nullptr, 'p' },
+        { "char-port",      required_argument, nullptr, 'c' },
+        { "map-port",       required_argument, nullptr, 'g' },
+        { "packet-version", required_argument, nullptr, 'P' },
+        { "server-version", required_argument, nullptr, 'S' },
+        { "seed",           required_argument, nullptr, 's' },
+        { "help",           no_argument,       nullptr, 'h' },
+        { nullptr,          0,                 nullptr, 0 }
+    };
+
+    while (optind < argc)
+    {
+        const int result = getopt_long(argc,
+            argv,
+            optstring,
+            long_options,
+            nullptr);
+
+        if (result == -1)
+            break;
+
+        switch (result)
+        {
+            case 'b':
+                options.beings = atoi(optarg);
+                break;
+            case 'r':
+                options.rate = atoi(optarg);
+                break;
+            case 'm':
+                options.mapName = optarg;
+                break;
+            case 'x':
+                options.x = atoi(optarg);
+                break;
+            case 'y':
+                options.y = atoi(optarg);
+                break;
+            case 'a':
+                options.radius = atoi(optarg);
+                break;
+            case 'j':
+                options.job = atoi(optarg);
+                break;
+            case 'M':
+                options.movePercent = atoi(optarg);
+                break;
+            case 'A':
+                options.attackPercent = atoi(optarg);
+                break;
+            case 'D':
+                options.despawnPercent = atoi(optarg);
+                break;
+            case 'p':
+                options.loginPort = atoi(optarg);
+                break;
+            case 'c':
+                options.charPort = atoi(optarg);
+                break;
+            case 'g':
+                options.mapPort = atoi(optarg);
+                break;
+            case 'P':
+                options.packetVersion = atoi(optarg);
+                break;
+            case 'S':
+                options.serverVersion = atoi(optarg);
+                break;
+            case 's':
+                options.seed = CAST_U32(atoi(optarg));
+                break;
+            case '?':  // Unknown option
+            case ':':  // Missing argument
+            case 'h':
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    FakeServerOptions options;
+    if (!parseOptions(argc, argv, options))
+    {
+        printHelp();
+        return 1;
+    }
+
+#ifndef WIN32
+    // client can disconnect in any time
+    signal(SIGPIPE, SIG_IGN);
+#endif  // WIN32
+
+    // stop on ctrl+c for close sockets and print statistics
+    signal(SIGINT, &stopServer);
+    signal(SIGTERM, &stopServer);
+
+    if (SDL_Init(SDL_INIT_TIMER) == -1)
+    {
+        std::cerr << "SDL init error: " << SDL_GetError() << std::endl;
+        return 1;
+    }
+    if (SDLNet_Init() == -1)
+    {
+        std::cerr << "SDL_net init error: " << SDLNet_GetError()
+            << std::endl;
+        SDL_Quit();
+        return 1;
+    }
+
+    int ret = 1;
+    FakeServer *const server = new FakeServer(options);
+    if (server->start())
+    {
+        server->run();
+        ret = 0;
+    }
+    delete server;
+
+    SDLNet_Quit();
+    SDL_Quit();
+    return ret;
+}
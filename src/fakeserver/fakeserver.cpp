@@ -0,0 +1,912 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "fakeserver/fakeserver.h"
+
+#include "enums/net/beingtype.h"
+
+#include <csignal>
+#include <iostream>
+#include <sstream>
+
+#include <SDL_timer.h>
+
+#include "debug.h"
+
+namespace
+{
+    enum ServerRole
+    {
+        LOGIN_ROLE = 0,
+        CHAR_ROLE = 1,
+        MAP_ROLE = 2
+    };
+
+    const int maxConnections = 16;
+    const int accountId = 2000000;
+    const int charId = 150000;
+    const int firstBeingId = 110000000;
+    const int beingMaxHp = 100;
+    // 127.0.0.1 in byte order what client expects
+    const int localAddress = 0x0100007f;
+    // set by signal handler
+    volatile sig_atomic_t stopRequested = 0;
+
+    int readInt16(const char *const data)
+    {
+        return CAST_U8(data[0]) | (CAST_U8(data[1]) << 8);
+    }
+
+    int readInt32(const char *const data)
+    {
+        return CAST_S32(CAST_U32(readInt16(data)) |
+            (CAST_U32(readInt16(data + 2)) << 16));
+    }
+
+    // login and char server packets have zero size in packetsout.inc
+    int loginPacketLength(const int id)
+    {
+        switch (id)
+        {
+            case 0x7530:  // CMSG_SERVER_VERSION_REQUEST
+                return 22;
+            case 0x0064:  // CMSG_LOGIN_REGISTER
+                return 55;
+            case 0x02b0:  // CMSG_LOGIN_REGISTER_HAN
+                return 85;
+            case 0x027c:  // CMSG_LOGIN_REGISTER4
+                return 91;
+            case 0x0200:  // CMSG_LOGIN_PING
+                return 26;
+            case 0x0065:  // CMSG_CHAR_SERVER_CONNECT
+                return 17;
+            case 0x0066:  // CMSG_CHAR_SELECT
+                return 3;
+            case 0x0187:  // CMSG_CHAR_PING
+                return 6;
+            default:
+                return 0;
+        }
+    }
+
+    const char *roleName(const int role)
+    {
+        switch (role)
+        {
+            case LOGIN_ROLE:
+                return "login";
+            case CHAR_ROLE:
+                return "char";
+            case MAP_ROLE:
+            default:
+                return "map";
+        }
+    }
+}  // namespace
+
+struct FakeConnection final
+{
+    FakeConnection(TCPsocket socket0,
+                   const int role0) :
+        socket(socket0),
+        input(),
+        role(role0),
+        inGame(false),
+        closed(false)
+    {
+    }
+
+    A_DELETE_COPY(FakeConnection)
+
+    TCPsocket socket;
+    std::string input;
+    int role;
+    bool inGame;
+    bool closed;
+};
+
+FakeServer::FakeServer(const FakeServerOptions &options) :
+    mOptions(options),
+    mPackets(),
+    mWriter(),
+    mConnections(),
+    mBeings(),
+    mLoginSocket(nullptr),
+    mCharSocket(nullptr),
+    mMapSocket(nullptr),
+    mSocketSet(nullptr),
+    mVisiblePacket(nullptr),
+    mMovePacket(nullptr),
+    mAttackPacket(nullptr),
+    mRemovePacket(nullptr),
+    mNamePacket(nullptr),
+    mMapConnectId(0),
+    mMapLoadedId(0),
+    mNameRequestId(0),
+    mRandom(options.seed),
+    mNextTick(0U),
+    mStatTime(0U),
+    mStartTime(0U),
+    mSentBytes(0U),
+    mSentPackets(0U),
+    mTotalBytes(0U),
+    mTotalPackets(0U),
+    mNextId(firstBeingId),
+    mNeedRemove(false),
+    mBadPackets(false)
+{
+    if (mOptions.rate < 1)
+        mOptions.rate = 1;
+    // tick time in milliseconds must not be zero
+    if (mOptions.rate > 1000)
+        mOptions.rate = 1000;
+    if (mOptions.beings < 0)
+        mOptions.beings = 0;
+}
+
+FakeServer::~FakeServer()
+{
+    FOR_EACH (std::vector<FakeConnection*>::iterator, it, mConnections)
+    {
+        SDLNet_TCP_Close((*it)->socket);
+        delete *it;
+    }
+    mConnections.clear();
+    if (mSocketSet)
+        SDLNet_FreeSocketSet(mSocketSet);
+    if (mLoginSocket)
+        SDLNet_TCP_Close(mLoginSocket);
+    if (mCharSocket)
+        SDLNet_TCP_Close(mCharSocket);
+    if (mMapSocket)
+        SDLNet_TCP_Close(mMapSocket);
+}
+
+bool FakeServer::start()
+{
+    mPackets.load(mOptions.packetVersion, mOptions.serverVersion);
+    if (!checkPackets())
+        return false;
+
+    mLoginSocket = listen(mOptions.loginPort);
+    mCharSocket = listen(mOptions.charPort);
+    mMapSocket = listen(mOptions.mapPort);
+    if (!mLoginSocket || !mCharSocket || !mMapSocket)
+        return false;
+
+    mSocketSet = SDLNet_AllocSocketSet(maxConnections + 3);
+    if (!mSocketSet)
+    {
+        std::cerr << "Socket set error: " << SDLNet_GetError() << std::endl;
+        return false;
+    }
+    SDLNet_TCP_AddSocket(mSocketSet, mLoginSocket);
+    SDLNet_TCP_AddSocket(mSocketSet, mCharSocket);
+    SDLNet_TCP_AddSocket(mSocketSet, mMapSocket);
+
+    mBeings.resize(CAST_SIZE(mOptions.beings));
+    mNextTick = SDL_GetTicks();
+    mStatTime = mNextTick;
+    mStartTime = mNextTick;
+    std::cout << "Fake server started. Login port: " << mOptions.loginPort
+        << ", map: " << mOptions.mapName
+        << ", beings: " << mOptions.beings
+        << ", rate: " << mOptions.rate << std::endl;
+    return true;
+}
+
+TCPsocket FakeServer::listen(const int port)
+{
+    IPaddress address;
+    // SDL_net can listen only on all interfaces.
+    if (SDLNet_ResolveHost(&address, nullptr, CAST_U16(port)) == -1)
+    {
+        std::cerr << "Resolve error: " << SDLNet_GetError() << std::endl;
+        return nullptr;
+    }
+    TCPsocket socket = SDLNet_TCP_Open(&address);
+    if (!socket)
+    {
+        std::cerr << "Cant listen port " << port << ": "
+            << SDLNet_GetError() << std::endl;
+    }
+    return socket;
+}
+
+const PacketInfo *FakeServer::getPacket(const char *const name)
+{
+    const PacketInfo *const info = mPackets.getIn(name);
+    if (!info)
+    {
+        std::cerr << "Packet " << name << " not supported in packet version "
+            << mOptions.packetVersion << std::endl;
+        mBadPackets = true;
+    }
+    return info;
+}
+
+bool FakeServer::checkPackets()
+{
+    mBadPackets = false;
+    mVisiblePacket = getPacket("SMSG_BEING_VISIBLE");
+    mMovePacket = getPacket("SMSG_BEING_MOVE2");
+    mAttackPacket = getPacket("SMSG_BEING_ACTION2");
+    mRemovePacket = getPacket("SMSG_BEING_REMOVE");
+    mNamePacket = getPacket("SMSG_BEING_NAME_RESPONSE");
+    if (!getPacket("SMSG_SERVER_VERSION_RESPONSE") ||
+        !getPacket("SMSG_LOGIN_DATA") ||
+        !getPacket("SMSG_CHAR_LOGIN") ||
+        !getPacket("SMSG_CHAR_MAP_INFO") ||
+        !getPacket("SMSG_MAP_LOGIN_SUCCESS") ||
+        mBadPackets)
+    {
+        return false;
+    }
+
+    mMapConnectId = mPackets.getOutId("CMSG_MAP_SERVER_CONNECT");
+    mMapLoadedId = mPackets.getOutId("CMSG_MAP_LOADED");
+    mNameRequestId = mPackets.getOutId("CMSG_NAME_REQUEST");
+
+    // write crowd packets once to compare sizes with packetsin.inc
+    PacketWriter writer;
+    FakeBeing being;
+    being.id = firstBeingId;
+    writeVisible(writer, being);
+    writeMove(writer, being, 1, 1);
+    writeAttack(writer, being, being, 1);
+    writeRemove(writer, being.id, 0);
+    writeName(writer, being.id);
+    mSentPackets = 0U;
+    return !mBadPackets;
+}
+
+int FakeServer::startPacket(PacketWriter &writer,
+                            const PacketInfo *const info)
+{
+    writer.start(info->id, info->len == -1);
+    return info->version;
+}
+
+void FakeServer::finishPacket(PacketWriter &writer,
+                              const PacketInfo *const info)
+{
+    const int len = writer.finish();
+    if (info->len != -1 && info->len != len)
+    {
+        std::cerr << "Wrong size for packet " << info->id << ": " << len
+            << ", expected: " << info->len << std::endl;
+        mBadPackets = true;
+    }
+    mSentPackets ++;
+}
+
+void FakeServer::run()
+{
+    const unsigned int tickTime = CAST_U32(1000 / mOptions.rate);
+    while (!stopRequested)
+    {
+        const int wait = CAST_S32(mNextTick - SDL_GetTicks());
+        if (SDLNet_CheckSockets(mSocketSet,
+            CAST_U32(wait > 0 ? wait : 0)) > 0)
+        {
+            if (SDLNet_SocketReady(mLoginSocket))
+                accept(mLoginSocket, LOGIN_ROLE);
+            if (SDLNet_SocketReady(mCharSocket))
+                accept(mCharSocket, CHAR_ROLE);
+            if (SDLNet_SocketReady(mMapSocket))
+                accept(mMapSocket, MAP_ROLE);
+            for (size_t f = 0; f < mConnections.size(); f ++)
+            {
+                FakeConnection *const connection = mConnections[f];
+                if (SDLNet_SocketReady(connection->socket))
+                    read(connection);
+            }
+        }
+        if (mNeedRemove)
+            removeClosed();
+
+        const unsigned int now = SDL_GetTicks();
+        if (CAST_S32(now - mNextTick) >= 0)
+        {
+            mNextTick += tickTime;
+            // server was paused, dont try catch up
+            if (CAST_S32(now - mNextTick) > 1000)
+                mNextTick = now + tickTime;
+            logic();
+        }
+        if (now - mStatTime >= 5000U)
+            printStatistics(now);
+    }
+
+    const unsigned int now = SDL_GetTicks();
+    if (now - mStatTime >= 1000U)
+        printStatistics(now);
+    mTotalPackets += mSentPackets;
+    mTotalBytes += mSentBytes;
+    const unsigned int seconds = (now - mStartTime) / 1000U;
+    std::cout << "Fake server stopped. Seconds: " << seconds
+        << ", packets: " << mTotalPackets
+        << ", bytes: " << mTotalBytes << std::endl;
+}
+
+void FakeServer::stop()
+{
+    stopRequested = 1;
+}
+
+void FakeServer::printStatistics(const unsigned int now)
+{
+    const unsigned int seconds = (now - mStatTime) / 1000U;
+    int visible = 0;
+    FOR_EACH (std::vector<FakeBeing>::const_iterator, it, mBeings)
+    {
+        if ((*it).visible)
+            visible ++;
+    }
+    std::cout << "beings: " << visible
+        << ", packets/s: " << mSentPackets / seconds
+        << ", bytes/s: " << mSentBytes / seconds << std::endl;
+    mTotalPackets += mSentPackets;
+    mTotalBytes += mSentBytes;
+    mSentPackets = 0U;
+    mSentBytes = 0U;
+    mStatTime = now;
+}
+
+void FakeServer::accept(TCPsocket server,
+                        const int role)
+{
+    TCPsocket socket = SDLNet_TCP_Accept(server);
+    if (!socket)
+        return;
+    if (mConnections.size() >= CAST_SIZE(maxConnections) ||
+        SDLNet_TCP_AddSocket(mSocketSet, socket) == -1)
+    {
+        std::cerr << "Too many connections" << std::endl;
+        SDLNet_TCP_Close(socket);
+        return;
+    }
+    mConnections.push_back(new FakeConnection(socket, role));
+    std::cout << "New connection to " << roleName(role) << " server"
+        << std::endl;
+}
+
+void FakeServer::read(FakeConnection *const connection)
+{
+    char buf[8192];
+    const int len = SDLNet_TCP_Recv(connection->socket, buf, sizeof(buf));
+    if (len <= 0)
+    {
+        connection->closed = true;
+        mNeedRemove = true;
+        return;
+    }
+    connection->input.append(buf, CAST_SIZE(len));
+    parse(connection);
+}
+
+int FakeServer::packetLength(const FakeConnection *const connection,
+                             const char *const data,
+                             const size_t size) const
+{
+    const int id = readInt16(data);
+    int len = 0;
+    if (connection->role == MAP_ROLE)
+        len = mPackets.getOutLength(id);
+    if (len == 0)
+        len = loginPacketLength(id);
+    if (len == -1)
+    {
+        if (size < 4)
+            return 0;
+        len = readInt16(data + 2);
+        if (len < 4)
+            return -1;
+    }
+    else if (len < 2)
+    {
+        return -1;
+    }
+    if (CAST_SIZE(len) > size)
+        return 0;
+    return len;
+}
+
+void FakeServer::parse(FakeConnection *const connection)
+{
+    std::string &input = connection->input;
+    size_t pos = 0;
+    while (!connection->closed && input.size() - pos >= 2)
+    {
+        const char *const data = input.data() + pos;
+        const int len = packetLength(connection, data, input.size() - pos);
+        if (len == 0)
+            break;
+        const int id = readInt16(data);
+        if (len < 0)
+        {
+            // without size rest of data cant be parsed
+            std::cerr << "Unknown packet " << id << " from client"
+                << std::endl;
+            pos = input.size();
+            break;
+        }
+        switch (connection->role)
+        {
+            case LOGIN_ROLE:
+                processLogin(connection, id);
+                break;
+            case CHAR_ROLE:
+                processChar(connection, id);
+                break;
+            case MAP_ROLE:
+            default:
+                processMap(connection, id, data, len);
+                break;
+        }
+        pos += CAST_SIZE(len);
+    }
+    input.erase(0, pos);
+}
+
+void FakeServer::processLogin(FakeConnection *const connection,
+                              const int id)
+{
+    PacketWriter writer;
+    if (id == 0x7530)
+    {
+        const PacketInfo *const info = getPacket(
+            "SMSG_SERVER_VERSION_RESPONSE");
+        startPacket(writer, info);
+        writer.writeInt32(0);
+        writer.writeInt32(mOptions.serverVersion);
+        writer.writeInt32(mOptions.packetVersion);
+        finishPacket(writer, info);
+    }
+    else if (id == 0x0064 || id == 0x02b0 || id == 0x027c)
+    {
+        const PacketInfo *const info = getPacket("SMSG_LOGIN_DATA");
+        startPacket(writer, info);
+        writer.writeInt32(1);
+        writer.writeInt32(accountId);
+        writer.writeInt32(2);
+        writer.writeInt32(0);
+        writer.writeString("", 24);
+        writer.writeInt16(0);
+        writer.writeInt8(1);
+        // one world on char port
+        writer.writeInt32(localAddress);
+        writer.writeInt16(mOptions.charPort);
+        writer.writeString("Fake server", 20);
+        writer.writeInt16(1);
+        writer.writeInt16(0);
+        writer.writeInt16(0);
+        finishPacket(writer, info);
+    }
+    send(connection, writer);
+}
+
+void FakeServer::processChar(FakeConnection *const connection,
+                             const int id)
+{
+    const int packetVersion = mOptions.packetVersion;
+    PacketWriter writer;
+    if (id == 0x0065)
+    {
+        // account id sent before answer
+        writer.writeInt32(accountId);
+
+        const PacketInfo *const info = getPacket("SMSG_CHAR_LOGIN");
+        startPacket(writer, info);
+        if (packetVersion >= 20100413)
+        {
+            writer.writeInt8(9);
+            writer.writeInt8(9);
+            writer.writeInt8(9);
+        }
+        writer.writeString("", 20);
+
+        // one character, same layout as in CharServerRecv::readPlayerData
+        const size_t charStart = writer.getData().size();
+        writer.writeInt32(charId);
+        writer.writeInt32(0);
+        writer.writeInt32(0);
+        writer.writeInt32(0);
+        writer.writeInt32(1);
+        for (int f = 0; f < 4; f ++)
+            writer.writeInt16(0);
+        writer.writeInt32(0);
+        writer.writeInt32(0);
+        writer.writeInt32(0);
+        writer.writeInt16(0);
+        if (packetVersion >= 20081217)
+        {
+            writer.writeInt32(100);
+            writer.writeInt32(100);
+        }
+        else
+        {
+            writer.writeInt16(100);
+            writer.writeInt16(100);
+        }
+        writer.writeInt16(10);
+        writer.writeInt16(10);
+        writer.writeInt16(150);
+        writer.writeInt16(0);
+        writer.writeInt16(0);
+        if (packetVersion >= 20141022)
+            writer.writeInt16(0);
+        writer.writeInt16(0);
+        writer.writeInt16(1);
+        for (int f = 0; f < 7; f ++)
+            writer.writeInt16(0);
+        writer.writeString("Fake", 24);
+        for (int f = 0; f < 6; f ++)
+            writer.writeInt8(1);
+        writer.writeInt16(0);
+        if (packetVersion >= 20061023)
+            writer.writeInt16(0);
+        if (packetVersion >= 20100803)
+        {
+            writer.writeString(mOptions.mapName + ".gat", 16);
+            writer.writeInt32(0);
+        }
+        if (packetVersion >= 20110111)
+            writer.writeInt32(0);
+        if (packetVersion >= 20110928)
+            writer.writeInt32(0);
+        if (packetVersion >= 20111025)
+            writer.writeInt32(0);
+        if (packetVersion >= 20141016)
+            writer.writeInt8(99);
+        // client derives characters count from packet size
+        const size_t charSize = writer.getData().size() - charStart;
+        for (size_t f = charSize; f < 144; f ++)
+            writer.writeInt8(0);
+        finishPacket(writer, info);
+    }
+    else if (id == 0x0066)
+    {
+        const PacketInfo *const info = getPacket("SMSG_CHAR_MAP_INFO");
+        startPacket(writer, info);
+        writer.writeInt32(charId);
+        writer.writeString(mOptions.mapName + ".gat", 16);
+        writer.writeInt32(localAddress);
+        writer.writeInt16(mOptions.mapPort);
+        finishPacket(writer, info);
+    }
+    send(connection, writer);
+}
+
+void FakeServer::processMap(FakeConnection *const connection,
+                            const int id,
+                            const char *const data,
+                            const int len)
+{
+    PacketWriter writer;
+    if (id == mMapConnectId)
+    {
+        const PacketInfo *const accountInfo = mPackets.getIn(
+            "SMSG_MAP_ACCOUNT_ID");
+        if (accountInfo)
+        {
+            startPacket(writer, accountInfo);
+            writer.writeInt32(accountId);
+            finishPacket(writer, accountInfo);
+        }
+        const PacketInfo *const info = getPacket("SMSG_MAP_LOGIN_SUCCESS");
+        const int version = startPacket(writer, info);
+        writer.writeInt32(CAST_S32(SDL_GetTicks()));
+        writer.writeCoordinates(mOptions.x, mOptions.y, 0);
+        writer.writeInt8(5);
+        writer.writeInt8(5);
+        if (version >= 20080102)
+            writer.writeInt16(0);
+        if (version >= 20141022)
+            writer.writeInt8(1);
+        finishPacket(writer, info);
+    }
+    else if (id == mMapLoadedId)
+    {
+        connection->inGame = true;
+        FOR_EACH (std::vector<FakeBeing>::const_iterator, it, mBeings)
+        {
+            if ((*it).visible)
+                writeVisible(writer, *it);
+        }
+    }
+    else if (id == mNameRequestId && len >= 6)
+    {
+        // being id is last field in all versions
+        writeName(writer, readInt32(data + len - 4));
+    }
+    send(connection, writer);
+}
+
+void FakeServer::send(FakeConnection *const connection,
+                      PacketWriter &writer)
+{
+    const std::string &data = writer.getData();
+    if (data.empty() || connection->closed)
+        return;
+    const int len = CAST_S32(data.size());
+    if (SDLNet_TCP_Send(connection->socket, data.data(), len) < len)
+    {
+        connection->closed = true;
+        mNeedRemove = true;
+        return;
+    }
+    mSentBytes += CAST_U32(len);
+}
+
+void FakeServer::broadcast()
+{
+    FOR_EACH (std::vector<FakeConnection*>::iterator, it, mConnections)
+    {
+        if ((*it)->inGame)
+            send(*it, mWriter);
+    }
+    mWriter.clear();
+}
+
+void FakeServer::removeClosed()
+{
+    std::vector<FakeConnection*>::iterator it = mConnections.begin();
+    while (it != mConnections.end())
+    {
+        FakeConnection *const connection = *it;
+        if (connection->closed)
+        {
+            std::cout << "Closed connection to "
+                << roleName(connection->role) << " server" << std::endl;
+            SDLNet_TCP_DelSocket(mSocketSet, connection->socket);
+            SDLNet_TCP_Close(connection->socket);
+            delete connection;
+            it = mConnections.erase(it);
+        }
+        else
+        {
+            ++ it;
+        }
+    }
+    mNeedRemove = false;
+}
+
+void FakeServer::logic()
+{
+    bool inGame = false;
+    FOR_EACH (std::vector<FakeConnection*>::const_iterator, it, mConnections)
+    {
+        if ((*it)->inGame)
+            inGame = true;
+    }
+    // crowd frozen while nobody can see it
+    if (!inGame)
+        return;
+
+    const int radius = mOptions.radius;
+    const int moveChance = mOptions.movePercent;
+    const int attackChance = moveChance + mOptions.attackPercent;
+    const int despawnChance = attackChance + mOptions.despawnPercent;
+    FOR_EACH (std::vector<FakeBeing>::iterator, it, mBeings)
+    {
+        FakeBeing &being = *it;
+        if (!being.visible)
+        {
+            if (being.respawnTicks > 0)
+            {
+                being.respawnTicks --;
+                continue;
+            }
+            // new id for each spawn, so client creates new being
+            being.id = mNextId;
+            mNextId ++;
+            being.hp = beingMaxHp;
+            being.x = std::max(0, mOptions.x + random(radius * 2 + 1)
+                - radius);
+            being.y = std::max(0, mOptions.y + random(radius * 2 + 1)
+                - radius);
+            being.visible = true;
+            writeVisible(mWriter, being);
+            continue;
+        }
+
+        const int chance = random(100);
+        if (chance < moveChance)
+        {
+            moveBeing(being);
+        }
+        else if (chance < attackChance)
+        {
+            attackBeing(being);
+        }
+        else if (chance < despawnChance)
+        {
+            writeRemove(mWriter, being.id, 0);
+            being.visible = false;
+            being.respawnTicks = mOptions.rate;
+        }
+    }
+    broadcast();
+}
+
+void FakeServer::moveBeing(FakeBeing &being)
+{
+    const int radius = mOptions.radius;
+    const int dstX = std::max(0, std::min(mOptions.x + radius, std::max(
+        mOptions.x - radius, being.x + random(7) - 3)));
+    const int dstY = std::max(0, std::min(mOptions.y + radius, std::max(
+        mOptions.y - radius, being.y + random(7) - 3)));
+    writeMove(mWriter, being, dstX, dstY);
+    being.x = dstX;
+    being.y = dstY;
+}
+
+void FakeServer::attackBeing(FakeBeing &being)
+{
+    FakeBeing &target = mBeings[CAST_SIZE(random(
+        CAST_S32(mBeings.size())))];
+    if (&target == &being || !target.visible)
+        return;
+    const int damage = 1 + random(30);
+    writeAttack(mWriter, being, target, damage);
+    target.hp -= damage;
+    if (target.hp <= 0)
+    {
+        writeRemove(mWriter, target.id, 1);
+        target.visible = false;
+        target.respawnTicks = mOptions.rate * 2;
+    }
+}
+
+void FakeServer::writeVisible(PacketWriter &writer,
+                              const FakeBeing &being)
+{
+    // same layout as in BeingRecv::processBeingVisible
+    const int serverVersion = mOptions.serverVersion;
+    const int version = startPacket(writer, mVisiblePacket);
+    if (version >= 20091103)
+        writer.writeInt8(CAST_S32(BeingType::MONSTER));
+    writer.writeInt32(being.id);
+    if (version >= 20131223 &&
+        (serverVersion == 0 || serverVersion >= 11))
+    {
+        writer.writeInt32(being.id);
+    }
+    writer.writeInt16(150);
+    writer.writeInt16(0);
+    writer.writeInt16(0);
+    if (version >= 20080102)
+        writer.writeInt32(0);
+    else
+        writer.writeInt16(0);
+    writer.writeInt16(mOptions.job);
+    writer.writeInt16(0);
+    if (version >= 7)
+        writer.writeInt32(0);
+    else
+        writer.writeInt16(0);
+    writer.writeInt16(0);
+    if (version < 7)
+        writer.writeInt16(0);
+    for (int f = 0; f < 5; f ++)
+        writer.writeInt16(0);
+    if (version >= 20101124)
+        writer.writeInt16(0);
+    writer.writeInt32(0);
+    writer.writeInt16(0);
+    writer.writeInt16(0);
+    if (version >= 7)
+        writer.writeInt32(0);
+    else
+        writer.writeInt16(0);
+    writer.writeInt8(0);
+    writer.writeInt8(0);
+    writer.writeCoordinates(being.x, being.y, 0);
+    writer.writeInt8(5);
+    writer.writeInt8(5);
+    writer.writeInt8(0);
+    writer.writeInt16(1);
+    if (version >= 20080102)
+        writer.writeInt16(0);
+    if (version >= 20120221)
+    {
+        writer.writeInt32(beingMaxHp);
+        writer.writeInt32(being.hp);
+        writer.writeInt8(0);
+    }
+    if (version >= 20150513)
+    {
+        writer.writeInt16(0);
+        writer.writeString("", 24);
+    }
+    finishPacket(writer, mVisiblePacket);
+}
+
+void FakeServer::writeMove(PacketWriter &writer,
+                           const FakeBeing &being,
+                           const int dstX,
+                           const int dstY)
+{
+    startPacket(writer, mMovePacket);
+    writer.writeInt32(being.id);
+    writer.writeCoordinatePair(being.x, being.y, dstX, dstY);
+    writer.writeInt8(0);
+    writer.writeInt32(CAST_S32(SDL_GetTicks()));
+    finishPacket(writer, mMovePacket);
+}
+
+void FakeServer::writeAttack(PacketWriter &writer,
+                             const FakeBeing &src,
+                             const FakeBeing &dst,
+                             const int damage)
+{
+    // same layout as in BeingRecv::processBeingAction2
+    const int version = startPacket(writer, mAttackPacket);
+    writer.writeInt32(src.id);
+    writer.writeInt32(dst.id);
+    writer.writeInt32(CAST_S32(SDL_GetTicks()));
+    writer.writeInt32(500);
+    writer.writeInt32(500);
+    if (version >= 20071113)
+        writer.writeInt32(damage);
+    else
+        writer.writeInt16(damage);
+    if (version >= 20131223)
+        writer.writeInt8(0);
+    writer.writeInt16(1);
+    // AttackType::HIT
+    writer.writeInt8(0);
+    if (version >= 20071113)
+        writer.writeInt32(0);
+    else
+        writer.writeInt16(0);
+    finishPacket(writer, mAttackPacket);
+}
+
+void FakeServer::writeRemove(PacketWriter &writer,
+                             const int id,
+                             const int flag)
+{
+    startPacket(writer, mRemovePacket);
+    writer.writeInt32(id);
+    writer.writeInt8(flag);
+    finishPacket(writer, mRemovePacket);
+}
+
+void FakeServer::writeName(PacketWriter &writer,
+                           const int id)
+{
+    std::ostringstream name;
+    name << "Fake " << id - firstBeingId;
+    startPacket(writer, mNamePacket);
+    writer.writeInt32(id);
+    writer.writeString(name.str(), 24);
+    finishPacket(writer, mNamePacket);
+}
+
+int FakeServer::random(const int range)
+{
+    if (range <= 0)
+        return 0;
+    mRandom = mRandom * 1103515245U + 12345U;
+    return CAST_S32((mRandom >> 16) % CAST_U32(range));
+}
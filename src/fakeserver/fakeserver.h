@@ -0,0 +1,239 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef FAKESERVER_FAKESERVER_H
+#define FAKESERVER_FAKESERVER_H
+
+#include "fakeserver/packettable.h"
+#include "fakeserver/packetwriter.h"
+
+#include <vector>
+
+#ifdef USE_SDL2
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wswitch-default"
+#endif  // USE_SDL2
+#include <SDL_stdinc.h>
+#ifdef USE_SDL2
+#pragma GCC diagnostic pop
+#endif  // USE_SDL2
+
+#include <SDL_net.h>
+
+#include "localconsts.h"
+
+struct FakeConnection;
+
+struct FakeServerOptions final
+{
+    FakeServerOptions() :
+        mapName("000-1"),
+        loginPort(6900),
+        charPort(6121),
+        mapPort(5121),
+        beings(100),
+        rate(10),
+        x(50),
+        y(50),
+        radius(20),
+        job(1002),
+        movePercent(50),
+        attackPercent(10),
+        despawnPercent(2),
+        packetVersion(20150000),
+        serverVersion(8),
+        seed(1)
+    {
+    }
+
+    std::string mapName;
+    int loginPort;
+    int charPort;
+    int mapPort;
+    int beings;
+    // crowd updates per second
+    int rate;
+    // crowd area center and size in tiles
+    int x;
+    int y;
+    int radius;
+    int job;
+    // chances per being per update
+    int movePercent;
+    int attackPercent;
+    int despawnPercent;
+    int packetVersion;
+    int serverVersion;
+    unsigned int seed;
+};
+
+struct FakeBeing final
+{
+    FakeBeing() :
+        id(0),
+        x(0),
+        y(0),
+        hp(0),
+        respawnTicks(0),
+        visible(false)
+    {
+    }
+
+    int id;
+    int x;
+    int y;
+    int hp;
+    int respawnTicks;
+    bool visible;
+};
+
+/**
+ * Fake eAthena login, char and map server for client load testing.
+ * Logins any account and spawns crowd of monsters what moves,
+ * attacks each other, dies and respawns with configured rate.
+ */
+class FakeServer final
+{
+    public:
+        explicit FakeServer(const FakeServerOptions &options);
+
+        A_DELETE_COPY(FakeServer)
+
+        ~FakeServer();
+
+        /**
+         * Opens listen sockets and checks packet layouts.
+         */
+        bool start();
+
+        /**
+         * Serves clients until stop called.
+         */
+        void run();
+
+        /**
+         * Stops run loop. Can be called from signal handler.
+         */
+        static void stop();
+
+    private:
+        TCPsocket listen(const int port);
+
+        bool checkPackets();
+
+        void accept(TCPsocket server,
+                    const int role);
+
+        void read(FakeConnection *const connection);
+
+        int packetLength(const FakeConnection *const connection,
+                         const char *const data,
+                         const size_t size) const A_WARN_UNUSED;
+
+        void parse(FakeConnection *const connection);
+
+        void processLogin(FakeConnection *const connection,
+                          const int id);
+
+        void processChar(FakeConnection *const connection,
+                         const int id);
+
+        void processMap(FakeConnection *const connection,
+                        const int id,
+                        const char *const data,
+                        const int len);
+
+        void send(FakeConnection *const connection,
+                  PacketWriter &writer);
+
+        void broadcast();
+
+        void removeClosed();
+
+        void logic();
+
+        void moveBeing(FakeBeing &being);
+
+        void attackBeing(FakeBeing &being);
+
+        void writeVisible(PacketWriter &writer,
+                          const FakeBeing &being);
+
+        void writeMove(PacketWriter &writer,
+                       const FakeBeing &being,
+                       const int dstX,
+                       const int dstY);
+
+        void writeAttack(PacketWriter &writer,
+                         const FakeBeing &src,
+                         const FakeBeing &dst,
+                         const int damage);
+
+        void writeRemove(PacketWriter &writer,
+                         const int id,
+                         const int flag);
+
+        void writeName(PacketWriter &writer,
+                       const int id);
+
+        const PacketInfo *getPacket(const char *const name) A_WARN_UNUSED;
+
+        static int startPacket(PacketWriter &writer,
+                               const PacketInfo *const info);
+
+        void finishPacket(PacketWriter &writer,
+                          const PacketInfo *const info);
+
+        int random(const int range) A_WARN_UNUSED;
+
+        void printStatistics(const unsigned int now);
+
+        FakeServerOptions mOptions;
+        PacketTable mPackets;
+        PacketWriter mWriter;
+        std::vector<FakeConnection*> mConnections;
+        std::vector<FakeBeing> mBeings;
+        TCPsocket mLoginSocket;
+        TCPsocket mCharSocket;
+        TCPsocket mMapSocket;
+        SDLNet_SocketSet mSocketSet;
+        const PacketInfo *mVisiblePacket;
+        const PacketInfo *mMovePacket;
+        const PacketInfo *mAttackPacket;
+        const PacketInfo *mRemovePacket;
+        const PacketInfo *mNamePacket;
+        int mMapConnectId;
+        int mMapLoadedId;
+        int mNameRequestId;
+        unsigned int mRandom;
+        unsigned int mNextTick;
+        unsigned int mStatTime;
+        unsigned int mStartTime;
+        unsigned int mSentBytes;
+        unsigned int mSentPackets;
+        uint64_t mTotalBytes;
+        uint64_t mTotalPackets;
+        int mNextId;
+        bool mNeedRemove;
+        bool mBadPackets;
+};
+
+#endif  // FAKESERVER_FAKESERVER_H
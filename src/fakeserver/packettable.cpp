@@ -0,0 +1,104 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "fakeserver/packettable.h"
+
+#include "debug.h"
+
+PacketTable::PacketTable() :
+    mIn(),
+    mInNames(),
+    mOutIds(),
+    mOutLengths()
+{
+}
+
+void PacketTable::load(const int packetVersion,
+                       const int serverVersion)
+{
+    mIn.clear();
+    mInNames.clear();
+    mOutIds.clear();
+    mOutLengths.clear();
+
+#define packet(name, id, size, handler, version) \
+    addIn(#name, id, size, version)
+#include "net/eathena/packetsin.inc"
+#undef packet
+
+#define PACKETS_UPDATE
+#define packet(name, id, size, handler) \
+    addOut(#name, id, size)
+#include "net/eathena/packetsout.inc"
+#undef packet
+#undef PACKETS_UPDATE
+}
+
+void PacketTable::addIn(const char *const name,
+                        const int id,
+                        const int len,
+                        const int version)
+{
+    // later packets override older, same as in client handlers table
+    mIn[name] = PacketInfo(id, len, version);
+    mInNames[id] = name;
+}
+
+void PacketTable::addOut(const char *const name,
+                         const int id,
+                         const int len)
+{
+    mOutIds[name] = id;
+    if (id)
+        mOutLengths[id] = len;
+}
+
+const PacketInfo *PacketTable::getIn(const std::string &name) const
+{
+    const std::map<std::string, PacketInfo>::const_iterator it =
+        mIn.find(name);
+    if (it == mIn.end())
+        return nullptr;
+    const PacketInfo &info = (*it).second;
+    const std::map<int, std::string>::const_iterator it2 =
+        mInNames.find(info.id);
+    if (it2 == mInNames.end() || (*it2).second != name)
+        return nullptr;
+    return &info;
+}
+
+int PacketTable::getOutLength(const int id) const
+{
+    const std::map<int, int>::const_iterator it = mOutLengths.find(id);
+    if (it == mOutLengths.end())
+        return 0;
+    return (*it).second;
+}
+
+int PacketTable::getOutId(const std::string &name) const
+{
+    const std::map<std::string, int>::const_iterator it = mOutIds.find(name);
+    if (it == mOutIds.end())
+        return 0;
+    return (*it).second;
+}
+
+PACKETSOUT_VOID
@@ -0,0 +1,102 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef FAKESERVER_PACKETTABLE_H
+#define FAKESERVER_PACKETTABLE_H
+
+#include <map>
+#include <string>
+
+#include "localconsts.h"
+
+struct PacketInfo final
+{
+    PacketInfo() :
+        id(0),
+        len(0),
+        version(0)
+    {
+    }
+
+    PacketInfo(const int id0,
+               const int len0,
+               const int version0) :
+        id(id0),
+        len(len0),
+        version(version0)
+    {
+    }
+
+    int id;
+    int len;
+    int version;
+};
+
+/**
+ * Packet ids and sizes for one packet version.
+ * Built from same packetsin.inc and packetsout.inc what client uses,
+ * so fake server and client always agree about protocol.
+ */
+class PacketTable final
+{
+    public:
+        PacketTable();
+
+        A_DELETE_COPY(PacketTable)
+
+        void load(const int packetVersion,
+                  const int serverVersion);
+
+        /**
+         * Returns info about server packet what client will handle by name.
+         * Returns nullptr if packet missing or its id reused by other packet.
+         */
+        const PacketInfo *getIn(const std::string &name) const A_WARN_UNUSED;
+
+        /**
+         * Returns size of client packet, -1 for variable size packets
+         * and 0 for unknown packets.
+         */
+        int getOutLength(const int id) const A_WARN_UNUSED;
+
+        /**
+         * Returns id of client packet by name or 0 if packet not used
+         * in this packet version.
+         */
+        int getOutId(const std::string &name) const A_WARN_UNUSED;
+
+    private:
+        void addIn(const char *const name,
+                   const int id,
+                   const int len,
+                   const int version);
+
+        void addOut(const char *const name,
+                    const int id,
+                    const int len);
+
+        std::map<std::string, PacketInfo> mIn;
+        std::map<int, std::string> mInNames;
+        std::map<std::string, int> mOutIds;
+        std::map<int, int> mOutLengths;
+};
+
+#endif  // FAKESERVER_PACKETTABLE_H
@@ -0,0 +1,103 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "fakeserver/packetwriter.h"
+
+#include "debug.h"
+
+PacketWriter::PacketWriter() :
+    mData(),
+    mStart(0),
+    mVariable(false)
+{
+}
+
+void PacketWriter::start(const int id,
+                         const bool variable)
+{
+    mStart = mData.size();
+    mVariable = variable;
+    writeInt16(id);
+    if (variable)
+        writeInt16(0);
+}
+
+int PacketWriter::finish()
+{
+    const size_t len = mData.size() - mStart;
+    if (mVariable)
+    {
+        mData[mStart + 2] = CAST_8(len & 0xffU);
+        mData[mStart + 3] = CAST_8((len >> 8) & 0xffU);
+    }
+    return CAST_S32(len);
+}
+
+void PacketWriter::writeInt8(const int value)
+{
+    mData.push_back(CAST_8(value & 0xff));
+}
+
+void PacketWriter::writeInt16(const int value)
+{
+    mData.push_back(CAST_8(value & 0xff));
+    mData.push_back(CAST_8((value >> 8) & 0xff));
+}
+
+void PacketWriter::writeInt32(const int value)
+{
+    const unsigned int val = CAST_U32(value);
+    mData.push_back(CAST_8(val & 0xffU));
+    mData.push_back(CAST_8((val >> 8) & 0xffU));
+    mData.push_back(CAST_8((val >> 16) & 0xffU));
+    mData.push_back(CAST_8((val >> 24) & 0xffU));
+}
+
+void PacketWriter::writeString(const std::string &str,
+                               const size_t length)
+{
+    const size_t sz = std::min(str.size(), length);
+    mData.append(str, 0, sz);
+    mData.append(length - sz, '\0');
+}
+
+void PacketWriter::writeCoordinates(const int x,
+                                    const int y,
+                                    const int dir)
+{
+    // inverse of Net::PacketView::readCoordinates
+    writeInt8(x >> 2);
+    writeInt8(((x << 6) & 0xc0) | ((y >> 4) & 0x3f));
+    writeInt8(((y << 4) & 0xf0) | (dir & 0x0f));
+}
+
+void PacketWriter::writeCoordinatePair(const int srcX,
+                                       const int srcY,
+                                       const int dstX,
+                                       const int dstY)
+{
+    // inverse of Net::PacketView::readCoordinatePair
+    writeInt8(srcX >> 2);
+    writeInt8(((srcX << 6) & 0xc0) | ((srcY >> 4) & 0x3f));
+    writeInt8(((srcY << 4) & 0xf0) | ((dstX >> 6) & 0x0f));
+    writeInt8(((dstX << 2) & 0xfc) | ((dstY >> 8) & 0x03));
+    writeInt8(dstY & 0xff);
+}
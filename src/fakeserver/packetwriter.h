@@ -0,0 +1,81 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef FAKESERVER_PACKETWRITER_H
+#define FAKESERVER_PACKETWRITER_H
+
+#include <string>
+
+#include "localconsts.h"
+
+/**
+ * Writes server packets in eAthena byte order into send buffer.
+ */
+class PacketWriter final
+{
+    public:
+        PacketWriter();
+
+        A_DELETE_COPY(PacketWriter)
+
+        /**
+         * Starts new packet. For variable size packets length field
+         * written by finish().
+         */
+        void start(const int id,
+                   const bool variable);
+
+        /**
+         * Finishes packet and returns its size.
+         */
+        int finish();
+
+        void writeInt8(const int value);
+
+        void writeInt16(const int value);
+
+        void writeInt32(const int value);
+
+        void writeString(const std::string &str,
+                         const size_t length);
+
+        void writeCoordinates(const int x,
+                              const int y,
+                              const int dir);
+
+        void writeCoordinatePair(const int srcX,
+                                 const int srcY,
+                                 const int dstX,
+                                 const int dstY);
+
+        const std::string &getData() const A_WARN_UNUSED
+        { return mData; }
+
+        void clear()
+        { mData.clear(); }
+
+    private:
+        std::string mData;
+        size_t mStart;
+        bool mVariable;
+};
+
+#endif  // FAKESERVER_PACKETWRITER_H
@@ -23,6 +23,7 @@
 #include "game.h"
 
 #include "actormanager.h"
+#include "chatlogger.h"
 #include "client.h"
 #include "configuration.h"
 #include "effectmanager.h"
@@ -31,6 +32,7 @@
 #include "soundmanager.h"
 #include "settings.h"
 
+#include "being/beingcache.h"
 #include "being/crazymoves.h"
 #include "being/localplayer.h"
 #include "being/playerinfo.h"
@@ -113,6 +115,7 @@
 #include "resources/db/mapdb.h"
 
 #include "resources/map/map.h"
+#include "resources/map/mapprefetcher.h"
 
 #include "resources/resourcemanager/resourcemanager.h"
 
@@ -160,6 +163,7 @@ static void initEngines()
 {
     actorManager = new ActorManager;
     effectManager = new EffectManager;
+    mapPrefetcher = new MapPrefetcher;
 #ifdef TMWA_SUPPORT
     GuildManager::init();
 #endif  // TMWA_SUPPORT
@@ -386,6 +390,7 @@ Game::Game() :
     mInstance = this;
 
     config.incValue("gamecount");
+    BeingCache::load();
 
     disconnectedDialog = nullptr;
 
@@ -462,6 +467,7 @@ Game::~Game()
     if (effectManager)
         effectManager->clear();
     delete2(effectManager)
+    delete2(mapPrefetcher)
     delete2(particleEngine)
     delete2(viewport)
     delete2(mCurrentMap)
@@ -654,11 +660,19 @@ void Game::slowLogic()
         }
         if (effectManager)
             effectManager->logic();
+        if (chatLogger)
+            chatLogger->flush();
     }
 
+    if (chatWindow)
+        chatWindow->slowLogic();
+
     if (mainGraphics->getOpenGL())
         DelayedManager::delayedLoad();
 
+    if (mapPrefetcher && localPlayer)
+        mapPrefetcher->logic(localPlayer->getTileX(), localPlayer->getTileY());
+
 #ifdef TMWA_SUPPORT
     if (shopWindow)
         cilk_spawn shopWindow->updateTimes();
@@ -737,7 +751,7 @@ void Game::adjustPerfomance()
     {
         mNextAdjustTime = time + adjustDelay;
 
-        if (mAdjustLevel > 3 || !localPlayer || localPlayer->getHalfAway()
+        if (mAdjustLevel > 2 || !localPlayer || localPlayer->getHalfAway()
             || settings.awayMode)
         {
             return;
@@ -799,18 +813,6 @@ void Game::adjustPerfomance()
                         mLowerCounter = 2;
                     }
                     break;
-                case 3:
-                    if (!config.getBoolValue("alphaCache"))
-                    {
-                        config.setValue("alphaCache", true);
-                        config.setSilent("alphaCache", false);
-                        if (localChatTab)
-                        {
-                            localChatTab->chatLog("Auto enable opacity cache",
-                                ChatMsgType::BY_SERVER);
-                        }
-                    }
-                    break;
                 default:
                     break;
             }
@@ -842,8 +844,6 @@ void Game::resetAdjustLevel()
                 config.getBoolValue("beingopacity"));
             ParticleEngine::emitterSkip = config.getIntValue(
                 "particleEmitterSkip") + 1;
-            config.setValue("alphaCache",
-                config.getBoolValue("alphaCache"));
             break;
     }
     mAdjustLevel = 0;
@@ -1060,6 +1060,10 @@ void Game::changeMap(const std::string &mapPath)
     // Attempt to load the new map
     Map *const newMap = MapReader::readMap(fullMap, realFullMap);
 
+    // release prefetched resources after new map took own references
+    if (mapPrefetcher)
+        mapPrefetcher->setMap(newMap);
+
     if (mCurrentMap)
         mCurrentMap->saveExtraLayer();
 
@@ -1094,6 +1098,7 @@ void Game::changeMap(const std::string &mapPath)
         else
             soundManager.fadeOutAndPlayMusic(newMusic);
     }
+    soundManager.preloadMapSounds();
 
     if (mCurrentMap)
         mCurrentMap->saveExtraLayer();
@@ -525,13 +525,9 @@ void GraphicsManager::initGraphics()
 #ifndef ANDROID
     SafeOpenGLImageHelper::setBlur(config.getBoolValue("blur"));
 #endif  // ANDROID
-    SurfaceImageHelper::SDLSetEnableAlphaCache(
-        config.getBoolValue("alphaCache") && !openGLMode);
     ImageHelper::setEnableAlpha((config.getFloatValue("guialpha") != 1.0F ||
         openGLMode) && config.getBoolValue("enableGuiOpacity"));
 #else  // USE_OPENGL
-    SurfaceImageHelper::SDLSetEnableAlphaCache(
-        config.getBoolValue("alphaCache"));
     ImageHelper::setEnableAlpha(config.getFloatValue("guialpha") != 1.0F &&
         config.getBoolValue("enableGuiOpacity"));
 #endif  // USE_OPENGL
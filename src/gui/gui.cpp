@@ -322,6 +322,7 @@ void Gui::slowLogic()
     Palette::advanceGradients();
 
     // Fade out mouse cursor after extended inactivity
+    const float cursorAlpha = mMouseCursorAlpha;
     if (mMouseInactivityTimer < 100 * 15)
     {
         ++mMouseInactivityTimer;
@@ -331,6 +332,8 @@ void Gui::slowLogic()
     {
         mMouseCursorAlpha = std::max(0.0F, mMouseCursorAlpha - 0.005F);
     }
+    if (cursorAlpha != mMouseCursorAlpha)
+        settings.needRedraw = true;
     if (mGuiFont)
         mGuiFont->slowLogic(0);
     if (mInfoParticleFont)
@@ -23,6 +23,8 @@
 
 #include "gui/palette.h"
 
+#include "settings.h"
+
 #include "utils/timer.h"
 
 #ifndef USE_SDL2
@@ -194,6 +196,10 @@ void Palette::advanceGradient()
         }
 
         if (advance)
+        {
             mRainbowTime = tick_time;
+            if (!mGradVector.empty())
+                settings.needRedraw = true;
+        }
     }
 }
@@ -83,6 +83,22 @@ namespace
         const int mX;
         const int mY;
     };
+
+    struct RowAbove final
+    {
+        bool operator() (const BrowserRow &row, const int y) const
+        {
+            return row.y + row.advance < y;
+        }
+    };
+
+    struct RowBelow final
+    {
+        bool operator() (const int y, const BrowserRow &row) const
+        {
+            return y < row.y;
+        }
+    };
 }  // namespace
 
 ImageSet *BrowserBox::mEmotes = nullptr;
@@ -99,8 +115,7 @@ BrowserBox::BrowserBox(const Widget2 *const widget,
     Widget(widget),
     MouseListener(),
     mTextRows(),
-    mTextRowLinksCount(),
-    mLineParts(),
+    mRows(),
     mLinks(),
     mLinkHandler(nullptr),
     mSkin(nullptr),
@@ -116,6 +131,10 @@ BrowserBox::BrowserBox(const Widget2 *const widget,
     mNewLinePadding(15U),
     mItemPadding(0),
     mDataWidth(0),
+    mLayoutCount(0),
+    mLayoutY(0),
+    mYOffset(0),
+    mRowsHeight(0),
     mHighlightColor(getThemeColor(ThemeColorId::HIGHLIGHT)),
     mHyperLinkColor(getThemeColor(ThemeColorId::HYPERLINK)),
     mOpaque(opaque),
@@ -203,7 +222,7 @@ void BrowserBox::addRow(const std::string &row, const bool atTop)
     std::string newRow;
     size_t idx1;
     const Font *const font = getFont();
-    int linksCount = 0;
+    Links rowLinks;
 
     if (getWidth() < 0)
         return;
@@ -331,11 +350,7 @@ void BrowserBox::addRow(const std::string &row, const bool atTop)
             bLink.x1 = font->getWidth(tmp2) - 1;
             bLink.x2 = bLink.x1 + font->getWidth(bLink.caption) + 1;
 
-            if (atTop)
-                mLinks.insert(mLinks.begin(), bLink);
-            else
-                mLinks.push_back(bLink);
-            linksCount ++;
+            rowLinks.push_back(bLink);
 
             newRow.append("##<").append(bLink.caption);
 
@@ -375,15 +390,23 @@ void BrowserBox::addRow(const std::string &row, const bool atTop)
         }
     }
 
+    BrowserRow rowLayout;
+    rowLayout.linksCount = CAST_S32(rowLinks.size());
     if (atTop)
     {
         mTextRows.push_front(newRow);
-        mTextRowLinksCount.push_front(linksCount);
+        mRows.push_front(rowLayout);
+        mLinks.insert(mLinks.begin(), rowLinks.begin(), rowLinks.end());
+        if (mSelectedLink >= 0)
+            mSelectedLink += rowLayout.linksCount;
+        // all rows moved down
+        mLayoutCount = 0;
     }
     else
     {
         mTextRows.push_back(newRow);
-        mTextRowLinksCount.push_back(linksCount);
+        mRows.push_back(rowLayout);
+        mLinks.insert(mLinks.end(), rowLinks.begin(), rowLinks.end());
     }
 
     // discard older rows when a row limit has been set
@@ -392,14 +415,24 @@ void BrowserBox::addRow(const std::string &row, const bool atTop)
         while (mTextRows.size() > CAST_SIZE(mMaxRows))
         {
             mTextRows.pop_front();
-            int cnt = mTextRowLinksCount.front();
-            mTextRowLinksCount.pop_front();
-
+            const BrowserRow &front = mRows.front();
+            int cnt = front.linksCount;
             while (cnt && !mLinks.empty())
             {
-                mLinks.erase(mLinks.begin());
+                mLinks.pop_front();
+                mSelectedLink --;
                 cnt --;
             }
+            if (mSelectedLink < 0)
+                mSelectedLink = -1;
+            // layout of other rows not changed, only top of widget moved
+            if (mLayoutCount > 0)
+            {
+                mLayoutCount --;
+                mYOffset += front.advance;
+                mRowsHeight -= front.height;
+            }
+            mRows.pop_front();
         }
     }
 
@@ -420,65 +453,6 @@ void BrowserBox::addRow(const std::string &row, const bool atTop)
             setWidth(w);
     }
 
-    const int fontHeight = font->getHeight();
-    if (mMode == AUTO_WRAP)
-    {
-        unsigned int y = 0;
-        unsigned int nextChar;
-        const char *const hyphen = "~";
-        const unsigned int hyphenWidth = CAST_U32(
-            font->getWidth(hyphen));
-        unsigned int x = 0;
-
-        FOR_EACH (TextRowCIter, i, mTextRows)
-        {
-            std::string tempRow = *i;
-            for (uint32_t j = 0, sz = CAST_U32(tempRow.size());
-                 j < sz;
-                 j++)
-            {
-                const std::string character = tempRow.substr(j, 1);
-                x += CAST_U32(font->getWidth(character));
-                nextChar = j + 1;
-
-                // Wraping between words (at blank spaces)
-                if (nextChar < sz && tempRow.at(nextChar) == ' ')
-                {
-                    int nextSpacePos = CAST_U32(
-                        tempRow.find(" ", (nextChar + 1)));
-                    if (nextSpacePos <= 0)
-                        nextSpacePos = CAST_U32(sz) - 1U;
-
-                    const unsigned int nextWordWidth =
-                        CAST_U32(font->getWidth(
-                        tempRow.substr(nextChar,
-                        (CAST_U32(nextSpacePos) - nextChar))));
-
-                    if ((x + nextWordWidth + 10)
-                        > CAST_U32(getWidth()))
-                    {
-                        x = mNewLinePadding;  // Ident in new line
-                        y += 1;
-                        j ++;
-                    }
-                }
-                // Wrapping looong lines (brutal force)
-                else if ((x + 2 * hyphenWidth)
-                         > CAST_U32(getWidth()))
-                {
-                    x = mNewLinePadding;  // Ident in new line
-                    y += 1;
-                }
-            }
-        }
-
-        setHeight(fontHeight * (CAST_S32(
-            CAST_U32(mTextRows.size()) + y)));
-    }
-    else
-    {
-        setHeight(fontHeight * CAST_S32(mTextRows.size()));
-    }
     mUpdateTime = 0;
     updateHeight();
 }
@@ -495,14 +469,15 @@ void BrowserBox::addImage(const std::string &path)
         return;
 
     mTextRows.push_back("~~~" + path);
-    mTextRowLinksCount.push_back(0);
+    mRows.push_back(BrowserRow());
 }
 
 void BrowserBox::clearRows()
 {
     mTextRows.clear();
-    mTextRowLinksCount.clear();
+    mRows.clear();
     mLinks.clear();
+    mLayoutCount = 0;
     setWidth(0);
     setHeight(0);
     mSelectedLink = -1;
@@ -517,7 +492,7 @@ void BrowserBox::mousePressed(MouseEvent &event)
         return;
 
     const LinkIterator i = std::find_if(mLinks.begin(), mLinks.end(),
-        MouseOverLink(event.getX(), event.getY()));
+        MouseOverLink(event.getX(), event.getY() + mYOffset));
 
     if (i != mLinks.end())
     {
@@ -529,7 +504,7 @@ void BrowserBox::mousePressed(MouseEvent &event)
 void BrowserBox::mouseMoved(MouseEvent &event)
 {
     const LinkIterator i = std::find_if(mLinks.begin(), mLinks.end(),
-        MouseOverLink(event.getX(), event.getY()));
+        MouseOverLink(event.getX(), event.getY() + mYOffset));
 
     mSelectedLink = (i != mLinks.end())
         ? CAST_S32(i - mLinks.begin()) : -1;
@@ -568,7 +543,7 @@ void BrowserBox::draw(Graphics *const graphics)
             graphics->setColor(mHighlightColor);
             graphics->fillRectangle(Rect(
                 link.x1,
-                link.y1,
+                link.y1 - mYOffset,
                 link.x2 - link.x1,
                 link.y2 - link.y1));
         }
@@ -579,44 +554,53 @@ void BrowserBox::draw(Graphics *const graphics)
             graphics->setColor(mHyperLinkColor);
             graphics->drawLine(
                 link.x1,
-                link.y2,
+                link.y2 - mYOffset,
                 link.x2,
-                link.y2);
+                link.y2 - mYOffset);
         }
     }
 
     Font *const font = getFont();
 
-    FOR_EACH (LinePartCIter, i, mLineParts)
+    // rows sorted by y, so first visible row can be found by bisection
+    const RowCIter rowsBegin = mRows.begin();
+    const RowCIter rowsEnd = rowsBegin + mLayoutCount;
+    for (RowCIter it = std::lower_bound(rowsBegin, rowsEnd,
+         mYStart + mYOffset - 50, RowAbove());
+         it != rowsEnd;
+         ++ it)
     {
-        const LinePart &part = *i;
-        if (part.mY + 50 < mYStart)
-            continue;
-        if (part.mY > yEnd)
+        const BrowserRow &row = *it;
+        if (row.y - mYOffset > yEnd)
             break;
-        if (!part.mType)
+        FOR_EACH (LinePartCIter, i, row.parts)
         {
-            if (part.mBold)
+            const LinePart &part = *i;
+            const int y = part.mY - mYOffset;
+            if (!part.mType)
             {
-                boldFont->drawString(graphics,
-                    part.mColor,
-                    part.mColor2,
-                    part.mText,
-                    part.mX, part.mY);
+                if (part.mBold)
+                {
+                    boldFont->drawString(graphics,
+                        part.mColor,
+                        part.mColor2,
+                        part.mText,
+                        part.mX, y);
+                }
+                else
+                {
+                    font->drawString(graphics,
+                        part.mColor,
+                        part.mColor2,
+                        part.mText,
+                        part.mX, y);
+                }
             }
-            else
+            else if (part.mImage)
             {
-                font->drawString(graphics,
-                    part.mColor,
-                    part.mColor2,
-                    part.mText,
-                    part.mX, part.mY);
+                graphics->drawImage(part.mImage, part.mX, y);
             }
         }
-        else if (part.mImage)
-        {
-            graphics->drawImage(part.mImage, part.mX, part.mY);
-        }
     }
 
     BLOCK_END("BrowserBox::draw")
@@ -629,374 +613,419 @@ void BrowserBox::safeDraw(Graphics *const graphics)
 
 int BrowserBox::calcHeight()
 {
-    unsigned int y = CAST_U32(mPadding);
-    int wrappedLines = 0;
-    int moreHeight = 0;
     int maxWidth = mDimension.width - mPadding;
-    int link = 0;
-    bool bold = false;
-    unsigned int wWidth = CAST_U32(maxWidth);
-
     if (maxWidth < 0)
         return 1;
+    const unsigned int wWidth = CAST_U32(maxWidth);
 
+    size_t link = 0;
+    TextRowCIter it = mTextRows.begin();
+    if (mLayoutCount == 0 || mLayoutCount > mRows.size())
+    {
+        mLayoutCount = 0;
+        mLayoutY = mPadding;
+        mYOffset = 0;
+        mRowsHeight = 0;
+        mLayoutColor[0] = mForegroundColor;
+        mLayoutColor[1] = mForegroundColor2;
+    }
+    else
+    {
+        // only new rows at end need layout
+        link = mLinks.size();
+        it = mTextRows.end();
+        for (size_t f = mRows.size(); f > mLayoutCount; f --)
+        {
+            -- it;
+            link -= CAST_SIZE(mRows[f - 1].linksCount);
+        }
+    }
+
+    for (size_t f = mLayoutCount, sz = mRows.size(); f < sz; f ++, ++ it)
+    {
+        BrowserRow &rowLayout = mRows[f];
+        rowLayout.y = mLayoutY;
+        layoutRow(*it, rowLayout, link, wWidth, maxWidth);
+        link += CAST_SIZE(rowLayout.linksCount);
+        mLayoutY += rowLayout.advance;
+        mRowsHeight += rowLayout.height;
+    }
+    mLayoutCount = mRows.size();
+
+    if (CAST_S32(wWidth) != maxWidth)
+        setWidth(maxWidth);
+
+    return mRowsHeight + 2 * mPadding;
+}
+
+void BrowserBox::layoutRow(const std::string &row,
+                           BrowserRow &rowLayout,
+                           const size_t firstLink,
+                           const unsigned int wWidth,
+                           int &maxWidth)
+{
     const Font *const font = getFont();
     const int fontHeight = font->getHeight() + 2 * mItemPadding;
-    const int fontWidthMinus = font->getWidth("-");
     const char *const hyphen = "~";
     const int hyphenWidth = font->getWidth(hyphen);
+    const size_t linkEnd = std::min(mLinks.size(),
+        firstLink + CAST_SIZE(rowLayout.linksCount));
 
-    Color selColor[2] = {mForegroundColor, mForegroundColor2};
+    LinePartList &parts = rowLayout.parts;
+    parts.clear();
+    Color *const selColor = mLayoutColor;
     const Color textColor[2] = {mForegroundColor, mForegroundColor2};
-    mLineParts.clear();
+    unsigned int x = CAST_U32(mPadding);
+    unsigned int y = CAST_U32(rowLayout.y);
+    size_t link = firstLink;
+    int wrappedLines = 0;
+    bool wrapped = false;
+    int objects = 0;
 
-    FOR_EACH (TextRowCIter, i, mTextRows)
+    // Check for separator lines
+    if (row.find("---", 0) == 0)
     {
-        unsigned int x = CAST_U32(mPadding);
-        const std::string row = *(i);
-        bool wrapped = false;
-        int objects = 0;
-
-        // Check for separator lines
-        if (row.find("---", 0) == 0)
+        const int dashWidth = font->getWidth("-");
+        for (x = CAST_U32(mPadding); x < wWidth; x ++)
         {
-            const int dashWidth = fontWidthMinus;
-            for (x = CAST_U32(mPadding); x < wWidth; x ++)
-            {
-                mLineParts.push_back(LinePart(CAST_S32(x),
-                    CAST_S32(y) + mItemPadding,
-                    selColor[0], selColor[1], "-", false));
-                x += CAST_U32(CAST_S32(
-                    dashWidth) - 2);
-            }
-
-            y += CAST_U32(fontHeight);
-            continue;
+            parts.push_back(LinePart(CAST_S32(x),
+                CAST_S32(y) + mItemPadding,
+                selColor[0], selColor[1], "-", false));
+            x += CAST_U32(CAST_S32(
+                dashWidth) - 2);
         }
-        else if (mEnableImages && row.find("~~~", 0) == 0)
+
+        rowLayout.advance = fontHeight;
+        rowLayout.height = fontHeight;
+        return;
+    }
+    else if (mEnableImages && row.find("~~~", 0) == 0)
+    {
+        std::string str = row.substr(3);
+        const size_t sz = str.size();
+        if (sz > 2 && str.substr(sz - 1) == "~")
+            str = str.substr(0, sz - 1);
+        Image *const img = Loader::getImage(str);
+        rowLayout.advance = 0;
+        rowLayout.height = fontHeight;
+        if (img)
         {
-            std::string str = row.substr(3);
-            const size_t sz = str.size();
-            if (sz > 2 && str.substr(sz - 1) == "~")
-                str = str.substr(0, sz - 1);
-            Image *const img = Loader::getImage(str);
-            if (img)
-            {
-                img->incRef();
-                mLineParts.push_back(LinePart(CAST_S32(x),
-                    CAST_S32(y) + mItemPadding,
-                    selColor[0], selColor[1], img));
-                y += CAST_U32(img->getHeight() + 2);
-                moreHeight += img->getHeight();
-                if (img->getWidth() > maxWidth)
-                    maxWidth = img->getWidth() + 2;
-            }
-            continue;
+            img->incRef();
+            parts.push_back(LinePart(CAST_S32(x),
+                CAST_S32(y) + mItemPadding,
+                selColor[0], selColor[1], img));
+            rowLayout.advance = img->getHeight() + 2;
+            rowLayout.height += img->getHeight();
+            if (img->getWidth() > maxWidth)
+                maxWidth = img->getWidth() + 2;
         }
+        return;
+    }
 
-        Color prevColor[2];
-        prevColor[0] = selColor[0];
-        prevColor[1] = selColor[1];
-        bold = false;
+    Color prevColor[2];
+    prevColor[0] = selColor[0];
+    prevColor[1] = selColor[1];
+    bool bold = false;
 
-        const int xPadding = CAST_S32(mNewLinePadding) + mPadding;
+    const int xPadding = CAST_S32(mNewLinePadding) + mPadding;
 
-        for (size_t start = 0, end = std::string::npos;
-             start != std::string::npos;
-             start = end, end = std::string::npos)
-        {
-            bool processed(false);
+    for (size_t start = 0, end = std::string::npos;
+         start != std::string::npos;
+         start = end, end = std::string::npos)
+    {
+        bool processed(false);
 
-            // Wrapped line continuation shall be indented
-            if (wrapped)
-            {
-                y += CAST_U32(fontHeight);
-                x = CAST_U32(xPadding);
-                wrapped = false;
-            }
+        // Wrapped line continuation shall be indented
+        if (wrapped)
+        {
+            y += CAST_U32(fontHeight);
+            x = CAST_U32(xPadding);
+            wrapped = false;
+        }
 
-            size_t idx1 = end;
-            size_t idx2 = end;
+        size_t idx1 = end;
+        size_t idx2 = end;
 
-            // "Tokenize" the string at control sequences
-            if (mUseLinksAndUserColors)
-                idx1 = row.find("##", start + 1);
-            if (idx1 < idx2)
-                end = idx1;
-            else
-                end = idx2;
+        // "Tokenize" the string at control sequences
+        if (mUseLinksAndUserColors)
+            idx1 = row.find("##", start + 1);
+        if (idx1 < idx2)
+            end = idx1;
+        else
+            end = idx2;
 
-            if (start == 0 || mUseLinksAndUserColors)
+        if (start == 0 || mUseLinksAndUserColors)
+        {
+            // Check for color change in format "##x", x = [L,P,0..9]
+            if (row.find("##", start) == start && row.size() > start + 2)
             {
-                // Check for color change in format "##x", x = [L,P,0..9]
-                if (row.find("##", start) == start && row.size() > start + 2)
-                {
-                    const signed char c = row.at(start + 2);
+                const signed char c = row.at(start + 2);
 
-                    bool valid(false);
-                    const Color col[2] =
-                    {
-                        getThemeCharColor(c, valid),
-                        getThemeCharColor(CAST_S8(
-                            c | 0x80), valid)
-                    };
+                bool valid(false);
+                const Color col[2] =
+                {
+                    getThemeCharColor(c, valid),
+                    getThemeCharColor(CAST_S8(
+                        c | 0x80), valid)
+                };
 
-                    if (c == '>')
-                    {
-                        selColor[0] = prevColor[0];
-                        selColor[1] = prevColor[1];
-                    }
-                    else if (c == '<')
-                    {
-                        prevColor[0] = selColor[0];
-                        prevColor[1] = selColor[1];
-                        selColor[0] = col[0];
-                        selColor[1] = col[1];
-                    }
-                    else if (c == 'B')
-                    {
-                        bold = true;
-                    }
-                    else if (c == 'b')
+                if (c == '>')
+                {
+                    selColor[0] = prevColor[0];
+                    selColor[1] = prevColor[1];
+                }
+                else if (c == '<')
+                {
+                    prevColor[0] = selColor[0];
+                    prevColor[1] = selColor[1];
+                    selColor[0] = col[0];
+                    selColor[1] = col[1];
+                }
+                else if (c == 'B')
+                {
+                    bold = true;
+                }
+                else if (c == 'b')
+                {
+                    bold = false;
+                }
+                else if (valid)
+                {
+                    selColor[0] = col[0];
+                    selColor[1] = col[1];
+                }
+                else
+                {
+                    switch (c)
                     {
-                        bold = false;
+                        case '0':
+                            selColor[0] = mColors[0][BLACK];
+                            selColor[1] = mColors[1][BLACK];
+                            break;
+                        case '1':
+                            selColor[0] = mColors[0][RED];
+                            selColor[1] = mColors[1][RED];
+                            break;
+                        case '2':
+                            selColor[0] = mColors[0][GREEN];
+                            selColor[1] = mColors[1][GREEN];
+                            break;
+                        case '3':
+                            selColor[0] = mColors[0][BLUE];
+                            selColor[1] = mColors[1][BLUE];
+                            break;
+                        case '4':
+                            selColor[0] = mColors[0][ORANGE];
+                            selColor[1] = mColors[1][ORANGE];
+                            break;
+                        case '5':
+                            selColor[0] = mColors[0][YELLOW];
+                            selColor[1] = mColors[1][YELLOW];
+                            break;
+                        case '6':
+                            selColor[0] = mColors[0][PINK];
+                            selColor[1] = mColors[1][PINK];
+                            break;
+                        case '7':
+                            selColor[0] = mColors[0][PURPLE];
+                            selColor[1] = mColors[1][PURPLE];
+                            break;
+                        case '8':
+                            selColor[0] = mColors[0][GRAY];
+                            selColor[1] = mColors[1][GRAY];
+                            break;
+                        case '9':
+                            selColor[0] = mColors[0][BROWN];
+                            selColor[1] = mColors[1][BROWN];
+                            break;
+                        default:
+                            selColor[0] = textColor[0];
+                            selColor[1] = textColor[1];
+                            break;
                     }
-                    else if (valid)
+                }
+
+                if (c == '<' && link < linkEnd)
+                {
+                    int size;
+                    if (bold)
                     {
-                        selColor[0] = col[0];
-                        selColor[1] = col[1];
+                        size = boldFont->getWidth(
+                            mLinks[link].caption) + 1;
                     }
                     else
                     {
-                        switch (c)
-                        {
-                            case '0':
-                                selColor[0] = mColors[0][BLACK];
-                                selColor[1] = mColors[1][BLACK];
-                                break;
-                            case '1':
-                                selColor[0] = mColors[0][RED];
-                                selColor[1] = mColors[1][RED];
-                                break;
-                            case '2':
-                                selColor[0] = mColors[0][GREEN];
-                                selColor[1] = mColors[1][GREEN];
-                                break;
-                            case '3':
-                                selColor[0] = mColors[0][BLUE];
-                                selColor[1] = mColors[1][BLUE];
-                                break;
-                            case '4':
-                                selColor[0] = mColors[0][ORANGE];
-                                selColor[1] = mColors[1][ORANGE];
-                                break;
-                            case '5':
-                                selColor[0] = mColors[0][YELLOW];
-                                selColor[1] = mColors[1][YELLOW];
-                                break;
-                            case '6':
-                                selColor[0] = mColors[0][PINK];
-                                selColor[1] = mColors[1][PINK];
-                                break;
-                            case '7':
-                                selColor[0] = mColors[0][PURPLE];
-                                selColor[1] = mColors[1][PURPLE];
-                                break;
-                            case '8':
-                                selColor[0] = mColors[0][GRAY];
-                                selColor[1] = mColors[1][GRAY];
-                                break;
-                            case '9':
-                                selColor[0] = mColors[0][BROWN];
-                                selColor[1] = mColors[1][BROWN];
-                                break;
-                            default:
-                                selColor[0] = textColor[0];
-                                selColor[1] = textColor[1];
-                                break;
-                        }
-                    }
-
-                    if (c == '<' && link < CAST_S32(mLinks.size()))
-                    {
-                        int size;
-                        if (bold)
-                        {
-                            size = boldFont->getWidth(
-                                mLinks[CAST_SIZE(link)].caption) + 1;
-                        }
-                        else
-                        {
-                            size = font->getWidth(
-                                mLinks[CAST_SIZE(link)].caption) + 1;
-                        }
-
-                        BrowserLink &linkRef = mLinks[CAST_SIZE(
-                            link)];
-                        linkRef.x1 = CAST_S32(x);
-                        linkRef.y1 = CAST_S32(y);
-                        linkRef.x2 = linkRef.x1 + size;
-                        linkRef.y2 = CAST_S32(y) + fontHeight - 1;
-                        link++;
+                        size = font->getWidth(
+                            mLinks[link].caption) + 1;
                     }
 
-                    processed = true;
-                    start += 3;
-                    if (start == row.size())
-                        break;
+                    BrowserLink &linkRef = mLinks[link];
+                    linkRef.x1 = CAST_S32(x);
+                    linkRef.y1 = CAST_S32(y);
+                    linkRef.x2 = linkRef.x1 + size;
+                    linkRef.y2 = CAST_S32(y) + fontHeight - 1;
+                    link++;
                 }
+
+                processed = true;
+                start += 3;
+                if (start == row.size())
+                    break;
             }
-            if (mUseEmotes)
-                idx2 = row.find("%%", start + 1);
-            if (idx1 < idx2)
-                end = idx1;
-            else
-                end = idx2;
-            if (mUseEmotes)
+        }
+        if (mUseEmotes)
+            idx2 = row.find("%%", start + 1);
+        if (idx1 < idx2)
+            end = idx1;
+        else
+            end = idx2;
+        if (mUseEmotes)
+        {
+            // check for emote icons
+            if (row.size() > start + 2 && row.substr(start, 2) == "%%")
             {
-                // check for emote icons
-                if (row.size() > start + 2 && row.substr(start, 2) == "%%")
+                if (objects < 5)
                 {
-                    if (objects < 5)
+                    const int cid = row.at(start + 2) - '0';
+                    if (cid >= 0)
                     {
-                        const int cid = row.at(start + 2) - '0';
-                        if (cid >= 0)
+                        if (mEmotes)
                         {
-                            if (mEmotes)
+                            const size_t sz = mEmotes->size();
+                            if (CAST_SIZE(cid) < sz)
                             {
-                                const size_t sz = mEmotes->size();
-                                if (CAST_SIZE(cid) < sz)
+                                Image *const img = mEmotes->get(
+                                    CAST_SIZE(cid));
+                                if (img)
                                 {
-                                    Image *const img = mEmotes->get(
-                                        CAST_SIZE(cid));
-                                    if (img)
-                                    {
-                                        mLineParts.push_back(LinePart(
-                                            CAST_S32(x),
-                                            CAST_S32(y) + mItemPadding,
-                                            selColor[0], selColor[1], img));
-                                        x += 18;
-                                    }
+                                    parts.push_back(LinePart(
+                                        CAST_S32(x),
+                                        CAST_S32(y) + mItemPadding,
+                                        selColor[0], selColor[1], img));
+                                    x += 18;
                                 }
                             }
                         }
-                        objects ++;
-                        processed = true;
                     }
+                    objects ++;
+                    processed = true;
+                }
 
-                    start += 3;
-                    if (start == row.size())
-                    {
-                        if (x > mDataWidth)
-                            mDataWidth = x;
-                        break;
-                    }
+                start += 3;
+                if (start == row.size())
+                {
+                    if (x > mDataWidth)
+                        mDataWidth = x;
+                    break;
                 }
             }
-            const size_t len = (end == std::string::npos) ? end : end - start;
+        }
+        const size_t len = (end == std::string::npos) ? end : end - start;
 
-            if (start >= row.length())
-                break;
+        if (start >= row.length())
+            break;
 
-            std::string part = row.substr(start, len);
-            int width = 0;
-            if (bold)
-                width = boldFont->getWidth(part);
-            else
-                width = font->getWidth(part);
+        std::string part = row.substr(start, len);
+        int width = 0;
+        if (bold)
+            width = boldFont->getWidth(part);
+        else
+            width = font->getWidth(part);
+
+        // Auto wrap mode
+        if (mMode == AUTO_WRAP && wWidth > 0 && width > 0
+            && (x + CAST_U32(width) + 10) > wWidth)
+        {
+            bool forced = false;
 
-            // Auto wrap mode
-            if (mMode == AUTO_WRAP && wWidth > 0 && width > 0
-                && (x + CAST_U32(width) + 10) > wWidth)
+            /* FIXME: This code layout makes it easy to crash remote
+               clients by talking garbage. Forged long utf-8 characters
+               will cause either a buffer underflow in substr or an
+               infinite loop in the main loop. */
+            do
             {
-                bool forced = false;
+                if (!forced)
+                    end = row.rfind(' ', end);
 
-                /* FIXME: This code layout makes it easy to crash remote
-                   clients by talking garbage. Forged long utf-8 characters
-                   will cause either a buffer underflow in substr or an
-                   infinite loop in the main loop. */
-                do
+                // Check if we have to (stupidly) force-wrap
+                if (end == std::string::npos || end <= start)
                 {
-                    if (!forced)
-                        end = row.rfind(' ', end);
-
-                    // Check if we have to (stupidly) force-wrap
-                    if (end == std::string::npos || end <= start)
-                    {
-                        forced = true;
-                        end = row.size();
-                        x += CAST_U32(hyphenWidth);
-                        continue;
-                    }
-
-                    // Skip to the start of the current character
-                    while ((row[end] & 192) == 128)
-                        end--;
-                    end--;  // And then to the last byte of the previous one
-
-                    part = row.substr(start, end - start + 1);
-                    if (bold)
-                        width = boldFont->getWidth(part);
-                    else
-                        width = font->getWidth(part);
+                    forced = true;
+                    end = row.size();
+                    x += CAST_U32(hyphenWidth);
+                    continue;
                 }
-                while (end > start &&
-                       width > 0 &&
-                       (x + CAST_U32(width) + 10) > wWidth);
 
-                if (forced)
-                {
-                    x -= CAST_U32(hyphenWidth);
-                    mLineParts.push_back(LinePart(
-                        CAST_S32(wWidth) - hyphenWidth,
-                        CAST_S32(y) + mItemPadding,
-                        selColor[0], selColor[1], hyphen, bold));
-                    end++;  // Skip to the next character
-                }
+                // Skip to the start of the current character
+                while ((row[end] & 192) == 128)
+                    end--;
+                end--;  // And then to the last byte of the previous one
+
+                part = row.substr(start, end - start + 1);
+                if (bold)
+                    width = boldFont->getWidth(part);
                 else
-                {
-                    end += 2;  // Skip to after the space
-                }
+                    width = font->getWidth(part);
+            }
+            while (end > start &&
+                   width > 0 &&
+                   (x + CAST_U32(width) + 10) > wWidth);
 
-                wrapped = true;
-                wrappedLines++;
+            if (forced)
+            {
+                x -= CAST_U32(hyphenWidth);
+                parts.push_back(LinePart(
+                    CAST_S32(wWidth) - hyphenWidth,
+                    CAST_S32(y) + mItemPadding,
+                    selColor[0], selColor[1], hyphen, bold));
+                end++;  // Skip to the next character
+            }
+            else
+            {
+                end += 2;  // Skip to after the space
             }
 
-            mLineParts.push_back(LinePart(CAST_S32(x),
-                CAST_S32(y) + mItemPadding,
-                selColor[0], selColor[1], part.c_str(), bold));
+            wrapped = true;
+            wrappedLines ++;
+        }
 
-            if (bold)
-                width = boldFont->getWidth(part);
-            else
-                width = font->getWidth(part);
+        parts.push_back(LinePart(CAST_S32(x),
+            CAST_S32(y) + mItemPadding,
+            selColor[0], selColor[1], part.c_str(), bold));
 
-            if (mMode == AUTO_WRAP && (width == 0 && !processed))
-                break;
+        if (bold)
+            width = boldFont->getWidth(part);
+        else
+            width = font->getWidth(part);
 
-            x += CAST_U32(width);
-            if (x > mDataWidth)
-                mDataWidth = x;
-        }
-        y += CAST_U32(fontHeight);
-    }
-    if (CAST_S32(wWidth) != maxWidth)
-        setWidth(maxWidth);
+        if (mMode == AUTO_WRAP && (width == 0 && !processed))
+            break;
 
-    return (CAST_S32(mTextRows.size()) + wrappedLines)
-        * fontHeight + moreHeight + 2 * mPadding;
+        x += CAST_U32(width);
+        if (x > mDataWidth)
+            mDataWidth = x;
+    }
+    y += CAST_U32(fontHeight);
+    rowLayout.advance = CAST_S32(y) - rowLayout.y;
+    rowLayout.height = (1 + wrappedLines) * fontHeight;
 }
 
 void BrowserBox::updateHeight()
 {
-    if (mAlwaysUpdate || mUpdateTime != cur_time
-        || mTextRows.size() < 3 || !mUpdateTime)
+    if (mDimension.width != mWidth)
     {
-        mWidth = mDimension.width;
-        mHeight = calcHeight();
-        setHeight(mHeight);
-        mUpdateTime = cur_time;
+        // full layout is slow, so it limited if need
+        if (!mAlwaysUpdate && mUpdateTime == cur_time
+            && mTextRows.size() >= 3 && mUpdateTime)
+        {
+            return;
+        }
+        mLayoutCount = 0;
     }
+    mWidth = mDimension.width;
+    mHeight = calcHeight();
+    setHeight(mHeight);
+    mUpdateTime = cur_time;
 }
 
 std::string BrowserBox::getTextAtPos(const int x, const int y) const
@@ -1008,15 +1037,21 @@ std::string BrowserBox::getTextAtPos(const int x, const int y) const
     if (x < textX || y < textY)
         return std::string();
 
-    textY = y - textY;
+    textY = y - textY + mYOffset;
     std::string str;
-    int lastY = 0;
 
-    FOR_EACH (LinePartCIter, i, mLineParts)
+    // last row what starts before y
+    const RowCIter rowsEnd = mRows.begin() + mLayoutCount;
+    RowCIter it = std::upper_bound(mRows.begin(), rowsEnd,
+        textY, RowBelow());
+    if (it == mRows.begin())
+        return str;
+    -- it;
+
+    int lastY = it->y - 1;
+    FOR_EACH (LinePartCIter, i, it->parts)
     {
         const LinePart &part = *i;
-        if (part.mY + 50 < mYStart)
-            continue;
         if (part.mY > textY)
             break;
 
@@ -1039,6 +1074,7 @@ void BrowserBox::setForegroundColorAll(const Color &color1,
 {
     mForegroundColor = color1;
     mForegroundColor2 = color2;
+    mLayoutCount = 0;
 }
 
 void BrowserBox::moveSelectionUp()
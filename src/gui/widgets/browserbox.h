@@ -31,6 +31,8 @@
 #include "gui/widgets/linepart.h"
 #include "gui/widgets/widget.h"
 
+#include <deque>
+
 #include "localconsts.h"
 
 class LinkHandler;
@@ -55,6 +57,29 @@ struct BrowserLink final
     std::string caption;
 };
 
+/**
+ * Cached layout of one text row.
+ * Coordinates of parts is in layout space, what not changed
+ * when old rows removed from top.
+ */
+struct BrowserRow final
+{
+    BrowserRow() :
+        parts(),
+        y(0),
+        advance(0),
+        height(0),
+        linksCount(0)
+    {
+    }
+
+    std::vector<LinePart> parts;
+    int y;
+    int advance;
+    int height;
+    int linksCount;
+};
+
 /**
  * A simple browser box able to handle links and forward events to the
  * parent conteiner.
@@ -205,19 +230,30 @@ class BrowserBox final : public Widget,
         void selectSelection();
 
     private:
+        /**
+         * Layouts rows added after last call.
+         * All rows layouted again only if layout was reset.
+         */
         int calcHeight() A_WARN_UNUSED;
 
+        void layoutRow(const std::string &row,
+                       BrowserRow &rowLayout,
+                       const size_t firstLink,
+                       const unsigned int wWidth,
+                       int &maxWidth);
+
         typedef TextRows::iterator TextRowIterator;
         typedef TextRows::const_iterator TextRowCIter;
         TextRows mTextRows;
-        std::list<int> mTextRowLinksCount;
+
+        typedef std::deque<BrowserRow> Rows;
+        typedef Rows::const_iterator RowCIter;
+        Rows mRows;
 
         typedef std::vector<LinePart> LinePartList;
-        typedef LinePartList::iterator LinePartIterator;
         typedef LinePartList::const_iterator LinePartCIter;
-        LinePartList mLineParts;
 
-        typedef std::vector<BrowserLink> Links;
+        typedef std::deque<BrowserLink> Links;
         typedef Links::iterator LinkIterator;
         Links mLinks;
 
@@ -235,10 +271,19 @@ class BrowserBox final : public Widget,
         unsigned int mNewLinePadding;
         int mItemPadding;
         unsigned int mDataWidth;
+        // rows from begin what have valid layout
+        size_t mLayoutCount;
+        // layout y of next row
+        int mLayoutY;
+        // layout y of top of widget
+        int mYOffset;
+        int mRowsHeight;
 
         Color mHighlightColor;
         Color mHyperLinkColor;
         Color mColors[2][COLORS_MAX];
+        // text color after last layouted row
+        Color mLayoutColor[2];
 
         Opaque mOpaque;
         bool mUseLinksAndUserColors;
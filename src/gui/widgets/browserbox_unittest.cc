@@ -31,6 +31,8 @@
 
 #include "resources/sdlimagehelper.h"
 
+#include "utils/stringutils.h"
+
 #include <physfs.h>
 
 #include "debug.h"
@@ -148,6 +150,23 @@ TEST_CASE("BrowserBox tests", "browserbox")
     row = "##1%%2";
     box->addRow(row);
 
+    // old rows removed without layout of other rows
+    box->clearRows();
+    box->setMaxRow(5);
+    for (int f = 0; f < 20; f ++)
+        box->addRow("@@" + toString(f) + "|row " + toString(f) + "@@");
+    REQUIRE(box->getRows().size() == 5);
+    BrowserBox *const box2 = new BrowserBox(nullptr,
+        BrowserBox::AUTO_WRAP,
+        Opaque_true,
+        "");
+    box2->setWidth(100);
+    for (int f = 15; f < 20; f ++)
+        box2->addRow("@@" + toString(f) + "|row " + toString(f) + "@@");
+    REQUIRE(box->getHeight() == box2->getHeight());
+    REQUIRE(box->getRows().front() == box2->getRows().front());
+    delete box2;
+
     delete box;
     delete client;
     client = nullptr;
@@ -28,6 +28,8 @@
 
 #include "render/graphics.h"
 
+#include <algorithm>
+
 #include "debug.h"
 
 ExtendedListBox::ExtendedListBox(const Widget2 *const widget,
@@ -38,8 +40,10 @@ ExtendedListBox::ExtendedListBox(const Widget2 *const widget,
     mImagePadding(mSkin ? mSkin->getOption("imagePadding") : 0),
     mSpacing(mSkin ? mSkin->getOption("spacing") : 0),
     mHeight(0),
+    mLayoutWidth(-1),
     mListItems(),
-    mSelectedItems()
+    mSelectedItems(),
+    mRowsY()
 {
     if (rowHeight)
         mRowHeight = rowHeight;
@@ -69,20 +73,31 @@ void ExtendedListBox::draw(Graphics *const graphics)
         textPos = 0;
 
     const int sz = mListModel->getNumberOfElements();
+    const int insideWidth = width - pad2;
+    if (mLayoutWidth != width || mRowsY.size() != CAST_SIZE(sz + 1))
+    {
+        mLayoutWidth = width;
+        layoutRows(font, insideWidth);
+    }
+
+    // measure and draw only rows inside of clip area,
+    // one more row from each side for text what go out of own row
+    const ClipRect &clipRect = graphics->getTopClip();
+    const int top = clipRect.y - clipRect.yOffset - mPadding - height;
+    const int bottom = top + clipRect.height + 2 * height;
+    int firstRow = CAST_S32(std::upper_bound(mRowsY.begin(),
+        mRowsY.end() - 1, top) - mRowsY.begin()) - 1;
+    if (firstRow < 0)
+        firstRow = 0;
+
     mListItems.clear();
     mSelectedItems.clear();
-    int y = 0;
-    const int insideWidth = width - pad2;
-    for (int f = 0; f < sz; f ++)
+    for (int row = firstRow; row < sz && mRowsY[row] < bottom; row ++)
     {
-        int row = f;
+        int y = mRowsY[row];
         bool useImage = true;
-        std::string str = mListModel->getElementAt(f);
-        int strWidth = font->getWidth(str) + 8;
-
-        const Image *const image = model->getImageAt(row);
-        if (image)
-            strWidth += image->getWidth() + mImagePadding;
+        std::string str = mListModel->getElementAt(row);
+        const int strWidth = getStrWidth(font, str, row);
 
         std::vector<ExtendedListBoxItem> &list =
             row == mSelected ? mSelectedItems : mListItems;
@@ -113,8 +128,15 @@ void ExtendedListBox::draw(Graphics *const graphics)
         list.push_back(ExtendedListBoxItem(row, str, useImage, y));
 
         y += height;
+        // row text changed after layout
+        const int delta = y - mRowsY[row + 1];
+        if (delta)
+        {
+            for (int f = row + 1; f <= sz; f ++)
+                mRowsY[f] += delta;
+        }
     }
-    mHeight = y + height;
+    mHeight = mRowsY[sz] + height;
 
     const size_t itemsSz = mListItems.size();
     const size_t selSz = mSelectedItems.size();
@@ -217,6 +239,36 @@ void ExtendedListBox::draw(Graphics *const graphics)
     BLOCK_END("ExtendedListBox::draw")
 }
 
+int ExtendedListBox::getStrWidth(const Font *const font,
+                                 const std::string &str,
+                                 const int row) const
+{
+    int strWidth = font->getWidth(str) + 8;
+    const Image *const image = static_cast<ExtendedListModel*>(
+        mListModel)->getImageAt(row);
+    if (image)
+        strWidth += image->getWidth() + mImagePadding;
+    return strWidth;
+}
+
+void ExtendedListBox::layoutRows(const Font *const font,
+                                 const int insideWidth)
+{
+    const int height = CAST_S32(mRowHeight);
+    const int sz = mListModel->getNumberOfElements();
+    mRowsY.resize(sz + 1);
+    int y = 0;
+    for (int f = 0; f < sz; f ++)
+    {
+        mRowsY[f] = y;
+        // long rows splitted to two lines
+        if (insideWidth < getStrWidth(font, mListModel->getElementAt(f), f))
+            y += height;
+        y += height;
+    }
+    mRowsY[sz] = y;
+}
+
 void ExtendedListBox::safeDraw(Graphics *const graphics)
 {
     ExtendedListBox::draw(graphics);
@@ -232,26 +284,12 @@ void ExtendedListBox::adjustSize()
 
 int ExtendedListBox::getSelectionByMouse(const int y) const
 {
-    if (mListItems.empty() && mSelectedItems.empty())
+    if (mRowsY.size() < 2)
         return ListBox::getSelectionByMouse(y);
 
-    const int height = CAST_S32(mRowHeight);
-    const size_t itemsSz = mListItems.size();
-    for (size_t f = 0; f < itemsSz; f ++)
-    {
-        const ExtendedListBoxItem &item = mListItems[f];
-        const int y2 = item.y;
-        if (y2 <= y && y2 + height > y)
-            return item.row;
-    }
-
-    const size_t selSz = mSelectedItems.size();
-    for (size_t f = 0; f < selSz; f ++)
-    {
-        const ExtendedListBoxItem &item = mSelectedItems[f];
-        const int y2 = item.y;
-        if (y2 <= y && y2 + height > y)
-            return item.row;
-    }
-    return 0;
+    const int row = CAST_S32(std::upper_bound(mRowsY.begin(),
+        mRowsY.end(), y) - mRowsY.begin()) - 1;
+    if (row < 0 || row + 1 >= CAST_S32(mRowsY.size()))
+        return 0;
+    return row;
 }
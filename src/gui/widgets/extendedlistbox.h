@@ -51,11 +51,24 @@ class ExtendedListBox final : public ListBox
         int getSelectionByMouse(const int y) const override final;
 
     protected:
+        int getStrWidth(const Font *const font,
+                        const std::string &str,
+                        const int row) const A_WARN_UNUSED;
+
+        /**
+         * Measures all rows. Called only if rows count or width changed.
+         */
+        void layoutRows(const Font *const font,
+                        const int insideWidth);
+
         int mImagePadding;
         int mSpacing;
         int mHeight;
+        int mLayoutWidth;
         std::vector<ExtendedListBoxItem> mListItems;
         std::vector<ExtendedListBoxItem> mSelectedItems;
+        // y position of each row and total height at end
+        std::vector<int> mRowsY;
 };
 
 #endif  // GUI_WIDGETS_EXTENDEDLISTBOX_H
@@ -234,7 +234,6 @@ void GuiTable::draw(Graphics *const graphics)
     const Rect &rect = mDimension;
     const int width = rect.width;
     const int height = rect.height;
-    const int y = rect.y;
     if (mOpaque == Opaque_true)
     {
         mBackgroundColor.a = CAST_U32(mAlpha * 255.0F);
@@ -247,25 +246,20 @@ void GuiTable::draw(Graphics *const graphics)
     int rHeight = getRowHeight();
     if (!rHeight)
         rHeight = 1;
-    int first_row = -(y / rHeight);
+    // only rows inside of clip area is visible
+    const ClipRect &clipRect = graphics->getTopClip();
+    const int top = clipRect.y - clipRect.yOffset;
+    int first_row = top / rHeight;
 
     if (first_row < 0)
         first_row = 0;
 
-    unsigned int rows_nr = CAST_U32(1 +
-        height / rHeight);  // May overestimate by one.
-    unsigned int max_rows_nr;
-    if (mModel->getRows() < first_row)
-    {
-        max_rows_nr = 0U;
-    }
-    else
-    {
-        max_rows_nr = CAST_U32(
-            mModel->getRows() - first_row);  // clip if neccessary:
-    }
-    if (max_rows_nr < rows_nr)
-        rows_nr = max_rows_nr;
+    // May overestimate by one.
+    int last_row = (top + clipRect.height) / rHeight + 1;
+    if (last_row > mModel->getRows())
+        last_row = mModel->getRows();
+    const unsigned int rows_nr = last_row > first_row
+        ? CAST_U32(last_row - first_row) : 0U;
 
     // Now determine the first and last column
     // Take the easy way out; these are usually bounded and all visible.
@@ -352,7 +346,6 @@ void GuiTable::safeDraw(Graphics *const graphics)
     const Rect &rect = mDimension;
     const int width = rect.width;
     const int height = rect.height;
-    const int y = rect.y;
     if (mOpaque == Opaque_true)
     {
         mBackgroundColor.a = CAST_U32(mAlpha * 255.0F);
@@ -365,25 +358,20 @@ void GuiTable::safeDraw(Graphics *const graphics)
     int rHeight = getRowHeight();
     if (!rHeight)
         rHeight = 1;
-    int first_row = -(y / rHeight);
+    // only rows inside of clip area is visible
+    const ClipRect &clipRect = graphics->getTopClip();
+    const int top = clipRect.y - clipRect.yOffset;
+    int first_row = top / rHeight;
 
     if (first_row < 0)
         first_row = 0;
 
-    unsigned int rows_nr = CAST_U32(
-        1 + height / rHeight);  // May overestimate by one.
-    unsigned int max_rows_nr;
-    if (mModel->getRows() < first_row)
-    {
-        max_rows_nr = 0;
-    }
-    else
-    {
-        max_rows_nr = CAST_U32(
-            mModel->getRows() - first_row);  // clip if neccessary:
-    }
-    if (max_rows_nr < rows_nr)
-        rows_nr = max_rows_nr;
+    // May overestimate by one.
+    int last_row = (top + clipRect.height) / rHeight + 1;
+    if (last_row > mModel->getRows())
+        last_row = mModel->getRows();
+    const unsigned int rows_nr = last_row > first_row
+        ? CAST_U32(last_row - first_row) : 0U;
 
     // Now determine the first and last column
     // Take the easy way out; these are usually bounded and all visible.
@@ -64,145 +64,121 @@
 
 namespace
 {
-    class ItemIdPair final
+    /**
+     * Compares inventory slots for sorting.
+     * Empty slots and slots marked as empty always after items.
+     * Names must be set for all compared not empty slots.
+     */
+    class SortItemFunctor final
     {
         public:
-            ItemIdPair(const int id, Item *const item) :
-                mId(id), mItem(item)
+            SortItemFunctor(const Inventory *const inventory,
+                            const std::string *const *const names,
+                            const unsigned char *const emptySlots,
+                            const int sortType) :
+                mInventory(inventory),
+                mNames(names),
+                mEmptySlots(emptySlots),
+                mSortType(sortType)
             {
             }
 
-            int mId;
-            Item* mItem;
-    };
-
-    class SortItemAlphaFunctor final
-    {
-        public:
-            bool operator() (const ItemIdPair *const pair1,
-                             const ItemIdPair *const pair2) const
+            bool operator() (const int slot1,
+                             const int slot2) const
             {
-                const Item *const item1 = pair1->mItem;
-                const Item *const item2 = pair2->mItem;
+                const Item *const item1 = mEmptySlots[slot1] ?
+                    nullptr : mInventory->getItem(slot1);
+                const Item *const item2 = mEmptySlots[slot2] ?
+                    nullptr : mInventory->getItem(slot2);
                 if (!item1 || !item2)
-                    return false;
-
-                const std::string name1 = item1->getInfo().getName(
-                    item1->getColor());
-                const std::string name2 = item2->getInfo().getName(
-                    item2->getColor());
-                if (name1 == name2)
                 {
-                    return item1->getInvIndex() <
-                        item2->getInvIndex();
+                    if (item1 || item2)
+                        return item1 != nullptr;
+                    return slot1 < slot2;
                 }
-                return (name1 < name2);
-            }
-    } itemAlphaInvSorter;
 
-    class SortItemIdFunctor final
-    {
-        public:
-            bool operator() (const ItemIdPair *const pair1,
-                             const ItemIdPair *const pair2) const
-            {
-                if (!pair1->mItem || !pair2->mItem)
-                    return false;
-
-                const int id1 = pair1->mItem->getId();
-                const int id2 = pair2->mItem->getId();
-                if (id1 == id2)
+                const ItemInfo &info1 = item1->getInfo();
+                const ItemInfo &info2 = item2->getInfo();
+                switch (mSortType)
                 {
-                    return pair1->mItem->getInvIndex() <
-                        pair2->mItem->getInvIndex();
-                }
-                return id1 < id2;
-            }
-    } itemIdInvSorter;
-
-    class SortItemWeightFunctor final
-    {
-        public:
-            bool operator() (const ItemIdPair *const pair1,
-                             const ItemIdPair *const pair2) const
-            {
-                if (!pair1->mItem || !pair2->mItem)
-                    return false;
-
-                const int w1 = pair1->mItem->getInfo().getWeight();
-                const int w2 = pair2->mItem->getInfo().getWeight();
-                if (w1 == w2)
-                {
-                    const std::string name1 =
-                        pair1->mItem->getInfo().getName();
-                    const std::string name2 =
-                        pair2->mItem->getInfo().getName();
-                    if (name1 == name2)
+                    case 1:
+                    default:
+                        break;
+                    case 2:
                     {
-                        return pair1->mItem->getInvIndex() <
-                            pair2->mItem->getInvIndex();
+                        const int id1 = item1->getId();
+                        const int id2 = item2->getId();
+                        if (id1 != id2)
+                            return id1 < id2;
+                        return slot1 < slot2;
+                    }
+                    case 3:
+                    {
+                        const int w1 = info1.getWeight();
+                        const int w2 = info2.getWeight();
+                        if (w1 != w2)
+                            return w1 < w2;
+                        break;
+                    }
+                    case 4:
+                    {
+                        const int c1 = item1->getQuantity();
+                        const int c2 = item2->getQuantity();
+                        if (c1 != c2)
+                            return c1 < c2;
+                        break;
+                    }
+                    case 5:
+                    {
+                        const ItemDbTypeT t1 = info1.getType();
+                        const ItemDbTypeT t2 = info2.getType();
+                        if (t1 != t2)
+                            return t1 < t2;
+                        break;
                     }
-                    return (name1 < name2);
                 }
-                return w1 < w2;
+
+                // alpha sort use names with colors
+                const std::string &name1 = mSortType == 1 ?
+                    *mNames[slot1] : info1.getName();
+                const std::string &name2 = mSortType == 1 ?
+                    *mNames[slot2] : info2.getName();
+                const int cmp = name1.compare(name2);
+                if (cmp != 0)
+                    return cmp < 0;
+                return slot1 < slot2;
             }
-    } itemWeightInvSorter;
 
-    class SortItemAmountFunctor final
+        private:
+            const Inventory *const mInventory;
+            const std::string *const *const mNames;
+            const unsigned char *const mEmptySlots;
+            const int mSortType;
+    };
+
+    /**
+     * Reverse order comparator, for find unsorted neighbours.
+     */
+    class InvertSortItemFunctor final
     {
         public:
-            bool operator() (const ItemIdPair *const pair1,
-                             const ItemIdPair *const pair2) const
+            explicit InvertSortItemFunctor(const SortItemFunctor &sorter) :
+                mSorter(sorter)
             {
-                if (!pair1->mItem || !pair2->mItem)
-                    return false;
-
-                const int c1 = pair1->mItem->getQuantity();
-                const int c2 = pair2->mItem->getQuantity();
-                if (c1 == c2)
-                {
-                    const std::string name1 =
-                        pair1->mItem->getInfo().getName();
-                    const std::string name2 =
-                        pair2->mItem->getInfo().getName();
-                    if (name1 == name2)
-                    {
-                        return pair1->mItem->getInvIndex() <
-                            pair2->mItem->getInvIndex();
-                    }
-                    return (name1 < name2);
-                }
-                return c1 < c2;
             }
-    } itemAmountInvSorter;
 
-    class SortItemTypeFunctor final
-    {
-        public:
-            bool operator() (const ItemIdPair *const pair1,
-                             const ItemIdPair *const pair2) const
+            bool operator() (const int slot1,
+                             const int slot2) const
             {
-                if (!pair1->mItem || !pair2->mItem)
-                    return false;
-
-                const ItemInfo &info1 = pair1->mItem->getInfo();
-                const ItemInfo &info2 = pair2->mItem->getInfo();
-                const ItemDbTypeT t1 = info1.getType();
-                const ItemDbTypeT t2 = info2.getType();
-                if (t1 == t2)
-                {
-                    const std::string name1 = info1.getName();
-                    const std::string name2 = info2.getName();
-                    if (name1 == name2)
-                    {
-                        return pair1->mItem->getInvIndex() <
-                            pair2->mItem->getInvIndex();
-                    }
-                    return (name1 < name2);
-                }
-                return t1 < t2;
+                return mSorter(slot2, slot1);
             }
-    } itemTypeInvSorter;
+
+        private:
+            const SortItemFunctor &mSorter;
+    };
+
+    // max new items what inserted in sorted items one by one
+    const size_t maxInsertItems = 8;
 }  // namespace
 
 ItemContainer::ItemContainer(const Widget2 *const widget,
@@ -219,7 +195,14 @@ ItemContainer::ItemContainer(const Widget2 *const widget,
     mProtectedImg(Theme::getImageFromTheme("lock.png")),
     mCellBackgroundImg(Theme::getImageFromThemeXml("inventory_cell.xml", "")),
     mName(),
+    mShownItems(),
+    mNewItems(),
+    mSlotMarks(),
+    mEmptySlots(),
+    mSortNames(),
+    mColorNames(),
     mShowMatrix(nullptr),
+    mShowMatrixSize(0),
     mSkin(theme ? theme->load("itemcontainer.xml", "") : nullptr),
     mVertexes(new ImageCollection),
     mEquipedColor(getThemeColor(ThemeColorId::ITEM_EQUIPPED)),
@@ -1068,91 +1051,129 @@ void ItemContainer::updateMatrix()
         return;
 
     mRedraw = true;
-    delete []mShowMatrix;
-    mShowMatrix = new int[CAST_SIZE(mGridRows * mGridColumns)];
-
-    std::vector<ItemIdPair*> sortedItems;
-    int i = 0;
-    int j = 0;
-
-    std::string temp = mName;
-    toLower(temp);
+    const size_t maxSize = CAST_SIZE(mGridRows * mGridColumns);
+    if (!mShowMatrix || mShowMatrixSize != maxSize)
+    {
+        delete []mShowMatrix;
+        mShowMatrix = new int[maxSize];
+        mShowMatrixSize = maxSize;
+    }
 
+    // buffers keep capacity between updates
     const unsigned int invSize = mInventory->getSize();
+    mNewItems.clear();
+    mSlotMarks.assign(invSize, SLOT_HIDDEN);
+    mEmptySlots.assign(invSize, 0U);
     for (unsigned int idx = 0; idx < invSize; idx ++)
     {
-        Item *const item = mInventory->getItem(idx);
+        const Item *const item = mInventory->getItem(idx);
 
         if (!item || item->getId() == 0 || !item->isHaveTag(mTag))
         {
             if (mShowEmptyRows == ShowEmptyRows_true)
-                sortedItems.push_back(new ItemIdPair(idx, nullptr));
+            {
+                mNewItems.push_back(idx);
+                mSlotMarks[idx] = SLOT_NEW;
+                // slot shown as empty, even if have not matched item
+                mEmptySlots[idx] = 1U;
+            }
             continue;
         }
 
-        if (!item->isHaveTag(mTag))
-            continue;
-
-        if (mName.empty())
+        if (!mName.empty() &&
+            item->getInfo().getLowerName().find(mName) == std::string::npos)
         {
-            sortedItems.push_back(new ItemIdPair(idx, item));
             continue;
         }
-        std::string name = item->getInfo().getName();
-        toLower(name);
-        if (name.find(temp) != std::string::npos)
-            sortedItems.push_back(new ItemIdPair(idx, item));
+        mNewItems.push_back(idx);
+        mSlotMarks[idx] = SLOT_NEW;
     }
 
-    switch (mSortType)
+    if (mSortType < 1 || mSortType > 5)
     {
-        case 0:
-        default:
-            break;
-        case 1:
-            std::sort(sortedItems.begin(), sortedItems.end(),
-                itemAlphaInvSorter);
-            break;
-        case 2:
-            std::sort(sortedItems.begin(), sortedItems.end(), itemIdInvSorter);
-            break;
-        case 3:
-            std::sort(sortedItems.begin(), sortedItems.end(),
-                itemWeightInvSorter);
-            break;
-        case 4:
-            std::sort(sortedItems.begin(), sortedItems.end(),
-                itemAmountInvSorter);
-            break;
-        case 5:
-            std::sort(sortedItems.begin(), sortedItems.end(),
-                itemTypeInvSorter);
-            break;
+        mShownItems.swap(mNewItems);
+    }
+    else
+    {
+        sortItems();
     }
 
-    int jMult = j * mGridColumns;
-    const int maxSize = mGridRows * mGridColumns;
-    FOR_EACH (std::vector<ItemIdPair*>::const_iterator, iter, sortedItems)
+    const size_t sz = std::min(mShownItems.size(), maxSize);
+    for (size_t idx = 0; idx < sz; idx ++)
+        mShowMatrix[idx] = mShownItems[idx];
+    for (size_t idx = sz; idx < maxSize; idx ++)
+        mShowMatrix[idx] = -1;
+}
+
+void ItemContainer::sortItems()
+{
+    const unsigned int invSize = mInventory->getSize();
+    if (!invSize)
     {
-        if (jMult >= maxSize)
-            break;
+        mShownItems.clear();
+        return;
+    }
+    if (mSortNames.size() < invSize)
+    {
+        mSortNames.resize(invSize);
+        mColorNames.resize(invSize);
+    }
+    FOR_EACH (std::vector<int>::const_iterator, it, mNewItems)
+    {
+        const int idx = *it;
+        const Item *const item = mInventory->getItem(idx);
+        if (!item || mEmptySlots[idx])
+            continue;
+        const ItemInfo &info = item->getInfo();
+        const std::string &name = info.getName();
+        // name with color placeholders need replace for each color
+        if (name.find('%') == std::string::npos)
+        {
+            mSortNames[idx] = &name;
+        }
+        else
+        {
+            mColorNames[idx] = info.getName(item->getColor());
+            mSortNames[idx] = &mColorNames[idx];
+        }
+    }
 
-        mShowMatrix[jMult + i] = (*iter)->mId;
+    const SortItemFunctor sorter(mInventory, &mSortNames[0],
+        &mEmptySlots[0], mSortType);
 
-        i ++;
-        if (i >= mGridColumns)
+    // items from previous update what still shown keep order
+    size_t kept = 0;
+    for (size_t f = 0, sz = mShownItems.size(); f < sz; f ++)
+    {
+        const int idx = mShownItems[f];
+        if (idx < CAST_S32(invSize) && mSlotMarks[idx] == SLOT_NEW)
         {
-            i = 0;
-            j ++;
-            jMult += mGridColumns;
+            mSlotMarks[idx] = SLOT_KEPT;
+            mShownItems[kept] = idx;
+            kept ++;
         }
     }
+    mShownItems.resize(kept);
+    const size_t added = mNewItems.size() - kept;
 
-    for (int idx = j * mGridColumns + i; idx < maxSize; idx ++)
-        mShowMatrix[idx] = -1;
+    if (added > maxInsertItems ||
+        std::adjacent_find(mShownItems.begin(), mShownItems.end(),
+        InvertSortItemFunctor(sorter)) != mShownItems.end())
+    {
+        mShownItems.swap(mNewItems);
+        std::sort(mShownItems.begin(), mShownItems.end(), sorter);
+        return;
+    }
 
-    for (size_t idx = 0, sz = sortedItems.size(); idx < sz; idx ++)
-        delete sortedItems[idx];
+    // few items changed, so insert it without full sort
+    FOR_EACH (std::vector<int>::const_iterator, it, mNewItems)
+    {
+        const int idx = *it;
+        if (mSlotMarks[idx] != SLOT_NEW)
+            continue;
+        mShownItems.insert(std::upper_bound(mShownItems.begin(),
+            mShownItems.end(), idx, sorter), idx);
+    }
 }
 
 int ItemContainer::getSlotIndex(int x, int y) const
@@ -1198,6 +1219,12 @@ void ItemContainer::setFilter(const int tag)
     updateMatrix();
 }
 
+void ItemContainer::setName(const std::string &str)
+{
+    mName = str;
+    toLower(mName);
+}
+
 void ItemContainer::setSortType(const int sortType)
 {
     mSortType = sortType;
@@ -128,8 +128,10 @@ class ItemContainer final : public Widget,
 
         void setSortType(const int sortType);
 
-        void setName(const std::string &str)
-        { mName = str; }
+        /**
+         * Sets name filter. Filter is case insensitive.
+         */
+        void setName(const std::string &str);
 
         void updateMatrix();
 
@@ -192,13 +194,36 @@ class ItemContainer final : public Widget,
 
         int getSlotByXY(int x, int y) const;
 
+        /**
+         * Sorts slots from mNewItems to mShownItems.
+         * Order of previous update reused if only few slots changed.
+         */
+        void sortItems();
+
+        enum SlotMark
+        {
+            SLOT_HIDDEN = 0,
+            SLOT_NEW = 1,
+            SLOT_KEPT = 2
+        };
+
         Inventory *mInventory;
         Image *mSelImg;
         Image *mProtectedImg;
         Image *mCellBackgroundImg;
+        // lower case name filter
         std::string mName;
 
+        std::vector<int> mShownItems;
+        std::vector<int> mNewItems;
+        std::vector<unsigned char> mSlotMarks;
+        // shown slots with items what not match tag
+        std::vector<unsigned char> mEmptySlots;
+        std::vector<const std::string*> mSortNames;
+        std::vector<std::string> mColorNames;
+
         int *mShowMatrix;
+        size_t mShowMatrixSize;
         Skin *mSkin;
         ImageCollection *mVertexes;
         Color mEquipedColor;
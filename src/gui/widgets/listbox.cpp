@@ -164,11 +164,17 @@ void ListBox::draw(Graphics *const graphics)
     Font *const font = getFont();
     const int rowHeight = CAST_S32(getRowHeight());
     const int width = mDimension.width;
+    int firstRow;
+    int lastRow;
+    getVisibleRows(graphics, rowHeight, mListModel->getNumberOfElements(),
+        firstRow, lastRow);
+    const bool selectedVisible = mSelected >= firstRow
+        && mSelected < lastRow;
 
     if (mCenterText)
     {
         // Draw filled rectangle around the selected list element
-        if (mSelected >= 0)
+        if (selectedVisible)
         {
             graphics->fillRectangle(Rect(mPadding,
                 rowHeight * mSelected + mPadding,
@@ -183,9 +189,8 @@ void ListBox::draw(Graphics *const graphics)
                 mSelected * rowHeight + mPadding + mItemPadding);
         }
         // Draw the list elements
-        const int sz = mListModel->getNumberOfElements();
-        for (int i = 0, y = mPadding + mItemPadding;
-             i < sz; ++i, y += rowHeight)
+        for (int i = firstRow, y = mPadding + mItemPadding
+             + firstRow * rowHeight; i < lastRow; ++i, y += rowHeight)
         {
             if (i != mSelected)
             {
@@ -201,7 +206,7 @@ void ListBox::draw(Graphics *const graphics)
     else
     {
         // Draw filled rectangle around the selected list element
-        if (mSelected >= 0)
+        if (selectedVisible)
         {
             graphics->fillRectangle(Rect(mPadding,
                 rowHeight * mSelected + mPadding,
@@ -216,9 +221,8 @@ void ListBox::draw(Graphics *const graphics)
                 mSelected * rowHeight + mPadding + mItemPadding);
         }
         // Draw the list elements
-        const int sz = mListModel->getNumberOfElements();
-        for (int i = 0, y = mPadding + mItemPadding; i < sz;
-             ++i, y += rowHeight)
+        for (int i = firstRow, y = mPadding + mItemPadding
+             + firstRow * rowHeight; i < lastRow; ++i, y += rowHeight)
         {
             if (i != mSelected)
             {
@@ -234,6 +238,29 @@ void ListBox::draw(Graphics *const graphics)
     BLOCK_END("ListBox::draw")
 }
 
+void ListBox::getVisibleRows(const Graphics *const graphics,
+                             const int rowHeight,
+                             const int rowsCount,
+                             int &restrict first,
+                             int &restrict last) const
+{
+    if (rowHeight <= 0)
+    {
+        first = 0;
+        last = rowsCount;
+        return;
+    }
+    const ClipRect &clipRect = graphics->getTopClip();
+    const int top = clipRect.y - clipRect.yOffset - mPadding;
+    // one more row from each side for text what go out of own row
+    first = top / rowHeight - 1;
+    if (first < 0)
+        first = 0;
+    last = (top + clipRect.height) / rowHeight + 2;
+    if (last > rowsCount)
+        last = rowsCount;
+}
+
 void ListBox::keyPressed(KeyEvent &event)
 {
     const InputActionT action = event.getActionId();
@@ -253,6 +253,16 @@ class ListBox notfinal : public Widget,
         void distributeValueChangedEvent();
 
     protected:
+        /**
+         * Gets range of rows what can be visible in current clip area.
+         * Rows from first to last - 1 should be drawn.
+         */
+        void getVisibleRows(const Graphics *const graphics,
+                            const int rowHeight,
+                            const int rowsCount,
+                            int &restrict first,
+                            int &restrict last) const A_NONNULL(2);
+
         /**
          * The selected item as an index in the list model.
          */
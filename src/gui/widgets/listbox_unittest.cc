@@ -0,0 +1,187 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "catch.hpp"
+#include "client.h"
+#include "graphicsmanager.h"
+#include "logger.h"
+
+#include "being/actorsprite.h"
+
+#include "gui/theme.h"
+
+#include "gui/fonts/font.h"
+
+#include "gui/models/extendedlistmodel.h"
+
+#include "gui/widgets/extendedlistbox.h"
+
+#include "render/sdlgraphics.h"
+
+#include "resources/sdlimagehelper.h"
+
+#include "resources/resourcemanager/resourcemanager.h"
+
+#include "utils/delete2.h"
+#include "utils/env.h"
+#include "utils/physfstools.h"
+#include "utils/stringutils.h"
+
+#include "debug.h"
+
+namespace
+{
+    // list model what count requested rows
+    class TestListModel final : public ExtendedListModel
+    {
+        public:
+            explicit TestListModel(const int size) :
+                mSize(size),
+                mCalls(0)
+            {
+            }
+
+            A_DELETE_COPY(TestListModel)
+
+            int getNumberOfElements() override final
+            { return mSize; }
+
+            std::string getElementAt(int i) override final
+            {
+                mCalls ++;
+                if (i % 100 == 0)
+                    return strprintf("long row %d %s", i, std::string(
+                        200, 'w').c_str());
+                return strprintf("row %d", i);
+            }
+
+            const Image *getImageAt(int i A_UNUSED) override final
+            {
+                return nullptr;
+            }
+
+            int mSize;
+            int mCalls;
+    };
+
+    // draw box like scroll area do it
+    void drawBox(ListBox *const box,
+                 const int scroll)
+    {
+        mainGraphics->pushClipArea(Rect(0, 0, 640, 480));
+        mainGraphics->pushClipArea(Rect(0, -scroll,
+            box->getWidth(), box->getHeight()));
+        box->draw(mainGraphics);
+        mainGraphics->popClipArea();
+        mainGraphics->popClipArea();
+    }
+}  // namespace
+
+TEST_CASE("ListBox virtualized draw", "listbox")
+{
+    setEnv("SDL_VIDEODRIVER", "dummy");
+
+    client = new Client;
+    PHYSFS_init("manaplus");
+    dirSeparator = "/";
+    SDL_Init(SDL_INIT_VIDEO);
+    logger = new Logger();
+    ResourceManager::init();
+    resourceManager->addToSearchPath("data", Append_false);
+    resourceManager->addToSearchPath("../data", Append_false);
+    mainGraphics = new SDLGraphics;
+    imageHelper = new SDLImageHelper;
+#ifdef USE_SDL2
+    SDLImageHelper::setRenderer(graphicsManager.createRenderer(
+        graphicsManager.createWindow(640, 480, 0,
+        SDL_WINDOW_SHOWN | SDL_SWSURFACE), SDL_RENDERER_SOFTWARE));
+#else  // USE_SDL2
+
+    graphicsManager.createWindow(640, 480, 0, SDL_ANYFORMAT | SDL_SWSURFACE);
+#endif  // USE_SDL2
+
+    ActorSprite::load();
+    theme = new Theme;
+    Widget::setGlobalFont(new Font("/usr/share/fonts/truetype/"
+        "ttf-dejavu/DejaVuSans-Oblique.ttf", 18));
+    mainGraphics->setVideoMode(640, 480, 1, 8, false, false, false, false);
+
+    const int rows = 100000;
+    TestListModel *const model = new TestListModel(rows);
+
+    SECTION("ListBox")
+    {
+        ListBox *const box = new ListBox(nullptr, model, "");
+        box->setWidth(300);
+        box->adjustSize();
+        box->setSelected(rows / 2);
+        const int rowHeight = CAST_S32(box->getRowHeight());
+        REQUIRE(box->getHeight() >= rows * rowHeight);
+
+        // benchmark: scroll over whole list
+        const int frames = 1000;
+        const uint32_t startTime = SDL_GetTicks();
+        for (int f = 0; f < frames; f ++)
+            drawBox(box, (rows * rowHeight / frames) * f);
+        logger->log("ListBox %d rows, %d frames: %u ms", rows, frames,
+            SDL_GetTicks() - startTime);
+        // only rows inside of clip area requested
+        REQUIRE(model->mCalls <= frames * (480 / rowHeight + 5));
+
+        model->mCalls = 0;
+        drawBox(box, rows / 2 * rowHeight);
+        REQUIRE(model->mCalls > 0);
+        REQUIRE(model->mCalls <= 480 / rowHeight + 5);
+        delete box;
+    }
+
+    SECTION("ExtendedListBox")
+    {
+        ExtendedListBox *const box = new ExtendedListBox(nullptr,
+            model, "", 20);
+        box->setWidth(300);
+        drawBox(box, 0);
+        box->adjustSize();
+        // every 100 row splitted to two lines
+        REQUIRE(box->getHeight() >= (rows + rows / 100) * 20);
+        REQUIRE(box->getSelectionByMouse(0) == 0);
+        REQUIRE(box->getSelectionByMouse(20 * 2) == 1);
+        REQUIRE(box->getSelectionByMouse(20 * 102) == 100);
+        REQUIRE(box->getSelectionByMouse(20 * 103) == 101);
+
+        // benchmark: scroll over whole list
+        model->mCalls = 0;
+        const int frames = 1000;
+        const int height = box->getHeight();
+        const uint32_t startTime = SDL_GetTicks();
+        for (int f = 0; f < frames; f ++)
+            drawBox(box, height / frames * f);
+        logger->log("ExtendedListBox %d rows, %d frames: %u ms",
+            rows, frames, SDL_GetTicks() - startTime);
+        // only rows inside of clip area requested
+        REQUIRE(model->mCalls <= frames * (480 / 20 + 5));
+        delete box;
+    }
+
+    delete model;
+    delete2(theme);
+    delete2(client);
+}
@@ -132,7 +132,7 @@ void ProgressBar::logic()
             mBackgroundColor.g--;
         if (mBackgroundColorToGo.b < mBackgroundColor.b)
             mBackgroundColor.b--;
-        mRedraw = true;
+        setRedraw(true);
     }
 
     if (mSmoothProgress && mProgressToGo != mProgress)
@@ -142,7 +142,7 @@ void ProgressBar::logic()
             mProgress = std::min(1.0F, mProgress + 0.005F);
         if (mProgressToGo < mProgress)
             mProgress = std::max(0.0F, mProgress - 0.005F);
-        mRedraw = true;
+        setRedraw(true);
     }
     BLOCK_END("ProgressBar::logic")
 }
@@ -308,7 +308,7 @@ void ProgressBar::setProgress(const float progress)
 {
     const float p = std::min(1.0F, std::max(0.0F, progress));
     mProgressToGo = p;
-    mRedraw = true;
+    setRedraw(true);
 
     if (!mSmoothProgress)
         mProgress = p;
@@ -324,7 +324,7 @@ void ProgressBar::setProgressPalette(const ProgressColorIdT progressPalette)
 {
     const ProgressColorIdT oldPalette = mProgressPalette;
     mProgressPalette = progressPalette;
-    mRedraw = true;
+    setRedraw(true);
 
     if (mProgressPalette != oldPalette &&
         mProgressPalette >= ProgressColorId::PROG_HP)
@@ -336,7 +336,7 @@ void ProgressBar::setProgressPalette(const ProgressColorIdT progressPalette)
 
 void ProgressBar::setBackgroundColor(const Color &color)
 {
-    mRedraw = true;
+    setRedraw(true);
     mBackgroundColorToGo = color;
 
     if (!mSmoothColorChange)
@@ -352,12 +352,12 @@ void ProgressBar::setColor(const Color &color1, const Color &color2)
 
 void ProgressBar::widgetResized(const Event &event A_UNUSED)
 {
-    mRedraw = true;
+    setRedraw(true);
 }
 
 void ProgressBar::widgetMoved(const Event &event A_UNUSED)
 {
-    mRedraw = true;
+    setRedraw(true);
 }
 
 void ProgressBar::setText(const std::string &str)
@@ -21,6 +21,8 @@
 
 #include "gui/widgets/progressindicator.h"
 
+#include "settings.h"
+
 #include "gui/gui.h"
 
 #include "resources/imageset.h"
@@ -66,8 +68,8 @@ ProgressIndicator::~ProgressIndicator()
 void ProgressIndicator::logic()
 {
     BLOCK_START("ProgressIndicator::logic")
-    if (mIndicator)
-        mIndicator->update(10);
+    if (mIndicator && mIndicator->update(10))
+        settings.needRedraw = true;
     BLOCK_END("ProgressIndicator::logic")
 }
 
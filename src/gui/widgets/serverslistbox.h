@@ -58,9 +58,13 @@ class ServersListBox final : public ListBox
 
             const int height = getRowHeight();
             mNotSupportedColor.a = CAST_S32(mAlpha * 255.0F);
+            int firstRow;
+            int lastRow;
+            getVisibleRows(graphics, height, model->getNumberOfElements(),
+                firstRow, lastRow);
 
             // Draw filled rectangle around the selected list element
-            if (mSelected >= 0)
+            if (mSelected >= firstRow && mSelected < lastRow)
             {
                 graphics->fillRectangle(Rect(mPadding,
                     height * mSelected + mPadding,
@@ -75,7 +79,7 @@ class ServersListBox final : public ListBox
             const int pad2 = height / 4 + mPadding;
             const int width = getWidth();
             // Draw the list elements
-            for (int i = 0, y = 0; i < model->getNumberOfElements();
+            for (int i = firstRow, y = firstRow * height; i < lastRow;
                  ++i, y += height)
             {
                 const ServerInfo &info = model->getServer(i);
@@ -101,9 +101,14 @@ class SkillListBox final : public ListBox
 
             const int width1 = getWidth();
             const int usableWidth = width1 - 2 * mPadding;
+            const int rowHeight = CAST_S32(getRowHeight());
+            int firstRow;
+            int lastRow;
+            getVisibleRows(graphics, rowHeight,
+                model->getNumberOfElements(), firstRow, lastRow);
 
             // Draw filled rectangle around the selected list element
-            if (mSelected >= 0)
+            if (mSelected >= firstRow && mSelected < lastRow)
             {
                 graphics->fillRectangle(Rect(mPadding, getRowHeight()
                     * mSelected + mPadding, usableWidth,
@@ -116,9 +121,9 @@ class SkillListBox final : public ListBox
             const int width2 = width1 - mPadding;
 
             graphics->setColor(mCooldownColor);
-            for (int i = 0, y = 1 + mPadding;
-                 i < model->getNumberOfElements();
-                 ++i, y += getRowHeight())
+            for (int i = firstRow, y = 1 + mPadding + firstRow * rowHeight;
+                 i < lastRow;
+                 ++i, y += rowHeight)
             {
                 SkillInfo *const e = model->getSkillAt(i);
                 if (e)
@@ -131,9 +136,9 @@ class SkillListBox final : public ListBox
                 }
             }
 
-            for (int i = 0, y = 1 + mPadding;
-                 i < model->getNumberOfElements();
-                 ++i, y += getRowHeight())
+            for (int i = firstRow, y = 1 + mPadding + firstRow * rowHeight;
+                 i < lastRow;
+                 ++i, y += rowHeight)
             {
                 SkillInfo *const e = model->getSkillAt(i);
                 if (e)
@@ -74,6 +74,7 @@ ChatTab::ChatTab(const Widget2 *const widget,
     mScrollArea(new ScrollArea(this, mTextOutput, Opaque_false)),
     mChannelName(channel),
     mLogName(logName),
+    mLogLoadId(-1),
     mType(type),
     mAllowHightlight(true),
     mRemoveNames(false),
@@ -100,6 +101,8 @@ ChatTab::~ChatTab()
 {
     if (chatWindow)
         chatWindow->removeTab(this);
+    if (chatLogger && mLogLoadId >= 0)
+        chatLogger->cancelLoad(mLogLoadId);
 
     delete2(mTextOutput);
     delete2(mScrollArea);
@@ -475,7 +478,8 @@ void ChatTab::saveToLogFile(const std::string &msg) const
     }
 }
 
-void ChatTab::addRow(std::string &line)
+void ChatTab::addRow(std::string &line,
+                     const bool atTop)
 {
     if (line.find("[@@http") == std::string::npos)
     {
@@ -493,22 +497,37 @@ void ChatTab::addRow(std::string &line)
             }
         }
     }
-    mTextOutput->addRow(line);
+    mTextOutput->addRow(line, atTop);
 }
 
 void ChatTab::loadFromLogFile(const std::string &name)
 {
     if (chatLogger)
     {
-        std::list<std::string> list;
-        chatLogger->loadLast(name, list, 5);
-        std::list<std::string>::const_iterator i = list.begin();
-        while (i != list.end())
-        {
-            std::string line("##o" + *i);
-            addRow(line);
-            ++i;
-        }
+        if (mLogLoadId >= 0)
+            chatLogger->cancelLoad(mLogLoadId);
+        mLogLoadId = chatLogger->loadLastAsync(name, 5);
+    }
+}
+
+void ChatTab::loadLogic()
+{
+    if (mLogLoadId < 0 || !chatLogger)
+        return;
+
+    std::list<std::string> list;
+    if (!chatLogger->getLoaded(mLogLoadId, list))
+        return;
+    mLogLoadId = -1;
+
+    // new messages can be added while log loading
+    const bool atTop = mTextOutput->hasRows();
+    if (atTop)
+        list.reverse();
+    FOR_EACH (std::list<std::string>::const_iterator, i, list)
+    {
+        std::string line("##o" + *i);
+        addRow(line, atTop);
     }
 }
 
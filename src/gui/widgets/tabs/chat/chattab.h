@@ -149,8 +149,14 @@ class ChatTab notfinal : public Tab
         bool hasRows() const A_WARN_UNUSED
         { return mTextOutput->hasRows(); }
 
+        /**
+         * Starts loading of last lines of log file.
+         * Lines added to tab by loadLogic after loading.
+         */
         void loadFromLogFile(const std::string &name);
 
+        void loadLogic();
+
         bool getAllowHighlight() const A_WARN_UNUSED
         { return mAllowHightlight; }
 
@@ -198,12 +204,14 @@ class ChatTab notfinal : public Tab
         virtual void getAutoCompleteCommands(StringVect&) const
         {}
 
-        void addRow(std::string &line);
+        void addRow(std::string &line,
+                    const bool atTop = false);
 
         BrowserBox *mTextOutput A_NONNULLPOINTER;
         ScrollArea *mScrollArea;
         std::string mChannelName;
         std::string mLogName;
+        int mLogLoadId;
         ChatTabTypeT mType;
         bool mAllowHightlight;
         bool mRemoveNames;
@@ -23,6 +23,7 @@
 #include "gui/widgets/tabs/debugwindowtabs.h"
 
 #include "game.h"
+#include "settings.h"
 
 #include "being/localplayer.h"
 
@@ -30,9 +31,12 @@
 
 #include "gui/viewport.h"
 
+#include "gui/widgets/browserbox.h"
+#include "gui/widgets/button.h"
 #include "gui/widgets/containerplacer.h"
 #include "gui/widgets/label.h"
 #include "gui/widgets/layouthelper.h"
+#include "gui/widgets/scrollarea.h"
 
 #ifdef USE_OPENGL
 #include "resources/imagehelper.h"
@@ -41,6 +45,7 @@
 #include "resources/map/map.h"
 
 #include "net/packetcounters.h"
+#include "net/packetstatistics.h"
 
 #include "utils/gettext.h"
 #include "utils/stringutils.h"
@@ -452,7 +457,8 @@ NetDebugTab::NetDebugTab(const Widget2 *const widget) :
     DebugTab(widget),
     mPingLabel(new Label(this, "                ")),
     mInPackets1Label(new Label(this, "                ")),
-    mOutPackets1Label(new Label(this, "                "))
+    mOutPackets1Label(new Label(this, "                ")),
+    mOutLatencyLabel(new Label(this, "                "))
 {
     LayoutHelper h(this);
     ContainerPlacer place = h.getPlacer(0, 0);
@@ -460,6 +466,7 @@ NetDebugTab::NetDebugTab(const Widget2 *const widget) :
     place(0, 0, mPingLabel, 2);
     place(0, 1, mInPackets1Label, 2);
     place(0, 2, mOutPackets1Label, 2);
+    place(0, 3, mOutLatencyLabel, 2);
 
     place.getCell().matchColWidth(0, 0);
     place = h.getPlacer(0, 1);
@@ -486,5 +493,79 @@ void NetDebugTab::logic()
     // TRANSLATORS: debug window label
     mOutPackets1Label->setCaption(strprintf(_("Out: %d bytes/s"),
         PacketCounters::getOutBytes()));
+    // TRANSLATORS: debug window label
+    mOutLatencyLabel->setCaption(strprintf(_("Send delay: %d ms"),
+        PacketCounters::getOutLatency()));
     BLOCK_END("NetDebugTab::logic")
 }
+
+PacketsDebugTab::PacketsDebugTab(const Widget2 *const widget) :
+    DebugTab(widget),
+    ActionListener(),
+    mBrowserBox(new BrowserBox(this, BrowserBox::AUTO_SIZE, Opaque_true,
+        "browserbox.xml")),
+    mScrollArea(new ScrollArea(this, mBrowserBox,
+        Opaque_false, "debug_packets_background.xml")),
+    // TRANSLATORS: debug window button
+    mSaveButton(new Button(this, _("Save CSV"), "save", this)),
+    // TRANSLATORS: debug window button
+    mResetButton(new Button(this, _("Reset"), "reset", this)),
+    mUpdateTime(0)
+{
+    mBrowserBox->setOpaque(Opaque_false);
+    mScrollArea->setHorizontalScrollPolicy(ScrollArea::SHOW_NEVER);
+
+    LayoutHelper h(this);
+    ContainerPlacer place = h.getPlacer(0, 0);
+
+    place(0, 0, mScrollArea, 4, 6).setPadding(3);
+    place(0, 6, mSaveButton);
+    place(1, 6, mResetButton);
+    setDimension(Rect(0, 0, 600, 300));
+}
+
+void PacketsDebugTab::logic()
+{
+    BLOCK_START("PacketsDebugTab::logic")
+    if (mUpdateTime == cur_time)
+    {
+        BLOCK_END("PacketsDebugTab::logic")
+        return;
+    }
+    mUpdateTime = cur_time;
+
+    std::vector<const PacketStatistic*> stats;
+    PacketStatistics::getSorted(stats);
+    mBrowserBox->clearRows();
+    const size_t sz = std::min(stats.size(), CAST_SIZE(30));
+    for (size_t f = 0; f < sz; f ++)
+    {
+        const PacketStatistic *const stat = stats[f];
+        // TRANSLATORS: debug window packet statistic line
+        mBrowserBox->addRow(strprintf(_("0x%04x %s: %u packets, "
+            "%u bytes, %u us, max %u us"),
+            stat->id,
+            stat->name ? stat->name : "",
+            stat->count,
+            stat->bytes,
+            CAST_U32(stat->time),
+            CAST_U32(stat->maxTime)));
+    }
+    mBrowserBox->updateHeight();
+    BLOCK_END("PacketsDebugTab::logic")
+}
+
+void PacketsDebugTab::action(const ActionEvent &event)
+{
+    const std::string &eventId = event.getId();
+    if (eventId == "save")
+    {
+        PacketStatistics::saveCsv(settings.localDataDir
+            + "/packets.csv");
+    }
+    else if (eventId == "reset")
+    {
+        PacketStatistics::clear();
+        mUpdateTime = 0;
+    }
+}
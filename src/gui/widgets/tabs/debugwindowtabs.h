@@ -25,7 +25,12 @@
 
 #include "gui/widgets/container.h"
 
+#include "listeners/actionlistener.h"
+
+class BrowserBox;
+class Button;
 class Label;
+class ScrollArea;
 
 class DebugTab notfinal : public Container
 {
@@ -124,6 +129,29 @@ class NetDebugTab final : public DebugTab
         Label *mPingLabel A_NONNULLPOINTER;
         Label *mInPackets1Label A_NONNULLPOINTER;
         Label *mOutPackets1Label A_NONNULLPOINTER;
+        Label *mOutLatencyLabel A_NONNULLPOINTER;
+};
+
+class PacketsDebugTab final : public DebugTab,
+                              public ActionListener
+{
+    friend class DebugWindow;
+
+    public:
+        explicit PacketsDebugTab(const Widget2 *const widget);
+
+        A_DELETE_COPY(PacketsDebugTab)
+
+        void logic() override final;
+
+        void action(const ActionEvent &event) override final;
+
+    private:
+        BrowserBox *mBrowserBox A_NONNULLPOINTER;
+        ScrollArea *mScrollArea A_NONNULLPOINTER;
+        Button *mSaveButton A_NONNULLPOINTER;
+        Button *mResetButton A_NONNULLPOINTER;
+        time_t mUpdateTime;
 };
 
 #endif  // GUI_WIDGETS_TABS_DEBUGWINDOWTABS_H
@@ -180,6 +180,10 @@ Setup_Other::Setup_Other(const Widget2 *const widget) :
     new SetupItemCheckBox(_("Auto resize minimaps"), "", "autoresizeminimaps",
         this, "autoresizeminimapsEvent");
 
+    // TRANSLATORS: settings option
+    new SetupItemIntTextField(_("Minimap dots update delay (ms)"), "",
+        "minimapDotsDelay", this, "minimapDotsDelayEvent", 0, 2000);
+
     // TRANSLATORS: settings option
     new SetupItemCheckBox(_("Play map animations"), "", "playMapAnimations",
         this, "playMapAnimationsEvent");
@@ -352,6 +356,10 @@ Setup_Other::Setup_Other(const Widget2 *const widget) :
     new SetupItemTextField(_("Proxy address:port"), "",
         "downloadProxy", this, "downloadProxyEvent");
 
+    // TRANSLATORS: settings option
+    new SetupItemIntTextField(_("Parallel update downloads"), "",
+        "updateDownloads", this, "updateDownloadsEvent", 1, 10);
+
 
     // TRANSLATORS: settings group
     new SetupItemLabel(_("Other"), "", this);
@@ -411,6 +419,10 @@ Setup_Other::Setup_Other(const Widget2 *const widget) :
     new SetupItemCheckBox(_("Low traffic mode"), "", "lowTraffic",
         this, "lowTrafficEvent");
 
+    // TRANSLATORS: settings option
+    new SetupItemCheckBox(_("Save players names cache"), "",
+        "saveBeingCache", this, "saveBeingCacheEvent");
+
 #ifndef ANDROID
     // TRANSLATORS: settings option
     new SetupItemCheckBox(_("Use FBO for screenshots (only for opengl)"),
@@ -429,6 +441,10 @@ Setup_Other::Setup_Other(const Widget2 *const widget) :
     new SetupItemIntTextField(_("Network delay between sub servers"),
         "", "networksleep", this, "networksleepEvent", 0, 10000);
 
+    // TRANSLATORS: settings option
+    new SetupItemIntTextField(_("Network send delay (ms)"),
+        "", "networkFlushDelay", this, "networkFlushDelayEvent", 0, 1000);
+
     // TRANSLATORS: settings option
     new SetupItemCheckBox(_("Show background"), "", "showBackground",
         this, "showBackgroundEvent");
@@ -67,12 +67,12 @@ Setup_Perfomance::Setup_Perfomance(const Widget2 *const widget) :
         "adjustPerfomance", this, "adjustPerfomanceEvent");
 
     // TRANSLATORS: settings option
-    new SetupItemCheckBox(_("Hw acceleration"), "",
-        "hwaccel", this, "hwaccelEvent");
+    new SetupItemCheckBox(_("Skip drawing and sleep if nothing changed"), "",
+        "idleSleep", this, "idleSleepEvent");
 
     // TRANSLATORS: settings option
-    new SetupItemCheckBox(_("Enable opacity cache (Software, can "
-        "use much memory)"), "", "alphaCache", this, "alphaCacheEvent");
+    new SetupItemCheckBox(_("Hw acceleration"), "",
+        "hwaccel", this, "hwaccelEvent");
 
 #ifndef USE_SDL2
     // TRANSLATORS: settings option
@@ -84,6 +84,14 @@ Setup_Perfomance::Setup_Perfomance(const Widget2 *const widget) :
     new SetupItemCheckBox(_("Enable compound sprite delay (Software)"), "",
         "enableCompoundSpriteDelay", this, "enableCompoundSpriteDelayEvent");
 
+    // TRANSLATORS: settings option
+    new SetupItemCheckBox(_("Reduce updates for beings outside of screen"),
+        "", "enableBeingLod", this, "enableBeingLodEvent");
+
+    // TRANSLATORS: settings option
+    new SetupItemCheckBox(_("Preload maps behind nearest warp"),
+        "", "enableMapPrefetch", this, "enableMapPrefetchEvent");
+
     // TRANSLATORS: settings option
     new SetupItemCheckBox(_("Enable delayed images load (OpenGL)"), "",
         "enableDelayedAnimations", this, "enableDelayedAnimationsEvent");
@@ -156,10 +164,14 @@ Setup_Perfomance::Setup_Perfomance(const Widget2 *const widget) :
         "uselonglivespritesEvent");
 
     // TRANSLATORS: settings option
-    new SetupItemCheckBox(_("Cache all sounds (can use additional memory)"),
-        "", "uselonglivesounds", this,
+    new SetupItemCheckBox(_("Keep unused sounds in cache (can use "
+        "additional memory)"), "", "uselonglivesounds", this,
         "uselonglivesoundsEvent");
 
+    // TRANSLATORS: settings option
+    new SetupItemIntTextField(_("Sound effects cache size (KiB)"), "",
+        "sfxCacheSize", this, "sfxCacheSizeEvent", 256, 1048576);
+
     // TRANSLATORS: settings group
     new SetupItemLabel(_("Critical options (DO NOT change if you don't "
         "know what you're doing)"), "", this);
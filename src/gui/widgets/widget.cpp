@@ -67,6 +67,8 @@
 
 #include "gui/widgets/widget.h"
 
+#include "settings.h"
+
 #include "gui/focushandler.h"
 
 #include "listeners/actionlistener.h"
@@ -513,6 +515,14 @@ void Widget::showPart(const Rect &rectangle)
 void Widget::windowResized()
 {
     mRedraw = true;
+    settings.needRedraw = true;
+}
+
+void Widget::setRedraw(const bool b) noexcept2
+{
+    mRedraw = b;
+    if (b)
+        settings.needRedraw = true;
 }
 
 Widget *Widget::callPostInit(Widget *const widget)
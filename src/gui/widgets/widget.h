@@ -1020,8 +1020,7 @@ class Widget notfinal : public Widget2
         bool isMouseConsume() const noexcept2 A_WARN_UNUSED
         { return mMouseConsume; }
 
-        void setRedraw(const bool b) noexcept2
-        { mRedraw = b; }
+        void setRedraw(const bool b) noexcept2;
 
         virtual bool isSelectable() const A_WARN_UNUSED
         { return mSelectable; }
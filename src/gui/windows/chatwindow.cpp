@@ -1310,6 +1310,25 @@ void ChatWindow::postConnection()
         chatHandler->joinChannel(langChatTab->getChannelName());
 }
 
+void ChatWindow::slowLogic()
+{
+    BLOCK_START("ChatWindow::slowLogic")
+    if (!mChatTabs)
+    {
+        BLOCK_END("ChatWindow::slowLogic")
+        return;
+    }
+    const int sz = mChatTabs->getNumberOfTabs();
+    for (int f = 0; f < sz; f ++)
+    {
+        ChatTab *const tab = dynamic_cast<ChatTab*>(
+            mChatTabs->getTabByIndex(f));
+        if (tab)
+            tab->loadLogic();
+    }
+    BLOCK_END("ChatWindow::slowLogic")
+}
+
 #define changeColor(fun) \
     { \
         msg = removeColors(msg); \
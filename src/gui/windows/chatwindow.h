@@ -304,6 +304,11 @@ class ChatWindow final : public Window,
 
         void postConnection();
 
+        /**
+         * Adds loaded log lines to tabs.
+         */
+        void slowLogic();
+
         void showGMTab();
 
         void debugMessage(const std::string &msg) override final;
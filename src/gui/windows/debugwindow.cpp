@@ -44,7 +44,8 @@ DebugWindow::DebugWindow() :
     mTabs(CREATEWIDGETR(TabbedArea, this)),
     mMapWidget(new MapDebugTab(this)),
     mTargetWidget(new TargetDebugTab(this)),
-    mNetWidget(new NetDebugTab(this))
+    mNetWidget(new NetDebugTab(this)),
+    mPacketsWidget(new PacketsDebugTab(this))
 {
     setWindowName("Debug");
     if (setupWindow)
@@ -66,6 +67,8 @@ DebugWindow::DebugWindow() :
     mTabs->addTab(std::string(_("Target")), mTargetWidget);
     // TRANSLATORS: debug window tab
     mTabs->addTab(std::string(_("Net")), mNetWidget);
+    // TRANSLATORS: debug window tab
+    mTabs->addTab(std::string(_("Packets")), mPacketsWidget);
 
     mTabs->setDimension(Rect(0, 0, 600, 300));
 
@@ -74,6 +77,7 @@ DebugWindow::DebugWindow() :
     mMapWidget->resize(w, h);
     mTargetWidget->resize(w, h);
     mNetWidget->resize(w, h);
+    mPacketsWidget->resize(w, h);
     loadWindowState();
     enableVisibleSound(true);
 }
@@ -83,6 +87,7 @@ DebugWindow::~DebugWindow()
     delete2(mMapWidget);
     delete2(mTargetWidget);
     delete2(mNetWidget);
+    delete2(mPacketsWidget);
 }
 
 void DebugWindow::postInit()
@@ -112,6 +117,9 @@ void DebugWindow::slowLogic()
         case 2:
             mNetWidget->logic();
             break;
+        case 3:
+            mPacketsWidget->logic();
+            break;
     }
 
     if (localPlayer)
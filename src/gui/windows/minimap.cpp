@@ -40,32 +40,91 @@
 
 #include "gui/windows/setupwindow.h"
 
+#include "render/vertexes/imagecollection.h"
+
 #include "resources/imagehelper.h"
 
 #include "resources/image/image.h"
 
 #include "resources/map/map.h"
-#include "resources/map/metatile.h"
+#include "resources/map/minimapcache.h"
 
 #include "resources/loaders/imageloader.h"
 
+#include "utils/delete2.h"
+#include "utils/dtor.h"
 #include "utils/gettext.h"
 #include "utils/physfstools.h"
 #include "utils/sdlcheckutils.h"
+#include "utils/timer.h"
 
 #include "debug.h"
 
 Minimap *minimap = nullptr;
 bool Minimap::mShow = true;
 
+namespace
+{
+    struct DotType final
+    {
+        UserColorIdT color;
+        int size;
+    };
+
+    // dot images placed in one image, so all dots drawn in one batch
+    const DotType dotTypes[] =
+    {
+        { UserColorId::SELF, 3 },
+        { UserColorId::GM, 2 },
+        { UserColorId::GUILD, 2 },
+        { UserColorId::MONSTER, 2 },
+        { UserColorId::NPC, 2 },
+        { UserColorId::PORTAL_HIGHLIGHT, 2 },
+        { UserColorId::PET, 2 },
+        { UserColorId::MERCENARY, 2 },
+        { UserColorId::HOMUNCULUS, 2 },
+        { UserColorId::SKILLUNIT, 2 },
+        { UserColorId::PARTY, 2 }
+    };
+    const int dotTypesCount = CAST_S32(sizeof(dotTypes) / sizeof(DotType));
+    const int dotCellSize = 3;
+
+    enum DotKind
+    {
+        DOT_SELF = 0,
+        DOT_GM = 1,
+        DOT_GUILD = 2,
+        DOT_MONSTER = 3,
+        DOT_NPC = 4,
+        DOT_PORTAL = 5,
+        DOT_PET = 6,
+        DOT_MERCENARY = 7,
+        DOT_HOMUNCULUS = 8,
+        DOT_SKILLUNIT = 9,
+        DOT_PARTY = 10
+    };
+}  // namespace
+
 Minimap::Minimap() :
     // TRANSLATORS: mini map window name
     Window(_("Map"), Modal_false, nullptr, "map.xml"),
     mWidthProportion(0.5),
     mHeightProportion(0.5),
     mMapImage(nullptr),
+    mMapCache(nullptr),
+    mDotsVertexes(new ImageCollection),
+    mDotsImage(nullptr),
+    mDotImages(),
+    mDotColors(),
+    mDots(),
+    mDotsTime(-1),
+    mDotsDelay(config.getIntValue("minimapDotsDelay")),
+    mDotsX(0),
+    mDotsY(0),
     mMapOriginX(0),
     mMapOriginY(0),
+    mZoomLevel(0),
+    mDotsChanged(true),
     mCustomMapImage(false),
     mAutoResize(config.getBoolValue("autoresizeminimaps"))
 {
@@ -73,6 +132,7 @@ Minimap::Minimap() :
     mShow = config.getValueBool(getWindowName() + "Show", true);
 
     config.addListener("autoresizeminimaps", this);
+    config.addListener("minimapDotsDelay", this);
 
     setDefaultSize(5, 25, 100, 100);
     // set this to false as the minimap window size is changed
@@ -98,6 +158,8 @@ Minimap::~Minimap()
     config.removeListeners(this);
     CHECKLISTENERS
     deleteMapImage();
+    deleteDotImages();
+    delete2(mDotsVertexes);
 }
 
 void Minimap::deleteMapImage()
@@ -110,6 +172,18 @@ void Minimap::deleteMapImage()
             mMapImage->decRef();
         mMapImage = nullptr;
     }
+    delete2(mMapCache);
+}
+
+void Minimap::deleteDotImages()
+{
+    // sub images must be deleted before parent image
+    delete_all(mDotImages);
+    mDotImages.clear();
+    delete2(mDotsImage);
+    mDotColors.clear();
+    mDotsVertexes->clear();
+    mDotsChanged = true;
 }
 
 void Minimap::setMap(const Map *const map)
@@ -133,45 +207,10 @@ void Minimap::setMap(const Map *const map)
     {
         if (config.getBoolValue("showExtMinimaps"))
         {
-            SDL_Surface *const surface = MSDL_CreateRGBSurface(SDL_SWSURFACE,
-                map->getWidth(), map->getHeight(), 32,
-                0x00ff0000, 0x0000ff00, 0x000000ff, 0x00000000);
-            if (!surface)
-            {
-                if (!isSticky())
-                    setVisible(Visible_false);
-                BLOCK_END("Minimap::setMap")
-                return;
-            }
-
-            // I'm not sure if the locks are necessary since it's a SWSURFACE
-            SDL_LockSurface(surface);
-            int* data = static_cast<int*>(surface->pixels);
-            if (!data)
-            {
-                if (!isSticky())
-                    setVisible(Visible_false);
-                BLOCK_END("Minimap::setMap")
-                return;
-            }
-            const int size = surface->h * surface->w;
-            const int mask = (BlockMask::WALL |
-                BlockMask::AIR |
-                BlockMask::WATER |
-                BlockMask::PLAYERWALL);
-
-            for (int ptr = 0; ptr < size; ptr ++)
-            {
-                *(data ++) = (map->mMetaTiles[ptr].blockmask & mask) ?
-                    0x0 : 0x00ffffff;
-            }
-
-            SDL_UnlockSurface(surface);
-
-            mMapImage = imageHelper->loadSurface(surface);
-            mMapImage->setAlpha(settings.guiAlpha);
+            // minimap tiles generated in worker thread
+            mMapCache = new MinimapCache(map);
+            mMapCache->start();
             mCustomMapImage = true;
-            MSDL_FreeSurface(surface);
         }
         else
         {
@@ -199,30 +238,37 @@ void Minimap::setMap(const Map *const map)
         }
     }
 
-    if (mMapImage && map)
+    int imageWidth = 0;
+    int imageHeight = 0;
+    if (mMapImage)
     {
-        const int width = mMapImage->mBounds.w + 2 * getPadding();
-        const int height = mMapImage->mBounds.h
-            + getTitleBarHeight() + getPadding();
-        const int mapWidth = mMapImage->mBounds.w < 100 ? width : 100;
-        const int mapHeight = mMapImage->mBounds.h < 100 ? height : 100;
-        const int minWidth = mapWidth > 310 ? 310 : mapWidth;
-        const int minHeight = mapHeight > 220 ? 220 : mapHeight;
+        imageWidth = mMapImage->mBounds.w;
+        imageHeight = mMapImage->mBounds.h;
+    }
+    else if (mMapCache)
+    {
+        if (mZoomLevel >= MinimapCache::levels)
+            mZoomLevel = MinimapCache::levels - 1;
+        imageWidth = mMapCache->getWidth(mZoomLevel);
+        imageHeight = mMapCache->getHeight(mZoomLevel);
+    }
+    mDotsChanged = true;
+    mDots.clear();
+    mDotsTime = -1;
 
-        setMinWidth(minWidth);
-        setMinHeight(minHeight);
+    if (imageWidth && imageHeight && map)
+    {
+        setSizeLimits(imageWidth, imageHeight);
 
         mWidthProportion = static_cast<float>(
-                mMapImage->mBounds.w) / static_cast<float>(map->getWidth());
+                imageWidth) / static_cast<float>(map->getWidth());
         mHeightProportion = static_cast<float>(
-                mMapImage->mBounds.h) / static_cast<float>(map->getHeight());
+                imageHeight) / static_cast<float>(map->getHeight());
 
-        setMaxWidth(width);
-        setMaxHeight(height);
         if (mAutoResize)
         {
-            setWidth(width);
-            setHeight(height);
+            setWidth(getMaxWidth());
+            setHeight(getMaxHeight());
         }
 
         const Rect &rect = mDimension;
@@ -240,6 +286,49 @@ void Minimap::setMap(const Map *const map)
     BLOCK_END("Minimap::setMap")
 }
 
+void Minimap::setSizeLimits(const int imageWidth,
+                            const int imageHeight)
+{
+    const int width = imageWidth + 2 * getPadding();
+    const int height = imageHeight + getTitleBarHeight() + getPadding();
+    const int mapWidth = imageWidth < 100 ? width : 100;
+    const int mapHeight = imageHeight < 100 ? height : 100;
+    const int minWidth = mapWidth > 310 ? 310 : mapWidth;
+    const int minHeight = mapHeight > 220 ? 220 : mapHeight;
+
+    setMinWidth(minWidth);
+    setMinHeight(minHeight);
+    setMaxWidth(width);
+    setMaxHeight(height);
+}
+
+void Minimap::setZoomLevel(const int level)
+{
+    if (!mMapCache ||
+        level < 0 ||
+        level >= MinimapCache::levels ||
+        level == mZoomLevel)
+    {
+        return;
+    }
+    mZoomLevel = level;
+    const int imageWidth = mMapCache->getWidth(level);
+    const int imageHeight = mMapCache->getHeight(level);
+    setSizeLimits(imageWidth, imageHeight);
+    mWidthProportion = static_cast<float>(imageWidth)
+        / static_cast<float>(mMapCache->getWidth(0));
+    mHeightProportion = static_cast<float>(imageHeight)
+        / static_cast<float>(mMapCache->getHeight(0));
+    if (mAutoResize)
+    {
+        setWidth(getMaxWidth());
+        setHeight(getMaxHeight());
+    }
+    // dots positions depend on zoom
+    mDotsTime = -1;
+    mDots.clear();
+}
+
 void Minimap::toggle()
 {
     setVisible(fromBool(!isWindowVisible(), Visible), isSticky());
@@ -251,7 +340,7 @@ void Minimap::draw(Graphics *const graphics)
     BLOCK_START("Minimap::draw")
 
     Window::draw(graphics);
-    draw2(graphics);
+    draw2(graphics, true);
 }
 
 void Minimap::safeDraw(Graphics *const graphics)
@@ -259,10 +348,81 @@ void Minimap::safeDraw(Graphics *const graphics)
     BLOCK_START("Minimap::draw")
 
     Window::safeDraw(graphics);
-    draw2(graphics);
+    draw2(graphics, false);
 }
 
-void Minimap::draw2(Graphics *const graphics)
+void Minimap::drawMapImage(Graphics *const graphics,
+                           const Rect &area)
+{
+    int w = 0;
+    int h = 0;
+    if (mMapImage)
+    {
+        const SDL_Rect &rect = mMapImage->mBounds;
+        w = rect.w;
+        h = rect.h;
+    }
+    else if (mMapCache)
+    {
+        w = mMapCache->getWidth(mZoomLevel);
+        h = mMapCache->getHeight(mZoomLevel);
+    }
+    else
+    {
+        return;
+    }
+
+    if (w > area.width || h > area.height)
+    {
+        mMapOriginX = (area.width / 2) - (localPlayer->mPixelX +
+            viewport->getCameraRelativeX() * mWidthProportion) / 32;
+
+        mMapOriginY = (area.height / 2) - (localPlayer->mPixelY +
+            viewport->getCameraRelativeY() * mHeightProportion) / 32;
+
+        const int minOriginX = area.width - w;
+        const int minOriginY = area.height - h;
+
+        if (mMapOriginX < minOriginX)
+            mMapOriginX = minOriginX;
+        if (mMapOriginY < minOriginY)
+            mMapOriginY = minOriginY;
+        if (mMapOriginX > 0)
+            mMapOriginX = 0;
+        if (mMapOriginY > 0)
+            mMapOriginY = 0;
+    }
+
+    if (mMapImage)
+    {
+        graphics->drawImage(mMapImage, mMapOriginX, mMapOriginY);
+        return;
+    }
+
+    if (!mMapCache->update(settings.guiAlpha))
+        return;
+
+    // draw only visible tiles
+    const MinimapTiles &tiles = mMapCache->getTiles(mZoomLevel);
+    FOR_EACH (MinimapTilesCIter, it, tiles)
+    {
+        const MinimapTile *const tile = *it;
+        const int x = tile->x + mMapOriginX;
+        const int y = tile->y + mMapOriginY;
+        if (!tile->image ||
+            x >= area.width ||
+            y >= area.height ||
+            x + tile->width <= 0 ||
+            y + tile->height <= 0)
+        {
+            continue;
+        }
+        graphics->drawImage(tile->image, x, y);
+    }
+}
+
+void Minimap::draw2(Graphics *const graphics,
+                    const bool batched)
 {
     if (!userPalette || !localPlayer || !viewport)
     {
@@ -283,34 +443,54 @@ void Minimap::draw2(Graphics *const graphics)
     mMapOriginX = 0;
     mMapOriginY = 0;
 
-    if (mMapImage)
-    {
-        const SDL_Rect &rect = mMapImage->mBounds;
-        const int w = rect.w;
-        const int h = rect.h;
-        if (w > a.width || h > a.height)
-        {
-            mMapOriginX = (a.width / 2) - (localPlayer->mPixelX +
-                viewport->getCameraRelativeX() * mWidthProportion) / 32;
-
-            mMapOriginY = (a.height / 2) - (localPlayer->mPixelY +
-                viewport->getCameraRelativeY() * mHeightProportion) / 32;
-
-            const int minOriginX = a.width - w;
-            const int minOriginY = a.height - h;
-
-            if (mMapOriginX < minOriginX)
-                mMapOriginX = minOriginX;
-            if (mMapOriginY < minOriginY)
-                mMapOriginY = minOriginY;
-            if (mMapOriginX > 0)
-                mMapOriginX = 0;
-            if (mMapOriginY > 0)
-                mMapOriginY = 0;
-        }
+    drawMapImage(graphics, a);
 
-        graphics->drawImage(mMapImage, mMapOriginX, mMapOriginY);
+    if (mDotsTime == -1 || get_elapsed_time(mDotsTime) >= mDotsDelay)
+        updateDots();
+    drawDots(graphics, batched);
+
+    const int gw = graphics->getWidth();
+    const int gh = graphics->getHeight();
+    int x = (localPlayer->mPixelX - (gw / 2)
+        + viewport->getCameraRelativeX())
+        * mWidthProportion / 32 + mMapOriginX;
+    int y = (localPlayer->mPixelY - (gh / 2)
+        + viewport->getCameraRelativeY())
+        * mHeightProportion / 32 + mMapOriginY;
+
+    const int w = CAST_S32(static_cast<float>(
+        gw) * mWidthProportion / 32);
+    const int h = CAST_S32(static_cast<float>(
+        gh) * mHeightProportion / 32);
+
+    if (w <= a.width)
+    {
+        if (x < 0 && w)
+            x = 0;
+        if (x + w > a.width)
+            x = a.width - w;
     }
+    if (h <= a.height)
+    {
+        if (y < 0 && h)
+            y = 0;
+        if (y + h > a.height)
+            y = a.height - h;
+    }
+
+    graphics->setColor(userPalette->getColor(UserColorId::PC));
+    graphics->drawRectangle(Rect(x, y, w, h));
+    graphics->popClipArea();
+    BLOCK_END("Minimap::draw")
+}
+
+void Minimap::updateDots()
+{
+    BLOCK_START("Minimap::updateDots")
+    mDotsTime = tick_time;
+    mDotsChanged = true;
+    mDots.clear();
+    updateDotImages();
 
     const ActorSprites &actors = actorManager->getAll();
     FOR_EACH (ActorSpritesConstIterator, it, actors)
@@ -322,52 +502,50 @@ void Minimap::draw2(Graphics *const graphics)
         if (!being)
             continue;
 
-        int dotSize = 2;
-        UserColorIdT type = UserColorId::PC;
+        int kind = DOT_SELF;
 
         if (being == localPlayer)
         {
-            type = UserColorId::SELF;
-            dotSize = 3;
+            kind = DOT_SELF;
         }
         else if (being->isGM())
         {
-            type = UserColorId::GM;
+            kind = DOT_GM;
         }
         else if (being->getGuild() == localPlayer->getGuild()
                  || being->getGuildName() == localPlayer->getGuildName())
         {
-            type = UserColorId::GUILD;
+            kind = DOT_GUILD;
         }
         else
         {
             switch (being->getType())
             {
                 case ActorType::Monster:
-                    type = UserColorId::MONSTER;
+                    kind = DOT_MONSTER;
                     break;
 
                 case ActorType::Npc:
-                    type = UserColorId::NPC;
+                    kind = DOT_NPC;
                     break;
 
                 case ActorType::Portal:
-                    type = UserColorId::PORTAL_HIGHLIGHT;
+                    kind = DOT_PORTAL;
                     break;
 
                 case ActorType::Pet:
-                    type = UserColorId::PET;
+                    kind = DOT_PET;
                     break;
                 case ActorType::Mercenary:
-                    type = UserColorId::MERCENARY;
+                    kind = DOT_MERCENARY;
                     break;
 
                 case ActorType::Homunculus:
-                    type = UserColorId::HOMUNCULUS;
+                    kind = DOT_HOMUNCULUS;
                     break;
 
                 case ActorType::SkillUnit:
-                    type = UserColorId::SKILLUNIT;
+                    kind = DOT_SKILLUNIT;
                     break;
                 case ActorType::Avatar:
                 case ActorType::Unknown:
@@ -379,18 +557,17 @@ void Minimap::draw2(Graphics *const graphics)
             }
         }
 
-        if (userPalette)
-            graphics->setColor(userPalette->getColor(type));
-
+        const int dotSize = dotTypes[kind].size;
         const int offsetHeight = CAST_S32(static_cast<float>(
                 dotSize - 1) * mHeightProportion);
         const int offsetWidth = CAST_S32(static_cast<float>(
                 dotSize - 1) * mWidthProportion);
-        graphics->fillRectangle(Rect(
-            (being->mPixelX * mWidthProportion) / 32
-            + mMapOriginX - offsetWidth,
-            (being->mPixelY * mHeightProportion) / 32
-            + mMapOriginY - offsetHeight, dotSize, dotSize));
+        mDots.push_back(MinimapDot(
+            CAST_S32((being->mPixelX * mWidthProportion) / 32)
+            - offsetWidth,
+            CAST_S32((being->mPixelY * mHeightProportion) / 32)
+            - offsetHeight,
+            kind));
     }
 
     if (localPlayer->isInParty())
@@ -413,63 +590,118 @@ void Minimap::draw2(Graphics *const graphics)
                     if (member && member->getMap() == curMap
                         && member->getOnline() && member != m)
                     {
-                        if (userPalette)
-                        {
-                            graphics->setColor(userPalette->getColor(
-                                UserColorId::PARTY));
-                        }
-
                         const int offsetHeight = CAST_S32(
                             mHeightProportion);
                         const int offsetWidth = CAST_S32(
                             mWidthProportion);
 
-                        graphics->fillRectangle(Rect(
+                        mDots.push_back(MinimapDot(
                             CAST_S32(member->getX()
-                            * mWidthProportion) + mMapOriginX - offsetWidth,
+                            * mWidthProportion) - offsetWidth,
                             CAST_S32(member->getY()
-                            * mHeightProportion) + mMapOriginY - offsetHeight,
-                            2, 2));
+                            * mHeightProportion) - offsetHeight,
+                            DOT_PARTY));
                     }
                     ++ it;
                 }
             }
         }
     }
+    BLOCK_END("Minimap::updateDots")
+}
 
-    const int gw = graphics->getWidth();
-    const int gh = graphics->getHeight();
-    int x = (localPlayer->mPixelX - (gw / 2)
-        + viewport->getCameraRelativeX())
-        * mWidthProportion / 32 + mMapOriginX;
-    int y = (localPlayer->mPixelY - (gh / 2)
-        + viewport->getCameraRelativeY())
-        * mHeightProportion / 32 + mMapOriginY;
-
-    const int w = CAST_S32(static_cast<float>(
-        gw) * mWidthProportion / 32);
-    const int h = CAST_S32(static_cast<float>(
-        gh) * mHeightProportion / 32);
+void Minimap::updateDotImages()
+{
+    std::vector<Color> colors;
+    colors.reserve(dotTypesCount);
+    for (int f = 0; f < dotTypesCount; f ++)
+        colors.push_back(userPalette->getColor(dotTypes[f].color));
+    if (mDotsImage && colors == mDotColors)
+        return;
 
-    if (w <= a.width)
+    deleteDotImages();
+    SDL_Surface *const surface = imageHelper->create32BitSurface(
+        dotTypesCount * dotCellSize, dotCellSize);
+    if (!surface)
+        return;
+    for (int f = 0; f < dotTypesCount; f ++)
     {
-        if (x < 0 && w)
-            x = 0;
-        if (x + w > a.width)
-            x = a.width - w;
+        const Color &color = colors[f];
+        SDL_Rect rect =
+        {
+            CAST_S16(f * dotCellSize),
+            0,
+            CAST_U16(dotCellSize),
+            CAST_U16(dotCellSize)
+        };
+        SDL_FillRect(surface, &rect, SDL_MapRGBA(surface->format,
+            CAST_U8(color.r), CAST_U8(color.g), CAST_U8(color.b), 255));
     }
-    if (h <= a.height)
+    mDotsImage = imageHelper->loadSurface(surface);
+    MSDL_FreeSurface(surface);
+    if (!mDotsImage)
+        return;
+    // sub images not release parent image
+    mDotsImage->setNotCount(true);
+    for (int f = 0; f < dotTypesCount; f ++)
     {
-        if (y < 0 && h)
-            y = 0;
-        if (y + h > a.height)
-            y = a.height - h;
+        const int size = dotTypes[f].size;
+        mDotImages.push_back(mDotsImage->getSubImage(
+            f * dotCellSize, 0, size, size));
     }
+    mDotColors = colors;
+}
 
-    graphics->setColor(userPalette->getColor(UserColorId::PC));
-    graphics->drawRectangle(Rect(x, y, w, h));
-    graphics->popClipArea();
-    BLOCK_END("Minimap::draw")
+void Minimap::drawDots(Graphics *const graphics,
+                       const bool batched)
+{
+    if (mDotImages.empty())
+        return;
+
+    BLOCK_START("Minimap::drawDots")
+    if (!batched)
+    {
+        FOR_EACH (std::vector<MinimapDot>::const_iterator, it, mDots)
+        {
+            const Image *const image = mDotImages[it->kind];
+            if (image)
+            {
+                graphics->drawImage(image,
+                    it->x + mMapOriginX,
+                    it->y + mMapOriginY);
+            }
+        }
+        BLOCK_END("Minimap::drawDots")
+        return;
+    }
+
+    // vertexes depend on window position in software renderer
+    const int x = mDimension.x + mMapOriginX;
+    const int y = mDimension.y + mMapOriginY;
+    if (mDotsChanged ||
+        x != mDotsX ||
+        y != mDotsY ||
+        graphics->getRedraw())
+    {
+        mDotsChanged = false;
+        mDotsX = x;
+        mDotsY = y;
+        mDotsVertexes->clear();
+        FOR_EACH (std::vector<MinimapDot>::const_iterator, it, mDots)
+        {
+            const Image *const image = mDotImages[it->kind];
+            if (image)
+            {
+                graphics->calcTileCollection(mDotsVertexes,
+                    image,
+                    it->x + mMapOriginX,
+                    it->y + mMapOriginY);
+            }
+        }
+        graphics->finalize(mDotsVertexes);
+    }
+    graphics->drawTileCollection(mDotsVertexes);
+    BLOCK_END("Minimap::drawDots")
 }
 
 void Minimap::mousePressed(MouseEvent &event)
@@ -521,6 +753,22 @@ void Minimap::mouseExited(MouseEvent &event)
     textPopup->hide();
 }
 
+void Minimap::mouseWheelMovedUp(MouseEvent &event)
+{
+    if (!mMapCache)
+        return;
+    setZoomLevel(mZoomLevel - 1);
+    event.consume();
+}
+
+void Minimap::mouseWheelMovedDown(MouseEvent &event)
+{
+    if (!mMapCache)
+        return;
+    setZoomLevel(mZoomLevel + 1);
+    event.consume();
+}
+
 void Minimap::screenToMap(int &x, int &y)
 {
     const Rect a = getChildrenArea();
@@ -532,4 +780,6 @@ void Minimap::optionChanged(const std::string &name)
 {
     if (name == "autoresizeminimaps")
         mAutoResize = config.getBoolValue("autoresizeminimaps");
+    else if (name == "minimapDotsDelay")
+        mDotsDelay = config.getIntValue("minimapDotsDelay");
 }
@@ -25,8 +25,12 @@
 
 #include "gui/widgets/window.h"
 
+#include "gui/color.h"
+
 class Image;
+class ImageCollection;
 class Map;
+class MinimapCache;
 
 /**
  * Minimap window. Shows a minimap image and the name of the current map.
@@ -63,7 +67,8 @@ class Minimap final : public Window, public ConfigListener
 
         void safeDraw(Graphics *const graphics) override final A_NONNULL(2);
 
-        void draw2(Graphics *const graphics) A_NONNULL(2);
+        void draw2(Graphics *const graphics,
+                   const bool batched) A_NONNULL(2);
 
         void mouseMoved(MouseEvent &event) override final;
 
@@ -73,18 +78,67 @@ class Minimap final : public Window, public ConfigListener
 
         void mouseExited(MouseEvent &event) override final;
 
+        void mouseWheelMovedUp(MouseEvent &event) override final;
+
+        void mouseWheelMovedDown(MouseEvent &event) override final;
+
         void screenToMap(int &x, int &y);
 
         void optionChanged(const std::string &name) override final;
 
     private:
+        struct MinimapDot final
+        {
+            MinimapDot(const int x0,
+                       const int y0,
+                       const int kind0) :
+                x(x0),
+                y(y0),
+                kind(kind0)
+            {
+            }
+
+            int x;
+            int y;
+            int kind;
+        };
+
         void deleteMapImage();
 
+        void deleteDotImages();
+
+        void setSizeLimits(const int imageWidth,
+                           const int imageHeight);
+
+        void setZoomLevel(const int level);
+
+        void drawMapImage(Graphics *const graphics,
+                          const Rect &area) A_NONNULL(2);
+
+        void updateDots();
+
+        void updateDotImages();
+
+        void drawDots(Graphics *const graphics,
+                      const bool batched) A_NONNULL(2);
+
         float mWidthProportion;
         float mHeightProportion;
         Image *mMapImage;
+        MinimapCache *mMapCache;
+        ImageCollection *mDotsVertexes;
+        Image *mDotsImage;
+        std::vector<Image*> mDotImages;
+        std::vector<Color> mDotColors;
+        std::vector<MinimapDot> mDots;
+        int mDotsTime;
+        int mDotsDelay;
+        int mDotsX;
+        int mDotsY;
         int mMapOriginX;
         int mMapOriginY;
+        int mZoomLevel;
+        bool mDotsChanged;
         bool mCustomMapImage;
         bool mAutoResize;
         static bool mShow;
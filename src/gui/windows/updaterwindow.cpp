@@ -39,6 +39,7 @@
 #include "gui/widgets/scrollarea.h"
 
 #include "net/download.h"
+#include "net/updatescheduler.h"
 #include "net/updatetypeoperators.h"
 
 #include "resources/db/moddb.h"
@@ -179,9 +180,9 @@ UpdaterWindow::UpdaterWindow(const std::string &restrict updateHost,
     mCurrentFile("news.txt"),
     mNewLabelCaption(),
     mDownloadMutex(),
-    mCurrentChecksum(0),
     mMemoryBuffer(nullptr),
     mDownload(nullptr),
+    mUpdateScheduler(nullptr),
     mUpdateFiles(),
     mTempUpdateFiles(),
     mUpdateServerPath(mUpdateHost),
@@ -271,6 +272,7 @@ UpdaterWindow::~UpdaterWindow()
 
         delete2(mDownload)
     }
+    delete2(mUpdateScheduler);
     free(mMemoryBuffer);
     delete2(mItemLinkHandler);
 }
@@ -318,6 +320,8 @@ void UpdaterWindow::action(const ActionEvent &event)
         {
             if (mDownload)
                 mDownload->cancel();
+            if (mUpdateScheduler)
+                mUpdateScheduler->cancel();
             mDownloadStatus = UpdateDownloadStatus::UPDATE_ERROR;
         }
     }
@@ -624,20 +628,11 @@ void UpdaterWindow::download()
     }
     else
     {
-        if (mDownloadStatus == UpdateDownloadStatus::UPDATE_RESOURCES)
-        {
-            mDownload->setFile(std::string(mUpdatesDir).append("/").append(
-                mCurrentFile), mCurrentChecksum);
-        }
-        else
-        {
-            mDownload->setFile(std::string(mUpdatesDir).append(
-                "/").append(mCurrentFile));
-        }
+        mDownload->setFile(std::string(mUpdatesDir).append(
+            "/").append(mCurrentFile));
     }
 
-    if (mDownloadStatus != UpdateDownloadStatus::UPDATE_RESOURCES)
-        mDownload->noCache();
+    mDownload->noCache();
 
     setLabel(mCurrentFile + " (0%)");
     mDownloadComplete = false;
@@ -645,6 +640,51 @@ void UpdaterWindow::download()
     mDownload->start();
 }
 
+void UpdaterWindow::startUpdateScheduler(const std::vector<UpdateFile> &files,
+                                         const StringVect &hosts,
+                                         const bool secondList)
+{
+    delete mUpdateScheduler;
+    mUpdateScheduler = new Net::UpdateScheduler(mUpdatesDir,
+        hosts,
+        config.getIntValue("updateDownloads"),
+        !secondList,
+        secondList);
+    const bool downloadMusic = secondList ||
+        config.getBoolValue("download-music");
+    FOR_EACH (std::vector<UpdateFile>::const_iterator, it, files)
+    {
+        const UpdateFile &file = *it;
+        if (file.type == "music" && !downloadMusic)
+            continue;
+        unsigned long hash = 0;
+        std::stringstream ss(file.hash);
+        ss >> std::hex >> hash;
+        mUpdateScheduler->addFile(file.name, hash);
+    }
+    mUpdateScheduler->start();
+}
+
+bool UpdaterWindow::updateScheduler(const std::vector<UpdateFile> &files)
+{
+    mUpdateScheduler->logic();
+    mUpdateIndex = CAST_U32(files.size()) - mUpdateScheduler->size()
+        + mUpdateScheduler->getCompleted();
+    setLabel(mUpdateScheduler->getLabel());
+    setProgress(mUpdateScheduler->getProgress());
+    if (mUpdateScheduler->hasError())
+    {
+        mUpdateScheduler->cancel();
+        mDownloadStatus = UpdateDownloadStatus::UPDATE_ERROR;
+        return false;
+    }
+    if (!mUpdateScheduler->isDone())
+        return false;
+    mUpdateIndex = CAST_U32(files.size());
+    delete2(mUpdateScheduler)
+    return true;
+}
+
 void UpdaterWindow::loadUpdates()
 {
     if (mUpdateFiles.empty())
@@ -853,8 +893,15 @@ void UpdaterWindow::logic()
             mBrowserBox->addRow(_("##1  It is strongly recommended that"));
             // TRANSLATORS: Begins "It is strongly recommended that".
             mBrowserBox->addRow(_("##1  you try again later."));
-            if (mDownload)
+            if (mUpdateScheduler)
+            {
+                mBrowserBox->addRow(mUpdateScheduler->getError());
+                delete2(mUpdateScheduler)
+            }
+            else if (mDownload)
+            {
                 mBrowserBox->addRow(mDownload->getError());
+            }
             mScrollArea->setVerticalScrollAmount(
                     mScrollArea->getVerticalMaxScroll());
             mDownloadStatus = UpdateDownloadStatus::UPDATE_COMPLETE;
@@ -926,40 +973,21 @@ void UpdaterWindow::logic()
         case UpdateDownloadStatus::UPDATE_RESOURCES:
             if (mDownloadComplete)
             {
-                if (CAST_SIZE(mUpdateIndex) < mUpdateFiles.size())
+                if (!mUpdateScheduler)
                 {
-                    UpdateFile thisFile = mUpdateFiles[mUpdateIndex];
-                    if (thisFile.type == "music"
-                        && !config.getBoolValue("download-music"))
-                    {
-                        mUpdateIndex++;
-                        break;
-                    }
-                    mCurrentFile = thisFile.name;
-                    std::string checksum;
-                    checksum = thisFile.hash;
-                    std::stringstream ss(checksum);
-                    ss >> std::hex >> mCurrentChecksum;
-
-                    std::ifstream temp((std::string(mUpdatesDir).append(
-                        "/").append(mCurrentFile)).c_str());
-
                     mValidateXml = false;
-                    if (!temp.is_open() || !validateFile(std::string(
-                        mUpdatesDir).append("/").append(mCurrentFile),
-                        mCurrentChecksum))
+                    StringVect hosts;
+                    hosts.push_back(mUpdateHost);
+                    const std::vector<std::string> &mirrors =
+                        settings.updateMirrors;
+                    FOR_EACH (std::vector<std::string>::const_iterator,
+                              it, mirrors)
                     {
-                        temp.close();
-                        download();
+                        hosts.push_back(*it);
                     }
-                    else
-                    {
-                        temp.close();
-                        logger->log("%s already here", mCurrentFile.c_str());
-                    }
-                    mUpdateIndex++;
+                    startUpdateScheduler(mUpdateFiles, hosts, false);
                 }
-                else
+                if (updateScheduler(mUpdateFiles))
                 {
                     if (!mSkipPatches)
                     {
@@ -999,34 +1027,17 @@ void UpdaterWindow::logic()
             if (mDownloadComplete)
             {
                 mValidateXml = false;
-                if (CAST_SIZE(mUpdateIndex)
-                    < mTempUpdateFiles.size())
+                if (!mUpdateScheduler)
                 {
-                    const UpdateFile thisFile = mTempUpdateFiles[mUpdateIndex];
-                    mCurrentFile = thisFile.name;
-                    std::string checksum;
-                    checksum = thisFile.hash;
-                    std::stringstream ss(checksum);
-                    ss >> std::hex >> mCurrentChecksum;
-
-                    std::ifstream temp((std::string(mUpdatesDir).append(
-                        "/").append(mCurrentFile)).c_str());
-
-                    if (!temp.is_open() || !validateFile(std::string(
-                        mUpdatesDir).append("/").append(mCurrentFile),
-                        mCurrentChecksum))
-                    {
-                        temp.close();
-                        download();
-                    }
-                    else
-                    {
-                        temp.close();
-                        logger->log("%s already here", mCurrentFile.c_str());
-                    }
-                    mUpdateIndex++;
+                    StringVect hosts;
+                    hosts.push_back(mUpdateHost);
+                    const std::string path = mUpdateServerPath;
+                    hosts.push_back(updateServer3 + path);
+                    hosts.push_back(updateServer4 + path);
+                    hosts.push_back(updateServer5 + path);
+                    startUpdateScheduler(mTempUpdateFiles, hosts, true);
                 }
-                else
+                if (updateScheduler(mTempUpdateFiles))
                 {
                     mUpdatesDir = mUpdatesDirReal;
                     mDownloadStatus = UpdateDownloadStatus::UPDATE_COMPLETE;
@@ -1050,18 +1061,6 @@ void UpdaterWindow::logic()
     BLOCK_END("UpdaterWindow::logic")
 }
 
-bool UpdaterWindow::validateFile(const std::string &filePath,
-                                 const unsigned long hash)
-{
-    FILE *const file = fopen(filePath.c_str(), "rb");
-    if (!file)
-        return false;
-
-    const unsigned long adler = Net::Download::fadler32(file);
-    fclose(file);
-    return adler == hash;
-}
-
 unsigned long UpdaterWindow::getFileHash(const std::string &filePath)
 {
     int size = 0;
@@ -35,6 +35,7 @@
 #include "resources/updatefile.h"
 
 #include "utils/mutex.h"
+#include "utils/stringvector.h"
 
 #include "listeners/actionlistener.h"
 #include "listeners/keylistener.h"
@@ -49,6 +50,7 @@ class ScrollArea;
 namespace Net
 {
     class Download;
+    class UpdateScheduler;
 }
 
 /**
@@ -146,6 +148,21 @@ class UpdaterWindow final : public Window,
     private:
         void download();
 
+        /**
+         * Starts parallel download of given update files.
+         * Second update list downloaded like before: without cache,
+         * without hash check after download and with music.
+         */
+        void startUpdateScheduler(const std::vector<UpdateFile> &files,
+                                  const StringVect &hosts,
+                                  const bool secondList);
+
+        /**
+         * Updates parallel download state.
+         * Returns true if all files downloaded.
+         */
+        bool updateScheduler(const std::vector<UpdateFile> &files);
+
         /**
          * Loads the updates this window has gotten into the resource manager
          */
@@ -165,9 +182,6 @@ class UpdaterWindow final : public Window,
         static size_t memoryWrite(void *ptr, size_t size, size_t nmemb,
                                   void *stream);
 
-        static bool validateFile(const std::string &filePath,
-                                 const unsigned long hash) A_WARN_UNUSED;
-
         /** The new progress value to be set in the logic method. */
         float mDownloadProgress;
 
@@ -189,15 +203,15 @@ class UpdaterWindow final : public Window,
         // and mDownloadProgress.
         Mutex mDownloadMutex;
 
-        /** The Adler32 checksum of the file currently downloading. */
-        unsigned long mCurrentChecksum;
-
         /** Buffer for files downloaded to memory. */
         char *mMemoryBuffer;
 
         /** Download handle. */
         Net::Download *mDownload;
 
+        /** Parallel downloads of update archives. */
+        Net::UpdateScheduler *mUpdateScheduler;
+
         /** List of files to download. */
         std::vector<UpdateFile> mUpdateFiles;
 
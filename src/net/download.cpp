@@ -71,6 +71,9 @@ Download::Download(void *const ptr,
     mUrlQueue(),
     mWriteFunction(nullptr),
     mAdler(0),
+    mFile(nullptr),
+    mFileAdler(0),
+    mResumeFrom(0),
     mUpdateFunction(updateFunction),
     mThread(nullptr),
     mCurl(nullptr),
@@ -131,21 +134,18 @@ unsigned long Download::fadler32(FILE *const file)
     if (!file)
         return 0;
 
-    // Obtain file size
-    fseek(file, 0, SEEK_END);
-    const long fileSize = ftell(file);
-    if (fileSize < 0)
-    {   // file size error
-        return 0;
-    }
     rewind(file);
 
     // Calculate Adler-32 checksum
-    char *const buffer = new char[CAST_SIZE(fileSize)];
-    const uInt read = static_cast<uInt>(fread(buffer, 1, fileSize, file));
+    const size_t bufferSize = 65536;
+    char *const buffer = new char[bufferSize];
     unsigned long adler = adler32(0L, Z_NULL, 0);
-    adler = adler32(static_cast<uInt>(adler),
-        reinterpret_cast<Bytef*>(buffer), read);
+    size_t read;
+    while ((read = fread(buffer, 1, bufferSize, file)) > 0)
+    {
+        adler = adler32(static_cast<uInt>(adler),
+            reinterpret_cast<Bytef*>(buffer), static_cast<uInt>(read));
+    }
     delete [] buffer;
     return adler;
 }
@@ -236,16 +236,25 @@ int Download::downloadProgress(void *clientp, double dltotal, double dlnow,
     if (d->mUpload)
         return 0;
 
+    // show progress of whole file if download was resumed
+    size_t total = CAST_SIZE(dltotal);
+    size_t now = CAST_SIZE(dlnow);
+    if (total)
+    {
+        total += d->mResumeFrom;
+        now += d->mResumeFrom;
+    }
+
     if (d->mOptions.cancel)
     {
         return d->mUpdateFunction(d->mPtr, DownloadStatus::Cancelled,
-                                  CAST_SIZE(dltotal),
-                                  CAST_SIZE(dlnow));
+                                  total,
+                                  now);
     }
 
     return d->mUpdateFunction(d->mPtr, DownloadStatus::Idle,
-                              CAST_SIZE(dltotal),
-                              CAST_SIZE(dlnow));
+                              total,
+                              now);
 }
 
 int Download::downloadThread(void *ptr)
@@ -320,11 +329,40 @@ int Download::downloadThread(void *ptr)
                     }
                     else
                     {
-                        file = fopen(outFilename.c_str(), "w+b");
+                        d->mResumeFrom = 0;
+                        if (d->mOptions.checkAdler)
+                        {
+                            // continue partially downloaded file
+                            file = fopen(outFilename.c_str(), "a+b");
+                            if (file)
+                            {
+                                d->mFileAdler = fadler32(file);
+                                fseek(file, 0, SEEK_END);
+                                const long size = ftell(file);
+                                if (size > 0)
+                                    d->mResumeFrom = CAST_SIZE(size);
+                            }
+                            curl_easy_setopt(d->mCurl, CURLOPT_FAILONERROR, 1);
+                        }
+                        else
+                        {
+                            file = fopen(outFilename.c_str(), "w+b");
+                            d->mFileAdler = adler32(0L, Z_NULL, 0);
+                        }
+                        d->mFile = file;
                         if (file)
                         {
-                            curl_easy_setopt(d->mCurl, CURLOPT_WRITEDATA,
-                                file);
+                            curl_easy_setopt(d->mCurl, CURLOPT_WRITEFUNCTION,
+                                &Download::writeFileFunction);
+                            curl_easy_setopt(d->mCurl, CURLOPT_WRITEDATA, d);
+                        }
+                        if (d->mResumeFrom > 0)
+                        {
+                            logger->log_r("Resuming from %u bytes",
+                                CAST_U32(d->mResumeFrom));
+                            curl_easy_setopt(d->mCurl,
+                                CURLOPT_RESUME_FROM_LARGE,
+                                static_cast<curl_off_t>(d->mResumeFrom));
                         }
                     }
                     curl_easy_setopt(d->mCurl, CURLOPT_USERAGENT,
@@ -340,13 +378,27 @@ int Download::downloadThread(void *ptr)
                     curl_easy_setopt(d->mCurl, CURLOPT_NOSIGNAL, 1);
                     curl_easy_setopt(d->mCurl, CURLOPT_CONNECTTIMEOUT, 30);
                     curl_easy_setopt(d->mCurl, CURLOPT_TIMEOUT, 1800);
-                    addHeaders(d->mCurl);
+                    // range offsets must be in not encoded data
+                    if (d->mResumeFrom == 0)
+                        addHeaders(d->mCurl);
                     addProxy(d->mCurl);
                     secureCurl(d->mCurl);
                 }
 
-                if ((res = curl_easy_perform(d->mCurl)) != 0
-                    && !d->mOptions.cancel)
+                if (!d->mUpload &&
+                    d->mResumeFrom > 0 &&
+                    d->mFileAdler == d->mAdler)
+                {
+                    logger->log_r("File already downloaded: %s",
+                        d->mFileName.c_str());
+                    res = CURLE_OK;
+                }
+                else
+                {
+                    res = curl_easy_perform(d->mCurl);
+                }
+
+                if (res != CURLE_OK)
                 {
                     PRAGMA45(GCC diagnostic push)
                     PRAGMA45(GCC diagnostic ignored "-Wswitch-enum")
@@ -361,29 +413,33 @@ int Download::downloadThread(void *ptr)
                     }
                     PRAGMA45(GCC diagnostic pop)
 
-                    if (res)
+                    if (d->mError && !d->mOptions.cancel)
                     {
-                        if (d->mError)
-                        {
-                            logger->log_r("curl error %d: %s host: %s",
-                                res, d->mError, d->mUrl.c_str());
-                        }
-                        attempts++;
-                        continue;
+                        logger->log_r("curl error %d: %s host: %s",
+                            res, d->mError, d->mUrl.c_str());
                     }
 
-                    if (d->mOptions.cancel)
-                        break;
-
-//                    d->mUpdateFunction(d->mPtr, DownloadStatus::Error, 0, 0);
-
                     if (file)
                     {
                         fclose(file);
                         file = nullptr;
+                        d->mFile = nullptr;
                     }
-                    if (!d->mUpload && !d->mOptions.memoryWrite)
+
+                    // Partial file kept for resume, except if server
+                    // can't continue from it
+                    long code = 0;
+                    curl_easy_getinfo(d->mCurl, CURLINFO_RESPONSE_CODE, &code);
+                    if (d->mResumeFrom > 0 &&
+                        (res == CURLE_RANGE_ERROR || code == 416))
+                    {
                         ::remove(outFilename.c_str());
+                    }
+
+                    curl_easy_cleanup(d->mCurl);
+                    d->mCurl = nullptr;
+                    if (d->mOptions.cancel)
+                        break;
                     attempts++;
                     continue;
                 }
@@ -405,21 +461,22 @@ int Download::downloadThread(void *ptr)
                 {
                     if (!d->mOptions.memoryWrite)
                     {
+                        d->mFile = nullptr;
+                        if (file)
+                        {
+                            fclose(file);
+                            file = nullptr;
+                        }
+
                         // Don't check resources.xml checksum
                         if (d->mOptions.checkAdler)
                         {
-                            const unsigned long adler = fadler32(file);
+                            const unsigned long adler = d->mFileAdler;
 
                             if (d->mAdler != adler)
                             {
-                                if (file)
-                                {
-                                    fclose(file);
-                                    file = nullptr;
-                                }
-
                                 // Remove the corrupted file
-                                ::remove(d->mFileName.c_str());
+                                ::remove(outFilename.c_str());
                                 logger->log_r("Checksum for file %s failed:"
                                     " (%lx/%lx)",
                                     d->mFileName.c_str(),
@@ -429,12 +486,6 @@ int Download::downloadThread(void *ptr)
                             }
                         }
 
-                        if (file)
-                        {
-                            fclose(file);
-                            file = nullptr;
-                        }
-
                         // Any existing file with this name is deleted first,
                         // otherwise the rename will fail on Windows.
                         if (!d->mOptions.cancel)
@@ -611,6 +662,22 @@ void Download::prepareForm(curl_httppost **form, const std::string &fileName)
         CURLFORM_END);
 }
 
+size_t Download::writeFileFunction(void *ptr,
+                                   size_t size,
+                                   size_t nmemb,
+                                   void *stream)
+{
+    Download *const d = reinterpret_cast<Download*>(stream);
+    if (!d || !d->mFile)
+        return 0;
+    const size_t totalMem = size * nmemb;
+    const size_t written = fwrite(ptr, 1, totalMem, d->mFile);
+    // checksum calculated while downloading, file not need to be read again
+    d->mFileAdler = adler32(static_cast<uInt>(d->mFileAdler),
+        static_cast<const Bytef*>(ptr), static_cast<uInt>(written));
+    return written;
+}
+
 size_t Download::writeFunction(void *ptr,
                                size_t size,
                                size_t nmemb,
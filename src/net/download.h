@@ -94,6 +94,9 @@ class Download final
         static size_t writeFunction(void *ptr, size_t size,
                                     size_t nmemb, void *stream);
 
+        static size_t writeFileFunction(void *ptr, size_t size,
+                                        size_t nmemb, void *stream);
+
         static void prepareForm(curl_httppost **form,
                                 const std::string &fileName);
 
@@ -128,6 +131,9 @@ class Download final
         std::queue<std::string> mUrlQueue;
         WriteFunction mWriteFunction;
         unsigned long mAdler;
+        FILE *mFile;
+        unsigned long mFileAdler;
+        size_t mResumeFrom;
         DownloadUpdate mUpdateFunction;
         SDL_Thread *mThread;
         CURL *mCurl;
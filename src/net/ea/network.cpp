@@ -23,8 +23,10 @@
 #include "net/ea/network.h"
 
 #include "configuration.h"
+#include "eventsmanager.h"
 #include "logger.h"
 
+#include "net/packetcounters.h"
 #include "net/packetinfo.h"
 
 #include "utils/delete2.h"
@@ -60,6 +62,7 @@ int networkThread(void *data)
 }
 
 Network::Network() :
+    ConfigListener(),
     mSocket(nullptr),
     mServer(),
     mPackets(nullptr),
@@ -67,6 +70,11 @@ Network::Network() :
     mOutBuffer(new char[BUFFER_SIZE]),
     mInSize(0),
     mOutSize(0),
+    mOutPackets(0),
+    mOutFlushSize(CAST_U32(config.getIntValue("networkFlushSize"))),
+    mOutFlushDelay(CAST_U32(config.getIntValue("networkFlushDelay"))),
+    mOutFirstTime(0),
+    mOutTimeSum(0),
     mToSkip(0),
     mState(IDLE),
     mError(),
@@ -77,10 +85,15 @@ Network::Network() :
     mPauseDispatch(false)
 {
     TcpNet::init();
+    config.addListener("networkFlushSize", this);
+    config.addListener("networkFlushDelay", this);
 }
 
 Network::~Network()
 {
+    config.removeListeners(this);
+    CHECKLISTENERS
+
     if (mState != IDLE && mState != NET_ERROR)
         disconnect();
 
@@ -96,6 +109,18 @@ Network::~Network()
     TcpNet::quit();
 }
 
+void Network::optionChanged(const std::string &name)
+{
+    if (name == "networkFlushSize")
+    {
+        mOutFlushSize = CAST_U32(config.getIntValue("networkFlushSize"));
+    }
+    else if (name == "networkFlushDelay")
+    {
+        mOutFlushDelay = CAST_U32(config.getIntValue("networkFlushDelay"));
+    }
+}
+
 bool Network::connect(const ServerInfo &server)
 {
     if (mState != IDLE && mState != NET_ERROR)
@@ -120,6 +145,8 @@ bool Network::connect(const ServerInfo &server)
 
     // Reset to sane values
     mOutSize = 0;
+    mOutPackets = 0;
+    mOutTimeSum = 0;
     mInSize = 0;
     mToSkip = 0;
 
@@ -175,10 +202,39 @@ void Network::flush()
         setError("Error in TcpNet::send(): " +
             std::string(TcpNet::getError()));
     }
+    if (mOutPackets)
+    {
+        // sum of times from finish of each packet to send
+        const uint32_t wait = SDL_GetTicks() - mOutFirstTime;
+        PacketCounters::incOutLatency(
+            CAST_S32(mOutPackets * wait - mOutTimeSum),
+            CAST_S32(mOutPackets));
+    }
     mOutSize = 0;
+    mOutPackets = 0;
+    mOutTimeSum = 0;
     SDL_mutexV(mMutexOut);
 }
 
+void Network::flushDelayed()
+{
+    if (!mOutSize)
+        return;
+    if (!mOutPackets || SDL_GetTicks() - mOutFirstTime >= mOutFlushDelay)
+        flush();
+}
+
+void Network::finishPacket(const bool urgent)
+{
+    const uint32_t time = SDL_GetTicks();
+    if (!mOutPackets)
+        mOutFirstTime = time;
+    mOutTimeSum += time - mOutFirstTime;
+    mOutPackets ++;
+    if (urgent || mOutSize >= mOutFlushSize)
+        flush();
+}
+
 void Network::skip(const int len)
 {
     SDL_mutexP(mMutexIn);
@@ -321,6 +377,8 @@ void Network::receive()
                     }
                 }
                 SDL_mutexV(mMutexIn);
+                // main thread can sleep, wake it for dispatch packets
+                EventsManager::wakeUp();
                 break;
             }
 
@@ -365,7 +423,11 @@ void Network::fixSendBuffer()
     if (mOutSize > BUFFER_LIMIT)
     {
         if (mState != CONNECTED)
+        {
             mOutSize = 0;
+            mOutPackets = 0;
+            mOutTimeSum = 0;
+        }
         else
             flush();
     }
@@ -23,6 +23,8 @@
 #ifndef NET_EA_NETWORK_H
 #define NET_EA_NETWORK_H
 
+#include "listeners/configlistener.h"
+
 #include "net/serverinfo.h"
 
 PRAGMACLANG6(GCC diagnostic push)
@@ -35,7 +37,7 @@ struct PacketInfo;
 namespace Ea
 {
 
-class Network notfinal
+class Network notfinal : public ConfigListener
 {
     public:
         Network();
@@ -44,6 +46,8 @@ class Network notfinal
 
         virtual ~Network();
 
+        void optionChanged(const std::string &name) override;
+
         bool connect(const ServerInfo &server);
 
         void disconnect();
@@ -65,8 +69,24 @@ class Network notfinal
 
         void skip(const int len);
 
+        /**
+         * Sends all packets from send buffer.
+         */
         void flush();
 
+        /**
+         * Sends packets from send buffer if oldest packet waits longer
+         * than flush delay.
+         */
+        void flushDelayed();
+
+        /**
+         * Called after packet written to send buffer.
+         * Urgent packets sent at once with all packets before them,
+         * other packets coalesced until flush size or delay reached.
+         */
+        void finishPacket(const bool urgent);
+
         void fixSendBuffer();
 
         void pauseDispatch()
@@ -103,6 +123,11 @@ class Network notfinal
         char *mOutBuffer;
         unsigned int mInSize;
         unsigned int mOutSize;
+        unsigned int mOutPackets;
+        unsigned int mOutFlushSize;
+        uint32_t mOutFlushDelay;
+        uint32_t mOutFirstTime;
+        uint32_t mOutTimeSum;
 
         unsigned int mToSkip;
 
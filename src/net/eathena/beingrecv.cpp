@@ -52,6 +52,7 @@
 #include "net/ea/beingrecv.h"
 
 #include "net/eathena/maptypeproperty2.h"
+#include "net/eathena/packetviews.h"
 #include "net/eathena/sp.h"
 #include "net/eathena/sprite.h"
 
@@ -1120,13 +1121,15 @@ void BeingRecv::processBeingMove2(Net::MessageIn &msg)
       * later versions of eAthena for both mobs and
       * players
       */
-    Being *const dstBeing = actorManager->findBeing(
-        msg.readBeingId("being id"));
-
-    uint16_t srcX, srcY, dstX, dstY;
-    msg.readCoordinatePair(srcX, srcY, dstX, dstY, "move path");
-    msg.readUInt8("(sx<<4) | (sy&0x0f)");
-    msg.readInt32("tick");
+    const char *const data = msg.readView(BeingMove2View::size,
+        "being move2");
+    if (!data)
+    {
+        BLOCK_END("BeingRecv::processBeingMove2")
+        return;
+    }
+    const BeingMove2View view(data);
+    Being *const dstBeing = actorManager->findBeing(view.id());
 
     /*
       * This packet doesn't have enough info to actually
@@ -1140,6 +1143,8 @@ void BeingRecv::processBeingMove2(Net::MessageIn &msg)
         return;
     }
 
+    uint16_t srcX, srcY, dstX, dstY;
+    view.path(srcX, srcY, dstX, dstY);
     dstBeing->setTileCoords(srcX, srcY);
     if (localPlayer)
         localPlayer->followMoveTo(dstBeing, srcX, srcY, dstX, dstY);
@@ -1280,14 +1285,16 @@ void BeingRecv::processBeingHp(Net::MessageIn &msg)
 
 void BeingRecv::processMonsterHp(Net::MessageIn &msg)
 {
-    Being *const dstBeing = actorManager->findBeing(
-        msg.readBeingId("monster id"));
-    const int hp = msg.readInt32("hp");
-    const int maxHP = msg.readInt32("max hp");
+    const char *const data = msg.readView(MonsterHpView::size,
+        "monster hp");
+    if (!data)
+        return;
+    const MonsterHpView view(data);
+    Being *const dstBeing = actorManager->findBeing(view.id());
     if (dstBeing)
     {
-        dstBeing->setHP(hp);
-        dstBeing->setMaxHP(maxHP);
+        dstBeing->setHP(view.hp());
+        dstBeing->setMaxHP(view.maxHp());
     }
 }
 
@@ -1370,20 +1377,23 @@ void BeingRecv::processBeingChangeDirection(Net::MessageIn &msg)
         return;
     }
 
-    Being *const dstBeing = actorManager->findBeing(
-        msg.readBeingId("being id"));
-
-    msg.readInt16("head direction");
-
-    const uint8_t dir = Net::MessageIn::fromServerDirection(
-        CAST_U8(msg.readUInt8("player direction") & 0x0FU));
-
+    const char *const data = msg.readView(
+        BeingChangeDirectionView::size, "being change direction");
+    if (!data)
+    {
+        BLOCK_END("BeingRecv::processBeingChangeDirection")
+        return;
+    }
+    const BeingChangeDirectionView view(data);
+    Being *const dstBeing = actorManager->findBeing(view.id());
     if (!dstBeing)
     {
         BLOCK_END("BeingRecv::processBeingChangeDirection")
         return;
     }
 
+    const uint8_t dir = Net::MessageIn::fromServerDirection(
+        CAST_U8(view.direction() & 0x0FU));
     dstBeing->setDirection(dir);
     if (localPlayer)
         localPlayer->imitateDirection(dstBeing, dir);
@@ -1632,20 +1642,22 @@ void BeingRecv::processBeingFakeName(Net::MessageIn &msg)
 
 void BeingRecv::processBeingStatUpdate1(Net::MessageIn &msg)
 {
-    const BeingId id = msg.readBeingId("account id");
-    const int type = msg.readInt16("type");
-    const int value = msg.readInt32("value");
-
-    Being *const dstBeing = actorManager->findBeing(id);
+    const char *const data = msg.readView(BeingStatUpdate1View::size,
+        "being stat update1");
+    if (!data)
+        return;
+    const BeingStatUpdate1View view(data);
+    Being *const dstBeing = actorManager->findBeing(view.id());
     if (!dstBeing)
         return;
 
+    const int type = view.type();
     if (type != Sp::MANNER)
     {
         UNIMPLEMENTEDPACKETFIELD(type);
         return;
     }
-    dstBeing->setManner(value);
+    dstBeing->setManner(view.value());
 }
 
 void BeingRecv::processBeingSelfEffect(Net::MessageIn &msg)
@@ -163,7 +163,7 @@ void GeneralHandler::flushNetwork() const
     if (!Network::mInstance)
         return;
 
-    Network::mInstance->flush();
+    Network::mInstance->flushDelayed();
     Network::mInstance->dispatchMessages();
 
     if (Network::mInstance->getState() == Network::NET_ERROR)
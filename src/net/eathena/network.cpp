@@ -22,7 +22,10 @@
 
 #include "net/eathena/network.h"
 
+#include "settings.h"
+
 #include "net/packetinfo.h"
+#include "net/packetstatistics.h"
 
 #include "net/ea/adminrecv.h"
 #include "net/ea/beingrecv.h"
@@ -208,7 +211,14 @@ void Network::dispatchMessages()
         {
             const PacketFuncPtr func = mPackets[msgId].func;
             if (func)
+            {
+                const uint32_t startTime = PacketStatistics::start();
                 func(msg);
+                // packets can change anything on screen
+                settings.needRedraw = true;
+                PacketStatistics::end(msgId, mPackets[msgId].name,
+                    CAST_U32(len), startTime);
+            }
             else
                 logger->log("Unhandled packet: %u 0x%x", msgId, msgId);
         }
@@ -217,6 +227,7 @@ void Network::dispatchMessages()
         if (mPauseDispatch)
             break;
     }
+    PacketStatistics::endFrame();
 }
 
 bool Network::messageReady()
@@ -0,0 +1,131 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Generated by tools/packetviews.py from packetviews.txt. Do not edit.
+
+#ifndef NET_EATHENA_PACKETVIEWS_H
+#define NET_EATHENA_PACKETVIEWS_H
+
+#include "enums/simpletypes/beingid.h"
+
+#include "net/packetview.h"
+
+#include "localconsts.h"
+
+namespace EAthena
+{
+
+// SMSG_BEING_MOVE2
+struct BeingMove2View final
+{
+    static const unsigned int size = 14;
+
+    explicit BeingMove2View(const char *const data) :
+        mData(data)
+    {
+    }
+
+    BeingId id() const A_WARN_UNUSED
+    { return fromInt(Net::PacketView::readInt32(mData), BeingId); }
+
+    void path(uint16_t &restrict srcX,
+              uint16_t &restrict srcY,
+              uint16_t &restrict dstX,
+              uint16_t &restrict dstY) const
+    {
+        Net::PacketView::readCoordinatePair(mData + 4,
+            srcX, srcY, dstX, dstY);
+    }
+
+    int32_t tick() const A_WARN_UNUSED
+    { return Net::PacketView::readInt32(mData + 10); }
+
+    const char *const mData;
+};
+
+// SMSG_BEING_CHANGE_DIRECTION
+struct BeingChangeDirectionView final
+{
+    static const unsigned int size = 7;
+
+    explicit BeingChangeDirectionView(const char *const data) :
+        mData(data)
+    {
+    }
+
+    BeingId id() const A_WARN_UNUSED
+    { return fromInt(Net::PacketView::readInt32(mData), BeingId); }
+
+    int16_t headDirection() const A_WARN_UNUSED
+    { return Net::PacketView::readInt16(mData + 4); }
+
+    uint8_t direction() const A_WARN_UNUSED
+    { return Net::PacketView::readUInt8(mData + 6); }
+
+    const char *const mData;
+};
+
+// SMSG_BEING_STAT_UPDATE_1
+struct BeingStatUpdate1View final
+{
+    static const unsigned int size = 10;
+
+    explicit BeingStatUpdate1View(const char *const data) :
+        mData(data)
+    {
+    }
+
+    BeingId id() const A_WARN_UNUSED
+    { return fromInt(Net::PacketView::readInt32(mData), BeingId); }
+
+    int16_t type() const A_WARN_UNUSED
+    { return Net::PacketView::readInt16(mData + 4); }
+
+    int32_t value() const A_WARN_UNUSED
+    { return Net::PacketView::readInt32(mData + 6); }
+
+    const char *const mData;
+};
+
+// SMSG_MONSTER_HP
+struct MonsterHpView final
+{
+    static const unsigned int size = 12;
+
+    explicit MonsterHpView(const char *const data) :
+        mData(data)
+    {
+    }
+
+    BeingId id() const A_WARN_UNUSED
+    { return fromInt(Net::PacketView::readInt32(mData), BeingId); }
+
+    int32_t hp() const A_WARN_UNUSED
+    { return Net::PacketView::readInt32(mData + 4); }
+
+    int32_t maxHp() const A_WARN_UNUSED
+    { return Net::PacketView::readInt32(mData + 8); }
+
+    const char *const mData;
+};
+
+}  // namespace EAthena
+
+#endif  // NET_EATHENA_PACKETVIEWS_H
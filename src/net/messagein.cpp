@@ -23,6 +23,7 @@
 #include "net/messagein.h"
 
 #include "net/packetcounters.h"
+#include "net/packetview.h"
 
 #include "utils/stringutils.h"
 
@@ -30,10 +31,6 @@
 
 #include "debug.h"
 
-#define MAKEWORD(low, high) \
-    (CAST_U16((CAST_U8(low)) | \
-    (CAST_U16(CAST_U8(high))) << 8))
-
 namespace Net
 {
 
@@ -134,13 +131,9 @@ void MessageIn::readCoordinates(uint16_t &restrict x,
 {
     if (mPos + 3 <= mLength)
     {
-        const char *const data = mData + CAST_SIZE(mPos);
-        uint16_t temp = MAKEWORD(data[1] & 0x00c0, data[0] & 0x00ff);
-        x = CAST_U16(temp >> 6);
-        temp = MAKEWORD(data[2] & 0x00f0, data[1] & 0x003f);
-        y = CAST_U16(temp >> 4);
-
-        const uint8_t serverDir = CAST_U8(data[2] & 0x000f);
+        uint8_t serverDir = 0;
+        PacketView::readCoordinates(mData + CAST_SIZE(mPos),
+            x, y, serverDir);
         direction = fromServerDirection(serverDir);
 
         DEBUGLOG2(std::string("readCoordinates: ").append(toString(
@@ -167,17 +160,8 @@ void MessageIn::readCoordinatePair(uint16_t &restrict srcX,
 {
     if (mPos + 5 <= mLength)
     {
-        const char *const data = mData + CAST_SIZE(mPos);
-        uint16_t temp = MAKEWORD(data[3], data[2] & 0x000f);
-        dstX = CAST_U16(temp >> 2);
-
-        dstY = MAKEWORD(data[4], data[3] & 0x0003);
-
-        temp = MAKEWORD(data[1], data[0]);
-        srcX = CAST_U16(temp >> 6);
-
-        temp = MAKEWORD(data[2], data[1] & 0x003f);
-        srcY = CAST_U16(temp >> 4);
+        PacketView::readCoordinatePair(mData + CAST_SIZE(mPos),
+            srcX, srcY, dstX, dstY);
 
         DEBUGLOG2(std::string("readCoordinatePair: ").append(toString(
             CAST_S32(srcX))).append(",").append(toString(
@@ -215,6 +199,24 @@ void MessageIn::skipToEnd(const char *const str)
     }
 }
 
+const char *MessageIn::readView(const unsigned int size,
+                                const char *const str)
+{
+    if (mPos + size > mLength)
+    {
+        DEBUGLOG2("readView error", mPos, str);
+        logger->log("error: wrong packet view size %u. packet size: %u",
+            size, mLength);
+        mPos = mLength + 1;
+        return nullptr;
+    }
+    const char *const data = mData + CAST_SIZE(mPos);
+    DEBUGLOG2("readView: " + toString(CAST_S32(size)), mPos, str);
+    mPos += size;
+    PacketCounters::incInBytes(size);
+    return data;
+}
+
 std::string MessageIn::readString(int length, const char *const dstr)
 {
     // Get string length
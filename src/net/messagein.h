@@ -121,6 +121,14 @@ class MessageIn notfinal
         unsigned char *readBytes(int length,
                                  const char *const dstr);
 
+        /**
+         * Returns pointer to next size bytes of packet and skips them.
+         * Used for generated fixed layout packet views.
+         * Returns nullptr if packet is shorter than size.
+         */
+        const char *readView(const unsigned int size,
+                             const char *const str) A_WARN_UNUSED;
+
         static uint8_t fromServerDirection(const uint8_t serverDir)
                                            A_WARN_UNUSED;
 
@@ -37,6 +37,10 @@ int PacketCounters::mOutBytes = 0;
 int PacketCounters::mOutBytesCalc = 0;
 int PacketCounters::mOutPackets = 0;
 int PacketCounters::mOutPacketsCalc = 0;
+int PacketCounters::mOutLatencyCurrentSec = 0;
+int PacketCounters::mOutLatency = 0;
+int PacketCounters::mOutLatencyPackets = 0;
+int PacketCounters::mOutLatencyCalc = 0;
 
 void PacketCounters::incInBytes(const int cnt)
 {
@@ -103,6 +107,35 @@ int PacketCounters::getOutPackets()
     return PacketCounters::mOutPacketsCalc;
 }
 
+void PacketCounters::incOutLatency(const int sum,
+                                   const int cnt)
+{
+    if (!runCounters)
+        return;
+
+    updateLatency();
+
+    PacketCounters::mOutLatency += sum;
+    PacketCounters::mOutLatencyPackets += cnt;
+}
+
+int PacketCounters::getOutLatency()
+{
+    return PacketCounters::mOutLatencyCalc;
+}
+
+void PacketCounters::updateLatency()
+{
+    const int idx = CAST_S32(cur_time % 60);
+    if (mOutLatencyCurrentSec != idx)
+    {
+        mOutLatencyCurrentSec = idx;
+        mOutLatencyCalc = mOutLatencyPackets
+            ? mOutLatency / mOutLatencyPackets : 0;
+        mOutLatency = 0;
+        mOutLatencyPackets = 0;
+    }
+}
 
 void PacketCounters::updateCounter(int &restrict currentSec,
                                    int &restrict calc,
@@ -131,5 +164,6 @@ void PacketCounters::update()
         PacketCounters::mOutBytesCalc, PacketCounters::mOutBytes);
     updateCounter(PacketCounters::mOutCurrentSec,
         PacketCounters::mOutPacketsCalc, PacketCounters::mOutPackets);
+    updateLatency();
     BLOCK_END("PacketCounters::update")
 }
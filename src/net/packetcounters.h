@@ -44,6 +44,14 @@ class PacketCounters final
 
         static int getOutPackets() A_WARN_UNUSED;
 
+        static void incOutLatency(const int sum,
+                                  const int cnt);
+
+        /**
+         * Returns average time in ms between packet creation and send.
+         */
+        static int getOutLatency() A_WARN_UNUSED;
+
         static void update();
 
         static int mInCurrentSec;
@@ -56,11 +64,17 @@ class PacketCounters final
         static int mOutBytesCalc;
         static int mOutPackets;
         static int mOutPacketsCalc;
+        static int mOutLatencyCurrentSec;
+        static int mOutLatency;
+        static int mOutLatencyPackets;
+        static int mOutLatencyCalc;
 
     private:
         static void updateCounter(int &restrict currentSec,
                                   int &restrict calc,
                                   int &restrict counter);
+
+        static void updateLatency();
 };
 
 #endif  // NET_PACKETCOUNTERS_H
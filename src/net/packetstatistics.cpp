@@ -0,0 +1,220 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "net/packetstatistics.h"
+
+#include "configuration.h"
+#include "logger.h"
+
+#include "utils/stringutils.h"
+#include "utils/timer.h"
+
+#include <algorithm>
+#include <fstream>
+
+#ifdef WIN32
+#ifdef USE_SDL2
+#include <SDL_timer.h>
+#else  // USE_SDL2
+#include <windows.h>
+#endif  // USE_SDL2
+#else  // WIN32
+#include <ctime>
+#endif  // WIN32
+
+#include "debug.h"
+
+extern volatile bool runCounters;
+
+const unsigned int PacketStatistics::histogramLimits[PACKET_HISTOGRAM_SIZE] =
+{
+    10U, 50U, 100U, 500U, 1000U, 5000U, 10000U, 0xffffffffU
+};
+
+PacketStatisticMap PacketStatistics::mStats;
+uint32_t PacketStatistics::mFrameTime = 0U;
+uint32_t PacketStatistics::mFrameMaxTime = 0U;
+unsigned int PacketStatistics::mFrameMaxId = 0U;
+uint32_t PacketStatistics::mBudget = 0U;
+time_t PacketStatistics::mBudgetTime = 0;
+time_t PacketStatistics::mWarnTime = 0;
+
+namespace
+{
+    struct StatisticSorter final
+    {
+        bool operator() (const PacketStatistic *const stat1,
+                         const PacketStatistic *const stat2) const
+        {
+            return stat1->time > stat2->time;
+        }
+    } statisticSorter;
+}  // namespace
+
+uint32_t PacketStatistics::getTime()
+{
+    // time in microseconds
+#ifdef WIN32
+#ifdef USE_SDL2
+    const uint64_t counter = SDL_GetPerformanceCounter();
+    const uint64_t freq = SDL_GetPerformanceFrequency();
+#else  // USE_SDL2
+    LARGE_INTEGER counter0;
+    LARGE_INTEGER freq0;
+    QueryPerformanceCounter(&counter0);
+    QueryPerformanceFrequency(&freq0);
+    const uint64_t counter = static_cast<uint64_t>(counter0.QuadPart);
+    const uint64_t freq = static_cast<uint64_t>(freq0.QuadPart);
+#endif  // USE_SDL2
+
+    if (freq == 0U)
+        return 0U;
+    // split to avoid overflow on big counter values
+    return CAST_U32((counter / freq) * 1000000U
+        + (counter % freq) * 1000000U / freq);
+#else  // WIN32
+
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return CAST_U32(static_cast<uint64_t>(time.tv_sec) * 1000000U
+        + static_cast<uint64_t>(time.tv_nsec) / 1000U);
+#endif  // WIN32
+}
+
+uint32_t PacketStatistics::start()
+{
+    if (!runCounters)
+        return 0U;
+    const uint32_t time = getTime();
+    // zero used as disabled flag
+    return time ? time : 1U;
+}
+
+void PacketStatistics::end(const unsigned int id,
+                           const char *const name,
+                           const unsigned int len,
+                           const uint32_t startTime)
+{
+    if (!startTime)
+        return;
+
+    const uint32_t time = getTime() - startTime;
+    PacketStatistic &stat = mStats[id];
+    if (!stat.count)
+    {
+        stat.id = id;
+        stat.name = name;
+    }
+    stat.count ++;
+    stat.bytes += len;
+    stat.time += time;
+    if (time > stat.maxTime)
+        stat.maxTime = time;
+    unsigned int idx = 0;
+    while (time >= histogramLimits[idx])
+        idx ++;
+    stat.histogram[idx] ++;
+
+    mFrameTime += time;
+    if (time >= mFrameMaxTime)
+    {
+        mFrameMaxTime = time;
+        mFrameMaxId = id;
+    }
+}
+
+void PacketStatistics::endFrame()
+{
+    if (!mFrameTime)
+        return;
+
+    if (mBudgetTime != cur_time)
+    {
+        mBudgetTime = cur_time;
+        mBudget = CAST_U32(config.getIntValue(
+            "packetHandlersBudget")) * 1000U;
+    }
+    // not more than one warning per second
+    if (mBudget && mFrameTime > mBudget && mWarnTime != cur_time)
+    {
+        mWarnTime = cur_time;
+        const PacketStatistic &stat = mStats[mFrameMaxId];
+        logger->log("Warning: packet handlers time %u us in frame. "
+            "Slowest packet 0x%04x %s: %u us",
+            mFrameTime,
+            mFrameMaxId,
+            stat.name ? stat.name : "",
+            mFrameMaxTime);
+    }
+    mFrameTime = 0U;
+    mFrameMaxTime = 0U;
+    mFrameMaxId = 0U;
+}
+
+void PacketStatistics::clear()
+{
+    mStats.clear();
+    mFrameTime = 0U;
+    mFrameMaxTime = 0U;
+    mFrameMaxId = 0U;
+}
+
+void PacketStatistics::getSorted(std::vector<const PacketStatistic*> &stats)
+{
+    stats.clear();
+    stats.reserve(mStats.size());
+    FOR_EACH (PacketStatisticMapCIter, it, mStats)
+        stats.push_back(&(*it).second);
+    std::sort(stats.begin(), stats.end(), statisticSorter);
+}
+
+bool PacketStatistics::saveCsv(const std::string &fileName)
+{
+    std::ofstream file(fileName.c_str(), std::ios::out);
+    if (!file.is_open())
+    {
+        logger->log("Error saving packet statistics: %s",
+            fileName.c_str());
+        return false;
+    }
+
+    file << "id,name,count,bytes,time_us,max_time_us";
+    for (unsigned int f = 0; f < PACKET_HISTOGRAM_SIZE - 1; f ++)
+        file << ",lt_" << histogramLimits[f] << "us";
+    file << ",more\n";
+
+    std::vector<const PacketStatistic*> stats;
+    getSorted(stats);
+    FOR_EACH (std::vector<const PacketStatistic*>::const_iterator,
+              it, stats)
+    {
+        const PacketStatistic *const stat = *it;
+        file << strprintf("0x%04x", stat->id) << ','
+            << (stat->name ? stat->name : "") << ','
+            << stat->count << ','
+            << stat->bytes << ','
+            << stat->time << ','
+            << stat->maxTime;
+        for (unsigned int f = 0; f < PACKET_HISTOGRAM_SIZE; f ++)
+            file << ',' << stat->histogram[f];
+        file << '\n';
+    }
+    return true;
+}
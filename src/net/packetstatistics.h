@@ -0,0 +1,108 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NET_PACKETSTATISTICS_H
+#define NET_PACKETSTATISTICS_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "localconsts.h"
+
+// handler time histogram limits in microseconds
+const unsigned int PACKET_HISTOGRAM_SIZE = 8;
+
+struct PacketStatistic final
+{
+    PacketStatistic() :
+        name(nullptr),
+        id(0U),
+        count(0U),
+        bytes(0U),
+        time(0U),
+        maxTime(0U)
+    {
+        for (unsigned int f = 0; f < PACKET_HISTOGRAM_SIZE; f ++)
+            histogram[f] = 0U;
+    }
+
+    const char *name;
+    unsigned int id;
+    unsigned int count;
+    unsigned int bytes;
+    uint64_t time;
+    uint32_t maxTime;
+    unsigned int histogram[PACKET_HISTOGRAM_SIZE];
+};
+
+typedef std::map<unsigned int, PacketStatistic> PacketStatisticMap;
+typedef PacketStatisticMap::const_iterator PacketStatisticMapCIter;
+
+/**
+ * Per opcode counters of received packets and its handlers time.
+ * Collected only if packet counters enabled.
+ */
+class PacketStatistics final
+{
+    public:
+        /**
+         * Returns start time of packet handler,
+         * or 0 if statistics disabled.
+         */
+        static uint32_t start() A_WARN_UNUSED;
+
+        /**
+         * Adds packet handled from start time.
+         */
+        static void end(const unsigned int id,
+                        const char *const name,
+                        const unsigned int len,
+                        const uint32_t startTime);
+
+        /**
+         * Checks time of all packet handlers in current frame.
+         */
+        static void endFrame();
+
+        static void clear();
+
+        /**
+         * Returns counters sorted by handlers time.
+         */
+        static void getSorted(std::vector<const PacketStatistic*> &stats);
+
+        static bool saveCsv(const std::string &fileName);
+
+        static const unsigned int histogramLimits[PACKET_HISTOGRAM_SIZE];
+
+    private:
+        static uint32_t getTime() A_WARN_UNUSED;
+
+        static PacketStatisticMap mStats;
+        static uint32_t mFrameTime;
+        static uint32_t mFrameMaxTime;
+        static unsigned int mFrameMaxId;
+        static uint32_t mBudget;
+        static time_t mBudgetTime;
+        static time_t mWarnTime;
+};
+
+#endif  // NET_PACKETSTATISTICS_H
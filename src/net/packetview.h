@@ -0,0 +1,134 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NET_PACKETVIEW_H
+#define NET_PACKETVIEW_H
+
+#include <cstring>
+#include <string>
+
+#ifndef SDL_BIG_ENDIAN
+#include <SDL_endian.h>
+#endif  // SDL_BIG_ENDIAN
+
+#include "localconsts.h"
+
+namespace Net
+{
+
+/**
+ * Readers for fields of fixed layout packets.
+ * Used by generated packet views, what read fields directly from
+ * packet buffer without allocations and bounds checks.
+ * Packet size must be checked before by MessageIn::readView.
+ */
+namespace PacketView
+{
+    inline uint8_t readUInt8(const char *const data)
+    {
+        return CAST_U8(*data);
+    }
+
+    inline int8_t readInt8(const char *const data)
+    {
+        return static_cast<int8_t>(*data);
+    }
+
+    inline uint16_t readUInt16(const char *const data)
+    {
+        uint16_t value;
+        memcpy(&value, data, sizeof(uint16_t));
+        return SDL_SwapLE16(value);
+    }
+
+    inline int16_t readInt16(const char *const data)
+    {
+        return static_cast<int16_t>(readUInt16(data));
+    }
+
+    inline uint32_t readUInt32(const char *const data)
+    {
+        uint32_t value;
+        memcpy(&value, data, sizeof(uint32_t));
+        return SDL_SwapLE32(value);
+    }
+
+    inline int32_t readInt32(const char *const data)
+    {
+        return static_cast<int32_t>(readUInt32(data));
+    }
+
+    inline int64_t readInt64(const char *const data)
+    {
+        uint64_t value;
+        memcpy(&value, data, sizeof(uint64_t));
+        return static_cast<int64_t>(SDL_SwapLE64(value));
+    }
+
+    /**
+     * Reads eAthena 3 bytes block with x, y and server direction.
+     */
+    inline void readCoordinates(const char *const data,
+                                uint16_t &restrict x,
+                                uint16_t &restrict y,
+                                uint8_t &restrict serverDir)
+    {
+        x = CAST_U16(((CAST_U8(data[1]) & 0xc0U) |
+            (CAST_U32(CAST_U8(data[0])) << 8)) >> 6);
+        y = CAST_U16(((CAST_U8(data[2]) & 0xf0U) |
+            ((CAST_U8(data[1]) & 0x3fU) << 8)) >> 4);
+        serverDir = CAST_U8(data[2] & 0x0f);
+    }
+
+    /**
+     * Reads eAthena 5 bytes block with source and destination coordinates.
+     */
+    inline void readCoordinatePair(const char *const data,
+                                   uint16_t &restrict srcX,
+                                   uint16_t &restrict srcY,
+                                   uint16_t &restrict dstX,
+                                   uint16_t &restrict dstY)
+    {
+        dstX = CAST_U16((CAST_U8(data[3]) |
+            ((CAST_U8(data[2]) & 0x0fU) << 8)) >> 2);
+        dstY = CAST_U16(CAST_U8(data[4]) |
+            ((CAST_U8(data[3]) & 0x03U) << 8));
+        srcX = CAST_U16((CAST_U8(data[1]) |
+            (CAST_U32(CAST_U8(data[0])) << 8)) >> 6);
+        srcY = CAST_U16((CAST_U8(data[2]) |
+            ((CAST_U8(data[1]) & 0x3fU) << 8)) >> 4);
+    }
+
+    /**
+     * Reads zero terminated string from fixed size field.
+     * String allocated only here, so call it only if string needed.
+     */
+    inline std::string readString(const char *const data,
+                                  const size_t length)
+    {
+        const char *const end = static_cast<const char*>(
+            memchr(data, '\0', length));
+        return std::string(data, end ? CAST_SIZE(end - data) : length);
+    }
+}  // namespace PacketView
+
+}  // namespace Net
+
+#endif  // NET_PACKETVIEW_H
@@ -260,7 +260,7 @@ void BeingRecv::processPlayerUpdate1(Net::MessageIn &msg)
     else if (disguiseId)
     {
         actorManager->undelete(dstBeing);
-        beingHandler->requestNameById(id);
+        actorManager->requestName(id);
     }
 
     uint8_t dir = dstBeing->getDirectionDelayed();
@@ -406,7 +406,7 @@ void BeingRecv::processPlayerUpdate2(Net::MessageIn &msg)
     else if (disguiseId)
     {
         actorManager->undelete(dstBeing);
-        beingHandler->requestNameById(id);
+        actorManager->requestName(id);
     }
 
     uint8_t dir = dstBeing->getDirectionDelayed();
@@ -548,7 +548,7 @@ void BeingRecv::processPlayerMove(Net::MessageIn &msg)
     else if (disguiseId)
     {
         actorManager->undelete(dstBeing);
-        beingHandler->requestNameById(id);
+        actorManager->requestName(id);
     }
 
     const uint8_t dir = dstBeing->getDirectionDelayed();
@@ -746,7 +746,7 @@ void BeingRecv::processBeingVisible(Net::MessageIn &msg)
         if (dstBeing->getType() == ActorType::Npc)
         {
             actorManager->undelete(dstBeing);
-            beingHandler->requestNameById(id);
+            actorManager->requestName(id);
         }
     }
 
@@ -961,7 +961,7 @@ void BeingRecv::processBeingMove(Net::MessageIn &msg)
         if (dstBeing->getType() == ActorType::Npc)
         {
             actorManager->undelete(dstBeing);
-            beingHandler->requestNameById(id);
+            actorManager->requestName(id);
         }
     }
 
@@ -164,7 +164,7 @@ void GeneralHandler::flushNetwork() const
         return;
 
     BLOCK_START("GeneralHandler::flushNetwork 1")
-    Network::mInstance->flush();
+    Network::mInstance->flushDelayed();
     BLOCK_END("GeneralHandler::flushNetwork 1")
     Network::mInstance->dispatchMessages();
 
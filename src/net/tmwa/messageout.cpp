@@ -25,6 +25,7 @@
 #include "net/packetcounters.h"
 
 #include "net/tmwa/network.h"
+#include "net/tmwa/protocolout.h"
 
 #include "logger.h"
 
@@ -45,6 +46,23 @@ MessageOut::MessageOut(const int16_t id) :
     mData = mNetwork->mOutBuffer + CAST_SIZE(mNetwork->mOutSize);
 }
 
+MessageOut::~MessageOut()
+{
+    mNetwork->finishPacket(isUrgent());
+}
+
+bool MessageOut::isUrgent() const
+{
+    // packets what must not wait for other packets
+    const int id = CAST_S32(mId);
+    return id == CMSG_PLAYER_CHANGE_DEST ||
+        id == CMSG_PLAYER_CHANGE_ACT ||
+        id == CMSG_PLAYER_STOP_ATTACK ||
+        id == CMSG_SKILL_USE_BEING ||
+        id == CMSG_SKILL_USE_POSITION ||
+        id == CMSG_MAP_PING;
+}
+
 void MessageOut::expand(const size_t bytes) const
 {
     mNetwork->mOutSize += CAST_U32(bytes);
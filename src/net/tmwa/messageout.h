@@ -47,6 +47,8 @@ class MessageOut final : public Net::MessageOut
 
         A_DELETE_COPY(MessageOut)
 
+        ~MessageOut();
+
         /**< Writes a short. */
         void writeInt16(const int16_t value,
                         const char *const str) override final;
@@ -72,6 +74,8 @@ class MessageOut final : public Net::MessageOut
     private:
         void expand(const size_t size) const override final;
 
+        bool isUrgent() const A_WARN_UNUSED;
+
         Network *mNetwork;
 };
 
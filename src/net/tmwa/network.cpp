@@ -23,8 +23,10 @@
 #include "net/tmwa/network.h"
 
 #include "logger.h"
+#include "settings.h"
 
 #include "net/packetinfo.h"
+#include "net/packetstatistics.h"
 
 #include "net/ea/adminrecv.h"
 #include "net/ea/beingrecv.h"
@@ -133,7 +135,14 @@ void Network::dispatchMessages()
         {
             const PacketFuncPtr func = mPackets[msgId].func;
             if (func)
+            {
+                const uint32_t startTime = PacketStatistics::start();
                 func(msg);
+                // packets can change anything on screen
+                settings.needRedraw = true;
+                PacketStatistics::end(msgId, mPackets[msgId].name,
+                    CAST_U32(len), startTime);
+            }
             else
                 logger->log("Unhandled packet: %u 0x%x", msgId, msgId);
         }
@@ -146,6 +155,7 @@ void Network::dispatchMessages()
         }
         BLOCK_END("Network::dispatchMessages 3")
     }
+    PacketStatistics::endFrame();
     BLOCK_END("Network::dispatchMessages 1")
 }
 
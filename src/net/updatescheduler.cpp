@@ -0,0 +1,335 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "net/updatescheduler.h"
+
+#include "logger.h"
+
+#include "net/download.h"
+
+#include "utils/delete2.h"
+#include "utils/dtor.h"
+#include "utils/sdlhelper.h"
+#include "utils/stringutils.h"
+
+#include "debug.h"
+
+namespace Net
+{
+
+UpdateScheduler::UpdateScheduler(const std::string &restrict updatesDir,
+                                 const StringVect &restrict hosts,
+                                 const int maxDownloads,
+                                 const bool checkHash,
+                                 const bool noCache) :
+    mUpdatesDir(updatesDir),
+    mHosts(hosts),
+    mJobs(),
+    mThreads(),
+    mError(),
+    mLabel(),
+    mMutex(),
+    mVerifyIndex(0),
+    mMaxDownloads(maxDownloads > 0 ? maxDownloads : 1),
+    mCompleted(0),
+    mProgress(0.0F),
+    mCheckHash(checkHash),
+    mNoCache(noCache),
+    mCancel(false),
+    mFailed(false),
+    mDone(false)
+{
+}
+
+UpdateScheduler::~UpdateScheduler()
+{
+    cancel();
+    delete_all(mJobs);
+    mJobs.clear();
+}
+
+void UpdateScheduler::addFile(const std::string &name,
+                              const unsigned long hash)
+{
+    mJobs.push_back(new UpdateJob(this, name, hash));
+}
+
+void UpdateScheduler::start()
+{
+    const size_t sz = mJobs.size();
+    const size_t threads = std::min(sz, CAST_SIZE(mMaxDownloads));
+    for (size_t f = 0; f < threads; f ++)
+    {
+        SDL_Thread *const thread = SDL::createThread(
+            &UpdateScheduler::verifyThread, "updateverify", this);
+        if (!thread)
+        {
+            logger->log1("Error: update verify thread creation failed");
+            break;
+        }
+        mThreads.push_back(thread);
+    }
+    if (mThreads.empty())
+    {
+        // check files in main thread
+        verifyThread(this);
+    }
+}
+
+void UpdateScheduler::logic()
+{
+    BLOCK_START("UpdateScheduler::logic")
+    if (mCancel || mDone)
+    {
+        BLOCK_END("UpdateScheduler::logic")
+        return;
+    }
+
+    std::vector<UpdateJob*> startJobs;
+    std::vector<Download*> finished;
+    bool verified(true);
+    bool done(true);
+    unsigned int completed = 0;
+    float progress = 0.0F;
+    std::string label;
+    {
+        MutexLocker lock(&mMutex);
+        int running = 0;
+        FOR_EACH (std::vector<UpdateJob*>::const_iterator, it, mJobs)
+        {
+            if ((*it)->state == UpdateJobState::Downloading)
+                running ++;
+        }
+
+        FOR_EACH (std::vector<UpdateJob*>::iterator, it, mJobs)
+        {
+            UpdateJob *const job = *it;
+            switch (job->state)
+            {
+                case UpdateJobState::Verify:
+                    verified = false;
+                    done = false;
+                    break;
+                case UpdateJobState::Queued:
+                    done = false;
+                    if (running < mMaxDownloads && !mFailed)
+                    {
+                        job->state = UpdateJobState::Downloading;
+                        startJobs.push_back(job);
+                        running ++;
+                    }
+                    break;
+                case UpdateJobState::Downloading:
+                {
+                    done = false;
+                    float jobProgress = 0.0F;
+                    if (job->total)
+                    {
+                        jobProgress = static_cast<float>(job->now)
+                            / static_cast<float>(job->total);
+                    }
+                    if (jobProgress > 1.0F)
+                        jobProgress = 1.0F;
+                    progress += jobProgress;
+                    if (!label.empty())
+                        label.append(", ");
+                    label.append(job->name).append(" (").append(toString(
+                        CAST_S32(jobProgress * 100))).append("%)");
+                    break;
+                }
+                case UpdateJobState::Failed:
+                    if (!mFailed)
+                    {
+                        mFailed = true;
+                        mError = job->download ?
+                            job->download->getError() : "";
+                        logger->log("Update download failed: %s",
+                            job->name.c_str());
+                    }
+                    if (job->download)
+                        finished.push_back(job->download);
+                    job->download = nullptr;
+                    break;
+                case UpdateJobState::Done:
+                    if (job->download)
+                        finished.push_back(job->download);
+                    job->download = nullptr;
+                    completed ++;
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    // download threads may use mutex in callback, so delete it unlocked
+    delete_all(finished);
+    FOR_EACH (std::vector<UpdateJob*>::iterator, it, startJobs)
+        startDownload(*it);
+
+    if (verified && !mThreads.empty())
+        waitThreads();
+
+    mCompleted = completed;
+    mLabel = label;
+    const size_t sz = mJobs.size();
+    if (sz)
+    {
+        mProgress = (static_cast<float>(completed) + progress)
+            / static_cast<float>(sz);
+    }
+    else
+    {
+        mProgress = 1.0F;
+    }
+    mDone = done && startJobs.empty();
+    BLOCK_END("UpdateScheduler::logic")
+}
+
+void UpdateScheduler::cancel()
+{
+    {
+        MutexLocker lock(&mMutex);
+        mCancel = true;
+    }
+    FOR_EACH (std::vector<UpdateJob*>::iterator, it, mJobs)
+    {
+        UpdateJob *const job = *it;
+        if (job->download)
+        {
+            job->download->cancel();
+            delete2(job->download)
+        }
+    }
+    waitThreads();
+}
+
+void UpdateScheduler::startDownload(UpdateJob *const job)
+{
+    if (mHosts.empty())
+    {
+        MutexLocker lock(&mMutex);
+        job->state = UpdateJobState::Failed;
+        return;
+    }
+    const std::string &name = job->name;
+    StringVectCIter it = mHosts.begin();
+    Download *const download = new Download(job,
+        std::string(*it).append("/").append(name),
+        &UpdateScheduler::updateProgress,
+        false, false, false);
+    for (++ it; it != mHosts.end(); ++ it)
+        download->addMirror(std::string(*it).append("/").append(name));
+    if (mCheckHash)
+    {
+        download->setFile(std::string(mUpdatesDir).append("/").append(name),
+            static_cast<int64_t>(job->hash));
+    }
+    else
+    {
+        download->setFile(std::string(mUpdatesDir).append("/").append(name));
+    }
+    if (mNoCache)
+        download->noCache();
+    job->download = download;
+    download->start();
+}
+
+void UpdateScheduler::waitThreads()
+{
+    FOR_EACH (std::vector<SDL_Thread*>::iterator, it, mThreads)
+        SDL_WaitThread(*it, nullptr);
+    mThreads.clear();
+}
+
+int UpdateScheduler::verifyThread(void *ptr)
+{
+    UpdateScheduler *const scheduler = static_cast<UpdateScheduler*>(ptr);
+    if (!scheduler)
+        return 0;
+
+    for (;;)
+    {
+        UpdateJob *job = nullptr;
+        {
+            MutexLocker lock(&scheduler->mMutex);
+            if (scheduler->mCancel ||
+                scheduler->mVerifyIndex >= scheduler->mJobs.size())
+            {
+                return 0;
+            }
+            job = scheduler->mJobs[scheduler->mVerifyIndex];
+            scheduler->mVerifyIndex ++;
+        }
+
+        bool valid(false);
+        FILE *const file = fopen(std::string(scheduler->mUpdatesDir).append(
+            "/").append(job->name).c_str(), "rb");
+        if (file)
+        {
+            valid = Download::fadler32(file) == job->hash;
+            fclose(file);
+        }
+
+        MutexLocker lock(&scheduler->mMutex);
+        if (valid)
+        {
+            logger->log_r("%s already here", job->name.c_str());
+            job->state = UpdateJobState::Done;
+        }
+        else
+        {
+            job->state = UpdateJobState::Queued;
+        }
+    }
+}
+
+int UpdateScheduler::updateProgress(void *ptr,
+                                    const DownloadStatusT status,
+                                    size_t total,
+                                    const size_t now)
+{
+    UpdateJob *const job = reinterpret_cast<UpdateJob*>(ptr);
+    if (!job)
+        return -1;
+
+    UpdateScheduler *const scheduler = job->scheduler;
+    MutexLocker lock(&scheduler->mMutex);
+    if (status == DownloadStatus::Complete)
+    {
+        job->state = UpdateJobState::Done;
+    }
+    else if (status == DownloadStatus::Error ||
+             status == DownloadStatus::ThreadError)
+    {
+        job->state = UpdateJobState::Failed;
+    }
+    else if (status == DownloadStatus::Idle)
+    {
+        job->total = total;
+        job->now = now;
+    }
+
+    if (scheduler->mCancel)
+        return -1;
+    return 0;
+}
+
+}  // namespace Net
@@ -0,0 +1,166 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NET_UPDATESCHEDULER_H
+#define NET_UPDATESCHEDULER_H
+
+#include "enums/net/downloadstatus.h"
+#include "enums/net/updatejobstate.h"
+
+#include "utils/mutex.h"
+#include "utils/stringvector.h"
+
+#include "localconsts.h"
+
+struct SDL_Thread;
+
+namespace Net
+{
+
+class Download;
+
+/**
+ * Downloads update archives in parallel.
+ * Already present archives checked in worker threads, missing or broken
+ * archives downloaded with up to maxDownloads downloads at same time.
+ */
+class UpdateScheduler final
+{
+    public:
+        /**
+         * Constructor.
+         *
+         * @param updatesDir Directory where to store archives.
+         * @param hosts Update hosts. First host used as main url, other as
+         *  mirrors.
+         * @param maxDownloads Max number of parallel downloads.
+         * @param checkHash Check hash of downloaded archives.
+         * @param noCache Ask servers and proxies to not use cache.
+         */
+        UpdateScheduler(const std::string &restrict updatesDir,
+                        const StringVect &restrict hosts,
+                        const int maxDownloads,
+                        const bool checkHash,
+                        const bool noCache);
+
+        A_DELETE_COPY(UpdateScheduler)
+
+        ~UpdateScheduler();
+
+        void addFile(const std::string &name,
+                     const unsigned long hash);
+
+        /**
+         * Starts checking of already present archives.
+         */
+        void start();
+
+        /**
+         * Starts queued downloads and removes finished.
+         * Must be called from main thread.
+         */
+        void logic();
+
+        /**
+         * Cancels all downloads and waits for worker threads.
+         */
+        void cancel();
+
+        bool isDone() const A_WARN_UNUSED
+        { return mDone; }
+
+        bool hasError() const A_WARN_UNUSED
+        { return mFailed; }
+
+        const std::string &getError() const A_WARN_UNUSED
+        { return mError; }
+
+        unsigned int size() const A_WARN_UNUSED
+        { return CAST_U32(mJobs.size()); }
+
+        unsigned int getCompleted() const A_WARN_UNUSED
+        { return mCompleted; }
+
+        float getProgress() const A_WARN_UNUSED
+        { return mProgress; }
+
+        const std::string &getLabel() const A_WARN_UNUSED
+        { return mLabel; }
+
+    private:
+        struct UpdateJob final
+        {
+            UpdateJob(UpdateScheduler *const scheduler0,
+                      const std::string &name0,
+                      const unsigned long hash0) :
+                scheduler(scheduler0),
+                download(nullptr),
+                name(name0),
+                hash(hash0),
+                total(0),
+                now(0),
+                state(UpdateJobState::Verify)
+            {
+            }
+
+            A_DELETE_COPY(UpdateJob)
+
+            UpdateScheduler *scheduler;
+            Download *download;
+            std::string name;
+            unsigned long hash;
+            size_t total;
+            size_t now;
+            UpdateJobStateT state;
+        };
+
+        static int verifyThread(void *ptr);
+
+        static int updateProgress(void *ptr,
+                                  const DownloadStatusT status,
+                                  size_t total,
+                                  const size_t now);
+
+        void startDownload(UpdateJob *const job);
+
+        void waitThreads();
+
+        std::string mUpdatesDir;
+        StringVect mHosts;
+        std::vector<UpdateJob*> mJobs;
+        std::vector<SDL_Thread*> mThreads;
+        std::string mError;
+        std::string mLabel;
+        // shared with download and verify threads
+        Mutex mMutex;
+        size_t mVerifyIndex;
+        int mMaxDownloads;
+        unsigned int mCompleted;
+        float mProgress;
+        bool mCheckHash;
+        bool mNoCache;
+        bool mCancel;
+        bool mFailed;
+        bool mDone;
+};
+
+}  // namespace Net
+
+#endif  // NET_UPDATESCHEDULER_H
@@ -21,6 +21,7 @@
  */
 
 #include "configuration.h"
+#include "settings.h"
 
 #include "gui/viewport.h"
 
@@ -81,6 +82,9 @@ bool ParticleEngine::update() restrict2
     if (mChildParticles.empty() || !mMap)
         return true;
 
+    // particles moving and fading all time
+    settings.needRedraw = true;
+
     // Update child particles
 
     const int cameraX = viewport->getCameraX();
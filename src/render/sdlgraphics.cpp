@@ -26,6 +26,7 @@
 
 #include "graphicsmanager.h"
 
+#include "utils/sdlalphablit.h"
 #include "utils/sdlcheckutils.h"
 
 #include "utils/sdlpixel.h"
@@ -96,7 +97,8 @@ void SDLGraphics::drawRescaledImage(const Image *restrict const image,
         0
     };
 
-    SDL_BlitSurface(tmpImage->mSDLSurface, &srcRect, mWindow, &dstRect);
+    SDLBlitImage(image, tmpImage->mSDLSurface, &srcRect,
+        mWindow, &dstRect, false);
     delete tmpImage;
 }
 
@@ -189,7 +191,7 @@ void SDLGraphics::drawImageInline(const Image *restrict const image,
             CAST_U16(h)
         };
 
-        SDL_LowerBlit(src, &srcRect, mWindow, &dstRect);
+        SDLBlitImage(image, src, &srcRect, mWindow, &dstRect, true);
     }
 }
 
@@ -282,7 +284,7 @@ void SDLGraphics::drawImageCached(const Image *restrict const image,
             CAST_U16(h)
         };
 
-        SDL_LowerBlit(src, &srcRect, mWindow, &dstRect);
+        SDLBlitImage(image, src, &srcRect, mWindow, &dstRect, true);
     }
 }
 
@@ -387,7 +389,8 @@ void SDLGraphics::drawPatternCached(const Image *restrict const image,
                         CAST_U16(h2)
                     };
 
-                    SDL_LowerBlit(src, &srcRect, mWindow, &dstRect);
+                    SDLBlitImage(image, src, &srcRect,
+                        mWindow, &dstRect, true);
                 }
 
 //            SDL_BlitSurface(image->mSDLSurface, &srcRect, mWindow, &dstRect);
@@ -508,7 +511,8 @@ void SDLGraphics::drawPatternInline(const Image *restrict const image,
                         CAST_U16(h2)
                     };
 
-                    SDL_LowerBlit(src, &srcRect, mWindow, &dstRect);
+                    SDLBlitImage(image, src, &srcRect,
+                        mWindow, &dstRect, true);
                 }
 
 //            SDL_BlitSurface(image->mSDLSurface, &srcRect, mWindow, &dstRect);
@@ -575,8 +579,8 @@ void SDLGraphics::drawRescaledPattern(const Image *restrict const image,
                 0
             };
 
-            SDL_BlitSurface(tmpImage->mSDLSurface, &srcRect,
-                            mWindow, &dstRect);
+            SDLBlitImage(image, tmpImage->mSDLSurface, &srcRect,
+                mWindow, &dstRect, false);
         }
     }
 
@@ -750,8 +754,8 @@ void SDLGraphics::drawTileCollection(const ImageCollection
         const DoubleRects::const_iterator it2_end = rects->end();
         while (it2 != it2_end)
         {
-            SDL_LowerBlit(img->mSDLSurface, &(*it2)->src,
-                mWindow, &(*it2)->dst);
+            SDLBlitImage(img, img->mSDLSurface, &(*it2)->src,
+                mWindow, &(*it2)->dst, true);
             ++ it2;
         }
     }
@@ -769,7 +773,8 @@ void SDLGraphics::drawTileVertexes(const ImageVertexes *
     const DoubleRects::const_iterator it_end = rects->end();
     while (it != it_end)
     {
-        SDL_LowerBlit(img->mSDLSurface, &(*it)->src, mWindow, &(*it)->dst);
+        SDLBlitImage(img, img->mSDLSurface, &(*it)->src,
+            mWindow, &(*it)->dst, true);
         ++ it;
     }
 }
@@ -24,6 +24,8 @@
 
 #ifndef USE_SDL2
 #include "resources/surfaceimagehelper.h"
+
+#include "utils/sdlalphablit.h"
 #endif  // USE_SDL2
 
 #include "resources/image/image.h"
@@ -43,6 +45,63 @@ SurfaceGraphics::~SurfaceGraphics()
 {
 }
 
+#ifndef USE_SDL2
+// combine mode copies source alpha to target, so image alpha applied
+// to temporary copy of source pixels
+static void combineImage(const Image *restrict const image,
+                         SDL_Surface *restrict const src,
+                         SDL_Rect *restrict const srcRect,
+                         SDL_Surface *restrict const dst,
+                         SDL_Rect *restrict const dstRect)
+{
+    if (image->mAlpha == 1.0F ||
+        src->format->BytesPerPixel != 4)
+    {
+        SurfaceImageHelper::combineSurface(src, srcRect, dst, dstRect);
+        return;
+    }
+
+    const int width = srcRect->w;
+    const int height = srcRect->h;
+    SDL_Surface *const tmp = surfaceImageHelper->create32BitSurface(
+        width, height);
+    if (!tmp)
+        return;
+
+    const uint32_t alpha = CAST_U32(255 * image->mAlpha);
+    const bool hasAlpha = image->isHasAlphaChannel();
+    if (SDL_MUSTLOCK(src))
+        SDL_LockSurface(src);
+    for (int y = 0; y < height; y ++)
+    {
+        const uint32_t *const srcRow = reinterpret_cast<const uint32_t*>(
+            static_cast<const uint8_t*>(src->pixels)
+            + CAST_SIZE((srcRect->y + y) * src->pitch)) + srcRect->x;
+        uint32_t *const dstRow = reinterpret_cast<uint32_t*>(
+            static_cast<uint8_t*>(tmp->pixels)
+            + CAST_SIZE(y * tmp->pitch));
+        for (int x = 0; x < width; x ++)
+        {
+            uint8_t r = 0;
+            uint8_t g = 0;
+            uint8_t b = 0;
+            uint8_t a = 255;
+            if (hasAlpha)
+                SDL_GetRGBA(srcRow[x], src->format, &r, &g, &b, &a);
+            else
+                SDL_GetRGB(srcRow[x], src->format, &r, &g, &b);
+            dstRow[x] = SDL_MapRGBA(tmp->format, r, g, b,
+                CAST_U8((a * alpha + 255) >> 8));
+        }
+    }
+    if (SDL_MUSTLOCK(src))
+        SDL_UnlockSurface(src);
+
+    SurfaceImageHelper::combineSurface(tmp, nullptr, dst, dstRect);
+    MSDL_FreeSurface(tmp);
+}
+#endif  // USE_SDL2
+
 void SurfaceGraphics::drawImage(const Image *restrict const image,
                                 int dstX, int dstY) restrict2
 {
@@ -67,12 +126,12 @@ void SurfaceGraphics::drawImage(const Image *restrict const image,
 
     if (mBlitMode == BlitMode::BLIT_NORMAL)
     {
-        SDL_BlitSurface(image->mSDLSurface, &srcRect, mTarget, &dstRect);
+        SDLBlitImage(image, image->mSDLSurface, &srcRect,
+            mTarget, &dstRect, false);
     }
     else
     {
-        SurfaceImageHelper::combineSurface(image->mSDLSurface,
-            &srcRect, mTarget, &dstRect);
+        combineImage(image, image->mSDLSurface, &srcRect, mTarget, &dstRect);
     }
 #endif  // USE_SDL2
 }
@@ -100,7 +159,8 @@ void SurfaceGraphics::copyImage(const Image *restrict const image,
     SDL_BlitSurface(image->mSDLSurface, &srcRect, mTarget, &dstRect);
 #else  // USE_SDL2
 
-    SDL_BlitSurface(image->mSDLSurface, &srcRect, mTarget, &dstRect);
+    SDLBlitImage(image, image->mSDLSurface, &srcRect,
+        mTarget, &dstRect, false);
 #endif  // USE_SDL2
 }
 
@@ -129,12 +189,12 @@ void SurfaceGraphics::drawImageCached(const Image *restrict const image,
 
     if (mBlitMode == BlitMode::BLIT_NORMAL)
     {
-        SDL_BlitSurface(image->mSDLSurface, &srcRect, mTarget, &dstRect);
+        SDLBlitImage(image, image->mSDLSurface, &srcRect,
+            mTarget, &dstRect, false);
     }
     else
     {
-        SurfaceImageHelper::combineSurface(image->mSDLSurface, &srcRect,
-            mTarget, &dstRect);
+        combineImage(image, image->mSDLSurface, &srcRect, mTarget, &dstRect);
     }
 #endif  // USE_SDL2
 }
@@ -0,0 +1,364 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef USE_OPENGL
+
+#include "resources/atlas/atlascache.h"
+
+#include "logger.h"
+#include "settings.h"
+
+#include "resources/atlas/textureatlas.h"
+
+#include "utils/files.h"
+#include "utils/mkdir.h"
+#include "utils/physfstools.h"
+#include "utils/sdlcheckutils.h"
+#include "utils/stringutils.h"
+
+#include <fstream>
+
+#include <SDL_endian.h>
+
+#include <zlib.h>
+
+#include "debug.h"
+
+// file format: magic, version, hash, then for each atlas:
+// name, width, height, items count, items (name, x, y, width, height),
+// compressed pixels size, zlib compressed RGBA pixels
+static const int atlasCacheMagic = 0x4c544143;
+static const int atlasCacheVersion = 1;
+
+AtlasCache::AtlasCache(const std::string &name,
+                       const uint32_t hash) :
+    mFileName(),
+    mData(),
+    mPos(0),
+    mHash(hash),
+    mLoaded(false),
+    mValid(true)
+{
+    std::string fileName = name;
+    replaceAll(fileName, "/", "_");
+    mFileName = getCacheDir().append(fileName).append(".bin");
+    load();
+}
+
+std::string AtlasCache::getCacheDir()
+{
+    return settings.localDataDir + "/cache/atlases/";
+}
+
+uint32_t AtlasCache::calcFilesHash(const StringVect &files,
+                                   const int size)
+{
+    uLong hash = adler32(0L, Z_NULL, 0);
+    hash = adler32(hash,
+        reinterpret_cast<const Bytef*>(&size),
+        CAST_U32(sizeof(size)));
+    FOR_EACH (StringVectCIter, it, files)
+    {
+        const std::string &str = *it;
+        // name with dye
+        hash = adler32(hash,
+            reinterpret_cast<const Bytef*>(str.c_str()),
+            CAST_U32(str.size()));
+
+        const size_t p = str.find('|');
+        int fileSize = 0;
+        void *const data = PhysFs::loadFile(
+            p != std::string::npos ? str.substr(0, p) : str,
+            fileSize);
+        if (!data)
+            continue;
+        hash = adler32(hash,
+            static_cast<const Bytef*>(data),
+            CAST_U32(fileSize));
+        free(data);
+    }
+    return CAST_U32(hash);
+}
+
+void AtlasCache::load()
+{
+    std::ifstream file;
+    file.open(mFileName.c_str(), std::ios::in | std::ios::binary);
+    if (!file.is_open())
+        return;
+
+    file.seekg(0, std::ios::end);
+    const int size = CAST_S32(file.tellg());
+    if (size < 3 * CAST_S32(sizeof(int)))
+        return;
+    file.seekg(0, std::ios::beg);
+    mData.resize(size);
+    file.read(&mData[0], size);
+    file.close();
+
+    int magic = 0;
+    int version = 0;
+    int hash = 0;
+    if (!readInt(magic) ||
+        !readInt(version) ||
+        !readInt(hash) ||
+        magic != atlasCacheMagic ||
+        version != atlasCacheVersion ||
+        CAST_U32(hash) != mHash)
+    {
+        logger->log("Outdated atlas cache: %s", mFileName.c_str());
+        mData.clear();
+        mPos = 0;
+        return;
+    }
+    mLoaded = true;
+}
+
+bool AtlasCache::readInt(int &val)
+{
+    if (mPos + sizeof(int) > mData.size())
+        return false;
+    memcpy(&val, &mData[mPos], sizeof(int));
+    mPos += sizeof(int);
+    return true;
+}
+
+bool AtlasCache::readString(std::string &str)
+{
+    int len = 0;
+    if (!readInt(len) ||
+        len < 0 ||
+        mPos + CAST_SIZE(len) > mData.size())
+    {
+        return false;
+    }
+    str.assign(&mData[mPos], CAST_SIZE(len));
+    mPos += CAST_SIZE(len);
+    return true;
+}
+
+void AtlasCache::writeInt(const int val)
+{
+    const char *const ptr = reinterpret_cast<const char*>(&val);
+    mData.insert(mData.end(), ptr, ptr + sizeof(int));
+}
+
+void AtlasCache::writeString(const std::string &str)
+{
+    writeInt(CAST_S32(str.size()));
+    mData.insert(mData.end(), str.begin(), str.end());
+}
+
+void AtlasCache::setBroken()
+{
+    logger->log("Broken atlas cache: %s", mFileName.c_str());
+    mLoaded = false;
+    mValid = false;
+}
+
+SDL_Surface *AtlasCache::readAtlas(TextureAtlas *const atlas)
+{
+    if (!mLoaded || !atlas)
+        return nullptr;
+
+    int width = 0;
+    int height = 0;
+    int count = 0;
+    if (!readString(atlas->name) ||
+        !readInt(width) ||
+        !readInt(height) ||
+        !readInt(count) ||
+        width <= 0 ||
+        height <= 0 ||
+        count < 0)
+    {
+        setBroken();
+        return nullptr;
+    }
+    atlas->width = width;
+    atlas->height = height;
+
+    for (int f = 0; f < count; f ++)
+    {
+        AtlasItem *const item = new AtlasItem(nullptr);
+        atlas->items.push_back(item);
+        if (!readString(item->name) ||
+            !readInt(item->x) ||
+            !readInt(item->y) ||
+            !readInt(item->width) ||
+            !readInt(item->height) ||
+            item->x < 0 ||
+            item->y < 0 ||
+            item->x + item->width > width ||
+            item->y + item->height > height)
+        {
+            setBroken();
+            return nullptr;
+        }
+    }
+
+    int compressedSize = 0;
+    if (!readInt(compressedSize) ||
+        compressedSize <= 0 ||
+        mPos + CAST_SIZE(compressedSize) > mData.size())
+    {
+        setBroken();
+        return nullptr;
+    }
+
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+    const unsigned int rmask = 0xff000000;
+    const unsigned int gmask = 0x00ff0000;
+    const unsigned int bmask = 0x0000ff00;
+    const unsigned int amask = 0x000000ff;
+#else  // SDL_BYTEORDER == SDL_BIG_ENDIAN
+
+    const unsigned int rmask = 0x000000ff;
+    const unsigned int gmask = 0x0000ff00;
+    const unsigned int bmask = 0x00ff0000;
+    const unsigned int amask = 0xff000000;
+#endif  // SDL_BYTEORDER == SDL_BIG_ENDIAN
+
+    SDL_Surface *const surface = MSDL_CreateRGBSurface(SDL_SWSURFACE,
+        width, height, 32U, rmask, gmask, bmask, amask);
+    if (!surface)
+    {
+        setBroken();
+        return nullptr;
+    }
+
+    const size_t rowSize = CAST_SIZE(width) * 4;
+    uLongf pixelsSize = static_cast<uLongf>(rowSize * height);
+    if (CAST_SIZE(surface->pitch) == rowSize)
+    {
+        if (uncompress(static_cast<Bytef*>(surface->pixels),
+            &pixelsSize,
+            reinterpret_cast<const Bytef*>(&mData[mPos]),
+            compressedSize) != Z_OK ||
+            pixelsSize != rowSize * height)
+        {
+            MSDL_FreeSurface(surface);
+            setBroken();
+            return nullptr;
+        }
+    }
+    else
+    {
+        std::vector<char> pixels(rowSize * height);
+        if (uncompress(reinterpret_cast<Bytef*>(&pixels[0]),
+            &pixelsSize,
+            reinterpret_cast<const Bytef*>(&mData[mPos]),
+            compressedSize) != Z_OK ||
+            pixelsSize != rowSize * height)
+        {
+            MSDL_FreeSurface(surface);
+            setBroken();
+            return nullptr;
+        }
+        for (int y = 0; y < height; y ++)
+        {
+            memcpy(static_cast<char*>(surface->pixels) + y * surface->pitch,
+                &pixels[y * rowSize],
+                rowSize);
+        }
+    }
+    mPos += CAST_SIZE(compressedSize);
+    return surface;
+}
+
+void AtlasCache::addAtlas(const TextureAtlas *const atlas,
+                          const SDL_Surface *const surface)
+{
+    if (mLoaded || !mValid || !atlas || !surface)
+        return;
+
+    if (surface->format->BitsPerPixel != 32)
+    {
+        mValid = false;
+        return;
+    }
+
+    if (mData.empty())
+    {
+        writeInt(atlasCacheMagic);
+        writeInt(atlasCacheVersion);
+        writeInt(CAST_S32(mHash));
+    }
+
+    const int width = surface->w;
+    const int height = surface->h;
+    writeString(atlas->name);
+    writeInt(width);
+    writeInt(height);
+    writeInt(CAST_S32(atlas->items.size()));
+    FOR_EACH (std::vector<AtlasItem*>::const_iterator, it, atlas->items)
+    {
+        const AtlasItem *const item = *it;
+        writeString(item->name);
+        writeInt(item->x);
+        writeInt(item->y);
+        writeInt(item->width);
+        writeInt(item->height);
+    }
+
+    const size_t rowSize = CAST_SIZE(width) * 4;
+    std::vector<char> pixels(rowSize * height);
+    for (int y = 0; y < height; y ++)
+    {
+        memcpy(&pixels[y * rowSize],
+            static_cast<const char*>(surface->pixels) + y * surface->pitch,
+            rowSize);
+    }
+
+    uLongf compressedSize = compressBound(
+        static_cast<uLong>(pixels.size()));
+    std::vector<char> compressed(compressedSize);
+    if (compress2(reinterpret_cast<Bytef*>(&compressed[0]),
+        &compressedSize,
+        reinterpret_cast<const Bytef*>(&pixels[0]),
+        static_cast<uLong>(pixels.size()),
+        Z_BEST_SPEED) != Z_OK)
+    {
+        mValid = false;
+        return;
+    }
+    writeInt(CAST_S32(compressedSize));
+    mData.insert(mData.end(),
+        compressed.begin(),
+        compressed.begin() + compressedSize);
+}
+
+void AtlasCache::save() const
+{
+    if (mLoaded || !mValid || mData.empty())
+        return;
+
+    if (mkdir_r(getCacheDir().c_str()))
+    {
+        logger->log("Error creating atlas cache directory: %s",
+            getCacheDir().c_str());
+        return;
+    }
+
+    if (!Files::writeFileAtomic(mFileName, &mData[0], mData.size()))
+        logger->log("Error saving atlas cache: %s", mFileName.c_str());
+}
+
+#endif  // USE_OPENGL
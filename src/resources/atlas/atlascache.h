@@ -0,0 +1,105 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RESOURCES_ATLAS_ATLASCACHE_H
+#define RESOURCES_ATLAS_ATLASCACHE_H
+
+#ifdef USE_OPENGL
+
+#include "utils/stringvector.h"
+
+#include "localconsts.h"
+
+struct SDL_Surface;
+struct TextureAtlas;
+
+/**
+ * Cache for composed atlas pixels and atlas items positions.
+ * All atlases with same name stored in one file.
+ * Cache file invalidated if any source image or atlas size changed.
+ */
+class AtlasCache final
+{
+    public:
+        AtlasCache(const std::string &name,
+                   const uint32_t hash);
+
+        A_DELETE_COPY(AtlasCache)
+
+        /**
+         * Returns true if valid cache file was loaded.
+         */
+        bool isLoaded() const A_WARN_UNUSED
+        { return mLoaded; }
+
+        /**
+         * Returns true if all cached atlases was read.
+         */
+        bool isEnd() const A_WARN_UNUSED
+        { return mPos >= mData.size(); }
+
+        /**
+         * Reads next atlas items and returns surface with atlas pixels.
+         * On error cache disabled and nullptr returned.
+         */
+        SDL_Surface *readAtlas(TextureAtlas *const atlas) A_WARN_UNUSED;
+
+        /**
+         * Adds composed atlas for saving.
+         */
+        void addAtlas(const TextureAtlas *const atlas,
+                      const SDL_Surface *const surface);
+
+        /**
+         * Saves added atlases to cache file.
+         */
+        void save() const;
+
+        /**
+         * Calculates hash of atlas source files.
+         */
+        static uint32_t calcFilesHash(const StringVect &files,
+                                      const int size) A_WARN_UNUSED;
+
+        static std::string getCacheDir() A_WARN_UNUSED;
+
+    private:
+        void load();
+
+        bool readInt(int &val) A_WARN_UNUSED;
+
+        bool readString(std::string &str) A_WARN_UNUSED;
+
+        void writeInt(const int val);
+
+        void writeString(const std::string &str);
+
+        void setBroken();
+
+        std::string mFileName;
+        std::vector<char> mData;
+        size_t mPos;
+        uint32_t mHash;
+        bool mLoaded;
+        bool mValid;
+};
+
+#endif  // USE_OPENGL
+#endif  // RESOURCES_ATLAS_ATLASCACHE_H
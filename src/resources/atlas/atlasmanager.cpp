@@ -35,6 +35,7 @@
 
 #include "resources/openglimagehelper.h"
 
+#include "resources/atlas/atlascache.h"
 #include "resources/atlas/atlasresource.h"
 #include "resources/atlas/textureatlas.h"
 
@@ -48,8 +49,152 @@
 
 #include "utils/checkutils.h"
 
+#include <algorithm>
+
 #include "debug.h"
 
+namespace
+{
+    struct SkylineNode final
+    {
+        SkylineNode(const int x0,
+                    const int y0,
+                    const int width0) :
+            x(x0),
+            y(y0),
+            width(width0)
+        {
+        }
+
+        int x;
+        int y;
+        int width;
+    };
+
+    typedef std::vector<SkylineNode> Skyline;
+
+    class ImageHeightSorter final
+    {
+        public:
+            bool operator() (const Image *const image1,
+                             const Image *const image2) const
+            {
+                if (image1->mBounds.h != image2->mBounds.h)
+                    return image1->mBounds.h > image2->mBounds.h;
+                return image1->mBounds.w > image2->mBounds.w;
+            }
+    } imageHeightSorter;
+}  // namespace
+
+// return top y where rectangle can be placed at skyline node or -1
+static int skylineFit(const Skyline &skyline,
+                      const size_t index,
+                      const int width,
+                      const int height,
+                      const int size)
+{
+    const int x = skyline[index].x;
+    if (x + width > size)
+        return -1;
+
+    int widthLeft = width;
+    int y = skyline[index].y;
+    const size_t sz = skyline.size();
+    for (size_t f = index; widthLeft > 0; f ++)
+    {
+        if (f >= sz)
+            return -1;
+        const SkylineNode &node = skyline[f];
+        if (node.y > y)
+            y = node.y;
+        if (y + height > size)
+            return -1;
+        widthLeft -= node.width;
+    }
+    return y;
+}
+
+static void skylineAdd(Skyline &skyline,
+                       const size_t index,
+                       const int x,
+                       const int y,
+                       const int width)
+{
+    skyline.insert(skyline.begin() + index, SkylineNode(x, y, width));
+
+    // cut nodes covered by new node
+    size_t f = index + 1;
+    while (f < skyline.size())
+    {
+        const SkylineNode &prev = skyline[f - 1];
+        SkylineNode &node = skyline[f];
+        const int prevEnd = prev.x + prev.width;
+        if (node.x >= prevEnd)
+            break;
+        const int shrink = prevEnd - node.x;
+        if (node.width <= shrink)
+        {
+            skyline.erase(skyline.begin() + f);
+            continue;
+        }
+        node.x += shrink;
+        node.width -= shrink;
+        break;
+    }
+
+    // merge nodes with same height
+    f = 0;
+    while (f + 1 < skyline.size())
+    {
+        if (skyline[f].y == skyline[f + 1].y)
+        {
+            skyline[f].width += skyline[f + 1].width;
+            skyline.erase(skyline.begin() + f + 1);
+        }
+        else
+        {
+            f ++;
+        }
+    }
+}
+
+// bottom left skyline packing
+static bool skylineInsert(Skyline &skyline,
+                          const int width,
+                          const int height,
+                          const int size,
+                          int &x,
+                          int &y)
+{
+    const size_t sz = skyline.size();
+    size_t bestIndex = sz;
+    int bestTop = size + 1;
+    int bestWidth = size + 1;
+    int bestY = 0;
+    for (size_t f = 0; f < sz; f ++)
+    {
+        const int y0 = skylineFit(skyline, f, width, height, size);
+        if (y0 < 0)
+            continue;
+        const int top = y0 + height;
+        if (top < bestTop ||
+            (top == bestTop && skyline[f].width < bestWidth))
+        {
+            bestIndex = f;
+            bestTop = top;
+            bestWidth = skyline[f].width;
+            bestY = y0;
+        }
+    }
+    if (bestIndex == sz)
+        return false;
+
+    x = skyline[bestIndex].x;
+    y = bestY;
+    skylineAdd(skyline, bestIndex, x, y + height, width);
+    return true;
+}
+
 AtlasManager::AtlasManager()
 {
 }
@@ -62,7 +207,6 @@ AtlasResource *AtlasManager::loadTextureAtlas(const std::string &name,
     std::vector<Image*> images;
     AtlasResource *resource = new AtlasResource;
 
-    loadImages(files, images);
     int maxSize = OpenGLImageHelper::getTextureSize();
 #if !defined(ANDROID) && !defined(__APPLE__)
     int sz = settings.textureSize;
@@ -70,8 +214,23 @@ AtlasResource *AtlasManager::loadTextureAtlas(const std::string &name,
         maxSize = sz;
 #endif  // !defined(ANDROID) && !defined(__APPLE__)
 
+    AtlasCache cache(name, AtlasCache::calcFilesHash(files, maxSize));
+    if (cache.isLoaded())
+    {
+        if (loadCachedAtlases(cache, files, resource))
+        {
+            BLOCK_END("AtlasManager::loadTextureAtlas")
+            return resource;
+        }
+        // release already converted atlases and images
+        delete resource;
+        resource = new AtlasResource;
+    }
+
+    loadImages(files, images);
+
     // sorting images on atlases.
-    simpleSort(name, atlases, images, maxSize);
+    skylineSort(name, atlases, images, maxSize);
 
     FOR_EACH (std::vector<TextureAtlas*>::iterator, it, atlases)
     {
@@ -79,17 +238,56 @@ AtlasResource *AtlasManager::loadTextureAtlas(const std::string &name,
         if (!atlas)
             continue;
 
-        createSDLAtlas(atlas);
+        SDL_Surface *const surface = createSDLAtlas(atlas);
+        if (!surface)
+            continue;
+        cache.addAtlas(atlas, surface);
+        uploadAtlas(atlas, surface);
+        MSDL_FreeSurface(surface);
         if (atlas->atlasImage == nullptr)
             continue;
         convertAtlas(atlas);
         resource->atlases.push_back(atlas);
     }
+    cache.save();
 
     BLOCK_END("AtlasManager::loadTextureAtlas")
     return resource;
 }
 
+bool AtlasManager::loadCachedAtlases(AtlasCache &cache,
+                                     const StringVect &files,
+                                     AtlasResource *const resource)
+{
+    BLOCK_START("AtlasManager::loadCachedAtlases")
+    FOR_EACH (StringVectCIter, it, files)
+        removeTempResource(*it);
+
+    while (!cache.isEnd())
+    {
+        TextureAtlas *const atlas = new TextureAtlas();
+        resource->atlases.push_back(atlas);
+        SDL_Surface *const surface = cache.readAtlas(atlas);
+        if (!surface)
+        {
+            BLOCK_END("AtlasManager::loadCachedAtlases")
+            return false;
+        }
+        uploadAtlas(atlas, surface);
+        MSDL_FreeSurface(surface);
+        if (atlas->atlasImage == nullptr)
+        {
+            BLOCK_END("AtlasManager::loadCachedAtlases")
+            return false;
+        }
+        convertAtlas(atlas);
+    }
+    logger->log("Loaded %d atlases from cache",
+        CAST_S32(resource->atlases.size()));
+    BLOCK_END("AtlasManager::loadCachedAtlases")
+    return true;
+}
+
 AtlasResource *AtlasManager::loadEmptyAtlas(const std::string &name,
                                             const StringVect &files)
 {
@@ -101,7 +299,7 @@ AtlasResource *AtlasManager::loadEmptyAtlas(const std::string &name,
     int maxSize = OpenGLImageHelper::getTextureSize();
 
     // sorting images on atlases.
-    simpleSort(name, atlases, images, maxSize);
+    skylineSort(name, atlases, images, maxSize);
 
     FOR_EACH (std::vector<TextureAtlas*>::iterator, it, atlases)
     {
@@ -122,6 +320,19 @@ AtlasResource *AtlasManager::loadEmptyAtlas(const std::string &name,
     return resource;
 }
 
+void AtlasManager::removeTempResource(const std::string &name)
+{
+    // check is image with same name already in cache
+    // and if yes, move it to deleted set
+    Resource *const res = resourceManager->getTempResource(name);
+    if (res)
+    {
+        // increase counter because in moveToDeleted it will be decreased.
+        res->incRef();
+        resourceManager->moveToDeleted(res);
+    }
+}
+
 void AtlasManager::loadImages(const StringVect &files,
                               std::vector<Image*> &images)
 {
@@ -130,15 +341,7 @@ void AtlasManager::loadImages(const StringVect &files,
     FOR_EACH (StringVectCIter, it, files)
     {
         const std::string str = *it;
-        // check is image with same name already in cache
-        // and if yes, move it to deleted set
-        Resource *const res = resourceManager->getTempResource(str);
-        if (res)
-        {
-            // increase counter because in moveToDeleted it will be decreased.
-            res->incRef();
-            resourceManager->moveToDeleted(res);
-        }
+        removeTempResource(str);
 
         std::string path = str;
         const size_t p = path.find('|');
@@ -179,15 +382,7 @@ void AtlasManager::loadEmptyImages(const StringVect &files,
     FOR_EACH (StringVectCIter, it, files)
     {
         const std::string str = *it;
-        // check is image with same name already in cache
-        // and if yes, move it to deleted set
-        Resource *const res = resourceManager->getTempResource(str);
-        if (res)
-        {
-            // increase counter because in moveToDeleted it will be decreased.
-            res->incRef();
-            resourceManager->moveToDeleted(res);
-        }
+        removeTempResource(str);
 
         Image *const image = new Image(0,
             2048, 2048,
@@ -198,78 +393,67 @@ void AtlasManager::loadEmptyImages(const StringVect &files,
     BLOCK_END("AtlasManager::loadEmptyImages")
 }
 
-void AtlasManager::simpleSort(const std::string &restrict name,
-                              std::vector<TextureAtlas*> &restrict atlases,
-                              const std::vector<Image*> &restrict images,
-                              int size)
+void AtlasManager::skylineSort(const std::string &restrict name,
+                               std::vector<TextureAtlas*> &restrict atlases,
+                               const std::vector<Image*> &restrict images,
+                               int size)
 {
-    BLOCK_START("AtlasManager::simpleSort")
-    int x = 0;
-    int y = 0;
-    int tempHeight = 0;
-    TextureAtlas *atlas = new TextureAtlas();
-    std::vector<Image*>::const_iterator it = images.begin();
-    const std::vector<Image*>::const_iterator it_end = images.end();
-    for (it = images.begin(); it != it_end; ++ it)
+    BLOCK_START("AtlasManager::skylineSort")
+    // packing high images first give much less empty space
+    std::vector<Image*> sorted;
+    sorted.reserve(images.size());
+    FOR_EACH (std::vector<Image*>::const_iterator, it, images)
     {
-        const Image *const img = *it;
-        if (img)
-        {
-            atlas->name = std::string("atlas_").append(name).append(
-                "_").append(img->getIdPath());
-            break;
-        }
+        if (*it)
+            sorted.push_back(*it);
     }
+    std::stable_sort(sorted.begin(), sorted.end(), imageHeightSorter);
 
-    for (it = images.begin(); it != it_end; ++ it)
+    TextureAtlas *atlas = nullptr;
+    Skyline skyline;
+    FOR_EACH (std::vector<Image*>::const_iterator, it, sorted)
     {
         Image *const img = *it;
-        if (img)
+        const int width = img->mBounds.w;
+        const int height = img->mBounds.h;
+        int x = 0;
+        int y = 0;
+        if (!atlas || !skylineInsert(skyline, width, height, size, x, y))
         {
-            AtlasItem *const item = new AtlasItem(img);
-            item->name = img->getIdPath();
-            // start next line
-            if (x + img->mBounds.w > size)
-            {
-                x = 0;
-                y += tempHeight;
-                tempHeight = 0;
-            }
-
-            // can't put image with this height
-            if (y + img->mBounds.h > size)
+            if (atlas)
+                atlases.push_back(atlas);
+            atlas = new TextureAtlas();
+            atlas->name = std::string("atlas_").append(name).append(
+                "_").append(img->getIdPath());
+            skyline.clear();
+            skyline.push_back(SkylineNode(0, 0, size));
+            if (!skylineInsert(skyline, width, height, size, x, y))
             {
+                // image bigger than atlas. put it alone in atlas.
                 x = 0;
                 y = 0;
-                atlases.push_back(atlas);
-                atlas = new TextureAtlas();
-                atlas->name = std::string("atlas_").append(name).append(
-                    "_").append(img->getIdPath());
+                skyline.clear();
+                skyline.push_back(SkylineNode(0, size, size));
             }
+        }
 
-            if (img->mBounds.h > tempHeight)
-                tempHeight = img->mBounds.h;
-
-            item->x = x;
-            item->y = y;
-            atlas->items.push_back(item);
+        AtlasItem *const item = new AtlasItem(img);
+        item->name = img->getIdPath();
+        item->x = x;
+        item->y = y;
+        atlas->items.push_back(item);
 
-            // continue put textures in line
-            x += img->mBounds.w;
-            if (x > atlas->width)
-                atlas->width = x;
-            if (y + img->mBounds.h > atlas->height)
-                atlas->height = y + img->mBounds.h;
-        }
+        if (x + width > atlas->width)
+            atlas->width = x + width;
+        if (y + height > atlas->height)
+            atlas->height = y + height;
     }
-    if (!atlas->items.empty())
+    if (atlas)
         atlases.push_back(atlas);
-    else
-        delete atlas;
-    BLOCK_END("AtlasManager::simpleSort")
+    BLOCK_END("AtlasManager::skylineSort")
 }
 
-void AtlasManager::createSDLAtlas(TextureAtlas *const atlas)
+SDL_Surface *AtlasManager::createSDLAtlas(TextureAtlas *const atlas)
 {
     BLOCK_START("AtlasManager::createSDLAtlas")
 #if SDL_BYTEORDER == SDL_BIG_ENDIAN
@@ -290,7 +474,7 @@ void AtlasManager::createSDLAtlas(TextureAtlas *const atlas)
     {
         logger->log("Skip atlas creation because only one image in atlas.");
         BLOCK_END("AtlasManager::createSDLAtlas")
-        return;
+        return nullptr;
     }
 
     // using only power of two sizes.
@@ -309,30 +493,57 @@ void AtlasManager::createSDLAtlas(TextureAtlas *const atlas)
             width,
             height);
         BLOCK_END("AtlasManager::createSDLAtlas")
-        return;
+        return nullptr;
     }
     BLOCK_END("AtlasManager::createSDLAtlas create surface")
 
-    Image *image = imageHelper->loadSurface(surface);
-    // free SDL atlas surface
-    MSDL_FreeSurface(surface);
-    if (image == nullptr)
-    {
-        reportAlways("Error converting surface to texture. Size: %dx%d",
-            width,
-            height);
-        return;
-    }
-
     // drawing SDL images to surface
+    int usedArea = 0;
     FOR_EACH (std::vector<AtlasItem*>::iterator, it, atlas->items)
     {
         AtlasItem *const item = *it;
-        imageHelper->copySurfaceToImage(image, item->x, item->y,
-            item->image->mSDLSurface);
+        SDL_Surface *const src = item->image->mSDLSurface;
+        if (!src)
+            continue;
+#ifdef USE_SDL2
+        SDL_SetSurfaceAlphaMod(src, SDL_ALPHA_OPAQUE);
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+#else  // USE_SDL2
+
+        // copy alpha channel to destination instead of blending
+        SDL_SetAlpha(src, 0, SDL_ALPHA_OPAQUE);
+#endif  // USE_SDL2
+
+        SDL_Rect rect;
+        rect.x = CAST_S16(item->x);
+        rect.y = CAST_S16(item->y);
+        rect.w = CAST_U16(item->width);
+        rect.h = CAST_U16(item->height);
+        SDL_BlitSurface(src, nullptr, surface, &rect);
+        usedArea += item->width * item->height;
     }
-    atlas->atlasImage = image;
+    logger->log("Atlas %s: %dx%d, %d images, fill rate %d%%",
+        atlas->name.c_str(),
+        width,
+        height,
+        CAST_S32(atlas->items.size()),
+        usedArea * 100 / (width * height));
     BLOCK_END("AtlasManager::createSDLAtlas")
+    return surface;
+}
+
+void AtlasManager::uploadAtlas(TextureAtlas *const atlas,
+                               SDL_Surface *const surface)
+{
+    Image *const image = imageHelper->loadSurface(surface);
+    if (image == nullptr)
+    {
+        reportAlways("Error converting surface to texture. Size: %dx%d",
+            surface->w,
+            surface->h);
+        return;
+    }
+    atlas->atlasImage = image;
 }
 
 void AtlasManager::convertAtlas(TextureAtlas *const atlas)
@@ -27,6 +27,7 @@
 
 #include "utils/stringvector.h"
 
+class AtlasCache;
 class AtlasResource;
 
 struct AtlasItem;
@@ -52,18 +53,29 @@ class AtlasManager final
         static void moveToDeleted(AtlasResource *const resource);
 
     private:
+        static bool loadCachedAtlases(AtlasCache &cache,
+                                      const StringVect &files,
+                                      AtlasResource *const resource)
+                                      A_NONNULL(3);
+
+        static void removeTempResource(const std::string &name);
+
         static void loadImages(const StringVect &files,
                                std::vector<Image*> &images);
 
         static void loadEmptyImages(const StringVect &files,
                                     std::vector<Image*> &images);
 
-        static void simpleSort(const std::string &restrict name,
-                               std::vector<TextureAtlas*> &restrict atlases,
-                               const std::vector<Image*> &restrict images,
-                               int size);
+        static void skylineSort(const std::string &restrict name,
+                                std::vector<TextureAtlas*> &restrict atlases,
+                                const std::vector<Image*> &restrict images,
+                                int size);
+
+        static SDL_Surface *createSDLAtlas(TextureAtlas *const atlas)
+                                           A_NONNULL(1);
 
-        static void createSDLAtlas(TextureAtlas *const atlas) A_NONNULL(1);
+        static void uploadAtlas(TextureAtlas *const atlas,
+                                SDL_Surface *const surface) A_NONNULL(1, 2);
 
         static void convertAtlas(TextureAtlas *const atlas) A_NONNULL(1);
 };
@@ -99,6 +99,9 @@ class BeingInfo final
         const SoundInfo &getSound(const ItemSoundEvent::Type event)
                                   const A_WARN_UNUSED;
 
+        const ItemSoundEvents &getSounds() const A_WARN_UNUSED
+        { return mSounds; }
+
         void addAttack(const int id,
                        const std::string &action,
                        const std::string &skyAttack,
@@ -22,19 +22,18 @@
 
 #include "resources/image/image.h"
 
+#ifdef DEBUG_IMAGES
 #include "logger.h"
+#endif  // DEBUG_IMAGES
 
 #ifdef USE_OPENGL
 #include "resources/openglimagehelper.h"
 #endif  // USE_OPENGL
 
-#include "resources/memorymanager.h"
-#include "resources/sdlimagehelper.h"
+#include "resources/imagehelper.h"
 
 #include "resources/image/subimage.h"
 
-#include "resources/resourcemanager/resourcemanager.h"
-
 #include "utils/sdlcheckutils.h"
 
 #ifdef USE_SDL2
@@ -58,11 +57,8 @@ Image::Image(SDL_Texture *restrict const image,
     mAlpha(1.0F),
     mSDLSurface(nullptr),
     mTexture(image),
-    mAlphaChannel(nullptr),
-    mAlphaCache(),
     mLoaded(false),
     mHasAlphaChannel(false),
-    mUseAlphaCache(false),
     mIsAlphaVisible(true),
     mIsAlphaCalculated(false)
 {
@@ -88,8 +84,8 @@ Image::Image(SDL_Texture *restrict const image,
 }
 #endif  // USE_SDL2
 
-Image::Image(SDL_Surface *restrict const image, const bool hasAlphaChannel0,
-             uint8_t *restrict const alphaChannel) :
+Image::Image(SDL_Surface *restrict const image,
+             const bool hasAlphaChannel0) :
     Resource(),
 #ifdef USE_OPENGL
     mGLImage(0),
@@ -102,11 +98,8 @@ Image::Image(SDL_Surface *restrict const image, const bool hasAlphaChannel0,
 #ifdef USE_SDL2
     mTexture(nullptr),
 #endif  // USE_SDL2
-    mAlphaChannel(alphaChannel),
-    mAlphaCache(),
     mLoaded(false),
     mHasAlphaChannel(hasAlphaChannel0),
-    mUseAlphaCache(SDLImageHelper::mEnableAlphaCache),
     mIsAlphaVisible(hasAlphaChannel0),
     mIsAlphaCalculated(false)
 {
@@ -144,11 +137,8 @@ Image::Image(const GLuint glimage, const int width, const int height,
 #ifdef USE_SDL2
     mTexture(nullptr),
 #endif  // USE_SDL2
-    mAlphaChannel(nullptr),
-    mAlphaCache(),
     mLoaded(false),
     mHasAlphaChannel(true),
-    mUseAlphaCache(false),
     mIsAlphaVisible(true),
     mIsAlphaCalculated(false)
 {
@@ -178,32 +168,15 @@ Image::~Image()
     unload();
 }
 
-void Image::SDLCleanCache()
-{
-    for (std::map<float, SDL_Surface*>::iterator
-         i = mAlphaCache.begin(), i_end = mAlphaCache.end();
-         i != i_end; ++i)
-    {
-        if (mSDLSurface != i->second)
-            resourceManager->scheduleDelete(i->second);
-        i->second = nullptr;
-    }
-    mAlphaCache.clear();
-}
-
 void Image::unload()
 {
     mLoaded = false;
 
     if (mSDLSurface)
     {
-        SDLCleanCache();
         // Free the image surface.
         MSDL_FreeSurface(mSDLSurface);
         mSDLSurface = nullptr;
-
-        delete [] mAlphaChannel;
-        mAlphaChannel = nullptr;
     }
 #ifdef USE_SDL2
     if (mTexture)
@@ -239,15 +212,6 @@ bool Image::hasAlphaChannel() const
     return false;
 }
 
-SDL_Surface *Image::getByAlpha(const float alpha)
-{
-    const std::map<float, SDL_Surface*>::const_iterator
-        it = mAlphaCache.find(alpha);
-    if (it != mAlphaCache.end())
-        return (*it).second;
-    return nullptr;
-}
-
 void Image::setAlpha(const float alpha)
 {
     if (mAlpha == alpha || !ImageHelper::mEnableAlpha)
@@ -258,54 +222,10 @@ void Image::setAlpha(const float alpha)
 
     if (mSDLSurface)
     {
-        if (mUseAlphaCache)
-        {
-            SDL_Surface *surface = getByAlpha(mAlpha);
-            if (!surface)
-            {
-                if (mAlphaCache.size() > 100)
-                {
-#ifdef DEBUG_ALPHA_CACHE
-                    logger->log("cleanCache");
-                    for (std::map<float, SDL_Surface*>::const_iterator
-                         i = mAlphaCache.begin(), i_end = mAlphaCache.end();
-                         i != i_end; ++i)
-                    {
-                        logger->log("alpha: " + toString(i->first));
-                    }
-#endif  // DEBUG_ALPHA_CACHE
-
-                    SDLCleanCache();
-                }
-                surface = mSDLSurface;
-                if (surface)
-                    mAlphaCache[mAlpha] = surface;
-            }
-            else
-            {
-                logger->log("cache bug");
-            }
-
-            surface = getByAlpha(alpha);
-            if (surface)
-            {
-                if (mSDLSurface == surface)
-                    logger->log("bug");
-                mAlphaCache.erase(alpha);
-                mSDLSurface = surface;
-                mAlpha = alpha;
-                return;
-            }
-            else
-            {
-                mSDLSurface = SDLImageHelper::SDLDuplicateSurface(mSDLSurface);
-                if (!mSDLSurface)
-                    return;
-            }
-        }
-
         mAlpha = alpha;
 
+        // images with alpha channel keep surface unchanged,
+        // alpha applied by graphics while drawing
         if (!mHasAlphaChannel)
         {
 #ifdef USE_SDL2
@@ -318,74 +238,6 @@ void Image::setAlpha(const float alpha)
                 CAST_U8(255 * mAlpha));
 #endif  // USE_SDL2
         }
-        else
-        {
-            if (SDL_MUSTLOCK(mSDLSurface))
-                SDL_LockSurface(mSDLSurface);
-
-            const int bx = mBounds.x;
-            const int by = mBounds.y;
-            const int bw = mBounds.w;
-            const int bh = mBounds.h;
-            const int bxw = bx + bw;
-            const int sw = mSDLSurface->w;
-            const int maxHeight = std::min(by + bh, mSDLSurface->h);
-            const int maxWidth = std::min(bxw, sw);
-            const int i1 = by * sw + bx;
-            const SDL_PixelFormat * const fmt = mSDLSurface->format;
-            const uint32_t amask = fmt->Amask;
-            const uint32_t invMask = ~fmt->Amask;
-            const uint8_t aloss = fmt->Aloss;
-            const uint8_t ashift = fmt->Ashift;
-
-            if (!bx && bxw == sw)
-            {
-                const int i2 = (maxHeight - 1) * sw + maxWidth - 1;
-                for (int i = i1; i <= i2; i++)
-                {
-                    const uint8_t sourceAlpha = mAlphaChannel[i];
-                    if (sourceAlpha > 0)
-                    {
-                        const uint8_t a = CAST_U8(
-                            static_cast<float>(sourceAlpha) * mAlpha);
-
-                        uint32_t c = (static_cast<uint32_t*>(
-                            mSDLSurface->pixels))[i];
-                        c &= invMask;
-                        c |= ((a >> aloss) << ashift & amask);
-                        (static_cast<uint32_t*>(mSDLSurface->pixels))[i] = c;
-                    }
-                }
-            }
-            else
-            {
-                for (int y = by; y < maxHeight; y ++)
-                {
-                    const int idx = y * sw;
-                    const int x1 = idx + bx;
-                    const int x2 = idx + maxWidth;
-                    for (int i = x1; i < x2; i ++)
-                    {
-                        const uint8_t sourceAlpha = mAlphaChannel[i];
-                        if (sourceAlpha > 0)
-                        {
-                            const uint8_t a = CAST_U8(
-                                static_cast<float>(sourceAlpha) * mAlpha);
-
-                            uint32_t c = (static_cast<uint32_t*>(
-                                mSDLSurface->pixels))[i];
-                            c &= invMask;
-                            c |= ((a >> aloss) << ashift & amask);
-                            (static_cast<uint32_t*>(
-                                mSDLSurface->pixels))[i] = c;
-                        }
-                    }
-                }
-            }
-
-            if (SDL_MUSTLOCK(mSDLSurface))
-                SDL_UnlockSurface(mSDLSurface);
-        }
     }
 #ifdef USE_SDL2
     else if (mTexture)
@@ -466,24 +318,11 @@ Image *Image::getSubImage(const int x, const int y,
 #endif  // USE_SDL2
 }
 
-void Image::SDLTerminateAlphaCache()
-{
-    SDLCleanCache();
-    mUseAlphaCache = false;
-}
-
 int Image::calcMemoryLocal() const
 {
     // +++ this calculation can be wrong for SDL2
-    int sz = static_cast<int>(sizeof(Image) +
-        sizeof(std::map<float, SDL_Surface*>)) +
+    return static_cast<int>(sizeof(Image)) +
         Resource::calcMemoryLocal();
-    if (mSDLSurface)
-    {
-        sz += CAST_S32(mAlphaCache.size()) *
-            memoryManager.getSurfaceSize(mSDLSurface);
-    }
-    return sz;
 }
 
 #ifdef USE_OPENGL
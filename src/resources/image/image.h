@@ -146,16 +146,6 @@ class Image notfinal : public Resource
         Image* SDLgetScaledImage(const int width,
                                  const int height) const A_WARN_UNUSED;
 
-        /**
-         * Get the alpha Channel of a SDL surface.
-         */
-        uint8_t *SDLgetAlphaChannel() const A_WARN_UNUSED
-        { return mAlphaChannel; }
-
-        void SDLCleanCache();
-
-        void SDLTerminateAlphaCache();
-
 #ifdef USE_OPENGL
         int getTextureWidth() const A_WARN_UNUSED
         { return mTexWidth; }
@@ -206,29 +196,21 @@ class Image notfinal : public Resource
         // -----------------------
 
         /** SDL Constructor */
-        Image(SDL_Surface *restrict const image, const bool hasAlphaChannel,
-              uint8_t *restrict const alphaChannel = nullptr);
+        Image(SDL_Surface *restrict const image,
+              const bool hasAlphaChannel);
 
 #ifdef USE_SDL2
         Image(SDL_Texture *restrict const image,
               const int width, const int height);
 #endif  // USE_SDL2
 
-        SDL_Surface *getByAlpha(const float alpha) A_WARN_UNUSED;
-
         SDL_Surface *mSDLSurface;
 #ifdef USE_SDL2
         SDL_Texture *mTexture;
 #endif  // USE_SDL2
 
-        /** Alpha Channel pointer used for 32bit based SDL surfaces */
-        uint8_t *mAlphaChannel;
-
-        std::map<float, SDL_Surface*> mAlphaCache;
-
         bool mLoaded;
         bool mHasAlphaChannel;
-        bool mUseAlphaCache;
         bool mIsAlphaVisible;
         bool mIsAlphaCalculated;
 
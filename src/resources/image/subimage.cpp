@@ -40,10 +40,8 @@ SubImage::SubImage(Image *const parent,
     if (mParent)
     {
         mParent->incRef();
-        mParent->SDLTerminateAlphaCache();
         mHasAlphaChannel = mParent->hasAlphaChannel();
         mIsAlphaVisible = mHasAlphaChannel;
-        mAlphaChannel = mParent->SDLgetAlphaChannel();
         mSource = parent->getIdPath();
 #ifdef DEBUG_IMAGES
         logger->log("set name2 %p, %s", this, mSource.c_str());
@@ -56,7 +54,6 @@ SubImage::SubImage(Image *const parent,
     {
         mHasAlphaChannel = false;
         mIsAlphaVisible = false;
-        mAlphaChannel = nullptr;
     }
 
     // Set up the rectangle.
@@ -78,7 +75,6 @@ SubImage::SubImage(Image *const parent,
         mInternalBounds.w = 1;
         mInternalBounds.h = 1;
     }
-    mUseAlphaCache = false;
 }
 #endif  // USE_SDL2
 
@@ -93,10 +89,8 @@ SubImage::SubImage(Image *const parent,
     if (mParent)
     {
         mParent->incRef();
-        mParent->SDLTerminateAlphaCache();
         mHasAlphaChannel = mParent->hasAlphaChannel();
         mIsAlphaVisible = mHasAlphaChannel;
-        mAlphaChannel = mParent->SDLgetAlphaChannel();
         mSource = parent->getIdPath();
 #ifdef DEBUG_IMAGES
         logger->log("set name2 %p, %s", static_cast<void*>(this),
@@ -110,7 +104,6 @@ SubImage::SubImage(Image *const parent,
     {
         mHasAlphaChannel = false;
         mIsAlphaVisible = false;
-        mAlphaChannel = nullptr;
     }
 
     // Set up the rectangle.
@@ -132,7 +125,6 @@ SubImage::SubImage(Image *const parent,
         mInternalBounds.w = 1;
         mInternalBounds.h = 1;
     }
-    mUseAlphaCache = false;
 }
 
 #ifdef USE_OPENGL
@@ -187,8 +179,6 @@ SubImage::~SubImage()
 #endif  // DEBUG_IMAGES
     // Avoid destruction of the image
     mSDLSurface = nullptr;
-    // Avoid possible destruction of its alpha channel
-    mAlphaChannel = nullptr;
 #ifdef USE_SDL2
     // Avoid destruction of texture
     mTexture = nullptr;
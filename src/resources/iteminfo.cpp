@@ -35,6 +35,7 @@
 
 #include "utils/checkutils.h"
 #include "utils/dtor.h"
+#include "utils/stringutils.h"
 
 #include "debug.h"
 
@@ -42,6 +43,7 @@ ItemInfo::ItemInfo() :
     mMissileParticleFile(),
     mDisplay(),
     mName(),
+    mLowerName(),
     mNameEn(),
     mDescription(),
     mEffect(),
@@ -252,6 +254,13 @@ const std::string ItemInfo::getDescription(const ItemColor color) const
     return replaceColors(mDescription, color);
 }
 
+void ItemInfo::setName(const std::string &name)
+{
+    mName = name;
+    mLowerName = name;
+    toLower(mLowerName);
+}
+
 const std::string ItemInfo::getName(const ItemColor color) const
 {
     return replaceColors(mName, color);
@@ -68,12 +68,17 @@ class ItemInfo final
         int getId() const A_WARN_UNUSED
         { return mId; }
 
-        void setName(const std::string &name)
-        { mName = name; }
+        void setName(const std::string &name);
 
         const std::string &getName() const A_WARN_UNUSED
         { return mName; }
 
+        /**
+         * Returns lower case name, for search by name.
+         */
+        const std::string &getLowerName() const A_WARN_UNUSED
+        { return mLowerName; }
+
         const std::string getName(const ItemColor color)
                                   const A_WARN_UNUSED;
 
@@ -205,6 +210,10 @@ class ItemInfo final
         const SoundInfo &getSound(const ItemSoundEvent::Type event)
                                   const A_WARN_UNUSED;
 
+        const std::map <ItemSoundEvent::Type, SoundInfoVect> &getSounds()
+                                  const A_WARN_UNUSED
+        { return mSounds; }
+
         int getDrawBefore(const int direction) const A_WARN_UNUSED;
 
         void setDrawBefore(const int direction, const int n);
@@ -328,6 +337,7 @@ class ItemInfo final
 
         SpriteDisplay mDisplay;     /**< Display info (like icon) */
         std::string mName;
+        std::string mLowerName;
         std::string mNameEn;
         std::string mDescription;   /**< Short description. */
         std::string mEffect;        /**< Description of effects. */
@@ -0,0 +1,132 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "resources/map/actorrows.h"
+
+#include "being/actor.h"
+
+#include "debug.h"
+
+ActorRows::ActorRows(const int height,
+                     const int tileHeight) :
+    mRows(height > 0 ? height : 1),
+    mPending(),
+    mMoved(),
+    mSorted(),
+    mTileHeight(tileHeight > 0 ? tileHeight : 1)
+{
+}
+
+int ActorRows::getRow(const int sortY) const
+{
+    // actors outside of map stored in first or last row
+    if (sortY < 0)
+        return 0;
+    const int row = sortY / mTileHeight;
+    const int sz = CAST_S32(mRows.size());
+    return row < sz ? row : sz - 1;
+}
+
+void ActorRows::add(Actor *const actor)
+{
+    // sort position can be not ready yet, so row selected in update
+    actor->mSortRow = -1;
+    mPending.push_back(SortedActor(actor, 0));
+}
+
+void ActorRows::remove(Actor *const actor)
+{
+    const int row = actor->mSortRow;
+    SortedActors &actors = row >= 0 && row < CAST_S32(mRows.size()) ?
+        mRows[row] : mPending;
+    FOR_EACH (SortedActors::iterator, it, actors)
+    {
+        if (it->actor == actor)
+        {
+            actors.erase(it);
+            break;
+        }
+    }
+    actor->mSortRow = -1;
+    // sorted list can contain removed actor until next update
+    mSorted.clear();
+}
+
+void ActorRows::update()
+{
+    BLOCK_START("ActorRows::update")
+    mMoved.clear();
+    const int sz = CAST_S32(mRows.size());
+    for (int row = 0; row < sz; row ++)
+    {
+        SortedActors &actors = mRows[row];
+        if (actors.empty())
+            continue;
+        const size_t actorsSize = actors.size();
+        size_t pos = 0;
+        for (size_t f = 0; f < actorsSize; f ++)
+        {
+            SortedActor item = actors[f];
+            item.sortY = item.actor->getSortPixelY();
+            if (getRow(item.sortY) == row)
+                actors[pos ++] = item;
+            else
+                mMoved.push_back(item);
+        }
+        actors.erase(actors.begin() + pos, actors.end());
+    }
+
+    FOR_EACH (SortedActors::iterator, it, mPending)
+    {
+        it->sortY = it->actor->getSortPixelY();
+        mMoved.push_back(*it);
+    }
+    mPending.clear();
+
+    FOR_EACH (SortedActors::const_iterator, it, mMoved)
+    {
+        const int row = getRow(it->sortY);
+        it->actor->mSortRow = row;
+        mRows[row].push_back(*it);
+    }
+
+    mSorted.clear();
+    for (int row = 0; row < sz; row ++)
+    {
+        SortedActors &actors = mRows[row];
+        const size_t actorsSize = actors.size();
+        if (!actorsSize)
+            continue;
+        // insertion sort is linear for almost sorted rows and stable
+        for (size_t f = 1; f < actorsSize; f ++)
+        {
+            const SortedActor item = actors[f];
+            size_t pos = f;
+            while (pos > 0 && actors[pos - 1].sortY > item.sortY)
+            {
+                actors[pos] = actors[pos - 1];
+                pos --;
+            }
+            actors[pos] = item;
+        }
+        mSorted.insert(mSorted.end(), actors.begin(), actors.end());
+    }
+    BLOCK_END("ActorRows::update")
+}
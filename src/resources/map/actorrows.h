@@ -0,0 +1,86 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RESOURCES_MAP_ACTORROWS_H
+#define RESOURCES_MAP_ACTORROWS_H
+
+#include <vector>
+
+#include "localconsts.h"
+
+class Actor;
+
+struct SortedActor final
+{
+    SortedActor(Actor *const actor0,
+                const int sortY0) :
+        actor(actor0),
+        sortY(sortY0)
+    {
+    }
+
+    Actor *actor;
+    int sortY;
+};
+
+typedef std::vector<SortedActor> SortedActors;
+typedef SortedActors::const_iterator SortedActorsCIter;
+
+/**
+ * Map actors grouped in buckets by sort row.
+ * Actors moved between rows only if sort position changed row,
+ * and rows mostly already sorted, so per frame update is linear
+ * instead of sorting all actors.
+ */
+class ActorRows final
+{
+    public:
+        ActorRows(const int height,
+                  const int tileHeight);
+
+        A_DELETE_COPY(ActorRows)
+
+        void add(Actor *const actor) A_NONNULL(2);
+
+        void remove(Actor *const actor) A_NONNULL(2);
+
+        /**
+         * Reads sort positions of all actors, moves changed actors
+         * to new rows and builds sorted actors list.
+         */
+        void update();
+
+        /**
+         * Actors sorted by sort position, valid after update.
+         */
+        const SortedActors &getSorted() const noexcept2 A_WARN_UNUSED
+        { return mSorted; }
+
+    private:
+        int getRow(const int sortY) const A_WARN_UNUSED;
+
+        std::vector<SortedActors> mRows;
+        SortedActors mPending;
+        SortedActors mMoved;
+        SortedActors mSorted;
+        const int mTileHeight;
+};
+
+#endif  // RESOURCES_MAP_ACTORROWS_H
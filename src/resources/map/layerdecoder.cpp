@@ -0,0 +1,394 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "resources/map/layerdecoder.h"
+
+#ifndef SDL_BIG_ENDIAN
+#include <SDL_endian.h>
+#endif  // SDL_BIG_ENDIAN
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif  // __SSE2__
+
+#include "debug.h"
+
+namespace
+{
+    const size_t bufferSize = 16384;
+
+    // 0-63 for base64 alphabet, 64 for padding, 65 for other chars
+    const unsigned char BASE64_PAD = 64U;
+    const unsigned char BASE64_SKIP = 65U;
+
+    struct Base64Table final
+    {
+        Base64Table() :
+            values()
+        {
+            const char *const chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                "abcdefghijklmnopqrstuvwxyz0123456789+/";
+            for (int f = 0; f < 256; f ++)
+                values[f] = BASE64_SKIP;
+            for (unsigned char f = 0; f < 64; f ++)
+                values[CAST_U8(chars[f])] = f;
+            values[CAST_U8('=')] = BASE64_PAD;
+        }
+
+        A_DELETE_COPY(Base64Table)
+
+        unsigned char values[256];
+    };
+
+    // initialized before any map loaded
+    const Base64Table base64Table;
+
+    // csv token parsing state, same as in atoi
+    enum CsvPhase
+    {
+        CSV_SPACE = 0,
+        CSV_SIGN = 1,
+        CSV_DIGITS = 2,
+        CSV_SKIP = 3
+    };
+
+    struct CsvParser final
+    {
+        CsvParser(int *restrict const out0,
+                  const size_t maxGids0) :
+            out(out0),
+            maxGids(maxGids0),
+            count(0),
+            value(0U),
+            phase(CSV_SPACE),
+            negative(false),
+            hasDigit(false)
+        {
+        }
+
+        A_DELETE_COPY(CsvParser)
+
+        // return true if gids array is full
+        bool add()
+        {
+            out[count] = CAST_S32(negative ? 0U - value : value);
+            count ++;
+            value = 0U;
+            phase = CSV_SPACE;
+            negative = false;
+            hasDigit = false;
+            return count == maxGids;
+        }
+
+        bool parse(const char c)
+        {
+            if (c >= '0' && c <= '9')
+            {
+                hasDigit = true;
+                if (phase == CSV_SKIP)
+                    return false;
+                value = value * 10U + CAST_U32(c - '0');
+                phase = CSV_DIGITS;
+                return false;
+            }
+            if (c == ',')
+                return add();
+            if (phase == CSV_SPACE)
+            {
+                if (c == ' ' || (c >= '\t' && c <= '\r'))
+                    return false;
+                if (c == '-' || c == '+')
+                {
+                    negative = c == '-';
+                    phase = CSV_SIGN;
+                    return false;
+                }
+            }
+            phase = CSV_SKIP;
+            return false;
+        }
+
+        int *restrict const out;
+        const size_t maxGids;
+        size_t count;
+        unsigned int value;
+        CsvPhase phase;
+        bool negative;
+        bool hasDigit;
+    };
+}  // namespace
+
+LayerDecoder::LayerDecoder() :
+    mStream(),
+    mBuffer(new unsigned char[bufferSize]),
+    mOut(nullptr),
+    mOutSize(0),
+    mOutPos(0),
+    mStreamInit(false),
+    mStreamEnd(false)
+{
+    mStream.zalloc = Z_NULL;
+    mStream.zfree = Z_NULL;
+    mStream.opaque = Z_NULL;
+}
+
+LayerDecoder::~LayerDecoder()
+{
+    if (mStreamInit)
+        inflateEnd(&mStream);
+    delete [] mBuffer;
+}
+
+int LayerDecoder::decode(const char *restrict data,
+                         const bool compressed,
+                         std::vector<int> &restrict gids,
+                         const size_t maxGids)
+{
+    gids.resize(maxGids);
+    if (!maxGids || !data)
+    {
+        gids.clear();
+        return Z_OK;
+    }
+
+    mOut = reinterpret_cast<unsigned char*>(&gids[0]);
+    mOutSize = maxGids * 4;
+    mOutPos = 0;
+    mStreamEnd = false;
+
+    if (compressed)
+    {
+        mStream.next_in = Z_NULL;
+        mStream.avail_in = 0;
+        // 15 + 32 for autodetect zlib or gzip header
+        const int ret = mStreamInit ? inflateReset(&mStream)
+            : inflateInit2(&mStream, 15 + 32);
+        if (ret != Z_OK)
+        {
+            gids.clear();
+            return ret;
+        }
+        mStreamInit = true;
+    }
+
+    const unsigned char *restrict const table = base64Table.values;
+    const unsigned char *restrict src =
+        reinterpret_cast<const unsigned char*>(data);
+    unsigned char *restrict const buffer = mBuffer;
+    size_t pos = 0;
+    unsigned int bits = 0;
+    int count = 0;
+    int ret = Z_OK;
+
+    while (*src)
+    {
+        const unsigned char ch = table[*src++];
+        if (ch >= BASE64_PAD)
+        {
+            if (ch == BASE64_PAD)
+                break;
+            continue;
+        }
+        bits = (bits << 6) | ch;
+        count ++;
+        if (count == 4)
+        {
+            buffer[pos] = CAST_U8(bits >> 16);
+            buffer[pos + 1] = CAST_U8(bits >> 8);
+            buffer[pos + 2] = CAST_U8(bits);
+            pos += 3;
+            bits = 0;
+            count = 0;
+            if (pos + 3 > bufferSize)
+            {
+                ret = write(buffer, pos, compressed);
+                pos = 0;
+                if (ret != Z_OK || mStreamEnd)
+                    break;
+            }
+        }
+    }
+    if (ret == Z_OK && !mStreamEnd)
+    {
+        // last incomplete quantum
+        if (count == 2)
+        {
+            buffer[pos ++] = CAST_U8(bits >> 4);
+        }
+        else if (count == 3)
+        {
+            buffer[pos ++] = CAST_U8(bits >> 10);
+            buffer[pos ++] = CAST_U8(bits >> 2);
+        }
+        if (pos)
+            ret = write(buffer, pos, compressed);
+        // compressed data must be complete if output buffer not full
+        if (ret == Z_OK && compressed && !mStreamEnd)
+            ret = Z_DATA_ERROR;
+    }
+
+    if (ret != Z_OK)
+    {
+        gids.clear();
+        return ret;
+    }
+
+    gids.resize(mOutPos / 4);
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+    FOR_EACH (std::vector<int>::iterator, it, gids)
+        *it = SDL_SwapLE32(*it);
+#endif  // SDL_BYTEORDER == SDL_BIG_ENDIAN
+
+    return Z_OK;
+}
+
+int LayerDecoder::write(const unsigned char *const data,
+                        const size_t size,
+                        const bool compressed)
+{
+    if (!compressed)
+    {
+        // too much data is not error
+        const size_t sz = std::min(size, mOutSize - mOutPos);
+        memcpy(mOut + mOutPos, data, sz);
+        mOutPos += sz;
+        if (mOutPos == mOutSize)
+            mStreamEnd = true;
+        return Z_OK;
+    }
+
+    mStream.next_in = const_cast<Bytef*>(data);
+    mStream.avail_in = CAST_U32(size);
+    mStream.next_out = mOut + mOutPos;
+    mStream.avail_out = CAST_U32(mOutSize - mOutPos);
+    const int ret = inflate(&mStream, Z_NO_FLUSH);
+    mOutPos = mOutSize - mStream.avail_out;
+    switch (ret)
+    {
+        case Z_STREAM_END:
+            mStreamEnd = true;
+            return Z_OK;
+        case Z_OK:
+            break;
+        case Z_BUF_ERROR:
+            // no progress possible, because input or output is full
+            break;
+        case Z_NEED_DICT:
+            return Z_DATA_ERROR;
+        default:
+            return ret;
+    }
+    // output full, rest of data ignored
+    if (!mStream.avail_out)
+        mStreamEnd = true;
+    return Z_OK;
+}
+
+void LayerDecoder::decodeCsv(const char *restrict data,
+                             std::vector<int> &restrict gids,
+                             const size_t maxGids)
+{
+    gids.resize(maxGids);
+    if (!maxGids || !data)
+    {
+        gids.clear();
+        return;
+    }
+
+    CsvParser parser(&gids[0], maxGids);
+    const char *restrict ptr = data;
+    const char *restrict const end = data + strlen(data);
+
+#ifdef __SSE2__
+    // blocks with only digits and commas parsed without per char checks
+    const __m128i zero1 = _mm_set1_epi8('0' - 1);
+    const __m128i nine1 = _mm_set1_epi8('9' + 1);
+    const __m128i comma = _mm_set1_epi8(',');
+    while (end - ptr >= 16)
+    {
+        const __m128i chars = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(ptr));
+        const int digits = _mm_movemask_epi8(_mm_and_si128(
+            _mm_cmpgt_epi8(chars, zero1),
+            _mm_cmplt_epi8(chars, nine1)));
+        unsigned int commas = CAST_U32(_mm_movemask_epi8(
+            _mm_cmpeq_epi8(chars, comma)));
+        if ((digits | CAST_S32(commas)) != 0xffff ||
+            parser.phase == CSV_SIGN ||
+            parser.phase == CSV_SKIP)
+        {
+            for (int f = 0; f < 16; f ++)
+            {
+                if (parser.parse(ptr[f]))
+                {
+                    gids.resize(parser.count);
+                    return;
+                }
+            }
+            ptr += 16;
+            continue;
+        }
+
+        int pos = 0;
+        while (commas)
+        {
+            const int next = __builtin_ctz(commas);
+            if (next > pos)
+            {
+                unsigned int value = parser.value;
+                for (; pos < next; pos ++)
+                    value = value * 10U + CAST_U32(ptr[pos] - '0');
+                parser.value = value;
+                parser.hasDigit = true;
+            }
+            if (parser.add())
+            {
+                gids.resize(parser.count);
+                return;
+            }
+            pos = next + 1;
+            commas &= commas - 1;
+        }
+        if (pos < 16)
+        {
+            unsigned int value = parser.value;
+            for (; pos < 16; pos ++)
+                value = value * 10U + CAST_U32(ptr[pos] - '0');
+            parser.value = value;
+            parser.hasDigit = true;
+            parser.phase = CSV_DIGITS;
+        }
+        ptr += 16;
+    }
+#endif  // __SSE2__
+
+    for (; ptr < end; ++ ptr)
+    {
+        if (parser.parse(*ptr))
+        {
+            gids.resize(parser.count);
+            return;
+        }
+    }
+    // last gid not have comma after it
+    if (parser.hasDigit)
+        parser.add();
+    gids.resize(parser.count);
+}
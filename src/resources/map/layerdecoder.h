@@ -0,0 +1,80 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RESOURCES_MAP_LAYERDECODER_H
+#define RESOURCES_MAP_LAYERDECODER_H
+
+#include <vector>
+
+#include <zlib.h>
+
+#include "localconsts.h"
+
+/**
+ * Decoder for base64 and csv encoded map layers.
+ * Base64 data decoded and inflated in chunks straight into gids array.
+ * zlib state reused between layers, so one decoder should be used
+ * for many layers from same thread.
+ */
+class LayerDecoder final
+{
+    public:
+        LayerDecoder();
+
+        A_DELETE_COPY(LayerDecoder)
+
+        ~LayerDecoder();
+
+        /**
+         * Decodes base64 data with optional gzip or zlib compression.
+         * Characters what is not part of base64 alphabet skipped.
+         * Decoded not more than maxGids gids.
+         *
+         * @return Z_OK on success or zlib error code.
+         */
+        int decode(const char *restrict data,
+                   const bool compressed,
+                   std::vector<int> &restrict gids,
+                   const size_t maxGids);
+
+        /**
+         * Decodes comma separated gids without copy of text.
+         * Each value parsed like atoi do it.
+         * Decoded not more than maxGids gids.
+         */
+        static void decodeCsv(const char *restrict data,
+                              std::vector<int> &restrict gids,
+                              const size_t maxGids);
+
+    private:
+        int write(const unsigned char *const data,
+                  const size_t size,
+                  const bool compressed);
+
+        z_stream mStream;
+        unsigned char *mBuffer;
+        unsigned char *mOut;
+        size_t mOutSize;
+        size_t mOutPos;
+        bool mStreamInit;
+        bool mStreamEnd;
+};
+
+#endif  // RESOURCES_MAP_LAYERDECODER_H
@@ -0,0 +1,240 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "resources/map/layerdecoder.h"
+
+#include "catch.hpp"
+
+#include "utils/base64.h"
+#include "utils/stringutils.h"
+
+#include <string>
+
+#include "debug.h"
+
+static std::vector<unsigned char> layerBytes(const std::vector<int> &gids)
+{
+    std::vector<unsigned char> bytes;
+    FOR_EACH (std::vector<int>::const_iterator, it, gids)
+    {
+        const unsigned int gid = CAST_U32(*it);
+        bytes.push_back(CAST_U8(gid));
+        bytes.push_back(CAST_U8(gid >> 8));
+        bytes.push_back(CAST_U8(gid >> 16));
+        bytes.push_back(CAST_U8(gid >> 24));
+    }
+    return bytes;
+}
+
+static std::vector<unsigned char> compressBytes(
+    const std::vector<unsigned char> &bytes,
+    const bool gzip)
+{
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+        gzip ? 15 + 16 : 15, 8, Z_DEFAULT_STRATEGY);
+    std::vector<unsigned char> out(deflateBound(&strm,
+        CAST_U32(bytes.size())) + 32);
+    strm.next_in = const_cast<Bytef*>(&bytes[0]);
+    strm.avail_in = CAST_U32(bytes.size());
+    strm.next_out = &out[0];
+    strm.avail_out = CAST_U32(out.size());
+    deflate(&strm, Z_FINISH);
+    out.resize(out.size() - strm.avail_out);
+    deflateEnd(&strm);
+    return out;
+}
+
+static std::string encodeBytes(const std::vector<unsigned char> &bytes)
+{
+    int len = 0;
+    unsigned char *const str = php3_base64_encode(&bytes[0],
+        CAST_S32(bytes.size()), &len);
+    // add formatting like in tmx files
+    std::string data("\n   ");
+    for (int f = 0; f < len; f ++)
+    {
+        data.push_back(static_cast<char>(str[f]));
+        if (f % 60 == 59)
+            data.append("\n   ");
+    }
+    data.append("\n  ");
+    free(str);
+    return data;
+}
+
+static std::vector<int> testGids(const int size)
+{
+    std::vector<int> gids;
+    for (int f = 0; f < size; f ++)
+        gids.push_back((f * 7919) % 3000 + (f % 5 == 0 ? 0x40000000 : 0));
+    return gids;
+}
+
+TEST_CASE("LayerDecoder uncompressed")
+{
+    LayerDecoder decoder;
+    const std::vector<int> gids = testGids(1000);
+    const std::string data = encodeBytes(layerBytes(gids));
+    std::vector<int> out;
+
+    REQUIRE(decoder.decode(data.c_str(), false, out, 1000) == Z_OK);
+    REQUIRE(out == gids);
+
+    // too much data ignored
+    REQUIRE(decoder.decode(data.c_str(), false, out, 100) == Z_OK);
+    REQUIRE(out.size() == 100);
+    REQUIRE(std::equal(out.begin(), out.end(), gids.begin()));
+
+    // not enough data
+    REQUIRE(decoder.decode(data.c_str(), false, out, 2000) == Z_OK);
+    REQUIRE(out == gids);
+}
+
+TEST_CASE("LayerDecoder compressed")
+{
+    LayerDecoder decoder;
+    // layers bigger than decoder buffer
+    const std::vector<int> gids = testGids(200 * 200);
+    const std::string zlibData = encodeBytes(compressBytes(
+        layerBytes(gids), false));
+    const std::string gzipData = encodeBytes(compressBytes(
+        layerBytes(gids), true));
+    std::vector<int> out;
+
+    SECTION("zlib")
+    {
+        REQUIRE(decoder.decode(zlibData.c_str(), true, out, 40000) == Z_OK);
+        REQUIRE(out == gids);
+    }
+
+    SECTION("gzip")
+    {
+        REQUIRE(decoder.decode(gzipData.c_str(), true, out, 40000) == Z_OK);
+        REQUIRE(out == gids);
+    }
+
+    SECTION("reuse")
+    {
+        for (int f = 0; f < 3; f ++)
+        {
+            REQUIRE(decoder.decode(gzipData.c_str(), true, out, 40000)
+                == Z_OK);
+            REQUIRE(out == gids);
+            REQUIRE(decoder.decode(zlibData.c_str(), true, out, 40000)
+                == Z_OK);
+            REQUIRE(out == gids);
+        }
+    }
+
+    SECTION("too much data")
+    {
+        REQUIRE(decoder.decode(zlibData.c_str(), true, out, 500) == Z_OK);
+        REQUIRE(out.size() == 500);
+        REQUIRE(std::equal(out.begin(), out.end(), gids.begin()));
+    }
+
+    SECTION("broken data")
+    {
+        std::string data = zlibData;
+        data.resize(data.size() / 2);
+        REQUIRE(decoder.decode(data.c_str(), true, out, 40000)
+            == Z_DATA_ERROR);
+        REQUIRE(out.empty());
+        REQUIRE(decoder.decode("AAAAAAAAAAAA", true, out, 40000)
+            != Z_OK);
+        REQUIRE(out.empty());
+
+        // decoder still usable after errors
+        REQUIRE(decoder.decode(zlibData.c_str(), true, out, 40000) == Z_OK);
+        REQUIRE(out == gids);
+    }
+}
+
+TEST_CASE("LayerDecoder csv")
+{
+    std::vector<int> out;
+
+    SECTION("simple")
+    {
+        LayerDecoder::decodeCsv("1,2,3", out, 10);
+        REQUIRE(out.size() == 3);
+        REQUIRE(out[0] == 1);
+        REQUIRE(out[1] == 2);
+        REQUIRE(out[2] == 3);
+    }
+
+    SECTION("formatting")
+    {
+        LayerDecoder::decodeCsv("\n0,0,0,12,\n12345,0,0,0,\r\n"
+            "7,  8 ,9,\n", out, 10);
+        REQUIRE(out.size() == 10);
+        REQUIRE(out[0] == 0);
+        REQUIRE(out[3] == 12);
+        REQUIRE(out[4] == 12345);
+        REQUIRE(out[7] == 0);
+        REQUIRE(out[8] == 7);
+        REQUIRE(out[9] == 8);
+    }
+
+    SECTION("atoi compatibility")
+    {
+        LayerDecoder::decodeCsv("-5,+6,,x7,8x9,1 2,- 3,2147483648", out, 10);
+        REQUIRE(out.size() == 8);
+        REQUIRE(out[0] == -5);
+        REQUIRE(out[1] == 6);
+        REQUIRE(out[2] == 0);
+        REQUIRE(out[3] == 0);
+        REQUIRE(out[4] == 8);
+        REQUIRE(out[5] == 1);
+        REQUIRE(out[6] == 0);
+        // flip flags in high bits
+        REQUIRE(CAST_U32(out[7]) == 2147483648U);
+    }
+
+    SECTION("max size")
+    {
+        LayerDecoder::decodeCsv("1,2,3,4,5", out, 3);
+        REQUIRE(out.size() == 3);
+        REQUIRE(out[2] == 3);
+        LayerDecoder::decodeCsv("", out, 3);
+        REQUIRE(out.empty());
+    }
+
+    SECTION("big layer")
+    {
+        const std::vector<int> gids = testGids(300 * 30);
+        std::string data;
+        for (size_t f = 0; f < gids.size(); f ++)
+        {
+            data.append(toString(gids[f])).append(",");
+            if (f % 300 == 299)
+                data.append("\n");
+        }
+        LayerDecoder::decodeCsv(data.c_str(), out, gids.size());
+        REQUIRE(out == gids);
+        LayerDecoder::decodeCsv(data.c_str(), out, 1234);
+        REQUIRE(out.size() == 1234);
+        REQUIRE(std::equal(out.begin(), out.end(), gids.begin()));
+    }
+}
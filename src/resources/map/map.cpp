@@ -74,17 +74,6 @@
 
 #include "debug.h"
 
-class ActorFunctuator final
-{
-    public:
-        bool operator()(const Actor *const a, const Actor *const b) const
-        {
-            if (!a || !b)
-                return false;
-            return a->getSortPixelY() < b->getSortPixelY();
-        }
-} actorCompare;
-
 Map::Map(const std::string &name,
          const int width,
          const int height,
@@ -101,6 +90,7 @@ Map::Map(const std::string &name,
     mDrawOverLayers(),
     mTilesets(),
     mActors(),
+    mActorRows(height, tileHeight),
     mHasWarps(false),
     mDrawLayersFlags(MapType::NORMAL),
     mOnClosedList(1),
@@ -111,6 +101,7 @@ Map::Map(const std::string &name,
     mLastAScrollY(0.0F),
     mParticleEffects(),
     mMapPortals(),
+    mPortalTargets(),
     mTileAnimations(),
     mName(name),
     mOverlayDetail(config.getIntValue("OverlayDetail")),
@@ -185,6 +176,7 @@ Map::~Map()
     delete2(mTempLayer);
     delete2(mObjects);
     delete_all(mMapPortals);
+    delete_all(mPortalTargets);
     if (mAtlas)
     {
         mAtlas->decRef();
@@ -316,13 +308,17 @@ void Map::addTileset(Tileset *const tileset) restrict2
 
 void Map::update(const int ticks) restrict2
 {
-    // Update animated tiles
+    // Update animated tiles. Tiles read current frame from animations,
+    // and only layers with changed animations update cached vertexes.
     FOR_EACH (TileAnimationMapCIter, iAni, mTileAnimations)
     {
         TileAnimation *restrict const tileAni = iAni->second;
-        if (tileAni && tileAni->update(ticks))
-            mRedrawMap = true;
+        if (tileAni)
+            tileAni->update(ticks);
     }
+    // ambient layers moving all time
+    if (!mBackgrounds.empty() || !mForegrounds.empty())
+        settings.needRedraw = true;
 }
 
 void Map::draw(Graphics *restrict const graphics,
@@ -343,9 +339,8 @@ void Map::draw(Graphics *restrict const graphics,
 
     // Make sure actors are sorted ascending by Y-coordinate
     // so that they overlap correctly
-    BLOCK_START("Map::draw sort")
-    mActors.sort(actorCompare);
-    BLOCK_END("Map::draw sort")
+    mActorRows.update();
+    const SortedActors &sortedActors = mActorRows.getSorted();
 
     // update scrolling of all ambient layers
     updateAmbientLayers(static_cast<float>(scrollX),
@@ -402,7 +397,7 @@ void Map::draw(Graphics *restrict const graphics,
                 startX, startY,
                 endX, endY,
                 scrollX, scrollY,
-                mActors);
+                sortedActors);
         }
     }
     else
@@ -410,16 +405,19 @@ void Map::draw(Graphics *restrict const graphics,
 #ifdef USE_OPENGL
         if (mCachedDraw)
         {
-            if (updateFlag)
+            FOR_EACH (Layers::iterator, it, mDrawUnderLayers)
             {
-                FOR_EACH (Layers::iterator, it, mDrawUnderLayers)
+                if (updateFlag || (*it)->isAnimationChanged())
                 {
                     (*it)->updateOGL(graphics,
                         startX, startY,
                         endX, endY,
                         scrollX, scrollY);
                 }
-                FOR_EACH (Layers::iterator, it, mDrawOverLayers)
+            }
+            FOR_EACH (Layers::iterator, it, mDrawOverLayers)
+            {
+                if (updateFlag || (*it)->isAnimationChanged())
                 {
                     (*it)->updateOGL(graphics,
                         startX, startY,
@@ -439,7 +437,7 @@ void Map::draw(Graphics *restrict const graphics,
                     startX, startY,
                     endX, endY,
                     scrollX, scrollY,
-                    mActors);
+                    sortedActors);
             }
 
             FOR_EACH (Layers::iterator, it, mDrawOverLayers)
@@ -464,7 +462,7 @@ void Map::draw(Graphics *restrict const graphics,
                     startX, startY,
                     endX, endY,
                     scrollX, scrollY,
-                    mActors);
+                    sortedActors);
             }
 
             FOR_EACH (Layers::iterator, it, mDrawOverLayers)
@@ -481,14 +479,14 @@ void Map::draw(Graphics *restrict const graphics,
     {
         // Draws beings with a lower opacity to make them visible
         // even when covered by a wall or some other elements...
-        ActorsCIter ai = mActors.begin();
-        const ActorsCIter ai_end = mActors.end();
+        SortedActorsCIter ai = sortedActors.begin();
+        const SortedActorsCIter ai_end = sortedActors.end();
 
         if (mOpenGL == RENDER_SOFTWARE)
         {
             while (ai != ai_end)
             {
-                if (Actor *restrict const actor = *ai)
+                if (Actor *restrict const actor = ai->actor)
                 {
                     const int x = actor->getTileX();
                     const int y = actor->getTileY();
@@ -512,7 +510,7 @@ void Map::draw(Graphics *restrict const graphics,
         {
             while (ai != ai_end)
             {
-                if (Actor *const actor = *ai)
+                if (Actor *const actor = ai->actor)
                 {
                     actor->setAlpha(0.3F);
                     actor->draw(graphics, -scrollX, -scrollY);
@@ -809,12 +807,14 @@ const MetaTile *Map::getMetaTile(const int x, const int y) const restrict2
 Actors::iterator Map::addActor(Actor *const actor) restrict2
 {
     mActors.push_front(actor);
+    mActorRows.add(actor);
 //    mSpritesUpdated = true;
     return mActors.begin();
 }
 
 void Map::removeActor(const Actors::iterator &restrict iterator) restrict2
 {
+    mActorRows.remove(*iterator);
     mActors.erase(iterator);
 //    mSpritesUpdated = true;
 }
@@ -1283,6 +1283,16 @@ void Map::addPortalTile(const std::string &restrict name,
     mMapPortals.push_back(new MapItem(type, name, x, y));
 }
 
+void Map::addPortalTarget(const std::string &restrict mapName,
+                          const int x, const int y,
+                          const int dx, const int dy) restrict2
+{
+    mPortalTargets.push_back(new MapItem(MapItemType::PORTAL,
+        mapName,
+        (x / mapTileSize) + (dx / mapTileSize / 2),
+        (y / mapTileSize) + (dy / mapTileSize / 2)));
+}
+
 void Map::updatePortalTile(const std::string &restrict name,
                            const int type,
                            const int x, const int y,
@@ -1499,20 +1509,22 @@ void Map::reduce() restrict2
                     }
                     else if (img->hasAlphaChannel())
                     {
-                        const uint8_t *restrict const arr =
-                            img->SDLgetAlphaChannel();
-                        if (!arr)
+                        const SDL_Surface *restrict const surface =
+                            img->getSDLSurface();
+                        if (!surface
+                            || !surface->format
+                            || surface->format->BytesPerPixel != 4
+                            || !surface->format->Amask)
+                        {
                             continue;
+                        }
 
+                        const uint32_t amask = surface->format->Amask;
+                        const uint8_t *restrict const pixels =
+                            static_cast<const uint8_t*>(surface->pixels);
+                        const int pitch = surface->pitch;
                         bool bad(false);
                         bool stop(false);
-                        int width;
-                        const SubImage *restrict const subImg
-                            = dynamic_cast<SubImage*>(img);
-                        if (subImg)
-                            width = subImg->mInternalBounds.w;
-                        else
-                            width = img->mBounds.w;
 
                         for (int f = img->mBounds.x;
                              f < img->mBounds.x + img->mBounds.w; f ++)
@@ -1520,8 +1532,10 @@ void Map::reduce() restrict2
                             for (int d = img->mBounds.y;
                                  d < img->mBounds.y + img->mBounds.h; d ++)
                             {
-                                const uint8_t chan = arr[f + d * width];
-                                if (chan != 255)
+                                const uint32_t c = *reinterpret_cast<
+                                    const uint32_t*>(pixels + d * pitch
+                                    + f * 4);
+                                if ((c & amask) != amask)
                                 {
                                     bad = true;
                                     stop = true;
@@ -1732,7 +1746,8 @@ int Map::calcMemoryLocal() const
         sizeof(AmbientLayer*) * (mBackgrounds.capacity()
         + mForegrounds.capacity()) +
         sizeof(ParticleEffectData) * mParticleEffects.capacity() +
-        sizeof(MapItem) * mMapPortals.capacity() +
+        sizeof(MapItem) * (mMapPortals.capacity() +
+        mPortalTargets.capacity()) +
         (sizeof(TileAnimation) + sizeof(int)) * mTileAnimations.size() +
         sizeof(Tileset*) * mIndexedTilesetsSize);
 }
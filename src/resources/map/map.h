@@ -35,6 +35,7 @@
 
 #include "resources/memorycounter.h"
 
+#include "resources/map/actorrows.h"
 #include "resources/map/properties.h"
 
 #include "listeners/configlistener.h"
@@ -272,6 +273,17 @@ class Map final : public Properties,
                                                 A_WARN_UNUSED
         { return mMapPortals; }
 
+        /**
+         * Adds warp destination map name. Used for maps prefetching.
+         */
+        void addPortalTarget(const std::string &restrict mapName,
+                             const int x, const int y,
+                             const int dx, const int dy) restrict2;
+
+        const std::vector<MapItem*> &getPortalTargets() const restrict2
+                                                      noexcept2 A_WARN_UNUSED
+        { return mPortalTargets; }
+
         /**
          * Gets the tile animation for a specific gid
          */
@@ -370,6 +382,7 @@ class Map final : public Properties,
     protected:
         friend class Actor;
         friend class Minimap;
+        friend class MinimapCache;
 
         /**
          * Adds an actor to the map.
@@ -413,6 +426,7 @@ class Map final : public Properties,
         Layers mDrawOverLayers;
         Tilesets mTilesets;
         Actors mActors;
+        ActorRows mActorRows;
         bool mHasWarps;
 
         // draw flags
@@ -453,6 +467,7 @@ class Map final : public Properties,
         std::vector<ParticleEffectData> mParticleEffects;
 
         std::vector<MapItem*> mMapPortals;
+        std::vector<MapItem*> mPortalTargets;
 
         std::map<int, TileAnimation*> mTileAnimations;
 
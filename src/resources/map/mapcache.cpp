@@ -0,0 +1,221 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "resources/map/mapcache.h"
+
+#include "logger.h"
+#include "settings.h"
+
+#include "utils/mkdir.h"
+#include "utils/stringutils.h"
+
+#include <cstdio>
+#include <fstream>
+
+#ifndef WIN32
+#include <unistd.h>
+#endif  // WIN32
+
+#include "debug.h"
+
+// file format: magic, version, map hash, then for each layer:
+// width, height, gids count, gids
+static const int mapCacheMagic = 0x434d504d;
+static const int mapCacheVersion = 1;
+
+MapCache::MapCache(const std::string &fileName,
+                   const uint32_t hash) :
+    mFileName(),
+    mData(),
+    mPos(0),
+    mHash(hash),
+    mLoaded(false),
+    mValid(true)
+{
+    std::string name = fileName;
+    replaceAll(name, "/", "_");
+    mFileName = getCacheDir().append(name).append(".bin");
+    load();
+}
+
+std::string MapCache::getCacheDir()
+{
+    return settings.localDataDir + "/cache/maps/";
+}
+
+void MapCache::load()
+{
+    std::ifstream file;
+    file.open(mFileName.c_str(), std::ios::in | std::ios::binary);
+    if (!file.is_open())
+        return;
+
+    file.seekg(0, std::ios::end);
+    const int size = CAST_S32(file.tellg());
+    if (size < 3 * CAST_S32(sizeof(int)))
+        return;
+    file.seekg(0, std::ios::beg);
+    mData.resize(size);
+    file.read(&mData[0], size);
+    file.close();
+
+    int magic = 0;
+    int version = 0;
+    int hash = 0;
+    if (!readInt(magic) ||
+        !readInt(version) ||
+        !readInt(hash) ||
+        magic != mapCacheMagic ||
+        version != mapCacheVersion ||
+        CAST_U32(hash) != mHash)
+    {
+        logger->log("Outdated map cache: %s", mFileName.c_str());
+        mData.clear();
+        mPos = 0;
+        return;
+    }
+    mLoaded = true;
+}
+
+bool MapCache::readInt(int &val)
+{
+    if (mPos + sizeof(int) > mData.size())
+        return false;
+    memcpy(&val, &mData[mPos], sizeof(int));
+    mPos += sizeof(int);
+    return true;
+}
+
+void MapCache::writeInt(const int val)
+{
+    const char *const ptr = reinterpret_cast<const char*>(&val);
+    mData.insert(mData.end(), ptr, ptr + sizeof(int));
+}
+
+bool MapCache::readLayer(std::vector<int> &gids,
+                         const int width,
+                         const int height)
+{
+    if (!mLoaded)
+        return false;
+
+    const size_t layerPos = mPos;
+    int w = 0;
+    int h = 0;
+    int count = 0;
+    if (!readInt(w) ||
+        !readInt(h) ||
+        !readInt(count) ||
+        w != width ||
+        h != height ||
+        count < 0 ||
+        count > w * h ||
+        mPos + CAST_SIZE(count) * sizeof(int) > mData.size())
+    {
+        logger->log("Broken map cache: %s", mFileName.c_str());
+        // keep header and already read layers, other layers will be
+        // added after decoding and cache file will be replaced.
+        mData.resize(layerPos);
+        mPos = 0;
+        mLoaded = false;
+        mValid = true;
+        return false;
+    }
+
+    gids.resize(count);
+    if (count > 0)
+    {
+        memcpy(&gids[0], &mData[mPos], count * sizeof(int));
+        mPos += CAST_SIZE(count) * sizeof(int);
+    }
+    return true;
+}
+
+void MapCache::addLayer(const std::vector<int> &gids,
+                        const int width,
+                        const int height)
+{
+    if (mLoaded || !mValid)
+        return;
+
+    if (mData.empty())
+    {
+        writeInt(mapCacheMagic);
+        writeInt(mapCacheVersion);
+        writeInt(CAST_S32(mHash));
+    }
+    writeInt(width);
+    writeInt(height);
+    writeInt(CAST_S32(gids.size()));
+    if (!gids.empty())
+    {
+        const char *const ptr = reinterpret_cast<const char*>(&gids[0]);
+        mData.insert(mData.end(), ptr, ptr + gids.size() * sizeof(int));
+    }
+}
+
+void MapCache::save() const
+{
+    if (mLoaded || !mValid || mData.empty())
+        return;
+
+    if (mkdir_r(getCacheDir().c_str()))
+    {
+        logger->log("Error creating map cache directory: %s",
+            getCacheDir().c_str());
+        return;
+    }
+
+    // other clients can read cache in same time,
+    // write new file near and replace old one.
+#ifndef WIN32
+    const std::string tmpName = strprintf("%s.%d.tmp",
+        mFileName.c_str(), CAST_S32(getpid()));
+#else  // WIN32
+
+    const std::string tmpName = mFileName + ".tmp";
+#endif  // WIN32
+
+    std::ofstream file;
+    file.open(tmpName.c_str(),
+        std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        logger->log("Error saving map cache: %s", mFileName.c_str());
+        return;
+    }
+    file.write(&mData[0], mData.size());
+    file.close();
+    if (!file)
+    {
+        logger->log("Error saving map cache: %s", mFileName.c_str());
+        ::remove(tmpName.c_str());
+        return;
+    }
+#ifdef WIN32
+    ::remove(mFileName.c_str());
+#endif  // WIN32
+
+    if (::rename(tmpName.c_str(), mFileName.c_str()))
+    {
+        logger->log("Error saving map cache: %s", mFileName.c_str());
+        ::remove(tmpName.c_str());
+    }
+}
@@ -0,0 +1,92 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RESOURCES_MAP_MAPCACHE_H
+#define RESOURCES_MAP_MAPCACHE_H
+
+#include <string>
+#include <vector>
+
+#include "localconsts.h"
+
+/**
+ * Cache for decoded map layers.
+ * All layers of one map stored in one binary file in layers reading order.
+ * Cache file invalidated if map file hash changed.
+ */
+class MapCache final
+{
+    public:
+        MapCache(const std::string &fileName,
+                 const uint32_t hash);
+
+        A_DELETE_COPY(MapCache)
+
+        /**
+         * Returns true if valid cache file was loaded.
+         */
+        bool isLoaded() const A_WARN_UNUSED
+        { return mLoaded; }
+
+        /**
+         * Reads next layer gids from loaded cache.
+         * On error false returned and cache switched to rebuild mode,
+         * next layers must be added by addLayer.
+         */
+        bool readLayer(std::vector<int> &gids,
+                       const int width,
+                       const int height);
+
+        /**
+         * Adds next decoded layer gids for saving.
+         */
+        void addLayer(const std::vector<int> &gids,
+                      const int width,
+                      const int height);
+
+        /**
+         * Disable cache saving for current map.
+         */
+        void invalidate()
+        { mValid = false; }
+
+        /**
+         * Saves added layers to cache file.
+         */
+        void save() const;
+
+        static std::string getCacheDir() A_WARN_UNUSED;
+
+    private:
+        void load();
+
+        bool readInt(int &val) A_WARN_UNUSED;
+
+        void writeInt(const int val);
+
+        std::string mFileName;
+        std::vector<char> mData;
+        size_t mPos;
+        uint32_t mHash;
+        bool mLoaded;
+        bool mValid;
+};
+
+#endif  // RESOURCES_MAP_MAPCACHE_H
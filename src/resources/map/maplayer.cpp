@@ -40,6 +40,8 @@
 #include "resources/map/metatile.h"
 #include "resources/map/speciallayer.h"
 
+#include <algorithm>
+
 #include "debug.h"
 
 MapLayer::MapLayer(const std::string &name,
@@ -62,6 +64,8 @@ MapLayer::MapLayer(const std::string &name,
     mTempLayer(nullptr),
     mName(name),
     mTempRows(),
+    mAnimations(),
+    mAnimationVersion(0U),
     mMask(mask),
     mTileCondition(tileCondition),
     mActorsFix(0),
@@ -99,6 +103,39 @@ void MapLayer::setTile(const int x,
     mTiles[x + y * mWidth].image = img;
 }
 
+void MapLayer::setTileAnimation(const int index,
+                                const TileAnimation *const ani) restrict
+{
+    mTiles[index].animation = ani;
+    // tiles with same animation usually placed together
+    if (!mAnimations.empty() && mAnimations.back() == ani)
+        return;
+    if (std::find(mAnimations.begin(), mAnimations.end(), ani)
+        == mAnimations.end())
+    {
+        mAnimations.push_back(ani);
+    }
+}
+
+unsigned int MapLayer::getAnimationVersion() const restrict2
+{
+    // versions only grow, so sum changed if any animation changed
+    unsigned int version = 0U;
+    FOR_EACH (std::vector<const TileAnimation*>::const_iterator,
+              it, mAnimations)
+    {
+        version += (*it)->getVersion();
+    }
+    return version;
+}
+
+bool MapLayer::isAnimationChanged() const restrict2
+{
+    if (mAnimations.empty())
+        return false;
+    return getAnimationVersion() != mAnimationVersion;
+}
+
 void MapLayer::draw(Graphics *const graphics,
                     int startX,
                     int startY,
@@ -144,7 +181,7 @@ void MapLayer::draw(Graphics *const graphics,
             const int x32 = x * mapTileSize;
 
             int c = 0;
-            const Image *const img = tilePtr->image;
+            const Image *const img = tilePtr->getImage();
             if (img)
             {
                 const int px = x32 + dx;
@@ -207,6 +244,7 @@ void MapLayer::updateSDL(const Graphics *const graphics,
     BLOCK_START("MapLayer::updateSDL")
     delete_all(mTempRows);
     mTempRows.clear();
+    mAnimationVersion = getAnimationVersion();
 
     startX -= mX;
     startY -= mY;
@@ -241,7 +279,7 @@ void MapLayer::updateSDL(const Graphics *const graphics,
         {
             if (!tilePtr->isEnabled)
                 continue;
-            Image *const img = (*tilePtr).image;
+            Image *const img = tilePtr->getImage();
             if (img)
             {
                 const int px = x * mapTileSize + dx;
@@ -275,6 +313,7 @@ void MapLayer::updateOGL(Graphics *const graphics,
     BLOCK_START("MapLayer::updateOGL")
     delete_all(mTempRows);
     mTempRows.clear();
+    mAnimationVersion = getAnimationVersion();
 
     startX -= mX;
     startY -= mY;
@@ -309,7 +348,7 @@ void MapLayer::updateOGL(Graphics *const graphics,
         {
             if (!tilePtr->isEnabled)
                 continue;
-            Image *const img = (*tilePtr).image;
+            Image *const img = tilePtr->getImage();
             if (img)
             {
                 const int px = x * mapTileSize + dx;
@@ -384,7 +423,7 @@ void MapLayer::drawFringe(Graphics *const graphics,
                           int endY,
                           const int scrollX,
                           const int scrollY,
-                          const Actors &actors) const restrict
+                          const SortedActors &actors) const restrict
 {
     BLOCK_START("MapLayer::drawFringe")
     if (!localPlayer ||
@@ -409,8 +448,8 @@ void MapLayer::drawFringe(Graphics *const graphics,
     if (endY > mHeight)
         endY = mHeight;
 
-    ActorsCIter ai = actors.begin();
-    const ActorsCIter ai_end = actors.end();
+    SortedActorsCIter ai = actors.begin();
+    const SortedActorsCIter ai_end = actors.end();
 
     const int dx = mPixelX - scrollX;
     const int dy = mPixelY - scrollY;
@@ -434,9 +473,9 @@ void MapLayer::drawFringe(Graphics *const graphics,
             BLOCK_START("MapLayer::drawFringe drawmobs")
             // If drawing the fringe layer, make sure all actors above this
             // row of tiles have been drawn
-            while (ai != ai_end && (*ai)->getSortPixelY() <= y32s)
+            while (ai != ai_end && ai->sortY <= y32s)
             {
-                (*ai)->draw(graphics, -scrollX, -scrollY);
+                ai->actor->draw(graphics, -scrollX, -scrollY);
                 ++ ai;
             }
             BLOCK_END("MapLayer::drawFringe drawmobs")
@@ -479,9 +518,9 @@ void MapLayer::drawFringe(Graphics *const graphics,
             BLOCK_START("MapLayer::drawFringe drawmobs")
             // If drawing the fringe layer, make sure all actors above this
             // row of tiles have been drawn
-            while (ai != ai_end && (*ai)->getSortPixelY() <= y32s)
+            while (ai != ai_end && ai->sortY <= y32s)
             {
-                (*ai)->draw(graphics, -scrollX, -scrollY);
+                ai->actor->draw(graphics, -scrollX, -scrollY);
                 ++ ai;
             }
             BLOCK_END("MapLayer::drawFringe drawmobs")
@@ -499,9 +538,9 @@ void MapLayer::drawFringe(Graphics *const graphics,
             // If drawing the fringe layer, make sure all actors above this
             // row of tiles have been drawn
             while (ai != ai_end &&
-                   (*ai)->getSortPixelY() <= y32s)
+                   ai->sortY <= y32s)
             {
-                (*ai)->draw(graphics, -scrollX, -scrollY);
+                ai->actor->draw(graphics, -scrollX, -scrollY);
                 ++ ai;
             }
             BLOCK_END("MapLayer::drawFringe drawmobs")
@@ -518,7 +557,7 @@ void MapLayer::drawFringe(Graphics *const graphics,
 
                 const int px1 = x32 - scrollX;
                 int c = 0;
-                const Image *const img = tilePtr->image;
+                const Image *const img = tilePtr->getImage();
                 if (img)
                 {
                     if (mSpecialFlag ||
@@ -589,9 +628,9 @@ void MapLayer::drawFringe(Graphics *const graphics,
             BLOCK_START("MapLayer::drawFringe drawmobs")
             // If drawing the fringe layer, make sure all actors above this
             // row of tiles have been drawn
-            while (ai != ai_end && (*ai)->getSortPixelY() <= y32s)
+            while (ai != ai_end && ai->sortY <= y32s)
             {
-                (*ai)->draw(graphics, -scrollX, -scrollY);
+                ai->actor->draw(graphics, -scrollX, -scrollY);
                 ++ ai;
             }
             BLOCK_END("MapLayer::drawFringe drawmobs")
@@ -604,7 +643,7 @@ void MapLayer::drawFringe(Graphics *const graphics,
                 if (!tilePtr->isEnabled)
                     continue;
                 const int x32 = x * mapTileSize;
-                const Image *const img = tilePtr->image;
+                const Image *const img = tilePtr->getImage();
                 if (img)
                 {
                     const int px = x32 + dx;
@@ -642,7 +681,7 @@ void MapLayer::drawFringe(Graphics *const graphics,
         BLOCK_START("MapLayer::drawFringe drawmobs")
         while (ai != ai_end)
         {
-            (*ai)->draw(graphics, -scrollX, -scrollY);
+            ai->actor->draw(graphics, -scrollX, -scrollY);
             ++ai;
         }
         BLOCK_END("MapLayer::drawFringe drawmobs")
@@ -685,7 +724,7 @@ int MapLayer::getTileDrawWidth(const TileInfo *restrict tilePtr,
                                int &width)
 {
     BLOCK_START("MapLayer::getTileDrawWidth")
-    const Image *const img1 = tilePtr->image;
+    const Image *const img1 = tilePtr->getImage();
     int c = 0;
     if (!img1)
     {
@@ -697,7 +736,7 @@ int MapLayer::getTileDrawWidth(const TileInfo *restrict tilePtr,
     for (int x = 1; x < endX; x++)
     {
         tilePtr ++;
-        const Image *const img = tilePtr->image;
+        const Image *const img = tilePtr->getImage();
         if (img != img1 || !tilePtr->isEnabled)
             break;
         c ++;
@@ -27,14 +27,14 @@
 
 #include "resources/memorycounter.h"
 
-#include "being/actor.h"
-
 #include "enums/resources/map/maptype.h"
 
+#include "resources/map/actorrows.h"
 #include "resources/map/tileinfo.h"
 
 #include <vector>
 
+class Graphics;
 class Image;
 class MapRowVertexes;
 class SpecialLayer;
@@ -85,6 +85,19 @@ class MapLayer final: public MemoryCounter, public ConfigListener
                      Image *restrict const img) restrict
         { mTiles[index].image = img; }
 
+        /**
+         * Set animation for tile with x + y * width already known.
+         */
+        void setTileAnimation(const int index,
+                              const TileAnimation *restrict const ani)
+                              restrict A_NONNULL(3);
+
+        /**
+         * Returns true if any animation used in layer changed frame
+         * after last update of cached vertexes.
+         */
+        bool isAnimationChanged() const restrict2 A_WARN_UNUSED;
+
         /**
          * Draws this layer to the given graphics context. The coordinates are
          * expected to be in map range and will be translated to local layer
@@ -132,7 +145,8 @@ class MapLayer final: public MemoryCounter, public ConfigListener
                         int endY,
                         const int scrollX,
                         const int scrollY,
-                        const Actors &actors) const restrict A_NONNULL(2);
+                        const SortedActors &actors) const restrict
+                        A_NONNULL(2);
 
         bool isFringeLayer() const restrict noexcept2 A_WARN_UNUSED
         { return mIsFringeLayer; }
@@ -173,6 +187,8 @@ class MapLayer final: public MemoryCounter, public ConfigListener
                                   const int width,
                                   const int height) restrict A_NONNULL(2);
 
+        unsigned int getAnimationVersion() const restrict2 A_WARN_UNUSED;
+
     private:
         const int mX;
         const int mY;
@@ -187,6 +203,8 @@ class MapLayer final: public MemoryCounter, public ConfigListener
         const std::string mName;
         typedef std::vector<MapRowVertexes*> MapRows;
         MapRows mTempRows;
+        std::vector<const TileAnimation*> mAnimations;
+        unsigned int mAnimationVersion;
         int mMask;
         int mTileCondition;
         int mActorsFix;
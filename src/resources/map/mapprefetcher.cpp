@@ -0,0 +1,368 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "resources/map/mapprefetcher.h"
+
+#include "configuration.h"
+#ifdef USE_OPENGL
+#include "graphicsmanager.h"
+#endif  // USE_OPENGL
+#include "logger.h"
+
+#include "resources/imagehelper.h"
+#include "resources/mapinfo.h"
+#include "resources/mapreader.h"
+
+#include "resources/db/mapdb.h"
+
+#include "resources/image/image.h"
+
+#ifdef USE_OPENGL
+#include "resources/loaders/atlasloader.h"
+#endif  // USE_OPENGL
+#include "resources/loaders/imageloader.h"
+#include "resources/loaders/musicloader.h"
+
+#include "resources/map/map.h"
+#include "resources/map/mapitem.h"
+
+#include "resources/sdlmusic.h"
+
+#include "resources/resourcemanager/resourcemanager.h"
+
+#include "utils/physfsrwops.h"
+#include "utils/physfstools.h"
+#include "utils/sdlcheckutils.h"
+#include "utils/sdlhelper.h"
+
+#include <algorithm>
+
+#include "debug.h"
+
+MapPrefetcher *mapPrefetcher = nullptr;
+
+namespace
+{
+    struct DecodedImageLoader final
+    {
+        SDL_Surface *surface;
+        static Resource *load(const void *const v)
+        {
+            if (!v)
+                return nullptr;
+            const DecodedImageLoader *const rl
+                = static_cast<const DecodedImageLoader *const>(v);
+            return imageHelper->loadSurface(rl->surface);
+        }
+    };
+}  // namespace
+
+MapPrefetcher::MapPrefetcher() :
+    ConfigListener(),
+    mMap(nullptr),
+    mTargetMap(),
+    mResources(),
+    mMemory(0),
+    mMaxMemory(config.getIntValue("mapPrefetchMemory") * 1024 * 1024),
+    mDistance(config.getIntValue("mapPrefetchDistance")),
+    mEnabled(config.getBoolValue("enableMapPrefetch")),
+    mAtlasLoaded(false),
+    mMutex(),
+    mMapFile(),
+    mMusic(),
+    mDecoded(),
+    mThread(nullptr),
+    mThreadMemory(0),
+    mStopThread(false),
+    mThreadDone(false)
+{
+    config.addListener("enableMapPrefetch", this);
+    config.addListener("mapPrefetchMemory", this);
+    config.addListener("mapPrefetchDistance", this);
+}
+
+MapPrefetcher::~MapPrefetcher()
+{
+    config.removeListeners(this);
+    CHECKLISTENERS
+    clear();
+}
+
+void MapPrefetcher::optionChanged(const std::string &name)
+{
+    if (name == "enableMapPrefetch")
+    {
+        mEnabled = config.getBoolValue("enableMapPrefetch");
+        if (!mEnabled)
+            clear();
+    }
+    else if (name == "mapPrefetchMemory")
+    {
+        mMaxMemory = config.getIntValue("mapPrefetchMemory") * 1024 * 1024;
+    }
+    else if (name == "mapPrefetchDistance")
+    {
+        mDistance = config.getIntValue("mapPrefetchDistance");
+    }
+}
+
+void MapPrefetcher::setMap(const Map *const map)
+{
+    // new map already referenced all own resources
+    clear();
+    mMap = map;
+}
+
+void MapPrefetcher::clear()
+{
+    stopThread();
+    FOR_EACH (std::vector<Resource*>::iterator, it, mResources)
+        (*it)->decRef();
+    mResources.clear();
+    mTargetMap.clear();
+    mMapFile.clear();
+    mMusic.clear();
+    mMemory = 0;
+    mAtlasLoaded = false;
+}
+
+void MapPrefetcher::stopThread()
+{
+    if (mThread)
+    {
+        {
+            MutexLocker lock(&mMutex);
+            mStopThread = true;
+        }
+        SDL_WaitThread(mThread, nullptr);
+        mThread = nullptr;
+    }
+
+    FOR_EACH (DecodedList::const_iterator, it, mDecoded)
+    {
+        if ((*it).second)
+            MSDL_FreeSurface((*it).second);
+    }
+    mDecoded.clear();
+    mStopThread = false;
+    mThreadDone = false;
+}
+
+void MapPrefetcher::logic(const int x, const int y)
+{
+    if (!mEnabled || !mMap)
+        return;
+
+    BLOCK_START("MapPrefetcher::logic")
+    const MapItem *nearest = nullptr;
+    int nearestDist = mDistance + 1;
+    const std::vector<MapItem*> &targets = mMap->getPortalTargets();
+    FOR_EACH (std::vector<MapItem*>::const_iterator, it, targets)
+    {
+        const MapItem *const item = *it;
+        const int dist = std::max(abs(item->getX() - x),
+            abs(item->getY() - y));
+        if (dist < nearestDist)
+        {
+            nearest = item;
+            nearestDist = dist;
+        }
+    }
+
+    if (!nearest)
+    {
+        // player moved away from warps
+        if (!mTargetMap.empty())
+            clear();
+        BLOCK_END("MapPrefetcher::logic")
+        return;
+    }
+
+    if (nearest->getComment() != mTargetMap)
+    {
+        clear();
+        startPrefetch(nearest->getComment());
+    }
+    else
+    {
+        loadNext();
+    }
+    BLOCK_END("MapPrefetcher::logic")
+}
+
+void MapPrefetcher::startPrefetch(const std::string &mapName)
+{
+    logger->log("Prefetch map: %s", mapName.c_str());
+    mTargetMap = mapName;
+
+    const std::string realName = MapDB::getMapName(mapName);
+    mMapFile = paths.getValue("maps", "maps/").append(
+        realName).append(".tmx");
+    if (!PhysFs::exists(mMapFile.c_str()))
+        mMapFile.append(".gz");
+    // same as MapReader::updateMusic
+    mMusic = realName.substr(realName.rfind("/") + 1).append(".ogg");
+    mThreadMemory = mMaxMemory;
+
+    mThread = SDL::createThread(&MapPrefetcher::prefetchThread,
+        "mapprefetch", this);
+    if (!mThread)
+    {
+        logger->log1("Error: map prefetch thread creation failed");
+        mThreadDone = true;
+    }
+}
+
+int MapPrefetcher::prefetchThread(void *ptr)
+{
+    MapPrefetcher *const prefetcher = static_cast<MapPrefetcher*>(ptr);
+    if (!prefetcher)
+        return 0;
+
+    StringVect files;
+    std::string music;
+    MapReader::readMapResources(prefetcher->mMapFile, files, music);
+    if (!music.empty())
+    {
+        MutexLocker lock(&prefetcher->mMutex);
+        prefetcher->mMusic = music;
+    }
+
+    int memory = 0;
+    FOR_EACH (StringVectCIter, it, files)
+    {
+        {
+            MutexLocker lock(&prefetcher->mMutex);
+            if (prefetcher->mStopThread)
+                break;
+        }
+        if (memory >= prefetcher->mThreadMemory)
+            break;
+
+        // dyed images loaded in main thread
+        const std::string &path = *it;
+        SDL_Surface *surface = nullptr;
+        if (path.find('|') == std::string::npos)
+        {
+            surface = ImageHelper::loadPng(
+                MPHYSFSRWOPS_openRead(path.c_str()));
+        }
+        if (surface)
+            memory += surface->pitch * surface->h;
+
+        MutexLocker lock(&prefetcher->mMutex);
+        prefetcher->mDecoded.push_back(std::make_pair(path, surface));
+    }
+
+    MutexLocker lock(&prefetcher->mMutex);
+    prefetcher->mThreadDone = true;
+    return 0;
+}
+
+void MapPrefetcher::addResource(Resource *const res)
+{
+    if (!res)
+        return;
+    mResources.push_back(res);
+    mMemory += res->calcMemory(0);
+}
+
+void MapPrefetcher::addImage(const std::string &path,
+                             SDL_Surface *const surface)
+{
+    if (!surface)
+    {
+        addResource(Loader::getImage(path));
+        return;
+    }
+
+    // image can be already loaded, then surface not used
+    DecodedImageLoader rl = { surface };
+    addResource(static_cast<Image*>(resourceManager->get(path,
+        DecodedImageLoader::load, &rl)));
+    MSDL_FreeSurface(surface);
+}
+
+void MapPrefetcher::loadNext()
+{
+    if (mTargetMap.empty() || mMemory >= mMaxMemory)
+        return;
+
+#ifdef USE_OPENGL
+    if (!mAtlasLoaded)
+    {
+        mAtlasLoaded = true;
+        if (graphicsManager.getUseAtlases())
+        {
+            const std::string realName = MapDB::getMapName(mTargetMap);
+            const MapInfo *const info = MapDB::getMapAtlas(
+                realName.substr(realName.rfind("/") + 1).append(".tmx"));
+            if (info)
+            {
+                addResource(Loader::getAtlas(
+                    info->atlas,
+                    *info->files));
+                return;
+            }
+        }
+    }
+#endif  // USE_OPENGL
+
+    std::string path;
+    SDL_Surface *surface = nullptr;
+    bool found(false);
+    bool done(false);
+    {
+        MutexLocker lock(&mMutex);
+        if (!mDecoded.empty())
+        {
+            // tilesets first, ambient layers after
+            path = mDecoded.front().first;
+            surface = mDecoded.front().second;
+            mDecoded.pop_front();
+            found = true;
+        }
+        done = mThreadDone;
+    }
+    if (found)
+    {
+        addImage(path, surface);
+        return;
+    }
+    if (!done)
+        return;
+    if (mThread)
+    {
+        SDL_WaitThread(mThread, nullptr);
+        mThread = nullptr;
+    }
+
+    if (!mMusic.empty())
+    {
+        if (config.getBoolValue("sound"))
+        {
+            const std::string path = paths.getStringValue(
+                "music").append(mMusic);
+            if (PhysFs::exists(path.c_str()))
+                addResource(Loader::getMusic(path));
+        }
+        mMusic.clear();
+    }
+}
@@ -0,0 +1,109 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RESOURCES_MAP_MAPPREFETCHER_H
+#define RESOURCES_MAP_MAPPREFETCHER_H
+
+#include "listeners/configlistener.h"
+
+#include "utils/mutex.h"
+#include "utils/stringvector.h"
+
+#include <list>
+#include <vector>
+
+#include "localconsts.h"
+
+class Map;
+class Resource;
+
+struct SDL_Surface;
+struct SDL_Thread;
+
+/**
+ * Loads resources of map behind nearest warp while player stand near it.
+ * Map file parsed and images decoded in worker thread, decoded images
+ * converted to textures one per call. Resources holded until next map
+ * loaded or player moved away from warp.
+ */
+class MapPrefetcher final : public ConfigListener
+{
+    public:
+        MapPrefetcher();
+
+        A_DELETE_COPY(MapPrefetcher)
+
+        ~MapPrefetcher();
+
+        /**
+         * Sets current map. Must be called after new map loaded,
+         * for keep prefetched resources until this time.
+         */
+        void setMap(const Map *const map);
+
+        /**
+         * Updates prefetch target and loads next resource.
+         * x, y is player tile position.
+         */
+        void logic(const int x, const int y);
+
+        void clear();
+
+        void optionChanged(const std::string &name) override final;
+
+    private:
+        void startPrefetch(const std::string &mapName);
+
+        void loadNext();
+
+        void addResource(Resource *const res);
+
+        void addImage(const std::string &path,
+                      SDL_Surface *const surface);
+
+        void stopThread();
+
+        static int prefetchThread(void *ptr);
+
+        typedef std::list<std::pair<std::string, SDL_Surface*> > DecodedList;
+
+        const Map *mMap;
+        std::string mTargetMap;
+        std::vector<Resource*> mResources;
+        int mMemory;
+        int mMaxMemory;
+        int mDistance;
+        bool mEnabled;
+        bool mAtlasLoaded;
+
+        // shared with worker thread
+        Mutex mMutex;
+        std::string mMapFile;
+        std::string mMusic;
+        DecodedList mDecoded;
+        SDL_Thread *mThread;
+        int mThreadMemory;
+        bool mStopThread;
+        bool mThreadDone;
+};
+
+extern MapPrefetcher *mapPrefetcher;
+
+#endif  // RESOURCES_MAP_MAPPREFETCHER_H
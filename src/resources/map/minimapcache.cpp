@@ -0,0 +1,215 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "resources/map/minimapcache.h"
+
+#include "logger.h"
+
+#include "enums/resources/map/blockmask.h"
+
+#include "resources/imagehelper.h"
+
+#include "resources/image/image.h"
+
+#include "resources/map/map.h"
+#include "resources/map/metatile.h"
+
+#include "utils/delete2.h"
+#include "utils/dtor.h"
+#include "utils/sdlcheckutils.h"
+#include "utils/sdlhelper.h"
+
+#include "debug.h"
+
+namespace
+{
+    const uint32_t walkableColor = 0x00ffffffU;
+    const uint32_t blockedColor = 0x0U;
+}  // namespace
+
+MinimapCache::MinimapCache(const Map *const map) :
+    mWalkable(),
+    mTiles(),
+    mThread(nullptr),
+    mMutex(),
+    mWidth(map->getWidth()),
+    mHeight(map->getHeight()),
+    mGenerated(false),
+    mUploaded(false)
+{
+    // copy collision grid, because map can be deleted before thread end
+    const int size = mWidth * mHeight;
+    const int mask = (BlockMask::WALL |
+        BlockMask::AIR |
+        BlockMask::WATER |
+        BlockMask::PLAYERWALL);
+    mWalkable.resize(size);
+    const MetaTile *const metaTiles = map->mMetaTiles;
+    for (int ptr = 0; ptr < size; ptr ++)
+    {
+        mWalkable[ptr] = (metaTiles[ptr].blockmask & mask) ?
+            CAST_U8(0) : CAST_U8(1);
+    }
+}
+
+MinimapCache::~MinimapCache()
+{
+    if (mThread)
+    {
+        SDL_WaitThread(mThread, nullptr);
+        mThread = nullptr;
+    }
+    for (int level = 0; level < levels; level ++)
+    {
+        FOR_EACH (MinimapTilesCIter, it, mTiles[level])
+        {
+            MinimapTile *const tile = *it;
+            delete2(tile->image);
+        }
+        delete_all(mTiles[level]);
+        mTiles[level].clear();
+    }
+}
+
+void MinimapCache::start()
+{
+    mThread = SDL::createThread(&MinimapCache::generateThread,
+        "minimap", this);
+    if (!mThread)
+    {
+        logger->log1("Error: minimap thread creation failed");
+        generate();
+    }
+}
+
+int MinimapCache::generateThread(void *ptr)
+{
+    MinimapCache *const cache = static_cast<MinimapCache*>(ptr);
+    if (cache)
+        cache->generate();
+    return 0;
+}
+
+void MinimapCache::generate()
+{
+    std::vector<unsigned char> walkable;
+    walkable.swap(mWalkable);
+    int width = mWidth;
+    int height = mHeight;
+    addTiles(0, walkable, width, height);
+
+    for (int level = 1; level < levels; level ++)
+    {
+        // pixel is walkable if any of map tiles under it is walkable
+        const int width2 = (width + 1) / 2;
+        const int height2 = (height + 1) / 2;
+        std::vector<unsigned char> walkable2(width2 * height2);
+        for (int y = 0; y < height; y ++)
+        {
+            const unsigned char *const src = &walkable[y * width];
+            unsigned char *const dst = &walkable2[(y / 2) * width2];
+            for (int x = 0; x < width; x ++)
+                dst[x / 2] |= src[x];
+        }
+        walkable.swap(walkable2);
+        width = width2;
+        height = height2;
+        addTiles(level, walkable, width, height);
+    }
+
+    MutexLocker lock(&mMutex);
+    mGenerated = true;
+}
+
+void MinimapCache::addTiles(const int level,
+                            const std::vector<unsigned char> &walkable,
+                            const int width,
+                            const int height)
+{
+    for (int tileY = 0; tileY < height; tileY += tileSize)
+    {
+        const int tileHeight = std::min(tileSize, height - tileY);
+        for (int tileX = 0; tileX < width; tileX += tileSize)
+        {
+            const int tileWidth = std::min(tileSize, width - tileX);
+            MinimapTile *const tile = new MinimapTile(tileX, tileY,
+                tileWidth, tileHeight);
+            std::vector<uint32_t> &pixels = tile->pixels;
+            pixels.resize(tileWidth * tileHeight);
+            uint32_t *dst = &pixels[0];
+            for (int y = 0; y < tileHeight; y ++)
+            {
+                const unsigned char *src =
+                    &walkable[(tileY + y) * width + tileX];
+                for (int x = 0; x < tileWidth; x ++)
+                    *(dst ++) = *(src ++) ? walkableColor : blockedColor;
+            }
+            mTiles[level].push_back(tile);
+        }
+    }
+}
+
+bool MinimapCache::update(const float alpha)
+{
+    if (mUploaded)
+        return true;
+    {
+        MutexLocker lock(&mMutex);
+        if (!mGenerated)
+            return false;
+    }
+    if (mThread)
+    {
+        SDL_WaitThread(mThread, nullptr);
+        mThread = nullptr;
+    }
+
+    BLOCK_START("MinimapCache::update")
+    for (int level = 0; level < levels; level ++)
+    {
+        FOR_EACH (MinimapTilesCIter, it, mTiles[level])
+        {
+            MinimapTile *const tile = *it;
+            SDL_Surface *const surface = MSDL_CreateRGBSurface(
+                SDL_SWSURFACE, tile->width, tile->height, 32,
+                0x00ff0000, 0x0000ff00, 0x000000ff, 0x00000000);
+            if (!surface)
+                continue;
+            SDL_LockSurface(surface);
+            const size_t rowSize = tile->width * sizeof(uint32_t);
+            for (int y = 0; y < tile->height; y ++)
+            {
+                memcpy(static_cast<char*>(surface->pixels)
+                    + y * surface->pitch,
+                    &tile->pixels[y * tile->width],
+                    rowSize);
+            }
+            SDL_UnlockSurface(surface);
+            tile->image = imageHelper->loadSurface(surface);
+            if (tile->image)
+                tile->image->setAlpha(alpha);
+            MSDL_FreeSurface(surface);
+            std::vector<uint32_t>().swap(tile->pixels);
+        }
+    }
+    mUploaded = true;
+    BLOCK_END("MinimapCache::update")
+    return true;
+}
@@ -0,0 +1,129 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RESOURCES_MAP_MINIMAPCACHE_H
+#define RESOURCES_MAP_MINIMAPCACHE_H
+
+#include "utils/mutex.h"
+
+#include <vector>
+
+#include "localconsts.h"
+
+class Image;
+class Map;
+
+struct SDL_Thread;
+
+struct MinimapTile final
+{
+    MinimapTile(const int x0,
+                const int y0,
+                const int width0,
+                const int height0) :
+        pixels(),
+        image(nullptr),
+        x(x0),
+        y(y0),
+        width(width0),
+        height(height0)
+    {
+    }
+
+    A_DELETE_COPY(MinimapTile)
+
+    std::vector<uint32_t> pixels;
+    Image *image;
+    const int x;
+    const int y;
+    const int width;
+    const int height;
+};
+
+typedef std::vector<MinimapTile*> MinimapTiles;
+typedef MinimapTiles::const_iterator MinimapTilesCIter;
+
+/**
+ * Extended minimap generated from map collision grid.
+ * Minimap split into tiles for each zoom level, so big maps not need
+ * huge images and only visible tiles drawn.
+ * Tiles pixels generated in worker thread and uploaded to images
+ * from main thread.
+ */
+class MinimapCache final
+{
+    public:
+        explicit MinimapCache(const Map *const map) A_NONNULL(2);
+
+        A_DELETE_COPY(MinimapCache)
+
+        ~MinimapCache();
+
+        /**
+         * Starts tiles generation in worker thread.
+         */
+        void start();
+
+        /**
+         * Creates images for generated tiles.
+         * Must be called from main thread.
+         *
+         * @return true if tiles images ready.
+         */
+        bool update(const float alpha);
+
+        const MinimapTiles &getTiles(const int level) const A_WARN_UNUSED
+        { return mTiles[level]; }
+
+        /**
+         * Returns minimap width in pixels for zoom level.
+         * On level n one pixel show 2^n x 2^n map tiles.
+         */
+        int getWidth(const int level) const A_WARN_UNUSED
+        { return (mWidth + (1 << level) - 1) >> level; }
+
+        int getHeight(const int level) const A_WARN_UNUSED
+        { return (mHeight + (1 << level) - 1) >> level; }
+
+        static const int levels = 3;
+
+        static const int tileSize = 256;
+
+    private:
+        static int generateThread(void *ptr);
+
+        void generate();
+
+        void addTiles(const int level,
+                      const std::vector<unsigned char> &walkable,
+                      const int width,
+                      const int height);
+
+        std::vector<unsigned char> mWalkable;
+        MinimapTiles mTiles[levels];
+        SDL_Thread *mThread;
+        Mutex mMutex;
+        const int mWidth;
+        const int mHeight;
+        bool mGenerated;
+        bool mUploaded;
+};
+
+#endif  // RESOURCES_MAP_MINIMAPCACHE_H
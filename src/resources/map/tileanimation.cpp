@@ -22,18 +22,18 @@
 
 #include "resources/map/tileanimation.h"
 
-#include "resources/animation/simpleanimation.h"
+#include "settings.h"
 
-#include "resources/map/maplayer.h"
+#include "resources/animation/simpleanimation.h"
 
 #include "utils/delete2.h"
 
 #include "debug.h"
 
 TileAnimation::TileAnimation(Animation *const ani) :
-    mAffected(),
     mAnimation(new SimpleAnimation(ani)),
-    mLastImage(nullptr)
+    mCurrentImage(mAnimation->getCurrentImage()),
+    mVersion(0U)
 {
 }
 
@@ -51,16 +51,11 @@ bool TileAnimation::update(const int ticks)
     if (!mAnimation->update(ticks))
         return false;
 
-    // exchange images
     Image *const img = mAnimation->getCurrentImage();
-    if (img != mLastImage)
-    {
-        FOR_EACH (TilePairVectorCIter, i, mAffected)
-        {
-            if (i->first)
-                i->first->setTile(i->second, img);
-        }
-        mLastImage = img;
-    }
+    if (img == mCurrentImage)
+        return false;
+    mCurrentImage = img;
+    mVersion ++;
+    settings.needRedraw = true;
     return true;
 }
@@ -24,20 +24,18 @@
 #define RESOURCES_MAP_TILEANIMATION_H
 
 #include <map>
-#include <vector>
 
 #include "localconsts.h"
 
 class Animation;
 class Image;
-class MapLayer;
 class SimpleAnimation;
 
-typedef std::vector<std::pair<MapLayer*, int> > TilePairVector;
-typedef TilePairVector::const_iterator TilePairVectorCIter;
-
 /**
- * Animation cycle of a tile image which changes the map accordingly.
+ * Animation cycle of a tile image.
+ * Tiles point to animation and read current frame while drawing.
+ * Frame change only increase version, what allow layers to detect
+ * if cached vertexes need update.
  */
 class TileAnimation final
 {
@@ -48,15 +46,23 @@ class TileAnimation final
 
         A_DELETE_COPY(TileAnimation)
 
+        /**
+         * Updates animation.
+         *
+         * @return true if current frame image changed.
+         */
         bool update(const int ticks = 1);
 
-        void addAffectedTile(MapLayer *const layer, const int index)
-        { mAffected.push_back(std::make_pair(layer, index)); }
+        Image *getCurrentImage() const noexcept2 A_WARN_UNUSED
+        { return mCurrentImage; }
+
+        unsigned int getVersion() const noexcept2 A_WARN_UNUSED
+        { return mVersion; }
 
     private:
-        TilePairVector mAffected;
         SimpleAnimation *mAnimation;
-        Image *mLastImage;
+        Image *mCurrentImage;
+        unsigned int mVersion;
 };
 
 typedef std::map<int, TileAnimation*> TileAnimationMap;
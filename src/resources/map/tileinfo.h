@@ -21,6 +21,8 @@
 #ifndef RESOURCES_MAP_TILEINFO_H
 #define RESOURCES_MAP_TILEINFO_H
 
+#include "resources/map/tileanimation.h"
+
 #include "localconsts.h"
 
 class Image;
@@ -29,11 +31,20 @@ struct TileInfo final
 {
     TileInfo() :
         image(nullptr),
+        animation(nullptr),
         isEnabled(true)
     {
     }
 
+    /**
+     * Returns image for drawing. Animated tiles read current frame
+     * from animation, so frame change not touch tiles.
+     */
+    Image *getImage() const
+    { return animation ? animation->getCurrentImage() : image; }
+
     Image *image;
+    const TileAnimation *animation;
     bool isEnabled;
 };
 
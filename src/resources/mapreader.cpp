@@ -31,9 +31,12 @@
 #include "const/resources/map/map.h"
 
 #include "enums/resources/map/collisiontype.h"
+#include "enums/resources/map/maplayertype.h"
 #include "enums/resources/map/mapitemtype.h"
 
+#include "resources/map/layerdecoder.h"
 #include "resources/map/map.h"
+#include "resources/map/mapcache.h"
 #include "resources/map/mapheights.h"
 #include "resources/map/maplayer.h"
 #include "resources/map/tileset.h"
@@ -55,14 +58,20 @@
 
 #include "resources/loaders/walklayerloader.h"
 
-#include "utils/base64.h"
 #include "utils/checkutils.h"
 #include "utils/delete2.h"
+#include "utils/dtor.h"
+#include "utils/mutex.h"
 #include "utils/physfstools.h"
+#include "utils/sdlhelper.h"
 #include "utils/stringmap.h"
 
 #include "utils/translation/podict.h"
 
+#include <algorithm>
+
+#include <SDL_timer.h>
+
 #include <zlib.h>
 
 #include "debug.h"
@@ -76,18 +85,77 @@ Resource *MapReader::mEmptyAtlas = nullptr;
 
 namespace
 {
+    struct LayerJob final
+    {
+        LayerJob(const XmlNodePtr node0,
+                 MapLayer *const layer0,
+                 MapHeights *const heights0,
+                 const MapLayerTypeT &type0,
+                 const int width0,
+                 const int height0) :
+            gids(),
+            node(node0),
+            layer(layer0),
+            heights(heights0),
+            type(type0),
+            width(width0),
+            height(height0),
+            cached(false),
+            failed(false)
+        {
+        }
+
+        A_DELETE_COPY(LayerJob)
+
+        std::vector<int> gids;
+        XmlNodePtr node;
+        MapLayer *layer;
+        MapHeights *heights;
+        MapLayerTypeT type;
+        int width;
+        int height;
+        bool cached;
+        bool failed;
+    };
+
+    struct LayerQueue final
+    {
+        LayerQueue() :
+            jobs(),
+            threads(),
+            mutex(),
+            map(nullptr),
+            next(0U)
+        {
+        }
+
+        A_DELETE_COPY(LayerQueue)
+
+        ~LayerQueue()
+        {
+            delete_all(jobs);
+        }
+
+        std::vector<LayerJob*> jobs;
+        std::vector<SDL_Thread*> threads;
+        Mutex mutex;
+        Map *map;
+        size_t next;
+    };
+
     std::map<std::string, XmlNodePtr> mKnownLayers;
     std::set<XML::Document*> mKnownDocs;
+    MapCache *mMapCache = nullptr;
+    LayerQueue *mLayerQueue = nullptr;
+    // logger can't be used from worker threads
+    volatile bool mSilentDecode = false;
 }  // namespace
 
-static int inflateMemory(unsigned char *restrict const in,
-                         const unsigned int inLength,
-                         unsigned char *&restrict out,
-                         unsigned int &restrict outLength);
-
-static int inflateMemory(unsigned char *restrict const in,
-                         const unsigned int inLength,
-                         unsigned char *&restrict out);
+static void reportLayerError(const char *const text)
+{
+    if (!mSilentDecode)
+        reportAlways("%s", text);
+}
 
 static std::string resolveRelativePath(std::string base, std::string relative)
 {
@@ -115,110 +183,31 @@ static std::string resolveRelativePath(std::string base, std::string relative)
     return base + relative;
 }
 
-/**
- * Inflates either zlib or gzip deflated memory. The inflated memory is
- * expected to be freed by the caller.
- */
-int inflateMemory(unsigned char *restrict const in,
-                  const unsigned int inLength,
-                  unsigned char *&restrict out,
-                  unsigned int &restrict outLength)
+static void reportInflateError(const int ret)
 {
-    int bufferSize = 256 * 1024;
-    out = static_cast<unsigned char*>(calloc(bufferSize, 1));
-
-    z_stream strm;
-    strm.zalloc = Z_NULL;
-    strm.zfree = Z_NULL;
-    strm.opaque = Z_NULL;
-    strm.next_in = in;
-    strm.avail_in = inLength;
-    strm.next_out = out;
-    strm.avail_out = bufferSize;
-
-    int ret = inflateInit2(&strm, 15 + 32);
-    if (ret != Z_OK)
-        return ret;
-
-    do
+    if (ret == Z_MEM_ERROR)
     {
-        if (!strm.next_out)
-        {
-            inflateEnd(&strm);
-            return Z_MEM_ERROR;
-        }
-
-        ret = inflate(&strm, Z_NO_FLUSH);
-        if (ret == Z_STREAM_ERROR)
-            return ret;
-
-        switch (ret)
-        {
-            case Z_NEED_DICT:
-                ret = Z_DATA_ERROR;
-                A_FALLTHROUGH
-            case Z_DATA_ERROR:
-            case Z_MEM_ERROR:
-                (void) inflateEnd(&strm);
-                return ret;
-            default:
-                break;
-        }
-
-        if (ret != Z_STREAM_END)
-        {
-            out = static_cast<unsigned char*>(realloc(out, bufferSize * 2));
-
-            if (!out)
-            {
-                inflateEnd(&strm);
-                return Z_MEM_ERROR;
-            }
-
-            strm.next_out = out + CAST_SIZE(bufferSize);
-            strm.avail_out = bufferSize;
-            bufferSize *= 2;
-        }
+        reportLayerError("Error: Out of memory while decompressing map data!");
     }
-    while (ret != Z_STREAM_END);
-
-    outLength = bufferSize - strm.avail_out;
-    (void) inflateEnd(&strm);
-    return ret == Z_STREAM_END ? Z_OK : Z_DATA_ERROR;
-}
-
-int inflateMemory(unsigned char *restrict const in,
-                  const unsigned int inLength,
-                  unsigned char *&restrict out)
-{
-    unsigned int outLength = 0;
-    const int ret = inflateMemory(in, inLength, out, outLength);
-
-    if (ret != Z_OK || !out)
+    else if (ret == Z_VERSION_ERROR)
     {
-        if (ret == Z_MEM_ERROR)
-        {
-            reportAlways("Error: Out of memory while decompressing map data!");
-        }
-        else if (ret == Z_VERSION_ERROR)
-        {
-            reportAlways("Error: Incompatible zlib version!");
-        }
-        else if (ret == Z_DATA_ERROR)
-        {
-            reportAlways("Error: Incorrect zlib compressed data!");
-        }
-        else
-        {
-            reportAlways("Error: Unknown error while decompressing map data!");
-        }
-
-        free(out);
-        out = nullptr;
-        outLength = 0;
+        reportLayerError("Error: Incompatible zlib version!");
+    }
+    else if (ret == Z_DATA_ERROR)
+    {
+        reportLayerError("Error: Incorrect zlib compressed data!");
     }
+    else
+    {
+        reportLayerError("Error: Unknown error while decompressing map data!");
+    }
+}
 
-    return outLength;
+static LayerDecoder &mainLayerDecoder()
+{
+    // used only from main thread, worker threads have own decoders
+    static LayerDecoder decoder;
+    return decoder;
 }
 
 void MapReader::addLayerToList(const std::string &fileName,
@@ -258,13 +247,36 @@ Map *MapReader::readMap(const std::string &restrict filename,
     BLOCK_START("MapReader::readMap str")
     logger->log("Attempting to read map %s", realFilename.c_str());
 
-    XML::Document doc(realFilename, UseResman_true, SkipError_false);
+    int fileSize = 0;
+    char *const fileData = static_cast<char*>(PhysFs::loadFile(
+        realFilename, fileSize));
+    if (!fileData)
+    {
+        reportAlways("Error loading map file %s", realFilename.c_str());
+        BLOCK_END("MapReader::readMap str")
+        return createEmptyMap(filename, realFilename);
+    }
+
+    // cached layers depend on map file and client version
+    uLong hash = adler32(0L, Z_NULL, 0);
+    hash = adler32(hash,
+        reinterpret_cast<const Bytef*>(fileData),
+        CAST_U32(fileSize));
+    hash = adler32(hash,
+        reinterpret_cast<const Bytef*>(CHECK_VERSION),
+        CAST_U32(strlen(CHECK_VERSION)));
+
+    XML::Document doc(fileData, fileSize);
+    free(fileData);
     if (!doc.isLoaded())
     {
         BLOCK_END("MapReader::readMap str")
         return createEmptyMap(filename, realFilename);
     }
 
+    MapCache cache(realFilename, CAST_U32(hash));
+    mMapCache = &cache;
+
     XmlNodePtrConst node = doc.rootNode();
 
     Map *map = nullptr;
@@ -282,8 +294,10 @@ Map *MapReader::readMap(const std::string &restrict filename,
             realFilename.c_str());
     }
 
+    mMapCache = nullptr;
     if (map)
     {
+        cache.save();
         map->setProperty("_filename", realFilename);
         map->setProperty("_realfilename", filename);
 
@@ -326,6 +340,7 @@ Map *MapReader::readMap(XmlNodePtrConst node, const std::string &path)
         return nullptr;
 
     BLOCK_START("MapReader::readMap xml")
+    const uint32_t startTime = SDL_GetTicks();
     // Take the filename off the path
     const std::string pathDir = path.substr(0, path.rfind("/") + 1);
 
@@ -349,6 +364,12 @@ Map *MapReader::readMap(XmlNodePtrConst node, const std::string &path)
 
     logger->log("loading replace layer list");
     loadLayers(path + "_replace.d");
+    if (mMapCache && !mKnownLayers.empty())
+    {
+        // cache can't track replace layers
+        mMapCache->invalidate();
+        mMapCache = nullptr;
+    }
 
     Map *const map = new Map(path,
         w, h,
@@ -377,28 +398,42 @@ Map *MapReader::readMap(XmlNodePtrConst node, const std::string &path)
     BLOCK_END("MapReader::readMap load atlas")
 #endif  // USE_OPENGL
 
+    // layers created first and decoded in background,
+    // while tilesets and objects loading
+    LayerQueue layerQueue;
+    layerQueue.map = map;
+    mLayerQueue = &layerQueue;
+    for_each_xml_child_node(childNode, node)
+    {
+        if (!xmlNameEqual(childNode, "layer"))
+            continue;
+        std::string name = XML::getProperty(childNode, "name", "");
+        name = toLower(name);
+        LayerInfoIterator it = mKnownLayers.find(name);
+        if (it == mKnownLayers.end())
+        {
+            readLayer(childNode, map);
+        }
+        else
+        {
+            logger->log("load replace layer: " + name);
+            loadReplaceLayer(it, map);
+        }
+    }
+    mLayerQueue = nullptr;
+    startLayersDecoding();
+    const uint32_t layersTime = SDL_GetTicks();
+
+    uint32_t tilesetsTime = 0;
     for_each_xml_child_node(childNode, node)
     {
         if (xmlNameEqual(childNode, "tileset"))
         {
+            const uint32_t tilesetTime = SDL_GetTicks();
             Tileset *const tileset = readTileset(childNode, pathDir, map);
             if (tileset)
                 map->addTileset(tileset);
-        }
-        else if (xmlNameEqual(childNode, "layer"))
-        {
-            std::string name = XML::getProperty(childNode, "name", "");
-            name = toLower(name);
-            LayerInfoIterator it = mKnownLayers.find(name);
-            if (it == mKnownLayers.end())
-            {
-                readLayer(childNode, map);
-            }
-            else
-            {
-                logger->log("load replace layer: " + name);
-                loadReplaceLayer(it, map);
-            }
+            tilesetsTime += SDL_GetTicks() - tilesetTime;
         }
         else if (xmlNameEqual(childNode, "properties"))
         {
@@ -466,6 +501,13 @@ Map *MapReader::readMap(XmlNodePtrConst node, const std::string &path)
                         }
                         map->addPortal(objName, MapItemType::PORTAL,
                                        objX, objY, objW, objH);
+                        const std::string destMap = readObjectProperty(
+                            objectNode, "dest_map");
+                        if (!destMap.empty())
+                        {
+                            map->addPortalTarget(destMap,
+                                objX, objY, objW, objH);
+                        }
                     }
                     else if (objType == "SPAWN")
                     {
@@ -488,6 +530,12 @@ Map *MapReader::readMap(XmlNodePtrConst node, const std::string &path)
         }
     }
 
+    const uint32_t objectsTime = SDL_GetTicks();
+    mLayerQueue = &layerQueue;
+    finishLayersDecoding(map);
+    mLayerQueue = nullptr;
+    const uint32_t tilesTime = SDL_GetTicks();
+
     map->initializeAmbientLayers();
     map->clearIndexedTilesets();
     map->setActorsFix(0, atoi(map->getProperty("actorsfix").c_str()));
@@ -495,10 +543,40 @@ Map *MapReader::readMap(XmlNodePtrConst node, const std::string &path)
     map->setWalkLayer(Loader::getWalkLayer(fileName, map));
     unloadTempLayers();
     map->updateDrawLayersList();
+
+    const uint32_t endTime = SDL_GetTicks();
+    logger->log("Map load time %s: %u ms (layers %u, tilesets %u, "
+        "objects %u, decode and tiles %u, finish %u)",
+        fileName.c_str(),
+        endTime - startTime,
+        layersTime - startTime,
+        tilesetsTime,
+        objectsTime - layersTime - tilesetsTime,
+        tilesTime - objectsTime,
+        endTime - tilesTime);
     BLOCK_END("MapReader::readMap xml")
     return map;
 }
 
+std::string MapReader::readObjectProperty(const XmlNodePtrConst node,
+                                          const std::string &name)
+{
+    for_each_xml_child_node(childNode, node)
+    {
+        if (!xmlNameEqual(childNode, "properties"))
+            continue;
+        for_each_xml_child_node(propNode, childNode)
+        {
+            if (xmlNameEqual(propNode, "property") &&
+                XML::getProperty(propNode, "name", "") == name)
+            {
+                return XML::getProperty(propNode, "value", "");
+            }
+        }
+    }
+    return std::string();
+}
+
 void MapReader::readProperties(const XmlNodePtrConst node,
                                Properties *const props)
 {
@@ -633,149 +711,144 @@ inline static void setTile(Map *const map,
     }
 }
 
-bool MapReader::readBase64Layer(const XmlNodePtrConst childNode,
-                                Map *const map,
-                                MapLayer *const layer,
-                                const MapLayerTypeT &layerType,
-                                MapHeights *const heights,
-                                const std::string &compression,
-                                int &restrict x, int &restrict y,
-                                const int w, const int h)
+static void setImageTiles(const Map *const map,
+                          MapLayer *const layer,
+                          const std::vector<int> &gids,
+                          const int sz,
+                          const bool hasAnimations) A_NONNULL(1, 2);
+
+static void setImageTiles(const Map *const map,
+                          MapLayer *const layer,
+                          const std::vector<int> &gids,
+                          const int sz,
+                          const bool hasAnimations)
 {
-    if (!childNode)
-        return false;
-
-    if (!compression.empty() && compression != "gzip"
-        && compression != "zlib")
-    {
-        reportAlways("Warning: only gzip and zlib layer"
-            " compression supported!");
-        return false;
-    }
-
-    // Read base64 encoded map file
-    if (!XmlHaveChildContent(childNode))
-        return true;
-
-    const size_t len = strlen(XmlChildContent(childNode)) + 1;
-    unsigned char *charData = new unsigned char[len + 1];
-    const char *const xmlChars = XmlChildContent(childNode);
-    const char *charStart = reinterpret_cast<const char*>(xmlChars);
-    if (!charStart)
-    {
-        delete [] charData;
-        return false;
-    }
-
-    unsigned char *charIndex = charData;
+    const std::map<int, TileAnimation*> &tileAnimations
+        = map->getTileAnimations();
 
-    while (*charStart)
+    // tile layers usually have long runs of same gid,
+    // so tileset and animation searched only if gid changed
+    int lastGid = 0;
+    Image *img = nullptr;
+    const TileAnimation *ani = nullptr;
+    bool first = true;
+    for (int f = 0; f < sz; f ++)
     {
-        if (*charStart != ' ' &&
-            *charStart != '\t' &&
-            *charStart != '\n')
+        const int gid = gids[f];
+        if (first || gid != lastGid)
         {
-            *charIndex = *charStart;
-            charIndex++;
+            first = false;
+            lastGid = gid;
+            const Tileset *const set = map->getTilesetWithGid(gid);
+            img = set ? set->get(gid - set->getFirstGid()) : nullptr;
+            ani = nullptr;
+            if (hasAnimations)
+            {
+                const TileAnimationMapCIter it = tileAnimations.find(gid);
+                if (it != tileAnimations.end())
+                    ani = it->second;
+            }
         }
-        charStart++;
+        layer->setTile(f, img);
+        if (ani)
+            layer->setTileAnimation(f, ani);
     }
-    *charIndex = '\0';
+}
 
-    int binLen;
-    unsigned char *binData = php3_base64_decode(charData,
-        CAST_S32(strlen(reinterpret_cast<char*>(
-        charData))), &binLen);
+inline static void setTiles(Map *const map,
+                            MapLayer *const layer,
+                            const MapLayerTypeT &layerType,
+                            MapHeights *const heights,
+                            const std::vector<int> &gids,
+                            const int w, const int h) A_NONNULL(1);
+
+inline static void setTiles(Map *const map,
+                            MapLayer *const layer,
+                            const MapLayerTypeT &layerType,
+                            MapHeights *const heights,
+                            const std::vector<int> &gids,
+                            const int w, const int h)
+{
+    const std::map<int, TileAnimation*> &tileAnimations
+        = map->getTileAnimations();
+    // animations without layer ignored, this allow call from threads
+    const bool hasAnimations = layer && !tileAnimations.empty();
+    const int sz = std::min(CAST_S32(gids.size()), w * h);
 
-    delete [] charData;
-//    XmlFree(const_cast<char*>(xmlChars));
+    if (layerType == MapLayerType::TILES)
+    {
+        if (layer)
+            setImageTiles(map, layer, gids, sz, hasAnimations);
+        return;
+    }
 
-    if (binData)
+    int x = 0;
+    int y = 0;
+    for (int f = 0; f < sz; f ++)
     {
-        if (compression == "gzip" || compression == "zlib")
+        const int gid = gids[f];
+        setTile(map, layer, layerType, heights, x, y, gid);
+        if (hasAnimations)
         {
-            // Inflate the gzipped layer data
-            unsigned char *inflated = nullptr;
-            const unsigned int inflatedSize =
-                inflateMemory(binData, binLen, inflated);
-
-            free(binData);
-            binData = inflated;
-            binLen = inflatedSize;
-
-            if (!inflated)
+            TileAnimationMapCIter it = tileAnimations.find(gid);
+            if (it != tileAnimations.end())
             {
-                reportAlways("Error: Could not decompress layer!");
-                return false;
+                const TileAnimation *const ani = it->second;
+                if (ani)
+                    layer->setTileAnimation(f, ani);
             }
         }
 
-        const std::map<int, TileAnimation*> &tileAnimations
-            = map->getTileAnimations();
-
-        const bool hasAnimations = !tileAnimations.empty();
-        if (hasAnimations)
+        x++;
+        if (x == w)
         {
-            for (int i = 0; i < binLen - 3; i += 4)
-            {
-                const int gid = binData[i] |
-                    binData[i + 1] << 8 |
-                    binData[i + 2] << 16 |
-                    binData[i + 3] << 24;
-
-                setTile(map, layer, layerType, heights, x, y, gid);
-                TileAnimationMapCIter it = tileAnimations.find(gid);
-                if (it != tileAnimations.end())
-                {
-                    TileAnimation *const ani = it->second;
-                    if (ani)
-                        ani->addAffectedTile(layer, x + y * w);
-                }
+            x = 0;
+            y++;
+        }
+    }
+}
 
-                x++;
-                if (x == w)
-                {
-                    x = 0; y++;
+bool MapReader::readBase64Layer(const XmlNodePtrConst childNode,
+                                const std::string &compression,
+                                std::vector<int> &gids,
+                                const int w, const int h,
+                                LayerDecoder &decoder)
+{
+    if (!childNode)
+        return false;
 
-                    // When we're done, don't crash on too much data
-                    if (y == h)
-                        break;
-                }
-            }
-        }
-        else
-        {
-            for (int i = 0; i < binLen - 3; i += 4)
-            {
-                const int gid = binData[i] |
-                    binData[i + 1] << 8 |
-                    binData[i + 2] << 16 |
-                    binData[i + 3] << 24;
+    if (!compression.empty() && compression != "gzip"
+        && compression != "zlib")
+    {
+        reportLayerError("Warning: only gzip and zlib layer"
+            " compression supported!");
+        return false;
+    }
 
-                setTile(map, layer, layerType, heights, x, y, gid);
+    // Read base64 encoded map file
+    if (!XmlHaveChildContent(childNode))
+        return true;
 
-                x++;
-                if (x == w)
-                {
-                    x = 0; y++;
+    const char *const xmlChars = XmlChildContent(childNode);
+    if (!xmlChars)
+        return false;
 
-                    // When we're done, don't crash on too much data
-                    if (y == h)
-                        break;
-                }
-            }
-        }
-        free(binData);
+    const bool compressed = !compression.empty();
+    const int ret = decoder.decode(reinterpret_cast<const char*>(xmlChars),
+        compressed,
+        gids,
+        CAST_SIZE(w * h));
+    if (ret != Z_OK)
+    {
+        reportInflateError(ret);
+        reportLayerError("Error: Could not decompress layer!");
+        return false;
     }
     return true;
 }
 
 bool MapReader::readCsvLayer(const XmlNodePtrConst childNode,
-                             Map *const map,
-                             MapLayer *const layer,
-                             const MapLayerTypeT &layerType,
-                             MapHeights *const heights,
-                             int &restrict x, int &restrict y,
+                             std::vector<int> &gids,
                              const int w, const int h)
 {
     if (!childNode)
@@ -789,66 +862,7 @@ bool MapReader::readCsvLayer(const XmlNodePtrConst childNode,
     if (!data)
         return false;
 
-    std::string csv(data);
-    size_t oldPos = 0;
-
-    const std::map<int, TileAnimation*> &tileAnimations
-        = map->getTileAnimations();
-    const bool hasAnimations = !tileAnimations.empty();
-
-    if (hasAnimations)
-    {
-        while (oldPos != csv.npos)
-        {
-            const size_t pos = csv.find_first_of(",", oldPos);
-            if (pos == csv.npos)
-                return false;
-
-            const int gid = atoi(csv.substr(oldPos, pos - oldPos).c_str());
-            setTile(map, layer, layerType, heights, x, y, gid);
-            TileAnimationMapCIter it = tileAnimations.find(gid);
-            if (it != tileAnimations.end())
-            {
-                TileAnimation *const ani = it->second;
-                if (ani)
-                    ani->addAffectedTile(layer, x + y * w);
-            }
-
-            x++;
-            if (x == w)
-            {
-                x = 0; y++;
-
-                // When we're done, don't crash on too much data
-                if (y == h)
-                    return false;
-            }
-            oldPos = pos + 1;
-        }
-    }
-    else
-    {
-        while (oldPos != csv.npos)
-        {
-            const size_t pos = csv.find_first_of(",", oldPos);
-            if (pos == csv.npos)
-                return false;
-
-            const int gid = atoi(csv.substr(oldPos, pos - oldPos).c_str());
-            setTile(map, layer, layerType, heights, x, y, gid);
-
-            x++;
-            if (x == w)
-            {
-                x = 0; y++;
-
-                // When we're done, don't crash on too much data
-                if (y == h)
-                    return false;
-            }
-            oldPos = pos + 1;
-        }
-    }
+    LayerDecoder::decodeCsv(data, gids, CAST_SIZE(w * h));
     return true;
 }
 
@@ -881,14 +895,10 @@ void MapReader::readLayer(const XmlNodePtr node, Map *const map)
     else if (isActionsLayer)
         layerType = MapLayerType::ACTIONS;
 
-    map->indexTilesets();
-
     MapLayer *layer = nullptr;
     MapHeights *heights = nullptr;
 
     logger->log("- Loading layer \"%s\"", name.c_str());
-    int x = 0;
-    int y = 0;
 
     // Load the tile data
     for_each_xml_child_node(childNode, node)
@@ -970,78 +980,233 @@ void MapReader::readLayer(const XmlNodePtr node, Map *const map)
                 break;
         }
 
-        const std::string encoding =
-            XML::getProperty(childNode, "encoding", "");
-        const std::string compression =
-            XML::getProperty(childNode, "compression", "");
+        if (mLayerQueue)
+        {
+            // decoding and tiles setting delayed to finishLayersDecoding
+            LayerJob *const job = new LayerJob(childNode,
+                layer, heights, layerType, w, h);
+            if (mMapCache && mMapCache->readLayer(job->gids, w, h))
+                job->cached = true;
+            mLayerQueue->jobs.push_back(job);
+            break;
+        }
 
-        if (encoding == "base64")
+        map->indexTilesets();
+        std::vector<int> gids;
+        if (!mMapCache || !mMapCache->readLayer(gids, w, h))
         {
-            if (readBase64Layer(childNode, map, layer, layerType,
-                heights, compression, x, y, w, h))
-            {
-                continue;
-            }
-            else
+            if (!readLayerData(childNode, gids, w, h, mainLayerDecoder()))
             {
+                if (mMapCache)
+                    mMapCache->invalidate();
                 return;
             }
+            if (mMapCache)
+                mMapCache->addLayer(gids, w, h);
+        }
+
+        setTiles(map, layer, layerType, heights, gids, w, h);
+
+        if (!gids.empty() && CAST_S32(gids.size()) < w * h)
+            std::cerr << "TOO SMALL!\n";
+
+        // There can be only one data element
+        break;
+    }
+}
+
+void MapReader::startLayersDecoding()
+{
+    LayerQueue *const queue = mLayerQueue;
+    if (!queue)
+        return;
+
+    int count = 0;
+    FOR_EACH (std::vector<LayerJob*>::const_iterator, it, queue->jobs)
+    {
+        if (!(*it)->cached)
+            count ++;
+    }
+    const int threads = std::min(count,
+        config.getIntValue("mapLoadThreads"));
+    if (threads <= 0)
+        return;
+
+    mSilentDecode = true;
+    for (int f = 0; f < threads; f ++)
+    {
+        SDL_Thread *const thread = SDL::createThread(
+            &MapReader::decodeLayersThread,
+            "maplayers",
+            queue);
+        if (!thread)
+        {
+            logger->log1("Error: layers decoding thread creation failed");
+            break;
         }
-        else if (encoding == "csv")
+        queue->threads.push_back(thread);
+    }
+}
+
+void MapReader::finishLayersDecoding(Map *const map)
+{
+    LayerQueue *const queue = mLayerQueue;
+    if (!queue)
+        return;
+
+    BLOCK_START("MapReader::finishLayersDecoding")
+    const bool threaded = !queue->threads.empty();
+    FOR_EACH (std::vector<SDL_Thread*>::const_iterator, it, queue->threads)
+        SDL_WaitThread(*it, nullptr);
+    queue->threads.clear();
+    mSilentDecode = false;
+
+    // decode layers what was not taken by threads
+    decodeLayersThread(queue);
+
+    map->indexTilesets();
+
+    // collision layers touch only map meta tiles and can be set
+    // in parallel with other layers.
+    bool hasCollision = false;
+    FOR_EACH (std::vector<LayerJob*>::const_iterator, it, queue->jobs)
+    {
+        if ((*it)->type == MapLayerType::COLLISION)
+            hasCollision = true;
+    }
+    SDL_Thread *collisionThread = nullptr;
+    if (threaded && hasCollision)
+    {
+        collisionThread = SDL::createThread(
+            &MapReader::buildCollisionThread,
+            "mapcollision",
+            queue);
+    }
+
+    FOR_EACH (std::vector<LayerJob*>::const_iterator, it, queue->jobs)
+    {
+        LayerJob *const job = *it;
+        if (job->failed)
         {
-            if (readCsvLayer(childNode, map, layer, layerType,
-                heights, x, y, w, h))
+            if (threaded)
             {
-                continue;
-            }
-            else
-            {
-                return;
+                // repeat decoding for report error from main thread
+                job->gids.clear();
+                readLayerData(job->node,
+                    job->gids,
+                    job->width,
+                    job->height,
+                    mainLayerDecoder());
             }
+            continue;
         }
-        else
+        if (collisionThread && job->type == MapLayerType::COLLISION)
+            continue;
+        setTiles(map, job->layer, job->type, job->heights,
+            job->gids, job->width, job->height);
+        if (!job->gids.empty() &&
+            CAST_S32(job->gids.size()) < job->width * job->height)
         {
-            const std::map<int, TileAnimation*> &tileAnimations
-                = map->getTileAnimations();
-            const bool hasAnimations = !tileAnimations.empty();
+            std::cerr << "TOO SMALL!\n";
+        }
+    }
+
+    if (collisionThread)
+        SDL_WaitThread(collisionThread, nullptr);
 
-            // Read plain XML map file
-            for_each_xml_child_node(childNode2, childNode)
+    if (mMapCache)
+    {
+        FOR_EACH (std::vector<LayerJob*>::const_iterator, it, queue->jobs)
+        {
+            const LayerJob *const job = *it;
+            if (job->failed)
             {
-                if (!xmlNameEqual(childNode2, "tile"))
-                    continue;
+                mMapCache->invalidate();
+                break;
+            }
+            if (!job->cached)
+                mMapCache->addLayer(job->gids, job->width, job->height);
+        }
+    }
+    BLOCK_END("MapReader::finishLayersDecoding")
+}
 
-                const int gid = XML::getProperty(childNode2, "gid", -1);
-                setTile(map, layer, layerType, heights, x, y, gid);
-                if (hasAnimations)
-                {
-                    TileAnimationMapCIter it = tileAnimations.find(gid);
-                    if (it != tileAnimations.end())
-                    {
-                        TileAnimation *const ani = it->second;
-                        if (ani)
-                            ani->addAffectedTile(layer, x + y * w);
-                    }
-                }
+int MapReader::decodeLayersThread(void *ptr)
+{
+    LayerQueue *const queue = static_cast<LayerQueue*>(ptr);
+    if (!queue)
+        return 0;
 
-                x++;
-                if (x == w)
-                {
-                    x = 0; y++;
-                    if (y >= h)
-                        break;
-                }
+    LayerDecoder decoder;
+    while (true)
+    {
+        LayerJob *job = nullptr;
+        {
+            MutexLocker lock(&queue->mutex);
+            while (queue->next < queue->jobs.size())
+            {
+                job = queue->jobs[queue->next];
+                queue->next ++;
+                if (!job->cached)
+                    break;
+                job = nullptr;
             }
         }
+        if (!job)
+            break;
+        job->failed = !readLayerData(job->node,
+            job->gids,
+            job->width,
+            job->height,
+            decoder);
+    }
+    return 0;
+}
 
-        if (y < h)
-            std::cerr << "TOO SMALL!\n";
-        if (x)
-            std::cerr << "TOO SMALL!\n";
+int MapReader::buildCollisionThread(void *ptr)
+{
+    const LayerQueue *const queue = static_cast<const LayerQueue*>(ptr);
+    if (!queue || !queue->map)
+        return 0;
 
-        // There can be only one data element
-        break;
+    FOR_EACH (std::vector<LayerJob*>::const_iterator, it, queue->jobs)
+    {
+        const LayerJob *const job = *it;
+        if (job->failed || job->type != MapLayerType::COLLISION)
+            continue;
+        setTiles(queue->map, nullptr, job->type, nullptr,
+            job->gids, job->width, job->height);
     }
+    return 0;
+}
+
+bool MapReader::readLayerData(const XmlNodePtr childNode,
+                              std::vector<int> &gids,
+                              const int w, const int h,
+                              LayerDecoder &decoder)
+{
+    const std::string encoding =
+        XML::getProperty(childNode, "encoding", "");
+    const std::string compression =
+        XML::getProperty(childNode, "compression", "");
+
+    if (encoding == "base64")
+        return readBase64Layer(childNode, compression, gids, w, h, decoder);
+    else if (encoding == "csv")
+        return readCsvLayer(childNode, gids, w, h);
+
+    // Read plain XML map file
+    const size_t sz = CAST_SIZE(w * h);
+    for_each_xml_child_node(childNode2, childNode)
+    {
+        if (!xmlNameEqual(childNode2, "tile"))
+            continue;
+
+        gids.push_back(XML::getProperty(childNode2, "gid", -1));
+        if (gids.size() >= sz)
+            break;
+    }
+    return true;
 }
 
 Tileset *MapReader::readTileset(XmlNodePtr node,
@@ -1239,6 +1404,94 @@ Tileset *MapReader::readTileset(XmlNodePtr node,
     return set;
 }
 
+static void addTilesetImage(XmlNodePtrConst node,
+                            const std::string &pathDir,
+                            StringVect &images)
+{
+    for_each_xml_child_node(childNode, node)
+    {
+        if (!xmlNameEqual(childNode, "image"))
+            continue;
+        const std::string source = XML::getProperty(childNode, "source", "");
+        if (!source.empty())
+            images.push_back(resolveRelativePath(pathDir, source));
+        // only first image used in tileset
+        break;
+    }
+}
+
+void MapReader::readMapResources(const std::string &restrict realFilename,
+                                 StringVect &restrict images,
+                                 std::string &restrict music)
+{
+    BLOCK_START("MapReader::readMapResources")
+    XML::Document doc(realFilename, UseResman_true, SkipError_true);
+    XmlNodePtrConst node = doc.rootNode();
+    if (!node || !xmlNameEqual(node, "map"))
+    {
+        BLOCK_END("MapReader::readMapResources")
+        return;
+    }
+
+    const std::string pathDir = realFilename.substr(0,
+        realFilename.rfind("/") + 1);
+    StringVect ambientImages;
+
+    for_each_xml_child_node(childNode, node)
+    {
+        if (xmlNameEqual(childNode, "tileset"))
+        {
+            if (XmlHasProp(childNode, "source"))
+            {
+                const std::string fileName = resolveRelativePath(pathDir,
+                    XML::getProperty(childNode, "source", ""));
+                XML::Document tsxDoc(fileName,
+                    UseResman_true,
+                    SkipError_true);
+                XmlNodePtrConst tsxNode = tsxDoc.rootNode();
+                if (tsxNode)
+                {
+                    addTilesetImage(tsxNode,
+                        fileName.substr(0, fileName.rfind("/") + 1),
+                        images);
+                }
+            }
+            else
+            {
+                addTilesetImage(childNode, pathDir, images);
+            }
+        }
+        else if (xmlNameEqual(childNode, "properties"))
+        {
+            for_each_xml_child_node(propNode, childNode)
+            {
+                if (!xmlNameEqual(propNode, "property"))
+                    continue;
+                const std::string name = XML::getProperty(
+                    propNode, "name", "");
+                const std::string value = XML::getProperty(
+                    propNode, "value", "");
+                if (value.empty())
+                    continue;
+                if (name == "music")
+                {
+                    music = value;
+                }
+                else if ((name.find("foreground") == 0 ||
+                         name.find("overlay") == 0 ||
+                         name.find("background") == 0) &&
+                         findLast(name, "image"))
+                {
+                    ambientImages.push_back(value);
+                }
+            }
+        }
+    }
+    // tilesets loading first
+    images.insert(images.end(), ambientImages.begin(), ambientImages.end());
+    BLOCK_END("MapReader::readMapResources")
+}
+
 Map *MapReader::createEmptyMap(const std::string &restrict filename,
                                const std::string &restrict realFilename)
 {
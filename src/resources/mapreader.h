@@ -23,13 +23,13 @@
 #ifndef RESOURCES_MAPREADER_H
 #define RESOURCES_MAPREADER_H
 
-#include "enums/resources/map/maplayertype.h"
-
+#include "utils/stringvector.h"
 #include "utils/xml.h"
 
+#include <vector>
+
+class LayerDecoder;
 class Map;
-class MapHeights;
-class MapLayer;
 class Properties;
 class Resource;
 class Tileset;
@@ -54,6 +54,14 @@ class MapReader final
         static Map *readMap(XmlNodePtrConst node,
                             const std::string &path) A_WARN_UNUSED;
 
+        /**
+         * Collects tileset, ambient layers images and music used by map,
+         * without loading map itself.
+         */
+        static void readMapResources(const std::string &restrict realFilename,
+                                     StringVect &restrict images,
+                                     std::string &restrict music);
+
         static Map *createEmptyMap(const std::string &restrict filename,
                                    const std::string &restrict realFilename)
                                    A_WARN_UNUSED;
@@ -70,6 +78,10 @@ class MapReader final
 #endif  // USE_OPENGL
 
     private:
+        static std::string readObjectProperty(const XmlNodePtrConst node,
+                                              const std::string &name)
+                                              A_WARN_UNUSED;
+
         /**
          * Reads the properties element.
          *
@@ -81,21 +93,22 @@ class MapReader final
                                    Properties *const props) A_NONNULL(2);
 
         static bool readBase64Layer(const XmlNodePtrConst childNode,
-                                    Map *const map,
-                                    MapLayer *const layer,
-                                    const MapLayerTypeT &layerType,
-                                    MapHeights *const heights,
                                     const std::string &compression,
-                                    int &restrict x, int &restrict y,
-                                    const int w, const int h) A_NONNULL(2);
+                                    std::vector<int> &gids,
+                                    const int w, const int h,
+                                    LayerDecoder &decoder);
 
         static bool readCsvLayer(const XmlNodePtrConst childNode,
-                                 Map *const map,
-                                 MapLayer *const layer,
-                                 const MapLayerTypeT &layerType,
-                                 MapHeights *const heights,
-                                 int &restrict x, int &restrict y,
-                                 const int w, const int h) A_NONNULL(2);
+                                 std::vector<int> &gids,
+                                 const int w, const int h);
+
+        /**
+         * Decodes layer tile gids from data element.
+         */
+        static bool readLayerData(const XmlNodePtr childNode,
+                                  std::vector<int> &gids,
+                                  const int w, const int h,
+                                  LayerDecoder &decoder);
 
         /**
          * Reads a tile set.
@@ -113,6 +126,20 @@ class MapReader final
 
         static void unloadTempLayers();
 
+        /**
+         * Starts decoding of queued layers in worker threads.
+         */
+        static void startLayersDecoding();
+
+        /**
+         * Waits for layers decoding and sets decoded tiles to map.
+         */
+        static void finishLayersDecoding(Map *const map) A_NONNULL(1);
+
+        static int decodeLayersThread(void *ptr);
+
+        static int buildCollisionThread(void *ptr);
+
 #ifdef USE_OPENGL
         static Resource *mEmptyAtlas;
 #endif  // USE_OPENGL
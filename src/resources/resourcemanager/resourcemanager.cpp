@@ -382,8 +382,7 @@ void ResourceManager::searchAndAddArchives(const std::string &restrict path,
         if (len > ext.length() && !ext.compare((*i) + (len - ext.length())))
         {
             const std::string file = path + (*i);
-            const std::string realPath = std::string(
-                PhysFs::getRealDir(file.c_str()));
+            const std::string realPath = PhysFs::getRealDir(file.c_str());
             addToSearchPath(std::string(realPath).append(
                 dirSep).append(file), append);
         }
@@ -405,8 +404,7 @@ void ResourceManager::searchAndRemoveArchives(const std::string &restrict path,
         if (len > ext.length() && !ext.compare((*i) + (len - ext.length())))
         {
             const std::string file = path + (*i);
-            const std::string realPath = std::string(
-                PhysFs::getRealDir(file.c_str()));
+            const std::string realPath = PhysFs::getRealDir(file.c_str());
             removeFromSearchPath(std::string(realPath).append(
                 dirSep).append(file));
         }
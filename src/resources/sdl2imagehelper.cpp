@@ -31,7 +31,6 @@
 
 #include "debug.h"
 
-bool SDLImageHelper::mEnableAlphaCache = false;
 SDL_Renderer *SDLImageHelper::mRenderer = nullptr;
 
 Image *SDLImageHelper::loadSurface(SDL_Surface *const tmpImage)
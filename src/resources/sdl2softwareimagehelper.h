@@ -60,12 +60,6 @@ class SDL2SoftwareImageHelper final : public ImageHelper
                                  const float alpha)
                                  override final A_WARN_UNUSED;
 
-        static void SDLSetEnableAlphaCache(const bool n)
-        { mEnableAlphaCache = n; }
-
-        static bool SDLGetEnableAlphaCache() A_WARN_UNUSED
-        { return mEnableAlphaCache; }
-
         static SDL_Surface* SDLDuplicateSurface(SDL_Surface *const tmpImage)
                                                 A_WARN_UNUSED;
 
@@ -88,7 +82,6 @@ class SDL2SoftwareImageHelper final : public ImageHelper
         /** SDL_Surface to SDL_Surface Image loader */
         Image *_SDLload(SDL_Surface *tmpImage) A_WARN_UNUSED;
 
-        static bool mEnableAlphaCache;
         static SDL_PixelFormat *mFormat;
 };
 
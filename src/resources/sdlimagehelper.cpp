@@ -41,8 +41,6 @@
 #error missing SDL_endian.h
 #endif  // SDL_BYTEORDER
 
-bool SDLImageHelper::mEnableAlphaCache = false;
-
 Image *SDLImageHelper::load(SDL_RWops *const rw, Dye const &dye)
 {
     SDL_Surface *const tmpImage = loadPng(rw);
@@ -127,31 +125,22 @@ Image *SDLImageHelper::createTextSurface(SDL_Surface *const tmpImage,
     bool hasAlpha = false;
     const size_t sz = tmpImage->w * tmpImage->h;
 
-    // The alpha channel to be filled with alpha values
-    uint8_t *alphaChannel = new uint8_t[sz];
-
     const SDL_PixelFormat *const fmt = tmpImage->format;
     if (fmt->Amask)
     {
+        const uint32_t *const pixels = static_cast<uint32_t*>(
+            tmpImage->pixels);
         for (size_t i = 0; i < sz; ++ i)
         {
-            uint32_t c = (static_cast<uint32_t*>(tmpImage->pixels))[i];
-
-            const unsigned v = (c & fmt->Amask) >> fmt->Ashift;
+            const unsigned v = (pixels[i] & fmt->Amask) >> fmt->Ashift;
             const uint8_t a = static_cast<const uint8_t>((v << fmt->Aloss)
                 + (v >> (8 - (fmt->Aloss << 1))));
 
-            const uint8_t a2 = CAST_U8(
-                static_cast<float>(a) * alpha);
-
-            c &= ~fmt->Amask;
-            c |= ((a2 >> fmt->Aloss) << fmt->Ashift & fmt->Amask);
-            (static_cast<uint32_t*>(tmpImage->pixels))[i] = c;
-
             if (a != 255)
+            {
                 hasAlpha = true;
-
-            alphaChannel[i] = a;
+                break;
+            }
         }
     }
 
@@ -159,27 +148,18 @@ Image *SDLImageHelper::createTextSurface(SDL_Surface *const tmpImage,
 
     // Convert the surface to the current display format
     if (hasAlpha)
-    {
         image = MSDL_DisplayFormatAlpha(tmpImage);
-    }
     else
-    {
         image = MSDL_DisplayFormat(tmpImage);
 
-        // We also delete the alpha channel since
-        // it's not used.
-        delete [] alphaChannel;
-        alphaChannel = nullptr;
-    }
-
     if (!image)
     {
         reportAlways("Error: Image convert failed.");
-        delete [] alphaChannel;
         return nullptr;
     }
 
-    Image *const img = new Image(image, hasAlpha, alphaChannel);
+    // text alpha applied while drawing
+    Image *const img = new Image(image, hasAlpha);
     img->mAlpha = alpha;
     return img;
 }
@@ -211,9 +191,6 @@ Image *SDLImageHelper::_SDLload(SDL_Surface *tmpImage)
 
     const size_t sz = tmpImage->w * tmpImage->h;
 
-    // The alpha channel to be filled with alpha values
-    uint8_t *alphaChannel = new uint8_t[sz];
-
     // Figure out whether the image uses its alpha layer
     if (!tmpImage->format->palette)
     {
@@ -224,63 +201,48 @@ Image *SDLImageHelper::_SDLload(SDL_Surface *tmpImage)
             const uint8_t ashift = fmt->Ashift;
             const uint8_t aloss = fmt->Aloss;
             const uint32_t *pixels = static_cast<uint32_t*>(tmpImage->pixels);
-            cilk_for (size_t i = 0; i < sz; ++ i)
+            for (size_t i = 0; i < sz; ++ i)
             {
                 const unsigned v = (pixels[i] & amask) >> ashift;
                 const uint8_t a = static_cast<const uint8_t>((v << aloss)
                     + (v >> (8 - (aloss << 1))));
 
                 if (a != 255)
+                {
                     hasAlpha = true;
-
-                alphaChannel[i] = a;
+                    break;
+                }
             }
         }
         else
         {
             if (SDL_ALPHA_OPAQUE != 255)
-            {
                 hasAlpha = true;
-                memset(alphaChannel, SDL_ALPHA_OPAQUE, sz);
-            }
         }
     }
     else
     {
         if (SDL_ALPHA_OPAQUE != 255)
-        {
             hasAlpha = true;
-            memset(alphaChannel, SDL_ALPHA_OPAQUE, sz);
-        }
     }
 
     SDL_Surface *image;
 
     // Convert the surface to the current display format
     if (hasAlpha)
-    {
         image = MSDL_DisplayFormatAlpha(tmpImage);
-    }
     else
-    {
         image = MSDL_DisplayFormat(tmpImage);
 
-        // We also delete the alpha channel since
-        // it's not used.
-        delete [] alphaChannel;
-        alphaChannel = nullptr;
-    }
-
     if (!image)
     {
         reportAlways("Error: Image convert failed.");
-        delete [] alphaChannel;
         return nullptr;
     }
 
     if (converted)
         MSDL_FreeSurface(tmpImage);
-    return new Image(image, hasAlpha, alphaChannel);
+    return new Image(image, hasAlpha);
 }
 
 int SDLImageHelper::combineSurface(SDL_Surface *restrict const src,
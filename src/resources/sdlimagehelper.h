@@ -81,12 +81,6 @@ class SDLImageHelper final : public ImageHelper
                                 SDL_Surface *const surface)
                                 const override final;
 
-        static void SDLSetEnableAlphaCache(const bool n)
-        { mEnableAlphaCache = n; }
-
-        static bool SDLGetEnableAlphaCache() A_WARN_UNUSED
-        { return mEnableAlphaCache; }
-
         static SDL_Surface* SDLDuplicateSurface(SDL_Surface *const tmpImage)
                                                 A_WARN_UNUSED;
 
@@ -98,8 +92,6 @@ class SDLImageHelper final : public ImageHelper
     protected:
         /** SDL_Surface to SDL_Surface Image loader */
         Image *_SDLload(SDL_Surface *tmpImage) A_WARN_UNUSED;
-
-        static bool mEnableAlphaCache;
 };
 
 #endif  // USE_SDL2
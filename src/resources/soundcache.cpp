@@ -0,0 +1,278 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "resources/soundcache.h"
+
+#include "logger.h"
+
+#include "resources/soundeffect.h"
+
+#include "resources/loaders/soundloader.h"
+
+#include "resources/resourcemanager/resourcemanager.h"
+
+#include "utils/physfsrwops.h"
+#include "utils/sdlhelper.h"
+
+#include <SDL_mixer.h>
+
+#include "debug.h"
+
+extern volatile time_t cur_time;
+
+namespace
+{
+    // seconds after not pinned sample removed from cache
+    const time_t expireTime = 30;
+}  // namespace
+
+SoundCache::SoundCache() :
+    mCache(),
+    mLru(),
+    mPending(),
+    mSize(0),
+    mMaxSize(0),
+    mPinned(true),
+    mMutex(),
+    mQueue(),
+    mDecoded(),
+    mThread(nullptr),
+    mThreadDone(false)
+{
+}
+
+SoundCache::~SoundCache()
+{
+    stopThread();
+}
+
+SoundEffect *SoundCache::get(const std::string &path)
+{
+    const CacheMapIter it = mCache.find(path);
+    if (it != mCache.end())
+    {
+        CacheEntry &entry = it->second;
+        mLru.splice(mLru.begin(), mLru, entry.lru);
+        entry.time = cur_time;
+        return entry.sample;
+    }
+
+    SoundEffect *const sample = Loader::getSoundEffect(path);
+    if (!sample)
+        return nullptr;
+    add(path, sample, sample->getDataSize());
+    return sample;
+}
+
+void SoundCache::preload(const std::string &path)
+{
+    if (path.empty()
+        || mCache.find(path) != mCache.end()
+        || mPending.find(path) != mPending.end())
+    {
+        return;
+    }
+    mPending.insert(path);
+
+    bool start(false);
+    {
+        MutexLocker lock(&mMutex);
+        mQueue.push_back(path);
+        start = !mThread || mThreadDone;
+    }
+    if (!start)
+        return;
+
+    waitThread();
+    mThread = SDL::createThread(&SoundCache::decodeThread,
+        "sfxdecode", this);
+    if (!mThread)
+    {
+        logger->log1("Error: sound decoding thread creation failed");
+        MutexLocker lock(&mMutex);
+        mQueue.clear();
+        mPending.clear();
+    }
+}
+
+void SoundCache::logic()
+{
+    DecodedList decoded;
+    bool done(false);
+    {
+        MutexLocker lock(&mMutex);
+        decoded.swap(mDecoded);
+        done = mThreadDone;
+    }
+    if (done)
+        waitThread();
+
+    FOR_EACH (DecodedList::const_iterator, it, decoded)
+    {
+        const std::string &path = (*it).first;
+        Mix_Chunk *const chunk = (*it).second;
+        mPending.erase(path);
+        if (!chunk)
+        {
+            // error will be reported on first play
+            continue;
+        }
+        if (mCache.find(path) != mCache.end())
+        {
+            Mix_FreeChunk(chunk);
+            continue;
+        }
+        if (resourceManager->isInCache(path))
+        {
+            Mix_FreeChunk(chunk);
+            SoundEffect *const sample = Loader::getSoundEffect(path);
+            if (sample)
+                add(path, sample, sample->getDataSize());
+            continue;
+        }
+        SoundEffect *const sample = new SoundEffect(chunk, path);
+        resourceManager->addResource(path, sample);
+        add(path, sample, chunk->alen);
+    }
+
+    if (mPinned)
+        return;
+    // least recently used samples are at end of list
+    while (!mLru.empty())
+    {
+        const CacheMapIter it = mCache.find(mLru.back());
+        if (it != mCache.end() && it->second.time + expireTime > cur_time)
+            break;
+        removeLast();
+    }
+}
+
+void SoundCache::clear()
+{
+    stopThread();
+
+    FOR_EACH (CacheMapIter, it, mCache)
+        it->second.sample->decRef();
+    mCache.clear();
+    mLru.clear();
+    mSize = 0;
+}
+
+void SoundCache::setMaxSize(const size_t size)
+{
+    mMaxSize = size;
+    evict(std::string());
+}
+
+void SoundCache::setPinned(const bool pinned)
+{
+    mPinned = pinned;
+}
+
+void SoundCache::add(const std::string &path,
+                     SoundEffect *const sample,
+                     const size_t size)
+{
+    mLru.push_front(path);
+    mCache.insert(std::make_pair(path,
+        CacheEntry(sample, size, mLru.begin(), cur_time)));
+    mSize += size;
+    evict(path);
+}
+
+void SoundCache::evict(const std::string &keep)
+{
+    if (!mMaxSize)
+        return;
+    while (mSize > mMaxSize && !mLru.empty())
+    {
+        if (mLru.back() == keep)
+            break;
+        removeLast();
+    }
+}
+
+void SoundCache::removeLast()
+{
+    const CacheMapIter it = mCache.find(mLru.back());
+    if (it != mCache.end())
+    {
+        mSize -= it->second.size;
+        it->second.sample->decRef();
+        mCache.erase(it);
+    }
+    mLru.pop_back();
+}
+
+void SoundCache::stopThread()
+{
+    {
+        MutexLocker lock(&mMutex);
+        mQueue.clear();
+    }
+    waitThread();
+
+    FOR_EACH (DecodedList::const_iterator, it, mDecoded)
+    {
+        if ((*it).second)
+            Mix_FreeChunk((*it).second);
+    }
+    mDecoded.clear();
+    mPending.clear();
+}
+
+void SoundCache::waitThread()
+{
+    if (!mThread)
+        return;
+    SDL_WaitThread(mThread, nullptr);
+    mThread = nullptr;
+    mThreadDone = false;
+}
+
+int SoundCache::decodeThread(void *ptr)
+{
+    SoundCache *const cache = static_cast<SoundCache*>(ptr);
+    if (!cache)
+        return 0;
+
+    for (;;)
+    {
+        std::string path;
+        {
+            MutexLocker lock(&cache->mMutex);
+            if (cache->mQueue.empty())
+            {
+                cache->mThreadDone = true;
+                return 0;
+            }
+            path = cache->mQueue.front();
+            cache->mQueue.pop_front();
+        }
+
+        Mix_Chunk *chunk = nullptr;
+        SDL_RWops *const rw = MPHYSFSRWOPS_openRead(path.c_str());
+        if (rw)
+            chunk = Mix_LoadWAV_RW(rw, 1);
+
+        MutexLocker lock(&cache->mMutex);
+        cache->mDecoded.push_back(std::make_pair(path, chunk));
+    }
+}
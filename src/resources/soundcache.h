@@ -0,0 +1,142 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RESOURCES_SOUNDCACHE_H
+#define RESOURCES_SOUNDCACHE_H
+
+#include "utils/mutex.h"
+
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+
+#include <ctime>
+
+#include "localconsts.h"
+
+class SoundEffect;
+
+struct Mix_Chunk;
+struct SDL_Thread;
+
+/**
+ * LRU cache of decoded sound effects.
+ * Samples can be queued for decoding in worker thread before first play.
+ */
+class SoundCache final
+{
+    public:
+        SoundCache();
+
+        A_DELETE_COPY(SoundCache)
+
+        ~SoundCache();
+
+        /**
+         * Returns decoded sample. If sample not in cache, it decoded
+         * immediately. Returned pointer valid until next call of get,
+         * logic or clear.
+         */
+        SoundEffect *get(const std::string &path);
+
+        /**
+         * Queue sample for decoding in worker thread.
+         */
+        void preload(const std::string &path);
+
+        /**
+         * Move samples decoded by worker thread to cache.
+         */
+        void logic();
+
+        /**
+         * Wait for worker thread and remove all samples from cache.
+         */
+        void clear();
+
+        /**
+         * Set max size of decoded samples in bytes. Zero mean no limit.
+         */
+        void setMaxSize(const size_t size);
+
+        /**
+         * Pinned samples stay in cache until evicted by size limit.
+         * Not pinned samples also removed if not used for some time.
+         */
+        void setPinned(const bool pinned);
+
+        size_t getSize() const A_WARN_UNUSED
+        { return mSize; }
+
+    private:
+        struct CacheEntry final
+        {
+            CacheEntry(SoundEffect *const sample0,
+                       const size_t size0,
+                       const std::list<std::string>::iterator &lru0,
+                       const time_t time0) :
+                sample(sample0),
+                size(size0),
+                lru(lru0),
+                time(time0)
+            {
+            }
+
+            SoundEffect *sample;
+            size_t size;
+            std::list<std::string>::iterator lru;
+            time_t time;
+        };
+
+        typedef std::map<std::string, CacheEntry> CacheMap;
+        typedef CacheMap::iterator CacheMapIter;
+        typedef std::list<std::pair<std::string, Mix_Chunk*> > DecodedList;
+
+        static int decodeThread(void *ptr);
+
+        void add(const std::string &path,
+                 SoundEffect *const sample,
+                 const size_t size);
+
+        void evict(const std::string &keep);
+
+        void removeLast();
+
+        void stopThread();
+
+        void waitThread();
+
+        CacheMap mCache;
+        std::list<std::string> mLru;
+        std::set<std::string> mPending;
+        size_t mSize;
+        size_t mMaxSize;
+        bool mPinned;
+
+        // shared with worker thread
+        Mutex mMutex;
+        std::list<std::string> mQueue;
+        DecodedList mDecoded;
+        SDL_Thread *mThread;
+        bool mThreadDone;
+};
+
+#endif  // RESOURCES_SOUNDCACHE_H
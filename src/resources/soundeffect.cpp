@@ -40,6 +40,6 @@ bool SoundEffect::play(const int loops, const int volume,
 int SoundEffect::calcMemoryLocal() const
 {
     return static_cast<int>(sizeof(SoundEffect) +
-        sizeof(SDL_AudioSpec)) +
+        sizeof(SDL_AudioSpec) + getDataSize()) +
         Resource::calcMemoryLocal();
 }
@@ -65,8 +65,20 @@ class SoundEffect final : public Resource
         bool play(const int loops, const int volume,
                   const int channel = -1) const;
 
+        /**
+         * Changes volume of sample, including already playing copies.
+         */
+        void setVolume(const int volume) const
+        { Mix_VolumeChunk(mChunk, volume); }
+
         int calcMemoryLocal() const override final;
 
+        /**
+         * Returns size of decoded sample data in bytes.
+         */
+        size_t getDataSize() const A_WARN_UNUSED
+        { return mChunk ? mChunk->alen : 0; }
+
         std::string getCounterName() const override final
         { return mName; }
 
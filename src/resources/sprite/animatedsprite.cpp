@@ -22,6 +22,8 @@
 
 #include "resources/sprite/animatedsprite.h"
 
+#include "settings.h"
+
 #include "const/resources/spriteaction.h"
 
 #include "render/graphics.h"
@@ -177,6 +179,7 @@ bool AnimatedSprite::play(const std::string &restrict spriteAction) restrict2
     {
         mAnimation = animation;
         reset();
+        settings.needRedraw = true;
 
         return true;
     }
@@ -208,7 +211,10 @@ bool AnimatedSprite::update(const int time) restrict2
     }
 
     // Make sure something actually changed
-    return animation != mAnimation || frame != mFrame;
+    if (animation == mAnimation && frame == mFrame)
+        return false;
+    settings.needRedraw = true;
+    return true;
 }
 
 bool AnimatedSprite::updateCurrentAnimation(const unsigned int time) restrict2
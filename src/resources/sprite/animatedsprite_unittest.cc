@@ -173,6 +173,33 @@ TEST_CASE("AnimatedSprite tests", "animatedsprite")
         delete sprite2;
     }
 
+    SECTION("delayed update test")
+    {
+        // Being::lodLogic skip sprite updates for beings outside of screen.
+        // Sprite must look same after one delayed update.
+        AnimatedSprite *sprite1 = AnimatedSprite::load(
+            "graphics/sprites/test.xml", 0);
+        AnimatedSprite *sprite2 = AnimatedSprite::load(
+            "graphics/sprites/test.xml", 0);
+        sprite1->play(SpriteAction::STAND);
+        sprite2->play(SpriteAction::STAND);
+        sprite1->update(1);
+        sprite2->update(1);
+
+        for (int time = 11; time < 1000; time += 10)
+        {
+            sprite1->update(time);
+            if (time % 170 == 1)
+            {
+                sprite2->update(time);
+                REQUIRE(sprite1->getFrameIndex() == sprite2->getFrameIndex());
+                REQUIRE(sprite1->getFrameTime() == sprite2->getFrameTime());
+            }
+        }
+        delete sprite1;
+        delete sprite2;
+    }
+
     delete client;
     client = nullptr;
 }
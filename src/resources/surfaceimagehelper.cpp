@@ -30,8 +30,6 @@
 
 #include "debug.h"
 
-bool SurfaceImageHelper::mEnableAlphaCache = false;
-
 Image *SurfaceImageHelper::loadSurface(SDL_Surface *const tmpImage)
 {
     return _SDLload(tmpImage);
@@ -46,11 +44,9 @@ Image *SurfaceImageHelper::createTextSurface(SDL_Surface *const tmpImage,
         return nullptr;
 
     Image *img;
-    bool hasAlpha = false;
-    uint8_t *alphaChannel = nullptr;
     SDL_Surface *image = SDLDuplicateSurface(tmpImage);
 
-    img = new Image(image, hasAlpha, alphaChannel);
+    img = new Image(image, false);
     img->setAlpha(alpha);
     return img;
 }
@@ -70,7 +66,7 @@ Image *SurfaceImageHelper::_SDLload(SDL_Surface *tmpImage) const
         return nullptr;
 
     SDL_Surface *image = convertTo32Bit(tmpImage);
-    return new Image(image, false, nullptr);
+    return new Image(image, false);
 }
 
 RenderType SurfaceImageHelper::useOpenGL() const
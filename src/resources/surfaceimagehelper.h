@@ -63,12 +63,6 @@ class SurfaceImageHelper final : public ImageHelper
                                  const float alpha)
                                  override final A_WARN_UNUSED;
 
-        static void SDLSetEnableAlphaCache(const bool n)
-        { mEnableAlphaCache = n; }
-
-        static bool SDLGetEnableAlphaCache() A_WARN_UNUSED
-        { return mEnableAlphaCache; }
-
          /**
          * Tells if the image was loaded using OpenGL or SDL
          * @return true if OpenGL, false if SDL.
@@ -86,8 +80,6 @@ class SurfaceImageHelper final : public ImageHelper
     protected:
         /** SDL_Surface to SDL_Surface Image loader */
         Image *_SDLload(SDL_Surface *tmpImage) const A_WARN_UNUSED;
-
-        static bool mEnableAlphaCache;
 };
 
 #endif  // USE_SDL2
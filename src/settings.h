@@ -78,6 +78,8 @@ class Settings final
             emoteType(EmoteType::Player),
             persistentIp(true),
             limitFps(false),
+            idleSleep(true),
+            needRedraw(true),
             inputFocused(true),
             mouseFocused(true),
             disableGameModifiers(false),
@@ -135,6 +137,9 @@ class Settings final
         EmoteTypeT emoteType;
         bool persistentIp;
         bool limitFps;
+        bool idleSleep;
+        // screen changed since last drawn frame
+        bool needRedraw;
         bool inputFocused;
         bool mouseFocused;
         bool disableGameModifiers;
@@ -26,6 +26,18 @@
 
 #ifndef DYECMD
 #include "being/localplayer.h"
+#include "being/playerinfo.h"
+
+#include "const/equipment.h"
+
+#include "enums/resources/notifytypes.h"
+
+#include "resources/iteminfo.h"
+
+#include "resources/db/itemdb.h"
+#include "resources/db/sounddb.h"
+
+#include "resources/item/item.h"
 #endif  // DYECMD
 
 #include "resources/sdlmusic.h"
@@ -36,6 +48,7 @@
 
 #include "utils/checkutils.h"
 #include "utils/physfstools.h"
+#include "utils/timer.h"
 
 #include <SDL.h>
 
@@ -58,6 +71,13 @@ static void fadeOutCallBack()
     sFadingOutEnded = true;
 }
 
+static std::string getSfxPath(const std::string &path)
+{
+    if (!path.compare(0, 4, "sfx/"))
+        return path;
+    return paths.getValue("sfx", "sfx/").append(path);
+}
+
 SoundManager::SoundManager() :
     mNextMusicFile(),
     mInstalled(false),
@@ -65,7 +85,8 @@ SoundManager::SoundManager() :
     mMusicVolume(60),
     mCurrentMusicFile(),
     mMusic(nullptr),
-    mGuiChannel(-1),
+    mSoundCache(),
+    mVoices(),
     mPlayBattle(false),
     mPlayGui(false),
     mPlayMusic(false),
@@ -107,7 +128,22 @@ void SoundManager::optionChanged(const std::string &value)
     else if (value == "fadeoutmusic")
         mFadeoutMusic = config.getIntValue("fadeoutmusic");
     else if (value == "uselonglivesounds")
+    {
         mCacheSounds = config.getIntValue("uselonglivesounds");
+        updateCacheSize();
+    }
+    else if (value == "sfxCacheSize")
+    {
+        updateCacheSize();
+    }
+}
+
+void SoundManager::updateCacheSize()
+{
+    // long live sounds only not expire, cache size limited always
+    mSoundCache.setPinned(mCacheSounds);
+    mSoundCache.setMaxSize(static_cast<size_t>(
+        config.getIntValue("sfxCacheSize")) * 1024U);
 }
 
 void SoundManager::init()
@@ -125,6 +161,7 @@ void SoundManager::init()
     mMusicVolume = config.getIntValue("musicVolume");
     mSfxVolume = config.getIntValue("sfxVolume");
     mCacheSounds = config.getIntValue("uselonglivesounds");
+    updateCacheSize();
 
     config.addListener("playBattleSound", this);
     config.addListener("playGuiSound", this);
@@ -133,6 +170,7 @@ void SoundManager::init()
     config.addListener("musicVolume", this);
     config.addListener("fadeoutmusic", this);
     config.addListener("uselonglivesounds", this);
+    config.addListener("sfxCacheSize", this);
 
     if (SDL_InitSubSystem(SDL_INIT_AUDIO) == -1)
     {
@@ -167,7 +205,8 @@ void SoundManager::init()
         logger->log("Fallback to stereo audio");
     }
 
-    Mix_AllocateChannels(16);
+    mVoices.clear();
+    mVoices.resize(CAST_SIZE(Mix_AllocateChannels(16)));
     Mix_VolumeMusic(mMusicVolume);
     Mix_Volume(-1, mSfxVolume);
 
@@ -418,6 +457,7 @@ void SoundManager::fadeOutAndPlayMusic(const std::string &fileName,
 void SoundManager::logic()
 {
     BLOCK_START("SoundManager::logic")
+    mSoundCache.logic();
     if (sFadingOutEnded)
     {
         if (mMusic)
@@ -440,47 +480,158 @@ void SoundManager::logic()
 #ifdef DYECMD
 void SoundManager::playSfx(const std::string &path A_UNUSED,
                            const int x A_UNUSED,
-                           const int y A_UNUSED) const
+                           const int y A_UNUSED)
+{
+}
+
+void SoundManager::preloadSfx(const ItemSoundEvents &sounds A_UNUSED)
+{
+}
+
+void SoundManager::preloadMapSounds()
 {
 }
 #else  // DYECMD
 void SoundManager::playSfx(const std::string &path,
-                           const int x, const int y) const
+                           const int x, const int y)
 {
     if (!mInstalled || path.empty() || !mPlayBattle)
         return;
 
-    std::string tmpPath;
-    if (!path.compare(0, 4, "sfx/"))
-        tmpPath = path;
-    else
-        tmpPath = paths.getValue("sfx", "sfx/").append(path);
-    SoundEffect *const sample = Loader::getSoundEffect(tmpPath);
+    int vol = 120;
+    if (localPlayer && (x > 0 || y > 0))
+    {
+        int dx = localPlayer->getTileX() - x;
+        int dy = localPlayer->getTileY() - y;
+        if (dx < 0)
+            dx = -dx;
+        if (dy < 0)
+            dy = -dy;
+        const int dist = dx > dy ? dx : dy;
+        if (dist * 8 > vol)
+            return;
+
+        vol -= dist * 8;
+    }
+
+    SoundEffect *const sample = mSoundCache.get(getSfxPath(path));
     if (sample)
+        playVoice(sample, vol, vol);
+}
+
+void SoundManager::preloadSfx(const ItemSoundEvents &sounds)
+{
+    if (!mInstalled || !mPlayBattle)
+        return;
+
+    FOR_EACH (ItemSoundEvents::const_iterator, it, sounds)
+    {
+        const SoundInfoVect *const vect = (*it).second;
+        if (!vect)
+            continue;
+        FOR_EACHP (SoundInfoVect::const_iterator, it2, vect)
+            preloadSfx((*it2).sound);
+    }
+}
+
+void SoundManager::preloadMapSounds()
+{
+    if (!mInstalled)
+        return;
+
+    if (mPlayBattle)
+    {
+        for (int f = 0; f < NotifyTypes::TYPE_END; f ++)
+            preloadSfx(SoundDB::getSound(f));
+    }
+
+    // item sounds played by playSfx, what depend on battle sounds option
+    if (mPlayBattle && localPlayer)
     {
-        logger->log("SoundManager::playSfx() Playing: %s", path.c_str());
-        int vol = 120;
-        if (localPlayer && (x > 0 || y > 0))
+        std::vector<const ItemInfo*> infos;
+        infos.push_back(&ItemDB::get(
+            -100 - toInt(localPlayer->getSubType(), int)));
+        for (int f = 0; f < EQUIPMENT_SIZE; f ++)
         {
-            int dx = localPlayer->getTileX() - x;
-            int dy = localPlayer->getTileY() - y;
-            if (dx < 0)
-                dx = -dx;
-            if (dy < 0)
-                dy = -dy;
-            const int dist = dx > dy ? dx : dy;
-            if (dist * 8 > vol)
-                return;
-
-            vol -= dist * 8;
+            const Item *const item = PlayerInfo::getEquipment(f);
+            if (item)
+                infos.push_back(&item->getInfo());
+        }
+        FOR_EACH (std::vector<const ItemInfo*>::const_iterator, it, infos)
+        {
+            const std::map <ItemSoundEvent::Type, SoundInfoVect> &sounds =
+                (*it)->getSounds();
+            for (std::map <ItemSoundEvent::Type, SoundInfoVect>::
+                 const_iterator it2 = sounds.begin();
+                 it2 != sounds.end(); ++ it2)
+            {
+                FOR_EACH (SoundInfoVect::const_iterator, it3, (*it2).second)
+                    preloadSfx((*it3).sound);
+            }
         }
-        sample->play(0, vol);
-        if (!mCacheSounds)
-            sample->decRef();
     }
 }
 #endif  // DYECMD
 
+void SoundManager::preloadSfx(const std::string &path)
+{
+    if (!mInstalled || path.empty())
+        return;
+    mSoundCache.preload(getSfxPath(path));
+}
+
+void SoundManager::playVoice(SoundEffect *const sample,
+                             const int volume,
+                             const int priority)
+{
+    const int time = tick_time;
+    const int sz = CAST_S32(mVoices.size());
+    int freeChannel = -1;
+    int weakChannel = -1;
+    for (int f = 0; f < sz; f ++)
+    {
+        SoundVoice &voice = mVoices[f];
+        if (!Mix_Playing(f))
+        {
+            if (freeChannel == -1)
+                freeChannel = f;
+            continue;
+        }
+        if (voice.sample == sample && voice.tick == time)
+        {
+            // same sound already started in this tick
+            if (priority > voice.priority)
+            {
+                voice.priority = priority;
+                sample->setVolume(volume);
+            }
+            return;
+        }
+        if (weakChannel == -1 ||
+            voice.priority < mVoices[weakChannel].priority)
+        {
+            weakChannel = f;
+        }
+    }
+
+    int channel = freeChannel;
+    if (channel == -1)
+    {
+        if (weakChannel == -1 || mVoices[weakChannel].priority >= priority)
+            return;
+        Mix_HaltChannel(weakChannel);
+        channel = weakChannel;
+    }
+
+    if (sample->play(0, volume, channel))
+    {
+        SoundVoice &voice = mVoices[channel];
+        voice.sample = sample;
+        voice.priority = priority;
+        voice.tick = time;
+    }
+}
+
 void SoundManager::playGuiSound(const std::string &name)
 {
     const std::string sound = config.getStringValue(name);
@@ -499,20 +650,12 @@ void SoundManager::playGuiSfx(const std::string &path)
         return;
     }
 
-    std::string tmpPath;
-    if (!path.compare(0, 4, "sfx/"))
-        tmpPath = path;
-    else
-        tmpPath = paths.getValue("sfx", "sfx/").append(path);
-    SoundEffect *const sample = Loader::getSoundEffect(tmpPath);
+    SoundEffect *const sample = mSoundCache.get(getSfxPath(path));
     if (sample)
     {
         logger->log("SoundManager::playGuiSfx() Playing: %s", path.c_str());
-        const int ret = sample->play(0, 120, mGuiChannel);
-        if (ret != -1)
-            mGuiChannel = ret;
-        if (!mCacheSounds)
-            sample->decRef();
+        // gui sounds have higher priority than any battle sound
+        playVoice(sample, 120, 1000);
     }
 }
 
@@ -523,6 +666,8 @@ void SoundManager::close()
 
     haltMusic();
     logger->log1("SoundManager::close() Shutting down sound...");
+    mSoundCache.clear();
+    mVoices.clear();
     Mix_CloseAudio();
 
     mInstalled = false;
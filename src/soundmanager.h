@@ -38,9 +38,13 @@ _SDL_stdinc_h
 
 #include "listeners/configlistener.h"
 
+#include "resources/soundcache.h"
+#include "resources/soundinfo.h"
+
 #include "localconsts.h"
 
 class SDLMusic;
+class SoundEffect;
 
 /** SoundManager
  *
@@ -119,7 +123,7 @@ class SoundManager final : public ConfigListener
          * @param path The resource path to the sound file.
          */
         void playSfx(const std::string &path, const int x = 0,
-                     const int y = 0) const;
+                     const int y = 0);
 
         /**
          * Plays an item for gui.
@@ -130,6 +134,20 @@ class SoundManager final : public ConfigListener
 
         void playGuiSound(const std::string &name);
 
+        /**
+         * Queue sound file for decoding in background.
+         *
+         * @param path The resource path to the sound file.
+         */
+        void preloadSfx(const std::string &path);
+
+        void preloadSfx(const ItemSoundEvents &sounds);
+
+        /**
+         * Queue for decoding sounds what can be played on new map.
+         */
+        void preloadMapSounds();
+
         void changeAudio();
 
         void volumeOff() const;
@@ -155,6 +173,31 @@ class SoundManager final : public ConfigListener
         /** Halts and frees currently playing music. */
         void haltMusic();
 
+        /**
+         * Plays sample on free channel. Same sample started in same tick
+         * not played twice. If all channels busy, sound with lowest
+         * priority stopped or new sound dropped.
+         */
+        void playVoice(SoundEffect *const sample,
+                       const int volume,
+                       const int priority);
+
+        void updateCacheSize();
+
+        struct SoundVoice final
+        {
+            SoundVoice() :
+                sample(nullptr),
+                priority(0),
+                tick(0)
+            {
+            }
+
+            const SoundEffect *sample;
+            int priority;
+            int tick;
+        };
+
         /**
          * When calling fadeOutAndPlayMusic(),
          * the music file below will then be played
@@ -168,7 +211,8 @@ class SoundManager final : public ConfigListener
 
         std::string mCurrentMusicFile;
         SDLMusic *mMusic;
-        int mGuiChannel;
+        SoundCache mSoundCache;
+        std::vector<SoundVoice> mVoices;
         bool mPlayBattle;
         bool mPlayGui;
         bool mPlayMusic;
@@ -34,9 +34,17 @@
 #include "utils/stringutils.h"
 
 #include <algorithm>
+#include <cstdio>
 #include <dirent.h>
+#include <fstream>
 #include <sstream>
 
+#include <sys/stat.h>
+
+#ifndef WIN32
+#include <unistd.h>
+#endif  // WIN32
+
 #include "debug.h"
 
 #ifdef ANDROID
@@ -244,25 +252,19 @@ void Files::getFilesWithDir(const std::string &path, StringVect &list)
 
 bool Files::existsLocal(const std::string &path)
 {
-    bool flg(false);
-    std::fstream file;
-    file.open(path.c_str(), std::ios::in);
-    if (file.is_open())
-        flg = true;
-    file.close();
-    return flg;
+    struct stat statbuf;
+    return !stat(path.c_str(), &statbuf);
 }
 
 std::string Files::getPath(const std::string &file)
 {
     // get the real path to the file
-    const char *const tmp = PhysFs::getRealDir(file.c_str());
-    std::string path;
+    std::string path = PhysFs::getRealDir(file.c_str());
 
-    // if the file is not in the search path, then its nullptr
-    if (tmp)
+    // if the file is not in the search path, then its empty
+    if (!path.empty())
     {
-        path = std::string(tmp).append(dirSeparator).append(file);
+        path.append(dirSeparator).append(file);
 #if defined __native_client__
         std::string dataZip = "/http/data.zip/";
         if (path.substr(0, dataZip.length()) == dataZip)
@@ -351,6 +353,46 @@ void Files::saveTextFile(std::string path,
     }
 }
 
+bool Files::writeFileAtomic(const std::string &fileName,
+                            const char *const data,
+                            const size_t size)
+{
+    // other clients can read same file, write new file near
+    // and replace old one.
+#ifndef WIN32
+    const std::string tmpName = strprintf("%s.%d.tmp",
+        fileName.c_str(), CAST_S32(getpid()));
+#else  // WIN32
+
+    const std::string tmpName = fileName + ".tmp";
+#endif  // WIN32
+
+    std::ofstream file;
+    file.open(tmpName.c_str(),
+        std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        return false;
+    if (size > 0)
+        file.write(data, size);
+    file.close();
+    if (!file)
+    {
+        ::remove(tmpName.c_str());
+        return false;
+    }
+#ifdef WIN32
+    // on windows rename can not replace existing file
+    ::remove(fileName.c_str());
+#endif  // WIN32
+
+    if (::rename(tmpName.c_str(), fileName.c_str()))
+    {
+        ::remove(tmpName.c_str());
+        return false;
+    }
+    return true;
+}
+
 void Files::deleteFilesInDirectory(std::string path)
 {
     path += "/";
@@ -76,6 +76,14 @@ namespace Files
                       const std::string &restrict name,
                       const std::string &restrict text);
 
+    /**
+     * Writes data to temporary file and renames it over fileName,
+     * so readers never see partially written file.
+     */
+    bool writeFileAtomic(const std::string &fileName,
+                         const char *const data,
+                         const size_t size);
+
     void deleteFilesInDirectory(std::string path);
 
     void getFilesInDir(const std::string &dir,
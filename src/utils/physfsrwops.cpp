@@ -28,6 +28,9 @@
 
 #include "utils/fuzzer.h"
 #include "utils/physfscheckutils.h"
+#include "utils/vfsindex.h"
+
+#include <cstring>
 
 #include "debug.h"
 
@@ -189,6 +192,141 @@ static PHYSFSINT physfsrwops_size(SDL_RWops *const rw)
 } /* physfsrwops_size */
 #endif  // USE_SDL2
 
+namespace
+{
+    struct VfsRWops final
+    {
+        VfsRWops() :
+            data(),
+            pos(0)
+        {
+        }
+
+        A_DELETE_COPY(VfsRWops)
+
+        VfsData data;
+        size_t pos;
+    };
+}  // namespace
+
+static PHYSFSINT vfsrwops_seek(SDL_RWops *const rw, const PHYSFSINT offset,
+                               const int whence)
+{
+    if (!rw)
+        return -1;
+    VfsRWops *const handle = static_cast<VfsRWops *const>(
+        rw->hidden.unknown.data1);
+    PHYSFSINT pos = 0;
+    if (whence == SEEK_SET)
+        pos = offset;
+    else if (whence == SEEK_CUR)
+        pos = static_cast<PHYSFSINT>(handle->pos) + offset;
+    else if (whence == SEEK_END)
+        pos = static_cast<PHYSFSINT>(handle->data.size) + offset;
+    else
+    {
+        SDL_SetError("Invalid 'whence' parameter.");
+        return -1;
+    }
+
+    if (pos < 0)
+    {
+        SDL_SetError("Attempt to seek past start of file.");
+        return -1;
+    }
+    if (static_cast<size_t>(pos) > handle->data.size)
+        pos = static_cast<PHYSFSINT>(handle->data.size);
+    handle->pos = static_cast<size_t>(pos);
+    return pos;
+}
+
+static PHYSFSSIZE vfsrwops_read(SDL_RWops *const rw,
+                                void *ptr,
+                                const PHYSFSSIZE size,
+                                const PHYSFSSIZE maxnum)
+{
+    if (!rw || !size)
+        return 0;
+    VfsRWops *const handle = static_cast<VfsRWops *const>(
+        rw->hidden.unknown.data1);
+    const size_t left = handle->data.size - handle->pos;
+    size_t num = static_cast<size_t>(maxnum);
+    if (num * static_cast<size_t>(size) > left)
+        num = left / static_cast<size_t>(size);
+    const size_t bytes = num * static_cast<size_t>(size);
+    if (bytes)
+    {
+        memcpy(ptr, handle->data.data + handle->pos, bytes);
+        handle->pos += bytes;
+    }
+    return static_cast<PHYSFSSIZE>(num);
+}
+
+static PHYSFSSIZE vfsrwops_write(SDL_RWops *const rw A_UNUSED,
+                                 const void *ptr A_UNUSED,
+                                 const PHYSFSSIZE size A_UNUSED,
+                                 const PHYSFSSIZE num A_UNUSED)
+{
+    SDL_SetError("Write to read only file.");
+    return 0;
+}
+
+static int vfsrwops_close(SDL_RWops *const rw)
+{
+    if (!rw)
+        return 0;
+    VfsRWops *const handle = static_cast<VfsRWops*>(
+        rw->hidden.unknown.data1);
+    VfsIndex::freeData(handle->data);
+    delete handle;
+    SDL_FreeRW(rw);
+#ifdef DUMP_LEAKED_RESOURCES
+    openedRWops --;
+#endif  // DUMP_LEAKED_RESOURCES
+    return 0;
+}
+
+#ifdef USE_SDL2
+static PHYSFSINT vfsrwops_size(SDL_RWops *const rw)
+{
+    const VfsRWops *const handle = static_cast<VfsRWops*>(
+        rw->hidden.unknown.data1);
+    return static_cast<PHYSFSINT>(handle->data.size);
+}
+#endif  // USE_SDL2
+
+// open file from vfs index. Files mapped to memory if possible.
+static SDL_RWops *create_vfs_rwops(const char *const fname)
+{
+    VfsRWops *const handle = new VfsRWops;
+    if (!VfsIndex::readFile(fname, handle->data))
+    {
+        delete handle;
+        return nullptr;
+    }
+
+    SDL_RWops *const retval = SDL_AllocRW();
+    if (!retval)
+    {
+        VfsIndex::freeData(handle->data);
+        delete handle;
+        return nullptr;
+    }
+#ifdef USE_SDL2
+    retval->size  = &vfsrwops_size;
+#endif  // USE_SDL2
+
+    retval->seek  = &vfsrwops_seek;
+    retval->read  = &vfsrwops_read;
+    retval->write = &vfsrwops_write;
+    retval->close = &vfsrwops_close;
+    retval->hidden.unknown.data1 = handle;
+#ifdef DUMP_LEAKED_RESOURCES
+    openedRWops ++;
+#endif  // DUMP_LEAKED_RESOURCES
+    return retval;
+}
+
 static SDL_RWops *create_rwops(PHYSFS_file *const handle)
 {
     SDL_RWops *retval = nullptr;
@@ -253,14 +391,11 @@ SDL_RWops *PHYSFSRWOPS_openRead(const char *const fname)
     if (Fuzzer::conditionTerminate(fname))
         return nullptr;
 #endif  // USE_FUZZER
-#ifdef USE_PROFILER
-    SDL_RWops *const ret = create_rwops(PhysFs::openRead(fname));
+    SDL_RWops *ret = create_vfs_rwops(fname);
+    if (!ret)
+        ret = create_rwops(PhysFs::openRead(fname));
     BLOCK_END("PHYSFSRWOPS_openRead")
     return ret;
-#else  // USE_PROFILER
-
-    return create_rwops(PhysFs::openRead(fname));
-#endif  // USE_PROFILER
 } /* PHYSFSRWOPS_openRead */
 
 SDL_RWops *PHYSFSRWOPS_openWrite(const char *const fname)
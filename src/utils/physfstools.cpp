@@ -22,6 +22,9 @@
 
 #include "logger.h"
 
+#include "utils/vfsindex.h"
+
+#include <cstring>
 #include <iostream>
 #include <unistd.h>
 
@@ -80,6 +83,9 @@ namespace PhysFs
 
     bool exists(const char *const fname)
     {
+        bool found(false);
+        if (VfsIndex::exists(fname, found))
+            return found;
         return PHYSFS_exists(fname);
     }
 
@@ -90,6 +96,9 @@ namespace PhysFs
 
     bool isDirectory(const char *const fname)
     {
+        bool isDir(false);
+        if (VfsIndex::isDirectory(fname, isDir))
+            return isDir;
         return PHYSFS_isDirectory(fname);
     }
 
@@ -120,17 +129,29 @@ namespace PhysFs
 
     bool addToSearchPath(const char *const newDir, const int appendToPath)
     {
-        return PHYSFS_addToSearchPath(newDir, appendToPath);
+        if (!PHYSFS_addToSearchPath(newDir, appendToPath))
+            return false;
+        VfsIndex::addMount(newDir, appendToPath);
+        return true;
     }
 
     bool removeFromSearchPath(const char *const oldDir)
     {
-        return PHYSFS_removeFromSearchPath(oldDir);
+        if (!PHYSFS_removeFromSearchPath(oldDir))
+            return false;
+        VfsIndex::removeMount(oldDir);
+        return true;
     }
 
-    const char *getRealDir(const char *const filename)
+    std::string getRealDir(const char *const filename)
     {
-        return PHYSFS_getRealDir(filename);
+        std::string dir;
+        if (VfsIndex::getRealDir(filename, dir))
+            return dir;
+        const char *const realDir = PHYSFS_getRealDir(filename);
+        if (realDir)
+            dir = realDir;
+        return dir;
     }
 
     bool mkdir(const char *const dirname)
@@ -140,6 +161,25 @@ namespace PhysFs
 
     void *loadFile(const std::string &fileName, int &fileSize)
     {
+        VfsData data;
+        if (VfsIndex::readFile(fileName.c_str(), data))
+        {
+            fileSize = CAST_S32(data.size);
+            void *buffer = data.buffer;
+            if (buffer)
+            {
+                data.buffer = nullptr;
+            }
+            else
+            {
+                buffer = calloc(fileSize + 1, 1);
+                if (buffer && fileSize)
+                    memcpy(buffer, data.data, fileSize);
+            }
+            VfsIndex::freeData(data);
+            return buffer;
+        }
+
         // Attempt to open the specified file using PhysicsFS
         PHYSFS_file *const file = PhysFs::openRead(fileName.c_str());
 
@@ -150,7 +190,8 @@ namespace PhysFs
             return nullptr;
         }
 
-        logger->log("Loaded %s/%s", PhysFs::getRealDir(fileName.c_str()),
+        logger->log("Loaded %s/%s",
+            PhysFs::getRealDir(fileName.c_str()).c_str(),
             fileName.c_str());
 
         fileSize = CAST_S32(PHYSFS_fileLength(file));
@@ -0,0 +1,273 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/sdlalphablit.h"
+
+#include "resources/image/image.h"
+
+#include "utils/sdlpixel.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif  // __SSE2__
+
+#include "debug.h"
+
+// all blend functions use same formula, for get same results:
+// a = (srcA * alpha + 255) / 256
+// dst = (src * a + dst * (255 - a) + 255) / 256
+
+void SDLAlphaBlendRowScalar(const uint32_t *restrict src,
+                            uint32_t *restrict dst,
+                            const int width,
+                            const uint8_t alpha)
+{
+    const uint32_t alpha1 = alpha;
+    for (int x = 0; x < width; x ++)
+    {
+        const uint32_t s = src[x];
+        const uint32_t a = ((s >> 24) * alpha1 + 255) >> 8;
+        if (!a)
+            continue;
+        const uint32_t d = dst[x];
+        const uint32_t ia = 255 - a;
+        const uint32_t rb = (((s & 0xff00ffU) * a
+            + (d & 0xff00ffU) * ia + 0xff00ffU) >> 8) & 0xff00ffU;
+        const uint32_t g = (((s & 0xff00U) * a
+            + (d & 0xff00U) * ia + 0xff00U) >> 8) & 0xff00U;
+        dst[x] = rb | g | (d & 0xff000000U);
+    }
+}
+
+#ifdef __SSE2__
+void SDLAlphaBlendRowSse2(const uint32_t *restrict src,
+                          uint32_t *restrict dst,
+                          const int width,
+                          const uint8_t alpha)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alpha32 = _mm_set1_epi32(alpha);
+    const __m128i round32 = _mm_set1_epi32(255);
+    const __m128i max16 = _mm_set1_epi16(255);
+    const __m128i alphaMask = _mm_set1_epi32(0xff000000U);
+    const __m128i colorMask = _mm_set1_epi32(0x00ffffffU);
+
+    int x = 0;
+    for (; x + 4 <= width; x += 4)
+    {
+        const __m128i s = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(src + x));
+        const __m128i d = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(dst + x));
+
+        // source alpha multiplied by global alpha, one value per pixel
+        __m128i a = _mm_srli_epi32(s, 24);
+        a = _mm_mullo_epi16(a, alpha32);
+        a = _mm_srli_epi32(_mm_add_epi32(a, round32), 8);
+        a = _mm_or_si128(a, _mm_slli_epi32(a, 16));
+        const __m128i aLo = _mm_unpacklo_epi32(a, a);
+        const __m128i aHi = _mm_unpackhi_epi32(a, a);
+        const __m128i iaLo = _mm_sub_epi16(max16, aLo);
+        const __m128i iaHi = _mm_sub_epi16(max16, aHi);
+
+        __m128i lo = _mm_add_epi16(
+            _mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), aLo),
+            _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), iaLo));
+        __m128i hi = _mm_add_epi16(
+            _mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), aHi),
+            _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), iaHi));
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, max16), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, max16), 8);
+
+        const __m128i res = _mm_or_si128(
+            _mm_and_si128(_mm_packus_epi16(lo, hi), colorMask),
+            _mm_and_si128(d, alphaMask));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), res);
+    }
+    if (x < width)
+        SDLAlphaBlendRowScalar(src + x, dst + x, width - x, alpha);
+}
+#endif  // __SSE2__
+
+void SDLAlphaBlendRow(const uint32_t *restrict src,
+                      uint32_t *restrict dst,
+                      const int width,
+                      const uint8_t alpha)
+{
+#ifdef __SSE2__
+    SDLAlphaBlendRowSse2(src, dst, width, alpha);
+#else  // __SSE2__
+
+    SDLAlphaBlendRowScalar(src, dst, width, alpha);
+#endif  // __SSE2__
+}
+
+void SDLAlphaBlit(SDL_Surface *restrict const src,
+                  int srcX, int srcY,
+                  int width, int height,
+                  SDL_Surface *restrict const dst,
+                  int dstX, int dstY,
+                  const uint8_t alpha)
+{
+    if (!src || !dst || !alpha)
+        return;
+
+    // clip by source surface
+    if (srcX < 0)
+    {
+        width += srcX;
+        dstX -= srcX;
+        srcX = 0;
+    }
+    if (srcY < 0)
+    {
+        height += srcY;
+        dstY -= srcY;
+        srcY = 0;
+    }
+    if (srcX + width > src->w)
+        width = src->w - srcX;
+    if (srcY + height > src->h)
+        height = src->h - srcY;
+
+    // clip by destination clip rect
+    const SDL_Rect &clip = dst->clip_rect;
+    int dx = clip.x - dstX;
+    if (dx > 0)
+    {
+        width -= dx;
+        dstX += dx;
+        srcX += dx;
+    }
+    dx = dstX + width - clip.x - clip.w;
+    if (dx > 0)
+        width -= dx;
+    int dy = clip.y - dstY;
+    if (dy > 0)
+    {
+        height -= dy;
+        dstY += dy;
+        srcY += dy;
+    }
+    dy = dstY + height - clip.y - clip.h;
+    if (dy > 0)
+        height -= dy;
+
+    if (width <= 0 || height <= 0)
+        return;
+
+    const SDL_PixelFormat *const srcFormat = src->format;
+    const SDL_PixelFormat *const dstFormat = dst->format;
+    if (srcFormat->BytesPerPixel != 4)
+    {
+        // only 32 bit images can have alpha channel
+        SDL_Rect srcRect =
+        {
+            CAST_S16(srcX),
+            CAST_S16(srcY),
+            CAST_U16(width),
+            CAST_U16(height)
+        };
+        SDL_Rect dstRect =
+        {
+            CAST_S16(dstX),
+            CAST_S16(dstY),
+            CAST_U16(width),
+            CAST_U16(height)
+        };
+        SDL_LowerBlit(src, &srcRect, dst, &dstRect);
+        return;
+    }
+
+    if (SDL_MUSTLOCK(src))
+        SDL_LockSurface(src);
+    if (SDL_MUSTLOCK(dst))
+        SDL_LockSurface(dst);
+
+    if (dstFormat->BytesPerPixel == 4 &&
+        srcFormat->Amask == 0xff000000U &&
+        srcFormat->Rmask == dstFormat->Rmask &&
+        srcFormat->Gmask == dstFormat->Gmask &&
+        srcFormat->Bmask == dstFormat->Bmask)
+    {
+        const uint8_t *const srcPixels = static_cast<const uint8_t*>(
+            src->pixels);
+        uint8_t *const dstPixels = static_cast<uint8_t*>(dst->pixels);
+        for (int y = 0; y < height; y ++)
+        {
+            const uint32_t *const srcRow = reinterpret_cast<const uint32_t*>(
+                srcPixels + CAST_SIZE((srcY + y) * src->pitch)) + srcX;
+            uint32_t *const dstRow = reinterpret_cast<uint32_t*>(
+                dstPixels + CAST_SIZE((dstY + y) * dst->pitch)) + dstX;
+            SDLAlphaBlendRow(srcRow, dstRow, width, alpha);
+        }
+    }
+    else
+    {
+        // slow path for 16 and 24 bit screens
+        for (int y = 0; y < height; y ++)
+        {
+            const uint32_t *const srcRow = reinterpret_cast<const uint32_t*>(
+                static_cast<const uint8_t*>(src->pixels)
+                + CAST_SIZE((srcY + y) * src->pitch)) + srcX;
+            for (int x = 0; x < width; x ++)
+            {
+                uint8_t r = 0;
+                uint8_t g = 0;
+                uint8_t b = 0;
+                uint8_t a = 0;
+                SDL_GetRGBA(srcRow[x], srcFormat, &r, &g, &b, &a);
+                a = CAST_U8((a * alpha + 255) >> 8);
+                if (!a)
+                    continue;
+                SDLputPixelAlpha(dst, dstX + x, dstY + y,
+                    Color(r, g, b, a));
+            }
+        }
+    }
+
+    if (SDL_MUSTLOCK(dst))
+        SDL_UnlockSurface(dst);
+    if (SDL_MUSTLOCK(src))
+        SDL_UnlockSurface(src);
+}
+
+void SDLBlitImage(const Image *restrict const image,
+                  SDL_Surface *restrict const src,
+                  SDL_Rect *restrict const srcRect,
+                  SDL_Surface *restrict const dst,
+                  SDL_Rect *restrict const dstRect,
+                  const bool clipped)
+{
+    if (image->mAlpha != 1.0F && image->isHasAlphaChannel())
+    {
+        SDLAlphaBlit(src, srcRect->x, srcRect->y, srcRect->w, srcRect->h,
+            dst, dstRect->x, dstRect->y,
+            CAST_U8(255 * image->mAlpha));
+    }
+    else if (clipped)
+    {
+        SDL_LowerBlit(src, srcRect, dst, dstRect);
+    }
+    else
+    {
+        SDL_BlitSurface(src, srcRect, dst, dstRect);
+    }
+}
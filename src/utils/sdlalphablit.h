@@ -0,0 +1,79 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UTILS_SDLALPHABLIT_H
+#define UTILS_SDLALPHABLIT_H
+
+#include <stdint.h>
+
+#include "localconsts.h"
+
+class Image;
+
+struct SDL_Rect;
+struct SDL_Surface;
+
+/**
+ * Blits surface with per pixel alpha to other surface, multiplying
+ * source alpha by given alpha. Source surface pixels not modified.
+ * Rectangle clipped by source size and destination clip rectangle.
+ */
+void SDLAlphaBlit(SDL_Surface *restrict const src,
+                  int srcX, int srcY,
+                  int width, int height,
+                  SDL_Surface *restrict const dst,
+                  int dstX, int dstY,
+                  const uint8_t alpha);
+
+/**
+ * Blits part of image surface with image alpha, or by SDL blit if
+ * image opaque or have no alpha channel. If rectangles already clipped,
+ * SDL_LowerBlit used instead of SDL_BlitSurface.
+ */
+void SDLBlitImage(const Image *restrict const image,
+                  SDL_Surface *restrict const src,
+                  SDL_Rect *restrict const srcRect,
+                  SDL_Surface *restrict const dst,
+                  SDL_Rect *restrict const dstRect,
+                  const bool clipped);
+
+/**
+ * Blends row of 32 bit pixels with alpha in highest byte to
+ * destination row with same color channels.
+ * Destination alpha byte not changed.
+ */
+void SDLAlphaBlendRow(const uint32_t *restrict src,
+                      uint32_t *restrict dst,
+                      const int width,
+                      const uint8_t alpha);
+
+void SDLAlphaBlendRowScalar(const uint32_t *restrict src,
+                            uint32_t *restrict dst,
+                            const int width,
+                            const uint8_t alpha);
+
+#ifdef __SSE2__
+void SDLAlphaBlendRowSse2(const uint32_t *restrict src,
+                          uint32_t *restrict dst,
+                          const int width,
+                          const uint8_t alpha);
+#endif  // __SSE2__
+
+#endif  // UTILS_SDLALPHABLIT_H
@@ -0,0 +1,85 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/sdlalphablit.h"
+
+#include "catch.hpp"
+
+#include "debug.h"
+
+TEST_CASE("SDLAlphaBlit blendRow")
+{
+    SECTION("transparent")
+    {
+        const uint32_t src[2] = { 0xff102030U, 0x00ffffffU };
+        uint32_t dst[2] = { 0x80405060U, 0x80405060U };
+        SDLAlphaBlendRowScalar(&src[0], &dst[0], 2, 0);
+        REQUIRE(dst[0] == 0x80405060U);
+        REQUIRE(dst[1] == 0x80405060U);
+    }
+
+    SECTION("opaque")
+    {
+        const uint32_t src[2] = { 0xff102030U, 0x00ffffffU };
+        uint32_t dst[2] = { 0x80405060U, 0x80405060U };
+        SDLAlphaBlendRowScalar(&src[0], &dst[0], 2, 255);
+        REQUIRE(dst[0] == 0x80102030U);
+        REQUIRE(dst[1] == 0x80405060U);
+    }
+
+    SECTION("half")
+    {
+        const uint32_t src[1] = { 0xff000000U };
+        uint32_t dst[1] = { 0x00fefefeU };
+        SDLAlphaBlendRowScalar(&src[0], &dst[0], 1, 128);
+        const uint32_t r = (dst[0] >> 16) & 0xffU;
+        REQUIRE(r >= 0x7eU);
+        REQUIRE(r <= 0x80U);
+        REQUIRE((dst[0] & 0xff000000U) == 0U);
+    }
+
+#ifdef __SSE2__
+    SECTION("sse2 same as scalar")
+    {
+        const int size = 37;
+        uint32_t src[size];
+        uint32_t dst1[size];
+        uint32_t dst2[size];
+        uint32_t seed = 12345;
+        for (int f = 0; f < size; f ++)
+        {
+            seed = seed * 1103515245U + 12345U;
+            src[f] = seed;
+            seed = seed * 1103515245U + 12345U;
+            dst1[f] = seed;
+            dst2[f] = seed;
+        }
+        for (int alpha = 0; alpha < 256; alpha += 17)
+        {
+            SDLAlphaBlendRowScalar(&src[0], &dst1[0], size,
+                static_cast<uint8_t>(alpha));
+            SDLAlphaBlendRowSse2(&src[0], &dst2[0], size,
+                static_cast<uint8_t>(alpha));
+            for (int f = 0; f < size; f ++)
+                REQUIRE(dst1[f] == dst2[f]);
+        }
+    }
+#endif  // __SSE2__
+}
@@ -38,6 +38,8 @@ namespace
     SDL_TimerID mLogicCounterId(nullptr);
     SDL_TimerID mSecondsCounterId(nullptr);
 #endif  // USE_SDL2
+
+    volatile uint32_t mLastTickTicks(0U);
 }  // namespace
 
 /**
@@ -66,6 +68,7 @@ static uint32_t nextTick(uint32_t interval, void *param A_UNUSED)
     tick_time++;
     if (tick_time == MAX_TICK_VALUE)
         tick_time = 0;
+    mLastTickTicks = SDL_GetTicks();
     return interval;
 }
 
@@ -110,10 +113,23 @@ int get_elapsed_time1(const int startTime)
         return time + (MAX_TICK_VALUE - startTime);
 }
 
+/**
+ * @return the time in milliseconds until the logic counter
+ * is expected to advance next time.
+ */
+int get_next_tick_delay()
+{
+    const uint32_t passed = SDL_GetTicks() - mLastTickTicks;
+    if (passed >= static_cast<uint32_t>(MILLISECONDS_IN_A_TICK))
+        return 0;
+    return MILLISECONDS_IN_A_TICK - static_cast<int>(passed);
+}
+
 void startTimers()
 {
     // Initialize logic and seconds counters
     tick_time = 0;
+    mLastTickTicks = SDL_GetTicks();
     mLogicCounterId = SDL_AddTimer(MILLISECONDS_IN_A_TICK, nextTick, nullptr);
     mSecondsCounterId = SDL_AddTimer(1000, nextSecond, nullptr);
 }
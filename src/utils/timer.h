@@ -41,4 +41,6 @@ int get_elapsed_time(const int startTime) A_WARN_UNUSED;
 
 int get_elapsed_time1(const int startTime) A_WARN_UNUSED;
 
+int get_next_tick_delay() A_WARN_UNUSED;
+
 #endif  // UTILS_TIMER_H
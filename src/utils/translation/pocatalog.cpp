@@ -0,0 +1,304 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "utils/translation/pocatalog.h"
+
+#include <cstdio>
+#include <fstream>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif  // WIN32
+
+#include "debug.h"
+
+// file format: header, buckets, strings.
+// header: magic, version, po file hash, po file size, strings count,
+// buckets count.
+// bucket: key hash, key offset, value offset. Zero key offset is empty
+// bucket. Offsets is from start of file, strings terminated by zero.
+static const uint32_t poCatalogMagic = 0x43444f50U;
+static const uint32_t poCatalogVersion = 1U;
+static const size_t headerSize = 6;
+static const size_t bucketSize = 3;
+
+PoCatalog::PoCatalog() :
+    mBuffer(),
+    mData(nullptr),
+    mDataSize(0),
+    mBuckets(nullptr),
+    mCount(0),
+    mMask(0),
+    mMapped(false)
+{
+}
+
+PoCatalog::~PoCatalog()
+{
+    unload();
+}
+
+void PoCatalog::unload()
+{
+#ifndef WIN32
+    if (mMapped)
+        munmap(const_cast<char*>(mData), mDataSize);
+#endif  // WIN32
+
+    mBuffer.clear();
+    mData = nullptr;
+    mDataSize = 0;
+    mBuckets = nullptr;
+    mCount = 0;
+    mMask = 0;
+    mMapped = false;
+}
+
+uint32_t PoCatalog::hashStr(const char *str)
+{
+    // fnv-1a
+    uint32_t hash = 2166136261U;
+    while (*str)
+    {
+        hash ^= CAST_U8(*str);
+        hash *= 16777619U;
+        str ++;
+    }
+    return hash;
+}
+
+void PoCatalog::build(const PoMap &lines,
+                      const uint32_t hash,
+                      const uint32_t size)
+{
+    unload();
+
+    // load factor not more than 0.5
+    uint32_t bucketsCount = 16U;
+    while (bucketsCount < 2 * lines.size())
+        bucketsCount *= 2;
+
+    const size_t tableSize = (headerSize + bucketSize * bucketsCount)
+        * sizeof(uint32_t);
+    size_t stringsSize = 0;
+    FOR_EACH (PoMap::const_iterator, it, lines)
+        stringsSize += (*it).first.size() + (*it).second.size() + 2;
+
+    mBuffer.resize(tableSize + stringsSize);
+    uint32_t *const header = reinterpret_cast<uint32_t*>(&mBuffer[0]);
+    header[0] = poCatalogMagic;
+    header[1] = poCatalogVersion;
+    header[2] = hash;
+    header[3] = size;
+    header[4] = CAST_U32(lines.size());
+    header[5] = bucketsCount;
+    uint32_t *const buckets = header + headerSize;
+    const uint32_t mask = bucketsCount - 1;
+
+    size_t pos = tableSize;
+    FOR_EACH (PoMap::const_iterator, it, lines)
+    {
+        const std::string &key = (*it).first;
+        const std::string &value = (*it).second;
+        const uint32_t keyPos = CAST_U32(pos);
+        memcpy(&mBuffer[pos], key.c_str(), key.size() + 1);
+        pos += key.size() + 1;
+        const uint32_t valuePos = CAST_U32(pos);
+        memcpy(&mBuffer[pos], value.c_str(), value.size() + 1);
+        pos += value.size() + 1;
+
+        const uint32_t keyHash = hashStr(key.c_str());
+        uint32_t idx = keyHash & mask;
+        while (buckets[idx * bucketSize + 1])
+            idx = (idx + 1) & mask;
+        uint32_t *const bucket = buckets + idx * bucketSize;
+        bucket[0] = keyHash;
+        bucket[1] = keyPos;
+        bucket[2] = valuePos;
+    }
+
+    mData = &mBuffer[0];
+    mDataSize = mBuffer.size();
+    mBuckets = buckets;
+    mCount = CAST_U32(lines.size());
+    mMask = mask;
+}
+
+bool PoCatalog::load(const std::string &fileName,
+                     const uint32_t hash,
+                     const uint32_t size)
+{
+    unload();
+
+#ifndef WIN32
+    const int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd == -1)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) == -1 ||
+        CAST_SIZE(st.st_size) < headerSize * sizeof(uint32_t))
+    {
+        close(fd);
+        return false;
+    }
+    void *const ptr = mmap(nullptr, CAST_SIZE(st.st_size), PROT_READ,
+        MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED)
+        return false;
+    mData = static_cast<const char*>(ptr);
+    mDataSize = CAST_SIZE(st.st_size);
+    mMapped = true;
+#else  // WIN32
+
+    std::ifstream file;
+    file.open(fileName.c_str(), std::ios::in | std::ios::binary);
+    if (!file.is_open())
+        return false;
+    file.seekg(0, std::ios::end);
+    const size_t fileSize = CAST_SIZE(file.tellg());
+    if (fileSize < headerSize * sizeof(uint32_t))
+        return false;
+    file.seekg(0, std::ios::beg);
+    mBuffer.resize(fileSize);
+    file.read(&mBuffer[0], fileSize);
+    if (!file)
+    {
+        mBuffer.clear();
+        return false;
+    }
+    mData = &mBuffer[0];
+    mDataSize = fileSize;
+#endif  // WIN32
+
+    if (!check(hash, size))
+    {
+        unload();
+        return false;
+    }
+    return true;
+}
+
+bool PoCatalog::check(const uint32_t hash,
+                      const uint32_t size)
+{
+    const uint32_t *const header = reinterpret_cast<const uint32_t*>(mData);
+    const uint32_t bucketsCount = header[5];
+    if (header[0] != poCatalogMagic ||
+        header[1] != poCatalogVersion ||
+        header[2] != hash ||
+        header[3] != size ||
+        bucketsCount == 0 ||
+        (bucketsCount & (bucketsCount - 1)) != 0 ||
+        header[4] >= bucketsCount)
+    {
+        return false;
+    }
+    const size_t tableSize = (headerSize + bucketSize * bucketsCount)
+        * sizeof(uint32_t);
+    if (tableSize > mDataSize || mData[mDataSize - 1] != 0)
+        return false;
+
+    const uint32_t *const buckets = header + headerSize;
+    uint32_t usedBuckets = 0;
+    for (uint32_t f = 0; f < bucketsCount; f ++)
+    {
+        const uint32_t *const bucket = buckets + f * bucketSize;
+        if (!bucket[1])
+            continue;
+        if (bucket[1] < tableSize || bucket[1] >= mDataSize ||
+            bucket[2] < tableSize || bucket[2] >= mDataSize)
+        {
+            return false;
+        }
+        usedBuckets ++;
+    }
+    // find need at least one empty bucket for stop
+    if (usedBuckets != header[4])
+        return false;
+
+    mBuckets = buckets;
+    mCount = header[4];
+    mMask = bucketsCount - 1;
+    return true;
+}
+
+bool PoCatalog::save(const std::string &fileName) const
+{
+    if (!mData || mMapped)
+        return false;
+
+    // other clients can have old file mapped, truncating it in place
+    // will crash them. Write new file near and replace old one.
+    std::string tmpName = fileName;
+#ifndef WIN32
+    char pidStr[20];
+    snprintf(pidStr, sizeof(pidStr), ".%d", CAST_S32(getpid()));
+    tmpName.append(pidStr);
+#endif  // WIN32
+
+    tmpName.append(".tmp");
+
+    std::ofstream file;
+    file.open(tmpName.c_str(),
+        std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        return false;
+    file.write(mData, mDataSize);
+    file.close();
+    if (!file)
+    {
+        ::remove(tmpName.c_str());
+        return false;
+    }
+#ifdef WIN32
+    // on windows rename can not replace existing file
+    ::remove(fileName.c_str());
+#endif  // WIN32
+
+    if (::rename(tmpName.c_str(), fileName.c_str()))
+    {
+        ::remove(tmpName.c_str());
+        return false;
+    }
+    return true;
+}
+
+const char *PoCatalog::find(const char *const str) const
+{
+    if (!mBuckets)
+        return nullptr;
+
+    const uint32_t keyHash = hashStr(str);
+    uint32_t idx = keyHash & mMask;
+    for (;;)
+    {
+        const uint32_t *const bucket = mBuckets + idx * bucketSize;
+        if (!bucket[1])
+            return nullptr;
+        if (bucket[0] == keyHash && !strcmp(mData + bucket[1], str))
+            return mData + bucket[2];
+        idx = (idx + 1) & mMask;
+    }
+}
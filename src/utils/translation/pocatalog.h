@@ -0,0 +1,90 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef UTILS_TRANSLATION_POCATALOG_H
+#define UTILS_TRANSLATION_POCATALOG_H
+
+#include "utils/translation/podict.h"
+
+#include <vector>
+
+#include "localconsts.h"
+
+/**
+ * Compiled translation catalog.
+ * Strings stored in one block with open addressing hash table,
+ * so catalog can be saved to file and mapped back to memory without
+ * parsing.
+ */
+class PoCatalog final
+{
+    public:
+        PoCatalog();
+
+        A_DELETE_COPY(PoCatalog)
+
+        ~PoCatalog();
+
+        /**
+         * Builds catalog from parsed po lines.
+         * hash and size of po file stored for check of cache.
+         */
+        void build(const PoMap &lines,
+                   const uint32_t hash,
+                   const uint32_t size);
+
+        /**
+         * Maps compiled catalog file.
+         *
+         * @return false if file missing or built from other po file.
+         */
+        bool load(const std::string &fileName,
+                  const uint32_t hash,
+                  const uint32_t size) A_WARN_UNUSED;
+
+        bool save(const std::string &fileName) const;
+
+        /**
+         * Returns translation or nullptr if string not translated.
+         */
+        const char *find(const char *const str) const A_WARN_UNUSED;
+
+        uint32_t size() const A_WARN_UNUSED
+        { return mCount; }
+
+        static uint32_t hashStr(const char *str) A_WARN_UNUSED;
+
+    private:
+        bool check(const uint32_t hash,
+                   const uint32_t size) A_WARN_UNUSED;
+
+        void unload();
+
+        std::vector<char> mBuffer;
+        const char *mData;
+        size_t mDataSize;
+        const uint32_t *mBuckets;
+        uint32_t mCount;
+        uint32_t mMask;
+        bool mMapped;
+};
+
+#endif  // UTILS_TRANSLATION_POCATALOG_H
@@ -20,6 +20,10 @@
 
 #include "utils/translation/podict.h"
 
+#include "utils/dtor.h"
+
+#include "utils/translation/pocatalog.h"
+
 #include "debug.h"
 
 std::string empty;
@@ -30,25 +34,54 @@ PoDict *mainTranslator = nullptr;
 #endif  // ENABLE_CUSTOMNLS
 
 PoDict::PoDict(std::string lang) :
-    mPoLines(),
+    mCatalogs(),
     mLang(lang)
 {
 }
 
 PoDict::~PoDict()
 {
+    delete_all(mCatalogs);
+    mCatalogs.clear();
+}
+
+void PoDict::addCatalog(PoCatalog *const catalog)
+{
+    mCatalogs.push_back(catalog);
+}
+
+const char *PoDict::find(const char *const str) const
+{
+    // last added catalog have priority
+    for (size_t f = mCatalogs.size(); f > 0; f --)
+    {
+        const char *const value = mCatalogs[f - 1]->find(str);
+        if (value)
+            return value;
+    }
+    return nullptr;
 }
 
 const std::string PoDict::getStr(const std::string &str)
 {
-    if (mPoLines.find(str) == mPoLines.end())
+    const char *const value = find(str.c_str());
+    if (!value)
         return str;
-    return mPoLines[str];
+    return value;
 }
 
 const char *PoDict::getChar(const char *const str)
 {
-    if (mPoLines.find(str) == mPoLines.end())
+    const char *const value = find(str);
+    if (!value)
         return str;
-    return mPoLines[str].c_str();
+    return value;
+}
+
+size_t PoDict::size() const
+{
+    size_t sz = 0;
+    FOR_EACH (std::vector<PoCatalog*>::const_iterator, it, mCatalogs)
+        sz += (*it)->size();
+    return sz;
 }
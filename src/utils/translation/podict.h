@@ -23,11 +23,19 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "localconsts.h"
 
 typedef std::map <std::string, std::string> PoMap;
 
+class PoCatalog;
+
+/**
+ * Translations dictionary.
+ * Strings searched in compiled catalogs, later added catalogs
+ * override earlier.
+ */
 class PoDict final
 {
     public:
@@ -41,22 +49,25 @@ class PoDict final
 
         const char *getChar(const char *const str);
 
+        /**
+         * Returns count of strings in all catalogs.
+         */
+        size_t size() const A_WARN_UNUSED;
+
 #ifndef UNITTESTS
     protected:
 #endif  // UNITTESTS
         friend class PoParser;
 
-        PoMap *getMap()
-        { return &mPoLines; }
-
-        void set(const std::string &key, const std::string &value)
-        { mPoLines[key] = value; }
+        void addCatalog(PoCatalog *const catalog);
 
         void setLang(const std::string &lang)
         { mLang = lang; }
 
     private:
-        PoMap mPoLines;
+        const char *find(const char *const str) const A_WARN_UNUSED;
+
+        std::vector<PoCatalog*> mCatalogs;
         std::string mLang;
 };
 
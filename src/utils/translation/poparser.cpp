@@ -20,18 +20,23 @@
 
 #include "utils/translation/poparser.h"
 
+#include "utils/mkdir.h"
 #include "utils/physfstools.h"
 #include "utils/stringutils.h"
 
-#include "utils/translation/podict.h"
+#include "utils/translation/pocatalog.h"
 
 #include "logger.h"
+#include "settings.h"
+
+#include <zlib.h>
 
 #include "debug.h"
 
 PoParser::PoParser() :
     mLang(),
     mFile(),
+    mPoLines(),
     mLine(),
     mMsgId(),
     mMsgStr(),
@@ -42,20 +47,49 @@ PoParser::PoParser() :
 {
 }
 
-void PoParser::openFile(const std::string &name)
+PoCatalog *PoParser::loadCatalog(const std::string &name)
 {
     int size;
     char *buf = static_cast<char*>(PhysFs::loadFile(getFileName(name), size));
-
-    if (buf)
+    if (!buf)
+        return nullptr;
+
+    const uint32_t hash = CAST_U32(adler32(adler32(0L, Z_NULL, 0),
+        reinterpret_cast<const Bytef*>(buf), CAST_U32(size)));
+    PoCatalog *const catalog = new PoCatalog;
+    std::string cacheName;
+    if (!settings.localDataDir.empty())
     {
-        mFile.str(std::string(buf, size));
-        free(buf);
+        cacheName = getCacheFileName(name);
+        if (catalog->load(cacheName, hash, CAST_U32(size)))
+        {
+            free(buf);
+            return catalog;
+        }
     }
-    else
+
+    mFile.clear();
+    mFile.str(std::string(buf, size));
+    free(buf);
+    parse();
+    catalog->build(mPoLines, hash, CAST_U32(size));
+    mPoLines.clear();
+    mFile.str(std::string());
+
+    if (!cacheName.empty())
     {
-        mFile.clear();
+        if (mkdir_r(getCacheDir().c_str()))
+        {
+            logger->log("Error creating directory: %s",
+                getCacheDir().c_str());
+        }
+        else if (!catalog->save(cacheName))
+        {
+            logger->log("Error saving translation cache: %s",
+                cacheName.c_str());
+        }
     }
+    return catalog;
 }
 
 PoDict *PoParser::load(const std::string &restrict lang,
@@ -70,11 +104,16 @@ PoDict *PoParser::load(const std::string &restrict lang,
     else
         mDict = dict;
 
-    if (fileName.empty())
-        openFile(mLang);
-    else
-        openFile(fileName);
+    PoCatalog *const catalog = loadCatalog(fileName.empty()
+        ? mLang : fileName);
+    if (catalog)
+        mDict->addCatalog(catalog);
 
+    return mDict;
+}
+
+void PoParser::parse()
+{
     mMsgId.clear();
     mMsgStr.clear();
 
@@ -106,14 +145,12 @@ PoDict *PoParser::load(const std::string &restrict lang,
             convertStr(mMsgId);
             convertStr(mMsgStr);
             // store key and value
-            mDict->set(mMsgId, mMsgStr);
+            mPoLines[mMsgId] = mMsgStr;
         }
 
         mMsgId.clear();
         mMsgStr.clear();
     }
-
-    return mDict;
 }
 
 bool PoParser::readLine()
@@ -264,6 +301,18 @@ bool PoParser::checkLang(const std::string &lang)
     return PhysFs::exists(getFileName(lang).c_str());
 }
 
+std::string PoParser::getCacheDir()
+{
+    return settings.localDataDir + "/cache/translations/";
+}
+
+std::string PoParser::getCacheFileName(const std::string &name)
+{
+    std::string fileName = getFileName(name);
+    replaceAll(fileName, "/", "_");
+    return getCacheDir().append(fileName).append(".bin");
+}
+
 std::string PoParser::getFileName(const std::string &lang)
 {
     // get po file name from lang name
@@ -21,11 +21,11 @@
 #ifndef UTILS_TRANSLATION_POPARSER_H
 #define UTILS_TRANSLATION_POPARSER_H
 
-#include "localconsts.h"
+#include "utils/translation/podict.h"
 
 #include <sstream>
 
-class PoDict;
+class PoCatalog;
 
 class PoParser final
 {
@@ -46,7 +46,13 @@ class PoParser final
         void setLang(const std::string &lang)
         { mLang = lang; }
 
-        void openFile(const std::string &name);
+        PoCatalog *loadCatalog(const std::string &name);
+
+        void parse();
+
+        static std::string getCacheDir();
+
+        static std::string getCacheFileName(const std::string &name);
 
         bool readLine();
 
@@ -68,6 +74,9 @@ class PoParser final
         // po file object
         std::istringstream mFile;
 
+        // parsed strings, used for build catalog
+        PoMap mPoLines;
+
         // current line from po file
         std::string mLine;
 
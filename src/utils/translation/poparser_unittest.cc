@@ -25,6 +25,7 @@
 
 #include "being/actorsprite.h"
 
+#include "utils/translation/pocatalog.h"
 #include "utils/translation/podict.h"
 #include "utils/translation/poparser.h"
 
@@ -35,6 +36,7 @@
 #include "utils/delete2.h"
 #include "utils/env.h"
 #include "utils/physfstools.h"
+#include "utils/stringutils.h"
 
 #include "debug.h"
 
@@ -70,8 +72,7 @@ TEST_CASE("PoParser tests", "PoParser")
             nullptr);
 
         REQUIRE(dict != nullptr);
-        REQUIRE(dict->getMap() != nullptr);
-        REQUIRE(dict->getMap()->size() == 0);
+        REQUIRE(dict->size() == 0);
 
         delete parser;
         delete dict;
@@ -85,8 +86,7 @@ TEST_CASE("PoParser tests", "PoParser")
             nullptr);
 
         REQUIRE(dict != nullptr);
-        REQUIRE(dict->getMap() != nullptr);
-        REQUIRE(dict->getMap()->size() == 1786);
+        REQUIRE(dict->size() == 1786);
         REQUIRE(dict->getStr("Unknown skill message.") ==
             "Неизвестная ошибка скилов.");
         REQUIRE(dict->getStr("Full strip failed because of coating.") ==
@@ -106,8 +106,7 @@ TEST_CASE("PoParser tests", "PoParser")
             nullptr);
 
         REQUIRE(dict != nullptr);
-        REQUIRE(dict->getMap() != nullptr);
-        REQUIRE(dict->getMap()->size() == 1786);
+        REQUIRE(dict->size() == 1786);
         REQUIRE(dict->getStr("Atk +100%.") == "Atk +100%.");
 
         delete parser;
@@ -115,3 +114,44 @@ TEST_CASE("PoParser tests", "PoParser")
     }
     delete2(client);
 }
+
+TEST_CASE("PoCatalog tests", "PoCatalog")
+{
+    PoMap lines;
+    for (int f = 0; f < 1000; f ++)
+    {
+        lines[strprintf("key %d", f)] = strprintf("value %d", f);
+    }
+    lines["%s"] = "";
+
+    PoCatalog catalog;
+    catalog.build(lines, 123U, 456U);
+    REQUIRE(catalog.size() == 1001);
+    REQUIRE(catalog.find("key 0") != nullptr);
+    REQUIRE(std::string(catalog.find("key 0")) == "value 0");
+    REQUIRE(std::string(catalog.find("key 999")) == "value 999");
+    REQUIRE(std::string(catalog.find("%s")).empty());
+    REQUIRE(catalog.find("key 1000") == nullptr);
+    REQUIRE(catalog.find("") == nullptr);
+
+    const std::string name = "catalog.test";
+    REQUIRE(catalog.save(name));
+
+    PoCatalog catalog2;
+    REQUIRE(catalog2.load(name, 123U, 456U));
+    REQUIRE(catalog2.size() == 1001);
+    for (int f = 0; f < 1000; f ++)
+    {
+        REQUIRE(catalog2.find(strprintf("key %d", f).c_str()) ==
+            strprintf("value %d", f));
+    }
+    REQUIRE(catalog2.find("key 1000") == nullptr);
+
+    // cache from other po file
+    PoCatalog catalog3;
+    REQUIRE_FALSE(catalog3.load(name, 124U, 456U));
+    REQUIRE_FALSE(catalog3.load(name, 123U, 457U));
+    REQUIRE(catalog3.find("key 0") == nullptr);
+    REQUIRE_FALSE(catalog3.load("unknownfile.test", 123U, 456U));
+    ::remove(name.c_str());
+}
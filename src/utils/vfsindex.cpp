@@ -0,0 +1,868 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/vfsindex.h"
+
+#include "logger.h"
+
+#include "utils/files.h"
+#include "utils/mkdir.h"
+#include "utils/mutex.h"
+#include "utils/physfstools.h"
+
+#include <fstream>
+#include <list>
+#include <map>
+#include <vector>
+
+#include <fcntl.h>
+#include <zlib.h>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifndef WIN32
+#include <sys/mman.h>
+#endif  // WIN32
+
+#include <unistd.h>
+
+#include "debug.h"
+
+// file format: magic, version, archives count, then for each archive:
+// path, file size, modification time, entries count, entries
+static const int vfsIndexMagic = 0x49534656;
+static const int vfsIndexVersion = 1;
+
+namespace
+{
+    struct VfsEntry final
+    {
+        VfsEntry() :
+            offset(0),
+            dataOffset(0),
+            packedSize(0),
+            size(0),
+            method(0),
+            isDir(false)
+        {
+        }
+
+        uint32_t offset;
+        uint32_t dataOffset;
+        uint32_t packedSize;
+        uint32_t size;
+        uint16_t method;
+        bool isDir;
+    };
+
+    typedef std::map<std::string, VfsEntry> VfsEntries;
+
+    struct VfsMount final
+    {
+        VfsMount() :
+            path(),
+            entries(),
+            fileSize(0),
+            fileTime(0),
+            isDir(false),
+            indexed(false),
+            checked(false)
+        {
+        }
+
+        std::string path;
+        VfsEntries entries;
+        int64_t fileSize;
+        int64_t fileTime;
+        bool isDir;
+        bool indexed;
+        // archive already indexed or can't be indexed
+        bool checked;
+    };
+
+    struct VfsFile final
+    {
+        VfsFile(VfsMount *const mount0,
+                VfsEntry *const entry0,
+                const int order0) :
+            mount(mount0),
+            entry(entry0),
+            order(order0)
+        {
+        }
+
+        VfsMount *mount;
+        VfsEntry *entry;
+        int order;
+    };
+
+    typedef std::list<VfsMount> VfsMounts;
+    typedef std::map<std::string, VfsFile> VfsFiles;
+
+    Mutex mMutex;
+    VfsMounts mMounts;
+    VfsFiles mFiles;
+    std::map<std::string, VfsMount> mCached;
+    std::string mCacheFile;
+    bool mDirty = true;
+    bool mCacheDirty = false;
+    bool mEnabled = true;
+    const char *const emptyData = "";
+}  // namespace
+
+static uint16_t readU16(const unsigned char *const ptr)
+{
+    return static_cast<uint16_t>(ptr[0] | (ptr[1] << 8));
+}
+
+static uint32_t readU32(const unsigned char *const ptr)
+{
+    return static_cast<uint32_t>(ptr[0]) |
+        (static_cast<uint32_t>(ptr[1]) << 8) |
+        (static_cast<uint32_t>(ptr[2]) << 16) |
+        (static_cast<uint32_t>(ptr[3]) << 24);
+}
+
+static bool readRegion(const std::string &path,
+                       const uint32_t offset,
+                       const size_t size,
+                       std::vector<unsigned char> &buf)
+{
+    std::ifstream file;
+    file.open(path.c_str(), std::ios::in | std::ios::binary);
+    if (!file.is_open())
+        return false;
+    file.seekg(offset, std::ios::beg);
+    buf.resize(size);
+    if (size)
+        file.read(reinterpret_cast<char*>(&buf[0]), size);
+    return file.good() || CAST_SIZE(file.gcount()) == size;
+}
+
+static void addParentDirs(VfsEntries &entries, const std::string &name)
+{
+    size_t pos = name.rfind('/');
+    while (pos != std::string::npos && pos > 0)
+    {
+        const std::string dir = name.substr(0, pos);
+        if (entries.find(dir) != entries.end())
+            break;
+        entries[dir].isDir = true;
+        pos = dir.rfind('/');
+    }
+}
+
+static bool indexZip(VfsMount &mount)
+{
+    std::ifstream file;
+    file.open(mount.path.c_str(), std::ios::in | std::ios::binary);
+    if (!file.is_open())
+        return false;
+    file.seekg(0, std::ios::end);
+    const int64_t fileSize = file.tellg();
+    file.close();
+    if (fileSize < 22 || fileSize > 0x7fffffff)
+        return false;
+
+    // end of central directory record located in last 64k + 22 bytes
+    const uint32_t tailSize = static_cast<uint32_t>(
+        fileSize > 65557 ? 65557 : fileSize);
+    std::vector<unsigned char> tail;
+    if (!readRegion(mount.path, static_cast<uint32_t>(fileSize - tailSize),
+        tailSize, tail))
+    {
+        return false;
+    }
+    int eocd = -1;
+    for (int f = CAST_S32(tailSize) - 22; f >= 0; f --)
+    {
+        if (readU32(&tail[f]) == 0x06054b50U)
+        {
+            eocd = f;
+            break;
+        }
+    }
+    if (eocd < 0)
+        return false;
+
+    const uint16_t count = readU16(&tail[eocd + 10]);
+    const uint32_t dirSize = readU32(&tail[eocd + 12]);
+    const uint32_t dirOffset = readU32(&tail[eocd + 16]);
+    // zip64 archives left to PhysFS
+    if (count == 0xffffU ||
+        dirOffset == 0xffffffffU ||
+        static_cast<int64_t>(dirOffset) + dirSize > fileSize)
+    {
+        return false;
+    }
+
+    std::vector<unsigned char> dir;
+    if (!readRegion(mount.path, dirOffset, dirSize, dir))
+        return false;
+
+    size_t pos = 0;
+    for (int f = 0; f < count; f ++)
+    {
+        if (pos + 46 > dir.size() || readU32(&dir[pos]) != 0x02014b50U)
+            return false;
+        const unsigned char *const ptr = &dir[pos];
+        const uint16_t flags = readU16(ptr + 8);
+        const uint16_t method = readU16(ptr + 10);
+        const uint16_t nameLen = readU16(ptr + 28);
+        const uint16_t extraLen = readU16(ptr + 30);
+        const uint16_t commentLen = readU16(ptr + 32);
+        if (pos + 46 + nameLen > dir.size())
+            return false;
+        std::string name(reinterpret_cast<const char*>(ptr + 46), nameLen);
+        pos += 46 + nameLen + extraLen + commentLen;
+
+        if (name.empty())
+            continue;
+        if (name[name.size() - 1] == '/')
+        {
+            name.erase(name.size() - 1);
+            if (!name.empty())
+            {
+                mount.entries[name].isDir = true;
+                addParentDirs(mount.entries, name);
+            }
+            continue;
+        }
+        // encrypted files and unknown compression left to PhysFS
+        if ((flags & 1) || (method != 0 && method != 8))
+            return false;
+
+        VfsEntry &entry = mount.entries[name];
+        entry.method = method;
+        entry.packedSize = readU32(ptr + 20);
+        entry.size = readU32(ptr + 24);
+        entry.offset = readU32(ptr + 42);
+        entry.isDir = false;
+        addParentDirs(mount.entries, name);
+    }
+    return true;
+}
+
+static bool readString(std::ifstream &file, std::string &str)
+{
+    int len = 0;
+    file.read(reinterpret_cast<char*>(&len), sizeof(int));
+    if (!file.good() || len < 0 || len > 65535)
+        return false;
+    str.resize(len);
+    if (len)
+        file.read(&str[0], len);
+    return file.good();
+}
+
+static void writeString(std::string &data, const std::string &str)
+{
+    const int len = CAST_S32(str.size());
+    data.append(reinterpret_cast<const char*>(&len), sizeof(int));
+    data.append(str);
+}
+
+template<typename T>
+static bool readValue(std::ifstream &file, T &val)
+{
+    file.read(reinterpret_cast<char*>(&val), sizeof(T));
+    return file.good();
+}
+
+template<typename T>
+static void writeValue(std::string &data, const T &val)
+{
+    data.append(reinterpret_cast<const char*>(&val), sizeof(T));
+}
+
+static void loadCache()
+{
+    mCached.clear();
+    std::ifstream file;
+    file.open(mCacheFile.c_str(), std::ios::in | std::ios::binary);
+    if (!file.is_open())
+        return;
+
+    int magic = 0;
+    int version = 0;
+    int count = 0;
+    if (!readValue(file, magic) ||
+        !readValue(file, version) ||
+        !readValue(file, count) ||
+        magic != vfsIndexMagic ||
+        version != vfsIndexVersion)
+    {
+        logger->log("Outdated vfs index cache: %s", mCacheFile.c_str());
+        return;
+    }
+
+    for (int f = 0; f < count; f ++)
+    {
+        VfsMount mount;
+        int entries = 0;
+        if (!readString(file, mount.path) ||
+            !readValue(file, mount.fileSize) ||
+            !readValue(file, mount.fileTime) ||
+            !readValue(file, entries) ||
+            entries < 0)
+        {
+            break;
+        }
+        bool correct(true);
+        for (int i = 0; i < entries; i ++)
+        {
+            std::string name;
+            VfsEntry entry;
+            uint8_t isDir = 0;
+            if (!readString(file, name) ||
+                !readValue(file, entry.offset) ||
+                !readValue(file, entry.packedSize) ||
+                !readValue(file, entry.size) ||
+                !readValue(file, entry.method) ||
+                !readValue(file, isDir))
+            {
+                correct = false;
+                break;
+            }
+            entry.isDir = isDir != 0;
+            mount.entries[name] = entry;
+        }
+        if (!correct)
+        {
+            logger->log("Broken vfs index cache: %s", mCacheFile.c_str());
+            break;
+        }
+        mount.indexed = true;
+        mCached[mount.path] = mount;
+    }
+}
+
+// serialize index of mounted archives for save after unlock
+static void writeCache(std::string &data)
+{
+    int count = 0;
+    FOR_EACH (VfsMounts::const_iterator, it, mMounts)
+    {
+        if (!(*it).isDir && (*it).indexed)
+            count ++;
+    }
+    writeValue(data, vfsIndexMagic);
+    writeValue(data, vfsIndexVersion);
+    writeValue(data, count);
+    FOR_EACH (VfsMounts::const_iterator, it, mMounts)
+    {
+        const VfsMount &mount = *it;
+        if (mount.isDir || !mount.indexed)
+            continue;
+        writeString(data, mount.path);
+        writeValue(data, mount.fileSize);
+        writeValue(data, mount.fileTime);
+        writeValue(data, CAST_S32(mount.entries.size()));
+        FOR_EACH (VfsEntries::const_iterator, it2, mount.entries)
+        {
+            const VfsEntry &entry = (*it2).second;
+            writeString(data, (*it2).first);
+            writeValue(data, entry.offset);
+            writeValue(data, entry.packedSize);
+            writeValue(data, entry.size);
+            writeValue(data, entry.method);
+            writeValue(data, static_cast<uint8_t>(entry.isDir ? 1 : 0));
+        }
+    }
+}
+
+static void rebuild()
+{
+    mFiles.clear();
+    mEnabled = true;
+    int order = 0;
+    FOR_EACH (VfsMounts::iterator, it, mMounts)
+    {
+        VfsMount &mount = *it;
+        if (!mount.isDir)
+        {
+            if (!mount.indexed)
+                mEnabled = false;
+            FOR_EACH (VfsEntries::iterator, it2, mount.entries)
+            {
+                mFiles.insert(std::make_pair((*it2).first,
+                    VfsFile(&mount, &(*it2).second, order)));
+            }
+        }
+        order ++;
+    }
+    mDirty = false;
+}
+
+// stat file in directory mount. like PhysFS by default, symbolic links
+// in path not followed and file behind link treated as not existing.
+static bool statFile(const std::string &dir,
+                     const std::string &path,
+                     struct stat &statbuf)
+{
+#ifdef WIN32
+    return !stat(std::string(dir).append(dirSeparator).append(
+        path).c_str(), &statbuf);
+#else  // WIN32
+
+    std::string realPath(dir);
+    size_t start = 0;
+    while (start < path.size())
+    {
+        size_t end = path.find('/', start);
+        if (end == std::string::npos)
+            end = path.size();
+        realPath.append(dirSeparator).append(path, start, end - start);
+        if (lstat(realPath.c_str(), &statbuf) ||
+            S_ISLNK(statbuf.st_mode))
+        {
+            return false;
+        }
+        start = end + 1;
+    }
+    return !path.empty();
+#endif  // WIN32
+}
+
+// find file in search path. returns false if file not found.
+// for files in directories entry is null.
+static bool findFile(const char *const name,
+                     VfsMount *&mount,
+                     VfsEntry *&entry,
+                     bool &isDir)
+{
+    if (mDirty)
+        rebuild();
+
+    std::string path(name);
+    while (!path.empty() && path[0] == '/')
+        path.erase(0, 1);
+    while (!path.empty() && path[path.size() - 1] == '/')
+        path.erase(path.size() - 1);
+    if (path.empty())
+        return false;
+
+    const VfsFiles::iterator it = mFiles.find(path);
+    const int limit = it != mFiles.end() ?
+        (*it).second.order : CAST_S32(mMounts.size());
+
+    int order = 0;
+    for (VfsMounts::iterator it2 = mMounts.begin();
+         it2 != mMounts.end() && order < limit;
+         ++ it2, ++ order)
+    {
+        VfsMount &dir = *it2;
+        if (!dir.isDir)
+            continue;
+        struct stat statbuf;
+        if (statFile(dir.path, path, statbuf))
+        {
+            mount = &dir;
+            entry = nullptr;
+            isDir = S_ISDIR(statbuf.st_mode);
+            return true;
+        }
+    }
+
+    if (it == mFiles.end())
+        return false;
+    mount = (*it).second.mount;
+    entry = (*it).second.entry;
+    isDir = entry->isDir;
+    return true;
+}
+
+static bool mapRegion(const std::string &path,
+                      const uint32_t offset,
+                      const size_t size,
+                      VfsData &data)
+{
+    if (!size)
+    {
+        data.data = emptyData;
+        data.size = 0;
+        return true;
+    }
+
+#ifdef WIN32
+    std::ifstream file;
+    file.open(path.c_str(), std::ios::in | std::ios::binary);
+    if (!file.is_open())
+        return false;
+    file.seekg(offset, std::ios::beg);
+    data.buffer = malloc(size);
+    if (!data.buffer)
+        return false;
+    file.read(static_cast<char*>(data.buffer), size);
+    if (CAST_SIZE(file.gcount()) != size)
+    {
+        free(data.buffer);
+        data.buffer = nullptr;
+        return false;
+    }
+    data.data = static_cast<const char*>(data.buffer);
+    data.size = size;
+    return true;
+#else  // WIN32
+
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        return false;
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    const uint32_t delta = pageSize > 0 ?
+        offset % static_cast<uint32_t>(pageSize) : 0;
+    void *const ptr = mmap(nullptr, size + delta, PROT_READ, MAP_PRIVATE,
+        fd, offset - delta);
+    close(fd);
+    if (ptr == MAP_FAILED)
+        return false;
+    data.map = ptr;
+    data.mapSize = size + delta;
+    data.data = static_cast<const char*>(ptr) + delta;
+    data.size = size;
+    return true;
+#endif  // WIN32
+}
+
+static bool inflateEntry(const std::string &path,
+                         const VfsEntry &entry,
+                         VfsData &data)
+{
+    VfsData packed;
+    if (!mapRegion(path, entry.dataOffset, entry.packedSize, packed))
+        return false;
+
+    data.buffer = malloc(entry.size ? entry.size : 1);
+    if (!data.buffer)
+    {
+        VfsIndex::freeData(packed);
+        return false;
+    }
+
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(packed.data));
+    strm.avail_in = CAST_U32(packed.size);
+    strm.next_out = static_cast<Bytef*>(data.buffer);
+    strm.avail_out = entry.size;
+
+    bool correct(false);
+    if (inflateInit2(&strm, -MAX_WBITS) == Z_OK)
+    {
+        const int ret = inflate(&strm, Z_FINISH);
+        correct = ret == Z_STREAM_END && strm.total_out == entry.size;
+        inflateEnd(&strm);
+    }
+    VfsIndex::freeData(packed);
+
+    if (!correct)
+    {
+        free(data.buffer);
+        data.buffer = nullptr;
+        return false;
+    }
+    data.data = static_cast<const char*>(data.buffer);
+    data.size = entry.size;
+    return true;
+}
+
+// data offset known only from local header, so it read on first access
+static bool findDataOffset(const std::string &path,
+                           VfsEntry &entry)
+{
+    if (entry.dataOffset)
+        return true;
+
+    std::vector<unsigned char> header;
+    if (!readRegion(path, entry.offset, 30, header) ||
+        readU32(&header[0]) != 0x04034b50U)
+    {
+        return false;
+    }
+    entry.dataOffset = entry.offset + 30 +
+        readU16(&header[26]) + readU16(&header[28]);
+    return true;
+}
+
+static bool readEntry(const std::string &path,
+                      const VfsEntry &entry,
+                      VfsData &data)
+{
+    if (entry.method == 0)
+        return mapRegion(path, entry.dataOffset, entry.size, data);
+    return inflateEntry(path, entry, data);
+}
+
+namespace VfsIndex
+{
+    void setCacheDir(const std::string &dir)
+    {
+        MutexLocker lock(&mMutex);
+        mkdir_r(dir.c_str());
+        mCacheFile = std::string(dir).append("/vfsindex.bin");
+        loadCache();
+    }
+
+    void addMount(const std::string &path, const int appendToPath)
+    {
+        MutexLocker lock(&mMutex);
+        FOR_EACH (VfsMounts::const_iterator, it, mMounts)
+        {
+            if ((*it).path == path)
+                return;
+        }
+
+        VfsMount mount;
+        mount.path = path;
+        struct stat statbuf;
+        bool isLink(false);
+#ifdef WIN32
+        if (!stat(path.c_str(), &statbuf))
+#else  // WIN32
+
+        if (!lstat(path.c_str(), &statbuf))
+#endif  // WIN32
+        {
+#ifndef WIN32
+            isLink = S_ISLNK(statbuf.st_mode);
+#endif  // WIN32
+
+            mount.isDir = S_ISDIR(statbuf.st_mode);
+            mount.fileSize = statbuf.st_size;
+            mount.fileTime = statbuf.st_mtime;
+        }
+        if (isLink)
+        {
+            // links not followed by index, so leave it to PhysFS
+            logger->log("Vfs index disabled by link: %s", path.c_str());
+            mount.checked = true;
+        }
+        else if (!mount.isDir)
+        {
+            // archives missing in cache indexed later by update
+            const std::map<std::string, VfsMount>::const_iterator it =
+                mCached.find(path);
+            if (it != mCached.end() &&
+                (*it).second.fileSize == mount.fileSize &&
+                (*it).second.fileTime == mount.fileTime)
+            {
+                mount.entries = (*it).second.entries;
+                mount.indexed = true;
+                mount.checked = true;
+            }
+        }
+
+        if (appendToPath)
+            mMounts.push_back(mount);
+        else
+            mMounts.push_front(mount);
+        mDirty = true;
+    }
+
+    void update()
+    {
+        std::list<VfsMount> archives;
+        {
+            MutexLocker lock(&mMutex);
+            FOR_EACH (VfsMounts::const_iterator, it, mMounts)
+            {
+                const VfsMount &mount = *it;
+                if (!mount.isDir && !mount.checked)
+                {
+                    archives.push_back(VfsMount());
+                    VfsMount &archive = archives.back();
+                    archive.path = mount.path;
+                    archive.fileSize = mount.fileSize;
+                    archive.fileTime = mount.fileTime;
+                }
+            }
+        }
+
+        // archives scanned without lock, lookups meanwhile use PhysFS
+        FOR_EACH (std::list<VfsMount>::iterator, it, archives)
+        {
+            VfsMount &archive = *it;
+            archive.indexed = indexZip(archive);
+            if (!archive.indexed)
+            {
+                logger->log("Vfs index disabled by archive: %s",
+                    archive.path.c_str());
+                archive.entries.clear();
+            }
+        }
+
+        std::string data;
+        std::string cacheFile;
+        {
+            MutexLocker lock(&mMutex);
+            FOR_EACH (std::list<VfsMount>::iterator, it, archives)
+            {
+                VfsMount &archive = *it;
+                FOR_EACH (VfsMounts::iterator, it2, mMounts)
+                {
+                    VfsMount &mount = *it2;
+                    if (mount.checked ||
+                        mount.path != archive.path ||
+                        mount.fileSize != archive.fileSize ||
+                        mount.fileTime != archive.fileTime)
+                    {
+                        continue;
+                    }
+                    mount.entries.swap(archive.entries);
+                    mount.indexed = archive.indexed;
+                    mount.checked = true;
+                    mDirty = true;
+                    if (mount.indexed)
+                        mCacheDirty = true;
+                    break;
+                }
+            }
+            if (mDirty)
+                rebuild();
+            if (mCacheDirty && !mCacheFile.empty())
+            {
+                writeCache(data);
+                cacheFile = mCacheFile;
+            }
+            mCacheDirty = false;
+        }
+
+        if (!data.empty() &&
+            !Files::writeFileAtomic(cacheFile, data.c_str(), data.size()))
+        {
+            logger->log("Error saving vfs index cache: %s",
+                cacheFile.c_str());
+        }
+    }
+
+    void removeMount(const std::string &path)
+    {
+        MutexLocker lock(&mMutex);
+        FOR_EACH (VfsMounts::iterator, it, mMounts)
+        {
+            if ((*it).path == path)
+            {
+                mMounts.erase(it);
+                mDirty = true;
+                return;
+            }
+        }
+    }
+
+    bool exists(const char *const name, bool &found)
+    {
+        if (!name)
+            return false;
+        MutexLocker lock(&mMutex);
+        VfsMount *mount = nullptr;
+        VfsEntry *entry = nullptr;
+        bool isDir(false);
+        found = findFile(name, mount, entry, isDir);
+        return mEnabled;
+    }
+
+    bool isDirectory(const char *const name, bool &isDir)
+    {
+        if (!name)
+            return false;
+        MutexLocker lock(&mMutex);
+        VfsMount *mount = nullptr;
+        VfsEntry *entry = nullptr;
+        isDir = false;
+        if (!findFile(name, mount, entry, isDir))
+            isDir = false;
+        return mEnabled;
+    }
+
+    bool getRealDir(const char *const name, std::string &dir)
+    {
+        if (!name)
+            return false;
+        MutexLocker lock(&mMutex);
+        VfsMount *mount = nullptr;
+        VfsEntry *entry = nullptr;
+        bool isDir(false);
+        // mount can be removed after unlock, so path copied
+        if (findFile(name, mount, entry, isDir))
+            dir = mount->path;
+        else
+            dir.clear();
+        return mEnabled;
+    }
+
+    bool readFile(const char *const name, VfsData &data)
+    {
+        if (!name)
+            return false;
+        // only lookup done under lock, data read and inflated after it
+        std::string mountPath;
+        VfsEntry entryCopy;
+        bool inArchive(false);
+        {
+            MutexLocker lock(&mMutex);
+            VfsMount *mount = nullptr;
+            VfsEntry *entry = nullptr;
+            bool isDir(false);
+            if (!mEnabled ||
+                !findFile(name, mount, entry, isDir) ||
+                isDir)
+            {
+                return false;
+            }
+            mountPath = mount->path;
+            if (entry)
+            {
+                if (!findDataOffset(mountPath, *entry))
+                    return false;
+                entryCopy = *entry;
+                inArchive = true;
+            }
+        }
+        if (inArchive)
+            return readEntry(mountPath, entryCopy, data);
+
+        std::string path(name);
+        while (!path.empty() && path[0] == '/')
+            path.erase(0, 1);
+        struct stat statbuf;
+        if (!statFile(mountPath, path, statbuf))
+            return false;
+        const std::string realPath = mountPath.append(
+            dirSeparator).append(path);
+        return mapRegion(realPath, 0, statbuf.st_size, data);
+    }
+
+    void freeData(VfsData &data)
+    {
+#ifndef WIN32
+        if (data.map)
+            munmap(data.map, data.mapSize);
+#endif  // WIN32
+        free(data.buffer);
+        data.map = nullptr;
+        data.mapSize = 0;
+        data.buffer = nullptr;
+        data.data = nullptr;
+        data.size = 0;
+    }
+}  // namespace VfsIndex
@@ -0,0 +1,84 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UTILS_VFSINDEX_H
+#define UTILS_VFSINDEX_H
+
+#include <string>
+
+#include "localconsts.h"
+
+/**
+ * File data returned by VfsIndex::readFile.
+ * Data can be mapped from file or allocated by malloc.
+ */
+struct VfsData final
+{
+    VfsData() :
+        data(nullptr),
+        size(0),
+        map(nullptr),
+        mapSize(0),
+        buffer(nullptr)
+    {
+    }
+
+    A_DELETE_COPY(VfsData)
+
+    const char *data;
+    size_t size;
+    void *map;
+    size_t mapSize;
+    void *buffer;
+};
+
+/**
+ * Index of files in PhysFS search path.
+ * Zip archives indexed once and index stored in cache dir.
+ * Directories in search path checked directly.
+ * All functions return false if index can't answer and caller should
+ * use PhysFS.
+ */
+namespace VfsIndex
+{
+    void setCacheDir(const std::string &dir);
+
+    void addMount(const std::string &path, const int appendToPath);
+
+    /**
+     * Indexes archives added after last call and saves index cache.
+     * Should be called without other locks after mounts added.
+     */
+    void update();
+
+    void removeMount(const std::string &path);
+
+    bool exists(const char *const name, bool &found);
+
+    bool isDirectory(const char *const name, bool &isDir);
+
+    bool getRealDir(const char *const name, std::string &dir);
+
+    bool readFile(const char *const name, VfsData &data);
+
+    void freeData(VfsData &data);
+}  // namespace VfsIndex
+
+#endif  // UTILS_VFSINDEX_H
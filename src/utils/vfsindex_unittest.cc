@@ -0,0 +1,262 @@
+/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "utils/vfsindex.h"
+
+#include "catch.hpp"
+#include "logger.h"
+
+#include "utils/delete2.h"
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include <zlib.h>
+
+#include "debug.h"
+
+namespace
+{
+    struct ZipEntry final
+    {
+        ZipEntry(const std::string &name0,
+                 const std::string &data0,
+                 const bool deflated0) :
+            name(name0),
+            data(data0),
+            deflated(deflated0)
+        {
+        }
+
+        std::string name;
+        std::string data;
+        bool deflated;
+    };
+
+    enum ZipDamage
+    {
+        ZipDamage_none = 0,
+        ZipDamage_truncatedDir,
+        ZipDamage_badLocalOffset
+    };
+}  // namespace
+
+static void addU16(std::string &str, const unsigned int val)
+{
+    str.append(1, static_cast<char>(val & 0xff));
+    str.append(1, static_cast<char>((val >> 8) & 0xff));
+}
+
+static void addU32(std::string &str, const unsigned int val)
+{
+    addU16(str, val & 0xffff);
+    addU16(str, (val >> 16) & 0xffff);
+}
+
+static std::string deflateData(const std::string &data)
+{
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    REQUIRE(deflateInit2(&strm, Z_BEST_COMPRESSION, Z_DEFLATED,
+        -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) == Z_OK);
+    std::vector<char> buf(deflateBound(&strm,
+        static_cast<uLong>(data.size())));
+    strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.c_str()));
+    strm.avail_in = static_cast<uInt>(data.size());
+    strm.next_out = reinterpret_cast<Bytef*>(&buf[0]);
+    strm.avail_out = static_cast<uInt>(buf.size());
+    REQUIRE(deflate(&strm, Z_FINISH) == Z_STREAM_END);
+    const std::string packed(&buf[0], strm.total_out);
+    deflateEnd(&strm);
+    return packed;
+}
+
+static void writeZip(const std::string &fileName,
+                     const std::vector<ZipEntry> &entries,
+                     const ZipDamage damage)
+{
+    std::string data;
+    std::string dir;
+    for (size_t f = 0; f < entries.size(); f ++)
+    {
+        const ZipEntry &entry = entries[f];
+        const std::string packed = entry.deflated ?
+            deflateData(entry.data) : entry.data;
+        const unsigned int crc = static_cast<unsigned int>(crc32(0,
+            reinterpret_cast<const Bytef*>(entry.data.c_str()),
+            static_cast<uInt>(entry.data.size())));
+        const unsigned int method = entry.deflated ? 8 : 0;
+        unsigned int offset = static_cast<unsigned int>(data.size());
+        if (damage == ZipDamage_badLocalOffset)
+            offset += 3;
+
+        addU32(data, 0x04034b50U);
+        addU16(data, 20);
+        addU16(data, 0);
+        addU16(data, method);
+        addU32(data, 0);
+        addU32(data, crc);
+        addU32(data, static_cast<unsigned int>(packed.size()));
+        addU32(data, static_cast<unsigned int>(entry.data.size()));
+        addU16(data, static_cast<unsigned int>(entry.name.size()));
+        addU16(data, 0);
+        data.append(entry.name);
+        data.append(packed);
+
+        addU32(dir, 0x02014b50U);
+        addU16(dir, 20);
+        addU16(dir, 20);
+        addU16(dir, 0);
+        addU16(dir, method);
+        addU32(dir, 0);
+        addU32(dir, crc);
+        addU32(dir, static_cast<unsigned int>(packed.size()));
+        addU32(dir, static_cast<unsigned int>(entry.data.size()));
+        addU16(dir, static_cast<unsigned int>(entry.name.size()));
+        addU16(dir, 0);
+        addU16(dir, 0);
+        addU16(dir, 0);
+        addU16(dir, 0);
+        addU32(dir, 0);
+        addU32(dir, offset);
+        dir.append(entry.name);
+    }
+
+    const unsigned int dirOffset = static_cast<unsigned int>(data.size());
+    unsigned int dirSize = static_cast<unsigned int>(dir.size());
+    if (damage == ZipDamage_truncatedDir)
+    {
+        // last entry of central directory cut in half
+        dir.resize(dir.size() - 20);
+    }
+    data.append(dir);
+
+    addU32(data, 0x06054b50U);
+    addU16(data, 0);
+    addU16(data, 0);
+    addU16(data, static_cast<unsigned int>(entries.size()));
+    addU16(data, static_cast<unsigned int>(entries.size()));
+    if (damage == ZipDamage_truncatedDir)
+        dirSize = static_cast<unsigned int>(dir.size());
+    addU32(data, dirSize);
+    addU32(data, dirOffset);
+    addU16(data, 0);
+
+    std::ofstream file;
+    file.open(fileName.c_str(),
+        std::ios::out | std::ios::binary | std::ios::trunc);
+    file.write(data.c_str(), data.size());
+    file.close();
+}
+
+static std::string readData(const char *const name)
+{
+    VfsData data;
+    if (!VfsIndex::readFile(name, data))
+        return "<error>";
+    const std::string str(data.data, data.size);
+    VfsIndex::freeData(data);
+    return str;
+}
+
+TEST_CASE("VfsIndex zip")
+{
+    logger = new Logger();
+
+    std::string bigData;
+    for (int f = 0; f < 1000; f ++)
+        bigData.append("deflated data line\n");
+
+    std::vector<ZipEntry> entries;
+    entries.push_back(ZipEntry("vfstest/dir/stored.txt",
+        "stored data", false));
+    entries.push_back(ZipEntry("vfstest/dir/sub/deflated.txt",
+        bigData, true));
+    entries.push_back(ZipEntry("vfstest/empty.txt", "", false));
+
+    SECTION("stored and deflated")
+    {
+        const std::string fileName = "vfsindextest1.zip";
+        writeZip(fileName, entries, ZipDamage_none);
+        VfsIndex::addMount(fileName, 1);
+        VfsIndex::update();
+
+        bool found(false);
+        REQUIRE(VfsIndex::exists("vfstest/dir/stored.txt", found));
+        REQUIRE(found);
+        REQUIRE(VfsIndex::exists("vfstest/missing.txt", found));
+        REQUIRE(!found);
+        bool isDir(false);
+        REQUIRE(VfsIndex::isDirectory("vfstest/dir/sub", isDir));
+        REQUIRE(isDir);
+        REQUIRE(VfsIndex::isDirectory("vfstest/dir/stored.txt", isDir));
+        REQUIRE(!isDir);
+        std::string dir;
+        REQUIRE(VfsIndex::getRealDir("vfstest/dir/sub/deflated.txt", dir));
+        REQUIRE(dir == fileName);
+
+        REQUIRE(readData("vfstest/dir/stored.txt") == "stored data");
+        REQUIRE(readData("vfstest/dir/sub/deflated.txt") == bigData);
+        REQUIRE(readData("vfstest/empty.txt").empty());
+        REQUIRE(readData("vfstest/dir") == "<error>");
+
+        VfsIndex::removeMount(fileName);
+        ::remove(fileName.c_str());
+    }
+
+    SECTION("truncated central directory")
+    {
+        const std::string fileName = "vfsindextest2.zip";
+        writeZip(fileName, entries, ZipDamage_truncatedDir);
+        VfsIndex::addMount(fileName, 1);
+        VfsIndex::update();
+
+        // archive left to PhysFS
+        bool found(false);
+        REQUIRE(!VfsIndex::exists("vfstest/dir/stored.txt", found));
+        REQUIRE(readData("vfstest/dir/stored.txt") == "<error>");
+
+        VfsIndex::removeMount(fileName);
+        ::remove(fileName.c_str());
+    }
+
+    SECTION("bad local header offset")
+    {
+        const std::string fileName = "vfsindextest3.zip";
+        writeZip(fileName, entries, ZipDamage_badLocalOffset);
+        VfsIndex::addMount(fileName, 1);
+        VfsIndex::update();
+
+        bool found(false);
+        REQUIRE(VfsIndex::exists("vfstest/dir/stored.txt", found));
+        REQUIRE(found);
+        REQUIRE(readData("vfstest/dir/stored.txt") == "<error>");
+        REQUIRE(readData("vfstest/dir/sub/deflated.txt") == "<error>");
+
+        VfsIndex::removeMount(fileName);
+        ::remove(fileName.c_str());
+    }
+
+    delete2(logger);
+}
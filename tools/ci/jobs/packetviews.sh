@@ -0,0 +1,7 @@
+#!/bin/bash
+
+source ./tools/ci/scripts/init.sh
+
+aptget_install python3
+
+python3 ./tools/packetviews.py --check
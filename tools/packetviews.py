@@ -0,0 +1,220 @@
+#!/usr/bin/env python3
+# -*- coding: utf8 -*-
+#
+# Copyright (C) 2016  The ManaPlus Developers
+#
+# This file is part of The ManaPlus Client.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# Generates packet view structs for fixed size eathena packets.
+# Reads layouts from src/net/eathena/packetviews.txt and checks
+# packet sizes with src/net/eathena/packetsin.inc.
+#
+# Usage:
+#   packetviews.py [--check]
+#
+# --check  do not write header, fail if it is not up to date
+
+import argparse
+import os
+import re
+import sys
+
+srcDir = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+    "..", "src", "net", "eathena")
+schemaFile = os.path.join(srcDir, "packetviews.txt")
+packetsFile = os.path.join(srcDir, "packetsin.inc")
+headerFile = os.path.join(srcDir, "packetviews.h")
+
+# type: (size, return type, reader)
+types = {
+    "int8": (1, "int8_t", "readInt8"),
+    "uint8": (1, "uint8_t", "readUInt8"),
+    "int16": (2, "int16_t", "readInt16"),
+    "uint16": (2, "uint16_t", "readUInt16"),
+    "int32": (4, "int32_t", "readInt32"),
+    "uint32": (4, "uint32_t", "readUInt32"),
+    "int64": (8, "int64_t", "readInt64"),
+    "beingid": (4, "BeingId", "readInt32"),
+    "coords": (3, None, "readCoordinates"),
+    "coordpair": (5, None, "readCoordinatePair"),
+}
+
+packetRe = re.compile(r"^\s*packet\((\w+),\s*(0x[0-9a-fA-F]+),\s*(-?\d+),")
+
+header = """/*
+ *  The ManaPlus Client
+ *  Copyright (C) 2016  The ManaPlus Developers
+ *
+ *  This file is part of The ManaPlus Client.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Generated by tools/packetviews.py from packetviews.txt. Do not edit.
+
+#ifndef NET_EATHENA_PACKETVIEWS_H
+#define NET_EATHENA_PACKETVIEWS_H
+
+#include "enums/simpletypes/beingid.h"
+
+#include "net/packetview.h"
+
+#include "localconsts.h"
+
+namespace EAthena
+{
+"""
+
+footer = """}  // namespace EAthena
+
+#endif  // NET_EATHENA_PACKETVIEWS_H
+"""
+
+
+def fail(text):
+    print("packetviews: " + text, file=sys.stderr)
+    sys.exit(1)
+
+
+def readPackets():
+    packets = {}
+    with open(packetsFile, "r") as r:
+        for line in r:
+            m = packetRe.match(line)
+            if m:
+                packets.setdefault(m.group(1), []).append(int(m.group(3)))
+    return packets
+
+
+def readSchema():
+    views = []
+    with open(schemaFile, "r") as r:
+        for num, line in enumerate(r, 1):
+            line = line.split("#")[0].rstrip()
+            if not line.strip():
+                continue
+            parts = line.split()
+            if not line[0].isspace():
+                if len(parts) != 3 or parts[0] != "view":
+                    fail("line %d: wrong view line" % num)
+                views.append((parts[1], parts[2], []))
+                continue
+            if not views:
+                fail("line %d: field outside of view" % num)
+            fieldType = parts[0]
+            if fieldType == "string":
+                if len(parts) != 3:
+                    fail("line %d: wrong string field" % num)
+                size = int(parts[1])
+                name = parts[2]
+            else:
+                if len(parts) != 2 or fieldType not in types:
+                    fail("line %d: wrong field" % num)
+                size = types[fieldType][0]
+                name = parts[1]
+            views[-1][2].append((fieldType, name, size))
+    return views
+
+
+def fieldCode(fieldType, name, offset, size):
+    ptr = "mData + %d" % offset if offset else "mData"
+    if fieldType == "string":
+        return ("    std::string %s() const A_WARN_UNUSED\n"
+            "    { return Net::PacketView::readString(%s, %d); }\n"
+            % (name, ptr, size))
+    if fieldType == "coords":
+        return ("    void %s(uint16_t &restrict x,\n"
+            "    %s      uint16_t &restrict y,\n"
+            "    %s      uint8_t &restrict serverDir) const\n"
+            "    { Net::PacketView::readCoordinates(%s, x, y, serverDir); }\n"
+            % (name, " " * len(name), " " * len(name), ptr))
+    if fieldType == "coordpair":
+        pad = " " * len(name)
+        return ("    void %s(uint16_t &restrict srcX,\n"
+            "    %s      uint16_t &restrict srcY,\n"
+            "    %s      uint16_t &restrict dstX,\n"
+            "    %s      uint16_t &restrict dstY) const\n"
+            "    {\n"
+            "        Net::PacketView::readCoordinatePair(%s,\n"
+            "            srcX, srcY, dstX, dstY);\n"
+            "    }\n"
+            % (name, pad, pad, pad, ptr))
+    retType, reader = types[fieldType][1], types[fieldType][2]
+    value = "Net::PacketView::%s(%s)" % (reader, ptr)
+    if fieldType == "beingid":
+        value = "fromInt(%s, BeingId)" % value
+    return ("    %s %s() const A_WARN_UNUSED\n"
+        "    { return %s; }\n" % (retType, name, value))
+
+
+def generate(views, packets):
+    out = [header]
+    for viewName, packetName, fields in views:
+        size = sum(field[2] for field in fields)
+        sizes = packets.get(packetName)
+        if not sizes:
+            fail("packet %s not found" % packetName)
+        for packetSize in sizes:
+            if packetSize != size + 2:
+                fail("packet %s size %d, but view %s size %d"
+                    % (packetName, packetSize, viewName, size + 2))
+        out.append("\n// %s\n" % packetName)
+        out.append("struct %s final\n{\n" % viewName)
+        out.append("    static const unsigned int size = %d;\n\n" % size)
+        out.append("    explicit %s(const char *const data) :\n"
+            "        mData(data)\n"
+            "    {\n"
+            "    }\n\n" % viewName)
+        offset = 0
+        for fieldType, name, fieldSize in fields:
+            if name != "-":
+                out.append(fieldCode(fieldType, name, offset, fieldSize))
+                out.append("\n")
+            offset += fieldSize
+        out.append("    const char *const mData;\n};\n")
+    out.append("\n")
+    out.append(footer)
+    return "".join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate packet views")
+    parser.add_argument("--check", action="store_true")
+    args = parser.parse_args()
+
+    data = generate(readSchema(), readPackets())
+    if args.check:
+        with open(headerFile, "r") as r:
+            if r.read() != data:
+                fail("packetviews.h is not up to date")
+        return
+    with open(headerFile, "w") as w:
+        w.write(data)
+
+
+if __name__ == "__main__":
+    main()
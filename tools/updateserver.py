@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+# -*- coding: utf8 -*-
+#
+# Copyright (C) 2016  The ManaPlus Developers
+#
+# This file is part of The ManaPlus Client.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# Local update server for testing updater.
+# Serves update tree with support for range requests.
+#
+# Usage:
+#   updateserver.py [--fixture N] [--drop BYTES] [--port PORT] dir
+#
+# --fixture N   create fixture update tree with N archives in dir
+# --drop BYTES  close connection after BYTES for first request of each file
+#               to test resume of downloads
+#
+# Start client with: manaplus -H http://127.0.0.1:PORT
+
+import argparse
+import http.server
+import io
+import os
+import random
+import socketserver
+import threading
+import zipfile
+import zlib
+
+
+def createFixture(path, count):
+    os.makedirs(path, exist_ok=True)
+    rnd = random.Random(count)
+    lines = []
+    xml = ['<?xml version="1.0"?>', '<updates>']
+    for f in range(count):
+        name = "update-%03d.zip" % f
+        data = io.BytesIO()
+        with zipfile.ZipFile(data, "w", zipfile.ZIP_STORED) as archive:
+            archive.writestr("data/fixture/%03d.bin" % f,
+                bytes(rnd.getrandbits(8) for _ in range(256 * 1024)))
+        data = data.getvalue()
+        with open(os.path.join(path, name), "wb") as w:
+            w.write(data)
+        adler = "%x" % zlib.adler32(data)
+        lines.append("%s %s" % (name, adler))
+        xml.append('    <update type="data" file="%s" hash="%s" />'
+            % (name, adler))
+    xml.append('</updates>')
+    with open(os.path.join(path, "resources2.txt"), "w") as w:
+        w.write("\n".join(lines) + "\n")
+    with open(os.path.join(path, "resources.xml"), "w") as w:
+        w.write("\n".join(xml) + "\n")
+    with open(os.path.join(path, "news.txt"), "w") as w:
+        w.write("##9 Fixture update server\n")
+
+
+class UpdateHandler(http.server.SimpleHTTPRequestHandler):
+    dropBytes = 0
+    dropped = set()
+    lock = threading.Lock()
+
+    def log_message(self, fmt, *args):
+        print("%s %s" % (self.headers.get("Range", "-"), fmt % args))
+
+    def do_GET(self):
+        path = self.translate_path(self.path)
+        if not os.path.isfile(path):
+            self.send_error(404)
+            return
+        with open(path, "rb") as r:
+            data = r.read()
+        size = len(data)
+        start = 0
+        status = 200
+        rangeHeader = self.headers.get("Range")
+        if rangeHeader and rangeHeader.startswith("bytes="):
+            start = int(rangeHeader[6:].split("-")[0] or 0)
+            if start >= size:
+                self.send_response(416)
+                self.send_header("Content-Range", "bytes */%d" % size)
+                self.send_header("Content-Length", "0")
+                self.end_headers()
+                return
+            status = 206
+        self.send_response(status)
+        self.send_header("Content-Length", str(size - start))
+        self.send_header("Accept-Ranges", "bytes")
+        if status == 206:
+            self.send_header("Content-Range",
+                "bytes %d-%d/%d" % (start, size - 1, size))
+        self.end_headers()
+        body = data[start:]
+        drop = False
+        with UpdateHandler.lock:
+            if UpdateHandler.dropBytes and path not in UpdateHandler.dropped:
+                UpdateHandler.dropped.add(path)
+                drop = len(body) > UpdateHandler.dropBytes
+        if drop:
+            self.wfile.write(body[:UpdateHandler.dropBytes])
+            self.wfile.flush()
+            self.close_connection = True
+            self.connection.shutdown(2)
+            return
+        self.wfile.write(body)
+
+
+class ThreadingServer(socketserver.ThreadingMixIn, http.server.HTTPServer):
+    daemon_threads = True
+    allow_reuse_address = True
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Local update server")
+    parser.add_argument("dir")
+    parser.add_argument("--port", type=int, default=8010)
+    parser.add_argument("--fixture", type=int, default=0)
+    parser.add_argument("--drop", type=int, default=0)
+    args = parser.parse_args()
+
+    if args.fixture:
+        createFixture(args.dir, args.fixture)
+    UpdateHandler.dropBytes = args.drop
+    os.chdir(args.dir)
+    server = ThreadingServer(("127.0.0.1", args.port), UpdateHandler)
+    print("Serving %s on port %d" % (args.dir, args.port))
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()